@@ -44,6 +44,7 @@ extern "C" {
 #define EverCrypt_Error_AuthenticationFailure 3
 #define EverCrypt_Error_InvalidIVLength 4
 #define EverCrypt_Error_DecodeError 5
+#define EverCrypt_Error_OutOfMemory 6
 
 typedef uint8_t EverCrypt_Error_error_code;
 
@@ -59,6 +60,8 @@ bool EverCrypt_Error_uu___is_InvalidIVLength(EverCrypt_Error_error_code projecte
 
 bool EverCrypt_Error_uu___is_DecodeError(EverCrypt_Error_error_code projectee);
 
+bool EverCrypt_Error_uu___is_OutOfMemory(EverCrypt_Error_error_code projectee);
+
 #if defined(__cplusplus)
 }
 #endif
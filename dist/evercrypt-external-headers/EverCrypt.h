@@ -546,6 +546,44 @@ EverCrypt_AEAD_decrypt_expand(
   uint8_t *dst
 );
 
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_encrypt_batch(
+  uint32_t len,
+  EverCrypt_AEAD_state_s **s,
+  uint8_t **iv,
+  uint32_t *iv_len,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **plain,
+  uint32_t *plain_len,
+  uint8_t **cipher,
+  uint8_t **tag,
+  EverCrypt_Error_error_code *res
+);
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_decrypt_batch(
+  uint32_t len,
+  EverCrypt_AEAD_state_s **s,
+  uint8_t **iv,
+  uint32_t *iv_len,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **cipher,
+  uint32_t *cipher_len,
+  uint8_t **tag,
+  uint8_t **dst,
+  EverCrypt_Error_error_code *res
+);
+
+extern EverCrypt_Error_error_code
+EverCrypt_AEAD_header_masks(
+  EverCrypt_AEAD_state_s *s,
+  uint32_t len,
+  uint8_t **sample,
+  uint8_t *mask
+);
+
 extern void EverCrypt_AEAD_free(EverCrypt_AEAD_state_s *a);
 
 extern bool EverCrypt_AutoConfig2_has_shaext();
@@ -24,6 +24,8 @@
 
 #include "EverCrypt_AEAD.h"
 
+#include "Lib_Memzero0.h"
+
 typedef struct EverCrypt_AEAD_state_s_s
 {
   Spec_Cipher_Expansion_impl impl;
@@ -66,6 +68,22 @@ Spec_Agile_AEAD_alg EverCrypt_AEAD_alg_of_state(EverCrypt_AEAD_state_s *s)
       {
         return Spec_Agile_AEAD_AES256_GCM;
       }
+    case Spec_Cipher_Expansion_Hacl_AES128:
+      {
+        return Spec_Agile_AEAD_AES128_GCM;
+      }
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        return Spec_Agile_AEAD_AES256_GCM;
+      }
+    case Spec_Cipher_Expansion_VAES_AES128:
+      {
+        return Spec_Agile_AEAD_AES128_GCM;
+      }
+    case Spec_Cipher_Expansion_VAES_AES256:
+      {
+        return Spec_Agile_AEAD_AES256_GCM;
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -94,10 +112,23 @@ create_in_aes128_gcm(EverCrypt_AEAD_state_s **dst, uint8_t *k)
   bool has_avx = EverCrypt_AutoConfig2_has_avx();
   bool has_sse = EverCrypt_AutoConfig2_has_sse();
   bool has_movbe = EverCrypt_AutoConfig2_has_movbe();
+  bool has_vaes = EverCrypt_AutoConfig2_has_vaes();
+  #if HACL_CAN_COMPILE_VAES
+  if (has_vaes && has_aesni && has_pclmulqdq)
+  {
+    uint8_t *ek = KRML_HOST_CALLOC(Hacl_AES_GCM_VAES_aes128_ctx_len, sizeof (uint8_t));
+    Hacl_AES_GCM_VAES_aes128_init(ek, k);
+    KRML_CHECK_SIZE(sizeof (EverCrypt_AEAD_state_s), (uint32_t)1U);
+    EverCrypt_AEAD_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_state_s));
+    p[0U] = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_VAES_AES128, .ek = ek });
+    *dst = p;
+    return EverCrypt_Error_Success;
+  }
+  #endif
   #if HACL_CAN_COMPILE_VALE
   if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
   {
-    uint8_t *ek = KRML_HOST_CALLOC((uint32_t)480U, sizeof (uint8_t));
+    uint8_t *ek = KRML_HOST_CALLOC((uint32_t)304U, sizeof (uint8_t));
     uint8_t *keys_b = ek;
     uint8_t *hkeys_b = ek + (uint32_t)176U;
     uint64_t scrut = aes128_key_expansion(k, keys_b);
@@ -109,7 +140,20 @@ create_in_aes128_gcm(EverCrypt_AEAD_state_s **dst, uint8_t *k)
     return EverCrypt_Error_Success;
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  /* Portable bitsliced fallback, only when the user opted into unverified code */
+  if (!EverCrypt_AutoConfig2_wants_unverified())
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len);
+  uint64_t *ctx = KRML_HOST_CALLOC(EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len, sizeof (uint64_t));
+  EverCrypt_Unverified_AES_GCM_CT64_aes128_init(ctx, k);
+  KRML_CHECK_SIZE(sizeof (EverCrypt_AEAD_state_s), (uint32_t)1U);
+  EverCrypt_AEAD_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_state_s));
+  p[0U]
+  = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_Hacl_AES128, .ek = (uint8_t *)ctx });
+  *dst = p;
+  return EverCrypt_Error_Success;
 }
 
 static EverCrypt_Error_error_code
@@ -120,10 +164,23 @@ create_in_aes256_gcm(EverCrypt_AEAD_state_s **dst, uint8_t *k)
   bool has_avx = EverCrypt_AutoConfig2_has_avx();
   bool has_sse = EverCrypt_AutoConfig2_has_sse();
   bool has_movbe = EverCrypt_AutoConfig2_has_movbe();
+  bool has_vaes = EverCrypt_AutoConfig2_has_vaes();
+  #if HACL_CAN_COMPILE_VAES
+  if (has_vaes && has_aesni && has_pclmulqdq)
+  {
+    uint8_t *ek = KRML_HOST_CALLOC(Hacl_AES_GCM_VAES_aes256_ctx_len, sizeof (uint8_t));
+    Hacl_AES_GCM_VAES_aes256_init(ek, k);
+    KRML_CHECK_SIZE(sizeof (EverCrypt_AEAD_state_s), (uint32_t)1U);
+    EverCrypt_AEAD_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_state_s));
+    p[0U] = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_VAES_AES256, .ek = ek });
+    *dst = p;
+    return EverCrypt_Error_Success;
+  }
+  #endif
   #if HACL_CAN_COMPILE_VALE
   if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
   {
-    uint8_t *ek = KRML_HOST_CALLOC((uint32_t)544U, sizeof (uint8_t));
+    uint8_t *ek = KRML_HOST_CALLOC((uint32_t)368U, sizeof (uint8_t));
     uint8_t *keys_b = ek;
     uint8_t *hkeys_b = ek + (uint32_t)240U;
     uint64_t scrut = aes256_key_expansion(k, keys_b);
@@ -135,7 +192,20 @@ create_in_aes256_gcm(EverCrypt_AEAD_state_s **dst, uint8_t *k)
     return EverCrypt_Error_Success;
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  /* Portable bitsliced fallback, only when the user opted into unverified code */
+  if (!EverCrypt_AutoConfig2_wants_unverified())
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len);
+  uint64_t *ctx = KRML_HOST_CALLOC(EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len, sizeof (uint64_t));
+  EverCrypt_Unverified_AES_GCM_CT64_aes256_init(ctx, k);
+  KRML_CHECK_SIZE(sizeof (EverCrypt_AEAD_state_s), (uint32_t)1U);
+  EverCrypt_AEAD_state_s *p = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_state_s));
+  p[0U]
+  = ((EverCrypt_AEAD_state_s){ .impl = Spec_Cipher_Expansion_Hacl_AES256, .ek = (uint8_t *)ctx });
+  *dst = p;
+  return EverCrypt_Error_Success;
 }
 
 EverCrypt_Error_error_code
@@ -186,7 +256,7 @@ encrypt_aes128_gcm(
   }
   EverCrypt_AEAD_state_s scrut = *s;
   uint8_t *ek = scrut.ek;
-  uint8_t *scratch_b = ek + (uint32_t)304U;
+  uint8_t scratch_b[176U] = { 0U };
   uint8_t *ek1 = ek;
   uint8_t *keys_b = ek1;
   uint8_t *hkeys_b = ek1 + (uint32_t)176U;
@@ -310,7 +380,7 @@ encrypt_aes256_gcm(
   }
   EverCrypt_AEAD_state_s scrut = *s;
   uint8_t *ek = scrut.ek;
-  uint8_t *scratch_b = ek + (uint32_t)368U;
+  uint8_t scratch_b[176U] = { 0U };
   uint8_t *ek1 = ek;
   uint8_t *keys_b = ek1;
   uint8_t *hkeys_b = ek1 + (uint32_t)240U;
@@ -410,6 +480,59 @@ encrypt_aes256_gcm(
   #endif
 }
 
+static EverCrypt_Error_error_code
+encrypt_vaes_aes_gcm(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  #if HACL_CAN_COMPILE_VAES
+  if (iv_len == (uint32_t)0U)
+  {
+    return EverCrypt_Error_InvalidIVLength;
+  }
+  EverCrypt_AEAD_state_s scrut = *s;
+  if (scrut.impl == Spec_Cipher_Expansion_VAES_AES128)
+  {
+    Hacl_AES_GCM_VAES_aes128_encrypt(scrut.ek,
+      iv_len,
+      iv,
+      ad_len,
+      ad,
+      plain_len,
+      plain,
+      cipher,
+      tag);
+  }
+  else
+  {
+    Hacl_AES_GCM_VAES_aes256_encrypt(scrut.ek,
+      iv_len,
+      iv,
+      ad_len,
+      ad,
+      plain_len,
+      plain,
+      cipher,
+      tag);
+  }
+  return EverCrypt_Error_Success;
+  #else
+  KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+    __FILE__,
+    __LINE__,
+    "statically unreachable");
+  KRML_HOST_EXIT(255U);
+  #endif
+}
+
 EverCrypt_Error_error_code
 EverCrypt_AEAD_encrypt(
   EverCrypt_AEAD_state_s *s,
@@ -449,6 +572,48 @@ EverCrypt_AEAD_encrypt(
         EverCrypt_Chacha20Poly1305_aead_encrypt(ek, iv, ad_len, ad, plain_len, plain, cipher, tag);
         return EverCrypt_Error_Success;
       }
+    case Spec_Cipher_Expansion_Hacl_AES128:
+      {
+        if (iv_len == (uint32_t)0U)
+        {
+          return EverCrypt_Error_InvalidIVLength;
+        }
+        EverCrypt_Unverified_AES_GCM_CT64_aes128_encrypt((uint64_t *)ek,
+          iv_len,
+          iv,
+          ad_len,
+          ad,
+          plain_len,
+          plain,
+          cipher,
+          tag);
+        return EverCrypt_Error_Success;
+      }
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        if (iv_len == (uint32_t)0U)
+        {
+          return EverCrypt_Error_InvalidIVLength;
+        }
+        EverCrypt_Unverified_AES_GCM_CT64_aes256_encrypt((uint64_t *)ek,
+          iv_len,
+          iv,
+          ad_len,
+          ad,
+          plain_len,
+          plain,
+          cipher,
+          tag);
+        return EverCrypt_Error_Success;
+      }
+    case Spec_Cipher_Expansion_VAES_AES128:
+      {
+        return encrypt_vaes_aes_gcm(s, iv, iv_len, ad, ad_len, plain, plain_len, cipher, tag);
+      }
+    case Spec_Cipher_Expansion_VAES_AES256:
+      {
+        return encrypt_vaes_aes_gcm(s, iv, iv_len, ad, ad_len, plain, plain_len, cipher, tag);
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -478,7 +643,7 @@ EverCrypt_AEAD_encrypt_expand_aes128_gcm(
   #if HACL_CAN_COMPILE_VALE
   if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
   {
-    uint8_t ek[480U] = { 0U };
+    uint8_t ek[304U] = { 0U };
     uint8_t *keys_b0 = ek;
     uint8_t *hkeys_b0 = ek + (uint32_t)176U;
     uint64_t scrut0 = aes128_key_expansion(k, keys_b0);
@@ -498,7 +663,7 @@ EverCrypt_AEAD_encrypt_expand_aes128_gcm(
     {
       EverCrypt_AEAD_state_s scrut = *s;
       uint8_t *ek0 = scrut.ek;
-      uint8_t *scratch_b = ek0 + (uint32_t)304U;
+      uint8_t scratch_b[176U] = { 0U };
       uint8_t *ek1 = ek0;
       uint8_t *keys_b = ek1;
       uint8_t *hkeys_b = ek1 + (uint32_t)176U;
@@ -593,7 +758,20 @@ EverCrypt_AEAD_encrypt_expand_aes128_gcm(
     return EverCrypt_Error_Success;
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  if (!EverCrypt_AutoConfig2_wants_unverified())
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  if (iv_len == (uint32_t)0U)
+  {
+    return EverCrypt_Error_InvalidIVLength;
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len);
+  uint64_t ctx[EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len];
+  memset(ctx, 0U, EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len * sizeof (uint64_t));
+  EverCrypt_Unverified_AES_GCM_CT64_aes128_init(ctx, k);
+  EverCrypt_Unverified_AES_GCM_CT64_aes128_encrypt(ctx, iv_len, iv, ad_len, ad, plain_len, plain, cipher, tag);
+  return EverCrypt_Error_Success;
 }
 
 EverCrypt_Error_error_code
@@ -617,7 +795,7 @@ EverCrypt_AEAD_encrypt_expand_aes256_gcm(
   #if HACL_CAN_COMPILE_VALE
   if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
   {
-    uint8_t ek[544U] = { 0U };
+    uint8_t ek[368U] = { 0U };
     uint8_t *keys_b0 = ek;
     uint8_t *hkeys_b0 = ek + (uint32_t)240U;
     uint64_t scrut0 = aes256_key_expansion(k, keys_b0);
@@ -637,7 +815,7 @@ EverCrypt_AEAD_encrypt_expand_aes256_gcm(
     {
       EverCrypt_AEAD_state_s scrut = *s;
       uint8_t *ek0 = scrut.ek;
-      uint8_t *scratch_b = ek0 + (uint32_t)368U;
+      uint8_t scratch_b[176U] = { 0U };
       uint8_t *ek1 = ek0;
       uint8_t *keys_b = ek1;
       uint8_t *hkeys_b = ek1 + (uint32_t)240U;
@@ -732,7 +910,20 @@ EverCrypt_AEAD_encrypt_expand_aes256_gcm(
     return EverCrypt_Error_Success;
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  if (!EverCrypt_AutoConfig2_wants_unverified())
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  if (iv_len == (uint32_t)0U)
+  {
+    return EverCrypt_Error_InvalidIVLength;
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len);
+  uint64_t ctx[EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len];
+  memset(ctx, 0U, EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len * sizeof (uint64_t));
+  EverCrypt_Unverified_AES_GCM_CT64_aes256_init(ctx, k);
+  EverCrypt_Unverified_AES_GCM_CT64_aes256_encrypt(ctx, iv_len, iv, ad_len, ad, plain_len, plain, cipher, tag);
+  return EverCrypt_Error_Success;
 }
 
 EverCrypt_Error_error_code
@@ -845,7 +1036,7 @@ decrypt_aes128_gcm(
   }
   EverCrypt_AEAD_state_s scrut = *s;
   uint8_t *ek = scrut.ek;
-  uint8_t *scratch_b = ek + (uint32_t)304U;
+  uint8_t scratch_b[176U] = { 0U };
   uint8_t *ek1 = ek;
   uint8_t *keys_b = ek1;
   uint8_t *hkeys_b = ek1 + (uint32_t)176U;
@@ -979,7 +1170,7 @@ decrypt_aes256_gcm(
   }
   EverCrypt_AEAD_state_s scrut = *s;
   uint8_t *ek = scrut.ek;
-  uint8_t *scratch_b = ek + (uint32_t)368U;
+  uint8_t scratch_b[176U] = { 0U };
   uint8_t *ek1 = ek;
   uint8_t *keys_b = ek1;
   uint8_t *hkeys_b = ek1 + (uint32_t)240U;
@@ -1121,6 +1312,101 @@ decrypt_chacha20_poly1305(
   return EverCrypt_Error_AuthenticationFailure;
 }
 
+static EverCrypt_Error_error_code
+decrypt_hacl_aes_gcm(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst
+)
+{
+  if (iv_len == (uint32_t)0U)
+  {
+    return EverCrypt_Error_InvalidIVLength;
+  }
+  EverCrypt_AEAD_state_s scrut = *s;
+  uint64_t *ctx = (uint64_t *)scrut.ek;
+  uint32_t r;
+  if (scrut.impl == Spec_Cipher_Expansion_Hacl_AES128)
+  {
+    r = EverCrypt_Unverified_AES_GCM_CT64_aes128_decrypt(ctx, iv_len, iv, ad_len, ad, cipher_len, dst, cipher, tag);
+  }
+  else
+  {
+    r = EverCrypt_Unverified_AES_GCM_CT64_aes256_decrypt(ctx, iv_len, iv, ad_len, ad, cipher_len, dst, cipher, tag);
+  }
+  if (r == (uint32_t)0U)
+  {
+    return EverCrypt_Error_Success;
+  }
+  return EverCrypt_Error_AuthenticationFailure;
+}
+
+static EverCrypt_Error_error_code
+decrypt_vaes_aes_gcm(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  uint8_t *ad,
+  uint32_t ad_len,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *tag,
+  uint8_t *dst
+)
+{
+  #if HACL_CAN_COMPILE_VAES
+  if (iv_len == (uint32_t)0U)
+  {
+    return EverCrypt_Error_InvalidIVLength;
+  }
+  EverCrypt_AEAD_state_s scrut = *s;
+  uint32_t r;
+  if (scrut.impl == Spec_Cipher_Expansion_VAES_AES128)
+  {
+    r =
+      Hacl_AES_GCM_VAES_aes128_decrypt(scrut.ek,
+        iv_len,
+        iv,
+        ad_len,
+        ad,
+        cipher_len,
+        dst,
+        cipher,
+        tag);
+  }
+  else
+  {
+    r =
+      Hacl_AES_GCM_VAES_aes256_decrypt(scrut.ek,
+        iv_len,
+        iv,
+        ad_len,
+        ad,
+        cipher_len,
+        dst,
+        cipher,
+        tag);
+  }
+  if (r == (uint32_t)0U)
+  {
+    return EverCrypt_Error_Success;
+  }
+  return EverCrypt_Error_AuthenticationFailure;
+  #else
+  KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+    __FILE__,
+    __LINE__,
+    "statically unreachable");
+  KRML_HOST_EXIT(255U);
+  #endif
+}
+
 EverCrypt_Error_error_code
 EverCrypt_AEAD_decrypt(
   EverCrypt_AEAD_state_s *s,
@@ -1154,6 +1440,22 @@ EverCrypt_AEAD_decrypt(
       {
         return decrypt_chacha20_poly1305(s, iv, iv_len, ad, ad_len, cipher, cipher_len, tag, dst);
       }
+    case Spec_Cipher_Expansion_Hacl_AES128:
+      {
+        return decrypt_hacl_aes_gcm(s, iv, iv_len, ad, ad_len, cipher, cipher_len, tag, dst);
+      }
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        return decrypt_hacl_aes_gcm(s, iv, iv_len, ad, ad_len, cipher, cipher_len, tag, dst);
+      }
+    case Spec_Cipher_Expansion_VAES_AES128:
+      {
+        return decrypt_vaes_aes_gcm(s, iv, iv_len, ad, ad_len, cipher, cipher_len, tag, dst);
+      }
+    case Spec_Cipher_Expansion_VAES_AES256:
+      {
+        return decrypt_vaes_aes_gcm(s, iv, iv_len, ad, ad_len, cipher, cipher_len, tag, dst);
+      }
     default:
       {
         KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
@@ -1183,7 +1485,7 @@ EverCrypt_AEAD_decrypt_expand_aes128_gcm(
   #if HACL_CAN_COMPILE_VALE
   if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
   {
-    uint8_t ek[480U] = { 0U };
+    uint8_t ek[304U] = { 0U };
     uint8_t *keys_b0 = ek;
     uint8_t *hkeys_b0 = ek + (uint32_t)176U;
     uint64_t scrut = aes128_key_expansion(k, keys_b0);
@@ -1202,7 +1504,7 @@ EverCrypt_AEAD_decrypt_expand_aes128_gcm(
     {
       EverCrypt_AEAD_state_s scrut1 = *s;
       uint8_t *ek0 = scrut1.ek;
-      uint8_t *scratch_b = ek0 + (uint32_t)304U;
+      uint8_t scratch_b[176U] = { 0U };
       uint8_t *ek1 = ek0;
       uint8_t *keys_b = ek1;
       uint8_t *hkeys_b = ek1 + (uint32_t)176U;
@@ -1309,7 +1611,25 @@ EverCrypt_AEAD_decrypt_expand_aes128_gcm(
     }
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  if (!EverCrypt_AutoConfig2_wants_unverified())
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  if (iv_len == (uint32_t)0U)
+  {
+    return EverCrypt_Error_InvalidIVLength;
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len);
+  uint64_t ctx[EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len];
+  memset(ctx, 0U, EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len * sizeof (uint64_t));
+  EverCrypt_Unverified_AES_GCM_CT64_aes128_init(ctx, k);
+  uint32_t
+  r = EverCrypt_Unverified_AES_GCM_CT64_aes128_decrypt(ctx, iv_len, iv, ad_len, ad, cipher_len, dst, cipher, tag);
+  if (r == (uint32_t)0U)
+  {
+    return EverCrypt_Error_Success;
+  }
+  return EverCrypt_Error_AuthenticationFailure;
 }
 
 EverCrypt_Error_error_code
@@ -1333,7 +1653,7 @@ EverCrypt_AEAD_decrypt_expand_aes256_gcm(
   #if HACL_CAN_COMPILE_VALE
   if (has_aesni && has_pclmulqdq && has_avx && has_sse && has_movbe)
   {
-    uint8_t ek[544U] = { 0U };
+    uint8_t ek[368U] = { 0U };
     uint8_t *keys_b0 = ek;
     uint8_t *hkeys_b0 = ek + (uint32_t)240U;
     uint64_t scrut = aes256_key_expansion(k, keys_b0);
@@ -1352,7 +1672,7 @@ EverCrypt_AEAD_decrypt_expand_aes256_gcm(
     {
       EverCrypt_AEAD_state_s scrut1 = *s;
       uint8_t *ek0 = scrut1.ek;
-      uint8_t *scratch_b = ek0 + (uint32_t)368U;
+      uint8_t scratch_b[176U] = { 0U };
       uint8_t *ek1 = ek0;
       uint8_t *keys_b = ek1;
       uint8_t *hkeys_b = ek1 + (uint32_t)240U;
@@ -1459,7 +1779,25 @@ EverCrypt_AEAD_decrypt_expand_aes256_gcm(
     }
   }
   #endif
-  return EverCrypt_Error_UnsupportedAlgorithm;
+  if (!EverCrypt_AutoConfig2_wants_unverified())
+  {
+    return EverCrypt_Error_UnsupportedAlgorithm;
+  }
+  if (iv_len == (uint32_t)0U)
+  {
+    return EverCrypt_Error_InvalidIVLength;
+  }
+  KRML_CHECK_SIZE(sizeof (uint64_t), EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len);
+  uint64_t ctx[EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len];
+  memset(ctx, 0U, EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len * sizeof (uint64_t));
+  EverCrypt_Unverified_AES_GCM_CT64_aes256_init(ctx, k);
+  uint32_t
+  r = EverCrypt_Unverified_AES_GCM_CT64_aes256_decrypt(ctx, iv_len, iv, ad_len, ad, cipher_len, dst, cipher, tag);
+  if (r == (uint32_t)0U)
+  {
+    return EverCrypt_Error_Success;
+  }
+  return EverCrypt_Error_AuthenticationFailure;
 }
 
 EverCrypt_Error_error_code
@@ -1547,6 +1885,1168 @@ EverCrypt_AEAD_decrypt_expand(
   }
 }
 
+/* Records that share a multi-record implementation, see batch_kind */
+#define BATCH_MAX (uint32_t)32U
+
+/*
+  0: handled one at a time; 1: ChaCha20-Poly1305; 2 (resp. 3): VAES AES-GCM
+  with a 128-bit (resp. 256-bit) key. Multi-record kernels require 12-byte IVs.
+*/
+static uint32_t batch_kind(EverCrypt_AEAD_state_s *s, uint32_t iv_len)
+{
+  if (s == NULL || iv_len != (uint32_t)12U)
+  {
+    return (uint32_t)0U;
+  }
+  EverCrypt_AEAD_state_s scrut = *s;
+  switch (scrut.impl)
+  {
+    case Spec_Cipher_Expansion_Hacl_CHACHA20:
+      {
+        return (uint32_t)1U;
+      }
+    case Spec_Cipher_Expansion_VAES_AES128:
+      {
+        return (uint32_t)2U;
+      }
+    case Spec_Cipher_Expansion_VAES_AES256:
+      {
+        return (uint32_t)3U;
+      }
+    default:
+      {
+        return (uint32_t)0U;
+      }
+  }
+}
+
+/* Length of the run of records starting at i that share a batch kind */
+static uint32_t
+batch_run(uint32_t len, EverCrypt_AEAD_state_s **s, uint32_t *iv_len, uint32_t i, uint32_t kind)
+{
+  uint32_t n = (uint32_t)1U;
+  while (i + n < len && n < BATCH_MAX && batch_kind(s[i + n], iv_len[i + n]) == kind)
+  {
+    n++;
+  }
+  return n;
+}
+
+static EverCrypt_Error_error_code
+batch_result(uint32_t len, EverCrypt_Error_error_code *res)
+{
+  for (uint32_t i = (uint32_t)0U; i < len; i++)
+  {
+    if (res[i] != EverCrypt_Error_Success)
+    {
+      return res[i];
+    }
+  }
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_encrypt_batch(
+  uint32_t len,
+  EverCrypt_AEAD_state_s **s,
+  uint8_t **iv,
+  uint32_t *iv_len,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **plain,
+  uint32_t *plain_len,
+  uint8_t **cipher,
+  uint8_t **tag,
+  EverCrypt_Error_error_code *res
+)
+{
+  uint8_t *ek[BATCH_MAX];
+  uint32_t i = (uint32_t)0U;
+  while (i < len)
+  {
+    uint32_t kind = batch_kind(s[i], iv_len[i]);
+    if (kind == (uint32_t)0U)
+    {
+      res[i] =
+        EverCrypt_AEAD_encrypt(s[i],
+          iv[i],
+          iv_len[i],
+          ad[i],
+          ad_len[i],
+          plain[i],
+          plain_len[i],
+          cipher[i],
+          tag[i]);
+      i++;
+      continue;
+    }
+    uint32_t n = batch_run(len, s, iv_len, i, kind);
+    for (uint32_t j = (uint32_t)0U; j < n; j++)
+    {
+      EverCrypt_AEAD_state_s scrut = *s[i + j];
+      ek[j] = scrut.ek;
+      res[i + j] = EverCrypt_Error_Success;
+    }
+    if (kind == (uint32_t)1U)
+    {
+      EverCrypt_Chacha20Poly1305_aead_encrypt_batch(n,
+        ek,
+        iv + i,
+        ad_len + i,
+        ad + i,
+        plain_len + i,
+        plain + i,
+        cipher + i,
+        tag + i);
+    }
+    else
+    {
+      #if HACL_CAN_COMPILE_VAES
+      if (kind == (uint32_t)2U)
+      {
+        Hacl_AES_GCM_VAES_aes128_encrypt_batch(n,
+          ek,
+          iv + i,
+          ad_len + i,
+          ad + i,
+          plain_len + i,
+          plain + i,
+          cipher + i,
+          tag + i);
+      }
+      else
+      {
+        Hacl_AES_GCM_VAES_aes256_encrypt_batch(n,
+          ek,
+          iv + i,
+          ad_len + i,
+          ad + i,
+          plain_len + i,
+          plain + i,
+          cipher + i,
+          tag + i);
+      }
+      #else
+      KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+        __FILE__,
+        __LINE__,
+        "statically unreachable");
+      KRML_HOST_EXIT(255U);
+      #endif
+    }
+    i = i + n;
+  }
+  return batch_result(len, res);
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_decrypt_batch(
+  uint32_t len,
+  EverCrypt_AEAD_state_s **s,
+  uint8_t **iv,
+  uint32_t *iv_len,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **cipher,
+  uint32_t *cipher_len,
+  uint8_t **tag,
+  uint8_t **dst,
+  EverCrypt_Error_error_code *res
+)
+{
+  uint8_t *ek[BATCH_MAX];
+  uint32_t r[BATCH_MAX];
+  uint32_t i = (uint32_t)0U;
+  while (i < len)
+  {
+    uint32_t kind = batch_kind(s[i], iv_len[i]);
+    if (kind == (uint32_t)0U)
+    {
+      res[i] =
+        EverCrypt_AEAD_decrypt(s[i],
+          iv[i],
+          iv_len[i],
+          ad[i],
+          ad_len[i],
+          cipher[i],
+          cipher_len[i],
+          tag[i],
+          dst[i]);
+      i++;
+      continue;
+    }
+    uint32_t n = batch_run(len, s, iv_len, i, kind);
+    for (uint32_t j = (uint32_t)0U; j < n; j++)
+    {
+      EverCrypt_AEAD_state_s scrut = *s[i + j];
+      ek[j] = scrut.ek;
+    }
+    if (kind == (uint32_t)1U)
+    {
+      EverCrypt_Chacha20Poly1305_aead_decrypt_batch(n,
+        ek,
+        iv + i,
+        ad_len + i,
+        ad + i,
+        cipher_len + i,
+        dst + i,
+        cipher + i,
+        tag + i,
+        r);
+    }
+    else
+    {
+      #if HACL_CAN_COMPILE_VAES
+      if (kind == (uint32_t)2U)
+      {
+        Hacl_AES_GCM_VAES_aes128_decrypt_batch(n,
+          ek,
+          iv + i,
+          ad_len + i,
+          ad + i,
+          cipher_len + i,
+          dst + i,
+          cipher + i,
+          tag + i,
+          r);
+      }
+      else
+      {
+        Hacl_AES_GCM_VAES_aes256_decrypt_batch(n,
+          ek,
+          iv + i,
+          ad_len + i,
+          ad + i,
+          cipher_len + i,
+          dst + i,
+          cipher + i,
+          tag + i,
+          r);
+      }
+      #else
+      KRML_HOST_EPRINTF("KreMLin abort at %s:%d\n%s\n",
+        __FILE__,
+        __LINE__,
+        "statically unreachable");
+      KRML_HOST_EXIT(255U);
+      #endif
+    }
+    for (uint32_t j = (uint32_t)0U; j < n; j++)
+    {
+      if (r[j] == (uint32_t)0U)
+      {
+        res[i + j] = EverCrypt_Error_Success;
+      }
+      else
+      {
+        res[i + j] = EverCrypt_Error_AuthenticationFailure;
+      }
+    }
+    i = i + n;
+  }
+  return batch_result(len, res);
+}
+
+/*
+  Header-protection masks: one block function call per sample, AES for the
+  AES-GCM states, ChaCha20 with the sample as counter and nonce otherwise.
+*/
+
+static void chacha20_masks(uint8_t *key, uint32_t len, uint8_t **sample, uint8_t *mask)
+{
+  uint32_t i = (uint32_t)0U;
+  #if HACL_CAN_COMPILE_VEC256
+  if (EverCrypt_AutoConfig2_has_vec256())
+  {
+    uint8_t *keys[8U] = { key, key, key, key, key, key, key, key };
+    for (; i + (uint32_t)8U <= len; i = i + (uint32_t)8U)
+    {
+      uint8_t block[512U] = { 0U };
+      uint8_t *n[8U];
+      uint32_t ctr[8U];
+      for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+      {
+        ctr[j] = load32_le(sample[i + j]);
+        n[j] = sample[i + j] + (uint32_t)4U;
+      }
+      Hacl_Chacha20_Vec256_chacha20_blocks_256(block, keys, n, ctr);
+      for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+      {
+        memcpy(mask + (i + j) * (uint32_t)16U,
+          block + j * (uint32_t)64U,
+          (uint32_t)16U * sizeof (uint8_t));
+      }
+    }
+  }
+  #endif
+  for (; i < len; i++)
+  {
+    uint8_t zero[16U] = { 0U };
+    Hacl_Chacha20_chacha20_encrypt((uint32_t)16U,
+      mask + i * (uint32_t)16U,
+      zero,
+      key,
+      sample[i] + (uint32_t)4U,
+      load32_le(sample[i]));
+  }
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_header_masks(
+  EverCrypt_AEAD_state_s *s,
+  uint32_t len,
+  uint8_t **sample,
+  uint8_t *mask
+)
+{
+  if (s == NULL)
+  {
+    return EverCrypt_Error_InvalidKey;
+  }
+  EverCrypt_AEAD_state_s scrut = *s;
+  switch (scrut.impl)
+  {
+    case Spec_Cipher_Expansion_Hacl_CHACHA20:
+      {
+        chacha20_masks(scrut.ek, len, sample, mask);
+        break;
+      }
+    #if HACL_CAN_COMPILE_VAES
+    case Spec_Cipher_Expansion_VAES_AES128:
+      {
+        Hacl_AES_GCM_VAES_aes128_ecb(scrut.ek, len, sample, mask);
+        break;
+      }
+    case Spec_Cipher_Expansion_VAES_AES256:
+      {
+        Hacl_AES_GCM_VAES_aes256_ecb(scrut.ek, len, sample, mask);
+        break;
+      }
+    #endif
+    #if HACL_CAN_COMPILE_VALE
+    case Spec_Cipher_Expansion_Vale_AES128:
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        /* The block function of Vale is its CTR mode, on one block of zeros */
+        uint8_t zero[16U] = { 0U };
+        for (uint32_t i = (uint32_t)0U; i < len; i++)
+        {
+          uint8_t ctr[16U] = { 0U };
+          uint8_t inout_b[16U] = { 0U };
+          for (uint32_t j = (uint32_t)0U; j < (uint32_t)16U; j++)
+          {
+            ctr[j] = sample[i][(uint32_t)15U - j];
+          }
+          if (scrut.impl == Spec_Cipher_Expansion_Vale_AES128)
+          {
+            uint64_t
+            scrut0 =
+              gctr128_bytes(zero,
+                (uint64_t)16U,
+                mask + i * (uint32_t)16U,
+                inout_b,
+                scrut.ek,
+                ctr,
+                (uint64_t)1U);
+          }
+          else
+          {
+            uint64_t
+            scrut0 =
+              gctr256_bytes(zero,
+                (uint64_t)16U,
+                mask + i * (uint32_t)16U,
+                inout_b,
+                scrut.ek,
+                ctr,
+                (uint64_t)1U);
+          }
+        }
+        break;
+      }
+    #endif
+    case Spec_Cipher_Expansion_Hacl_AES128:
+      {
+        EverCrypt_Unverified_AES_GCM_CT64_aes128_ecb((uint64_t *)scrut.ek, len, sample, mask);
+        break;
+      }
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        EverCrypt_Unverified_AES_GCM_CT64_aes256_ecb((uint64_t *)scrut.ek, len, sample, mask);
+        break;
+      }
+    default:
+      {
+        return EverCrypt_Error_UnsupportedAlgorithm;
+      }
+  }
+  return EverCrypt_Error_Success;
+}
+
+/*
+  Piecewise AEAD. AES-GCM is rebuilt from two building blocks of each
+  implementation, CTR over full blocks and GHASH, with the same bookkeeping as
+  EverCrypt_Chacha20Poly1305_state_s: the counter block and the unused end of
+  the last keystream block on one side, the GHASH accumulator and up to 15
+  bytes not yet absorbed on the other.
+*/
+
+typedef struct gcm_state_s
+{
+  Spec_Cipher_Expansion_impl impl;
+  uint8_t *ek;
+  uint8_t ctr[16U];
+  uint8_t mask[16U];
+  uint8_t acc[16U];
+  uint8_t hkey[64U];
+  uint8_t ks[16U];
+  uint32_t ks_len;
+  uint8_t buf[16U];
+  uint32_t buf_len;
+  bool aad_done;
+  uint64_t aad_len;
+  uint64_t len;
+}
+gcm_state;
+
+static inline void ctr_add(uint8_t *ctr, uint32_t n)
+{
+  store32_be(ctr + (uint32_t)12U, load32_be(ctr + (uint32_t)12U) + n);
+}
+
+#if HACL_CAN_COMPILE_VALE
+/*
+  The Vale CTR code wants the counter block byte-reversed and at most 2^20
+  bytes per call
+*/
+static void
+vale_ctr(
+  Spec_Cipher_Expansion_impl impl,
+  uint8_t *ek,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+)
+{
+  uint8_t c[16U] = { 0U };
+  memcpy(c, ctr, (uint32_t)16U * sizeof (uint8_t));
+  for (uint32_t pos = (uint32_t)0U; pos < len; pos = pos + (uint32_t)65536U)
+  {
+    uint32_t n = len - pos;
+    if (n > (uint32_t)65536U)
+    {
+      n = (uint32_t)65536U;
+    }
+    uint8_t c_le[16U] = { 0U };
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+    {
+      c_le[i] = c[(uint32_t)15U - i];
+    }
+    uint32_t nb = n / (uint32_t)16U;
+    uint8_t inout_b[16U] = { 0U };
+    memcpy(inout_b, in + pos + nb * (uint32_t)16U, n % (uint32_t)16U * sizeof (uint8_t));
+    if (impl == Spec_Cipher_Expansion_Vale_AES128)
+    {
+      uint64_t
+      scrut =
+        gctr128_bytes(in + pos,
+          (uint64_t)n,
+          out + pos,
+          inout_b,
+          ek,
+          c_le,
+          (uint64_t)nb);
+    }
+    else
+    {
+      uint64_t
+      scrut =
+        gctr256_bytes(in + pos,
+          (uint64_t)n,
+          out + pos,
+          inout_b,
+          ek,
+          c_le,
+          (uint64_t)nb);
+    }
+    memcpy(out + pos + nb * (uint32_t)16U, inout_b, n % (uint32_t)16U * sizeof (uint8_t));
+    ctr_add(c, nb);
+  }
+}
+#endif
+
+/* XORs len bytes of in with the keystream from st->ctr on, leaving st->ctr as is */
+static void gcm_ctr(gcm_state *st, uint32_t len, uint8_t *in, uint8_t *out)
+{
+  switch (st->impl)
+  {
+    #if HACL_CAN_COMPILE_VAES
+    case Spec_Cipher_Expansion_VAES_AES128:
+      {
+        Hacl_AES_GCM_VAES_aes128_ctr(st->ek, st->ctr, len, in, out);
+        break;
+      }
+    case Spec_Cipher_Expansion_VAES_AES256:
+      {
+        Hacl_AES_GCM_VAES_aes256_ctr(st->ek, st->ctr, len, in, out);
+        break;
+      }
+    #endif
+    #if HACL_CAN_COMPILE_VALE
+    case Spec_Cipher_Expansion_Vale_AES128:
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        vale_ctr(st->impl, st->ek, st->ctr, len, in, out);
+        break;
+      }
+    #endif
+    case Spec_Cipher_Expansion_Hacl_AES128:
+      {
+        EverCrypt_Unverified_AES_GCM_CT64_aes128_ctr((uint64_t *)st->ek, st->ctr, len, in, out);
+        break;
+      }
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        EverCrypt_Unverified_AES_GCM_CT64_aes256_ctr((uint64_t *)st->ek, st->ctr, len, in, out);
+        break;
+      }
+    default:
+      {
+        KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
+        KRML_HOST_EXIT(253U);
+      }
+  }
+}
+
+/* Absorbs len bytes of text into st->acc, the last block padded with zeros */
+static void gcm_ghash(gcm_state *st, uint32_t len, uint8_t *text)
+{
+  switch (st->impl)
+  {
+    #if HACL_CAN_COMPILE_VAES
+    case Spec_Cipher_Expansion_VAES_AES128:
+      {
+        Hacl_AES_GCM_VAES_aes128_ghash(st->ek, st->acc, len, text);
+        break;
+      }
+    case Spec_Cipher_Expansion_VAES_AES256:
+      {
+        Hacl_AES_GCM_VAES_aes256_ghash(st->ek, st->acc, len, text);
+        break;
+      }
+    #endif
+    #if HACL_CAN_COMPILE_VALE
+    case Spec_Cipher_Expansion_Vale_AES128:
+    case Spec_Cipher_Expansion_Vale_AES256:
+      {
+        Hacl_Gf128_NI_gcm_update_padded(st->acc, st->hkey, len, text);
+        break;
+      }
+    #endif
+    case Spec_Cipher_Expansion_Hacl_AES128:
+      {
+        EverCrypt_Unverified_AES_GCM_CT64_aes128_ghash((uint64_t *)st->ek, st->acc, len, text);
+        break;
+      }
+    case Spec_Cipher_Expansion_Hacl_AES256:
+      {
+        EverCrypt_Unverified_AES_GCM_CT64_aes256_ghash((uint64_t *)st->ek, st->acc, len, text);
+        break;
+      }
+    default:
+      {
+        KRML_HOST_EPRINTF("KreMLin incomplete match at %s:%d\n", __FILE__, __LINE__);
+        KRML_HOST_EXIT(253U);
+      }
+  }
+}
+
+static void
+gcm_init(gcm_state *st, EverCrypt_AEAD_state_s *s, uint8_t *iv, uint32_t iv_len)
+{
+  EverCrypt_AEAD_state_s scrut = *s;
+  uint8_t zero[16U] = { 0U };
+  st->impl = scrut.impl;
+  st->ek = scrut.ek;
+  memset(st->ctr, 0U, (uint32_t)16U * sizeof (uint8_t));
+  memset(st->acc, 0U, (uint32_t)16U * sizeof (uint8_t));
+  if (st->impl == Spec_Cipher_Expansion_Vale_AES128 || st->impl == Spec_Cipher_Expansion_Vale_AES256)
+  {
+    /* H = E(K, 0^128), from the counter block 0 */
+    uint8_t h[16U] = { 0U };
+    gcm_ctr(st, (uint32_t)16U, zero, h);
+    Hacl_Gf128_NI_gcm_init(st->hkey, h);
+  }
+  if (iv_len == (uint32_t)12U)
+  {
+    memcpy(st->ctr, iv, (uint32_t)12U * sizeof (uint8_t));
+    st->ctr[15U] = (uint8_t)1U;
+  }
+  else
+  {
+    uint8_t lens[16U] = { 0U };
+    store64_be(lens + (uint32_t)8U, (uint64_t)iv_len * (uint64_t)8U);
+    gcm_ghash(st, iv_len, iv);
+    gcm_ghash(st, (uint32_t)16U, lens);
+    memcpy(st->ctr, st->acc, (uint32_t)16U * sizeof (uint8_t));
+    memset(st->acc, 0U, (uint32_t)16U * sizeof (uint8_t));
+  }
+  gcm_ctr(st, (uint32_t)16U, zero, st->mask);
+  ctr_add(st->ctr, (uint32_t)1U);
+  st->ks_len = (uint32_t)0U;
+  st->buf_len = (uint32_t)0U;
+  st->aad_done = false;
+  st->aad_len = (uint64_t)0U;
+  st->len = (uint64_t)0U;
+}
+
+static void gcm_absorb(gcm_state *st, uint32_t len, uint8_t *text)
+{
+  if (st->buf_len > (uint32_t)0U)
+  {
+    uint32_t n = (uint32_t)16U - st->buf_len;
+    if (n > len)
+    {
+      n = len;
+    }
+    memcpy(st->buf + st->buf_len, text, n * sizeof (uint8_t));
+    st->buf_len = st->buf_len + n;
+    text = text + n;
+    len = len - n;
+    if (st->buf_len < (uint32_t)16U)
+    {
+      return;
+    }
+    gcm_ghash(st, (uint32_t)16U, st->buf);
+    st->buf_len = (uint32_t)0U;
+  }
+  uint32_t full = len / (uint32_t)16U * (uint32_t)16U;
+  if (full > (uint32_t)0U)
+  {
+    gcm_ghash(st, full, text);
+  }
+  memcpy(st->buf, text + full, (len - full) * sizeof (uint8_t));
+  st->buf_len = len - full;
+}
+
+/* Absorbs the pending partial block, zero-padded */
+static void gcm_pad(gcm_state *st)
+{
+  if (st->buf_len > (uint32_t)0U)
+  {
+    gcm_ghash(st, st->buf_len, st->buf);
+    st->buf_len = (uint32_t)0U;
+  }
+}
+
+static void gcm_update_aad(gcm_state *st, uint32_t len, uint8_t *aad)
+{
+  gcm_absorb(st, len, aad);
+  st->aad_len = st->aad_len + (uint64_t)len;
+}
+
+static void gcm_xor_keystream(gcm_state *st, uint32_t len, uint8_t *in, uint8_t *out)
+{
+  uint32_t i = (uint32_t)0U;
+  for (; i < len && st->ks_len > (uint32_t)0U; i++)
+  {
+    out[i] = in[i] ^ st->ks[(uint32_t)16U - st->ks_len];
+    st->ks_len = st->ks_len - (uint32_t)1U;
+  }
+  uint32_t full = (len - i) / (uint32_t)16U * (uint32_t)16U;
+  if (full > (uint32_t)0U)
+  {
+    gcm_ctr(st, full, in + i, out + i);
+    ctr_add(st->ctr, full / (uint32_t)16U);
+    i = i + full;
+  }
+  if (i < len)
+  {
+    uint32_t rem = len - i;
+    uint8_t zero[16U] = { 0U };
+    gcm_ctr(st, (uint32_t)16U, zero, st->ks);
+    ctr_add(st->ctr, (uint32_t)1U);
+    for (uint32_t j = (uint32_t)0U; j < rem; j++)
+    {
+      out[i + j] = in[i + j] ^ st->ks[j];
+    }
+    st->ks_len = (uint32_t)16U - rem;
+  }
+}
+
+static void gcm_update_cipher(gcm_state *st, uint32_t len, uint8_t *cipher)
+{
+  if (!st->aad_done)
+  {
+    gcm_pad(st);
+    st->aad_done = true;
+  }
+  gcm_absorb(st, len, cipher);
+  st->len = st->len + (uint64_t)len;
+}
+
+static void gcm_finish(gcm_state *st, uint8_t *tag)
+{
+  gcm_pad(st);
+  uint8_t lens[16U] = { 0U };
+  store64_be(lens, st->aad_len * (uint64_t)8U);
+  store64_be(lens + (uint32_t)8U, st->len * (uint64_t)8U);
+  gcm_ghash(st, (uint32_t)16U, lens);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    tag[i] = st->acc[i] ^ st->mask[i];
+  }
+}
+
+/* Either algorithm, behind the same five steps */
+typedef struct pieces_s
+{
+  bool chacha;
+  union {
+    gcm_state gcm;
+    EverCrypt_Chacha20Poly1305_state_s chacha20;
+  }
+  u;
+}
+pieces;
+
+static EverCrypt_Error_error_code
+pieces_init(pieces *p, EverCrypt_AEAD_state_s *s, uint8_t *iv, uint32_t iv_len)
+{
+  if (s == NULL)
+  {
+    return EverCrypt_Error_InvalidKey;
+  }
+  if (iv_len == (uint32_t)0U)
+  {
+    return EverCrypt_Error_InvalidIVLength;
+  }
+  EverCrypt_AEAD_state_s scrut = *s;
+  if (scrut.impl == Spec_Cipher_Expansion_Hacl_CHACHA20)
+  {
+    if (iv_len != (uint32_t)12U)
+    {
+      return EverCrypt_Error_InvalidIVLength;
+    }
+    p->chacha = true;
+    EverCrypt_Chacha20Poly1305_init(&p->u.chacha20, scrut.ek, iv);
+    return EverCrypt_Error_Success;
+  }
+  p->chacha = false;
+  gcm_init(&p->u.gcm, s, iv, iv_len);
+  return EverCrypt_Error_Success;
+}
+
+static void pieces_aad(pieces *p, uint32_t len, uint8_t *aad)
+{
+  if (p->chacha)
+  {
+    EverCrypt_Chacha20Poly1305_update_aad(&p->u.chacha20, len, aad);
+  }
+  else
+  {
+    gcm_update_aad(&p->u.gcm, len, aad);
+  }
+}
+
+static void pieces_xor(pieces *p, uint32_t len, uint8_t *in, uint8_t *out)
+{
+  if (p->chacha)
+  {
+    EverCrypt_Chacha20Poly1305_xor_keystream(&p->u.chacha20, len, in, out);
+  }
+  else
+  {
+    gcm_xor_keystream(&p->u.gcm, len, in, out);
+  }
+}
+
+static void pieces_cipher(pieces *p, uint32_t len, uint8_t *cipher)
+{
+  if (p->chacha)
+  {
+    EverCrypt_Chacha20Poly1305_update_cipher(&p->u.chacha20, len, cipher);
+  }
+  else
+  {
+    gcm_update_cipher(&p->u.gcm, len, cipher);
+  }
+}
+
+static void pieces_finish(pieces *p, uint8_t *tag)
+{
+  if (p->chacha)
+  {
+    EverCrypt_Chacha20Poly1305_finish(&p->u.chacha20, tag);
+  }
+  else
+  {
+    gcm_finish(&p->u.gcm, tag);
+  }
+}
+
+/* Largest message for one IV: 2^32 - 2 AES blocks, or 2^32 - 1 ChaCha20 blocks */
+static uint64_t pieces_max_len(bool chacha)
+{
+  if (chacha)
+  {
+    return ((uint64_t)0x100000000U - (uint64_t)1U) * (uint64_t)64U;
+  }
+  return ((uint64_t)0x100000000U - (uint64_t)2U) * (uint64_t)16U;
+}
+
+static bool iovec_too_long(EverCrypt_AEAD_state_s *s, uint64_t len)
+{
+  return
+    s != NULL
+    && len > pieces_max_len(s->impl == Spec_Cipher_Expansion_Hacl_CHACHA20);
+}
+
+static uint64_t iovec_len(EverCrypt_AEAD_iovec *v, uint32_t cnt)
+{
+  uint64_t len = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < cnt; i++)
+  {
+    len = len + (uint64_t)v[i].len;
+  }
+  return len;
+}
+
+/* Pieces contiguous in both lists are capped so that they stay in the L1 cache */
+#define IOVEC_CHUNK (uint32_t)4096U
+
+/*
+  Runs the keystream over in[] into out[], two lists of the same total length,
+  and feeds either side to the MAC when mac_in or mac_out is set
+*/
+static void
+iovec_xor(
+  pieces *p,
+  EverCrypt_AEAD_iovec *in,
+  uint32_t in_cnt,
+  EverCrypt_AEAD_iovec *out,
+  uint32_t out_cnt,
+  bool mac_in,
+  bool mac_out
+)
+{
+  uint32_t i = (uint32_t)0U;
+  uint32_t j = (uint32_t)0U;
+  uint32_t oi = (uint32_t)0U;
+  uint32_t oj = (uint32_t)0U;
+  while (i < in_cnt && j < out_cnt)
+  {
+    if (oi == in[i].len)
+    {
+      i++;
+      oi = (uint32_t)0U;
+    }
+    else if (oj == out[j].len)
+    {
+      j++;
+      oj = (uint32_t)0U;
+    }
+    else
+    {
+      uint32_t n = in[i].len - oi;
+      if (out[j].len - oj < n)
+      {
+        n = out[j].len - oj;
+      }
+      if (n > IOVEC_CHUNK)
+      {
+        n = IOVEC_CHUNK;
+      }
+      uint8_t *src = in[i].base + oi;
+      uint8_t *dst = out[j].base + oj;
+      if (mac_in)
+      {
+        pieces_cipher(p, n, src);
+      }
+      pieces_xor(p, n, src, dst);
+      if (mac_out)
+      {
+        pieces_cipher(p, n, dst);
+      }
+      oi = oi + n;
+      oj = oj + n;
+    }
+  }
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_encryptv(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_iovec *ad,
+  uint32_t ad_cnt,
+  EverCrypt_AEAD_iovec *plain,
+  uint32_t plain_cnt,
+  EverCrypt_AEAD_iovec *cipher,
+  uint32_t cipher_cnt,
+  uint8_t *tag
+)
+{
+  uint64_t len = iovec_len(plain, plain_cnt);
+  if (len != iovec_len(cipher, cipher_cnt) || iovec_too_long(s, len))
+  {
+    return EverCrypt_Error_DecodeError;
+  }
+  pieces p;
+  EverCrypt_Error_error_code r = pieces_init(&p, s, iv, iv_len);
+  if (r != EverCrypt_Error_Success)
+  {
+    return r;
+  }
+  for (uint32_t i = (uint32_t)0U; i < ad_cnt; i++)
+  {
+    pieces_aad(&p, ad[i].len, ad[i].base);
+  }
+  iovec_xor(&p, plain, plain_cnt, cipher, cipher_cnt, false, true);
+  pieces_finish(&p, tag);
+  Lib_Memzero0_memzero(&p, (uint32_t)sizeof (pieces) * sizeof (uint8_t));
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_decryptv(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_iovec *ad,
+  uint32_t ad_cnt,
+  EverCrypt_AEAD_iovec *cipher,
+  uint32_t cipher_cnt,
+  uint8_t *tag,
+  EverCrypt_AEAD_iovec *dst,
+  uint32_t dst_cnt
+)
+{
+  uint64_t len = iovec_len(cipher, cipher_cnt);
+  if (len != iovec_len(dst, dst_cnt) || iovec_too_long(s, len))
+  {
+    return EverCrypt_Error_DecodeError;
+  }
+  pieces p;
+  EverCrypt_Error_error_code r = pieces_init(&p, s, iv, iv_len);
+  if (r != EverCrypt_Error_Success)
+  {
+    return r;
+  }
+  for (uint32_t i = (uint32_t)0U; i < ad_cnt; i++)
+  {
+    pieces_aad(&p, ad[i].len, ad[i].base);
+  }
+  /* The tag is checked before any plaintext is written */
+  for (uint32_t i = (uint32_t)0U; i < cipher_cnt; i++)
+  {
+    pieces_cipher(&p, cipher[i].len, cipher[i].base);
+  }
+  uint8_t computed[16U] = { 0U };
+  pieces_finish(&p, computed);
+  uint8_t res = (uint8_t)255U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    uint8_t uu____0 = FStar_UInt8_eq_mask(computed[i], tag[i]);
+    res = uu____0 & res;
+  }
+  if (res != (uint8_t)255U)
+  {
+    Lib_Memzero0_memzero(&p, (uint32_t)sizeof (pieces) * sizeof (uint8_t));
+    return EverCrypt_Error_AuthenticationFailure;
+  }
+  iovec_xor(&p, cipher, cipher_cnt, dst, dst_cnt, false, false);
+  Lib_Memzero0_memzero(&p, (uint32_t)sizeof (pieces) * sizeof (uint8_t));
+  return EverCrypt_Error_Success;
+}
+
+/*
+  Streaming AEAD. The context holds the per-message state of the piecewise
+  engine above and a pointer to the expanded key, so its size does not depend
+  on the length of the message.
+*/
+
+struct EverCrypt_AEAD_streaming_state_s_s
+{
+  pieces p;
+  uint64_t max_len;
+  bool data;
+  bool encrypt;
+  bool finished;
+  uint8_t *raw;
+};
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_create_in(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_streaming_state_s **dst
+)
+{
+  /* The vector Poly1305 state needs the alignment of its widest member */
+  uint8_t
+  *raw = KRML_HOST_MALLOC(sizeof (EverCrypt_AEAD_streaming_state_s) + (uint32_t)64U);
+  if (raw == NULL)
+  {
+    return EverCrypt_Error_OutOfMemory;
+  }
+  EverCrypt_AEAD_streaming_state_s
+  *st = (EverCrypt_AEAD_streaming_state_s *)(raw + ((uint32_t)64U - (uint32_t)((uintptr_t)raw % (uintptr_t)64U)));
+  st->raw = raw;
+  EverCrypt_Error_error_code r = EverCrypt_AEAD_streaming_init(st, s, iv, iv_len);
+  if (r != EverCrypt_Error_Success)
+  {
+    KRML_HOST_FREE(raw);
+    return r;
+  }
+  *dst = st;
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_init(
+  EverCrypt_AEAD_streaming_state_s *st,
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len
+)
+{
+  EverCrypt_Error_error_code r = pieces_init(&st->p, s, iv, iv_len);
+  if (r != EverCrypt_Error_Success)
+  {
+    return r;
+  }
+  st->max_len = pieces_max_len(st->p.chacha);
+  st->data = false;
+  st->encrypt = false;
+  st->finished = false;
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_update_aad(
+  EverCrypt_AEAD_streaming_state_s *st,
+  uint8_t *ad,
+  uint32_t ad_len
+)
+{
+  if (st->data || st->finished)
+  {
+    return EverCrypt_Error_DecodeError;
+  }
+  pieces_aad(&st->p, ad_len, ad);
+  return EverCrypt_Error_Success;
+}
+
+static EverCrypt_Error_error_code
+streaming_update(
+  EverCrypt_AEAD_streaming_state_s *st,
+  uint8_t *in,
+  uint32_t len,
+  uint8_t *out,
+  bool encrypt
+)
+{
+  if (st->finished || (st->data && st->encrypt != encrypt) || (uint64_t)len > st->max_len)
+  {
+    return EverCrypt_Error_DecodeError;
+  }
+  st->data = true;
+  st->encrypt = encrypt;
+  st->max_len = st->max_len - (uint64_t)len;
+  for (uint32_t pos = (uint32_t)0U; pos < len; pos = pos + IOVEC_CHUNK)
+  {
+    uint32_t n = len - pos;
+    if (n > IOVEC_CHUNK)
+    {
+      n = IOVEC_CHUNK;
+    }
+    if (!encrypt)
+    {
+      pieces_cipher(&st->p, n, in + pos);
+    }
+    pieces_xor(&st->p, n, in + pos, out + pos);
+    if (encrypt)
+    {
+      pieces_cipher(&st->p, n, out + pos);
+    }
+  }
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_encrypt_update(
+  EverCrypt_AEAD_streaming_state_s *st,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher
+)
+{
+  return streaming_update(st, plain, plain_len, cipher, true);
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_decrypt_update(
+  EverCrypt_AEAD_streaming_state_s *st,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *dst
+)
+{
+  return streaming_update(st, cipher, cipher_len, dst, false);
+}
+
+/* A context that saw no data yet may be finished in either direction */
+static bool streaming_can_finish(EverCrypt_AEAD_streaming_state_s *st, bool encrypt)
+{
+  return !st->finished && (!st->data || st->encrypt == encrypt);
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_encrypt_finish(EverCrypt_AEAD_streaming_state_s *st, uint8_t *tag)
+{
+  if (!streaming_can_finish(st, true))
+  {
+    return EverCrypt_Error_DecodeError;
+  }
+  st->finished = true;
+  pieces_finish(&st->p, tag);
+  return EverCrypt_Error_Success;
+}
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_decrypt_finish(EverCrypt_AEAD_streaming_state_s *st, uint8_t *tag)
+{
+  if (!streaming_can_finish(st, false))
+  {
+    return EverCrypt_Error_DecodeError;
+  }
+  st->finished = true;
+  uint8_t computed[16U] = { 0U };
+  pieces_finish(&st->p, computed);
+  uint8_t res = (uint8_t)255U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    uint8_t uu____0 = FStar_UInt8_eq_mask(computed[i], tag[i]);
+    res = uu____0 & res;
+  }
+  if (res == (uint8_t)255U)
+  {
+    return EverCrypt_Error_Success;
+  }
+  return EverCrypt_Error_AuthenticationFailure;
+}
+
+void EverCrypt_AEAD_streaming_free(EverCrypt_AEAD_streaming_state_s *st)
+{
+  uint8_t *raw = st->raw;
+  Lib_Memzero0_memzero(st, (uint32_t)sizeof (EverCrypt_AEAD_streaming_state_s) * sizeof (uint8_t));
+  KRML_HOST_FREE(raw);
+}
+
 void EverCrypt_AEAD_free(EverCrypt_AEAD_state_s *s)
 {
   EverCrypt_AEAD_state_s scrut = *s;
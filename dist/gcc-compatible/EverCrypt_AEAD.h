@@ -39,6 +39,9 @@ extern "C" {
 
 #include "Hacl_Kremlib.h"
 #include "EverCrypt_Chacha20Poly1305.h"
+#include "EverCrypt_Unverified_AES_GCM_CT64.h"
+#include "Hacl_AES_GCM_VAES.h"
+#include "Hacl_Gf128_NI.h"
 #include "Vale.h"
 #include "EverCrypt_AutoConfig2.h"
 #include "EverCrypt_Error.h"
@@ -46,6 +49,16 @@ extern "C" {
 
 typedef struct EverCrypt_AEAD_state_s_s EverCrypt_AEAD_state_s;
 
+/* A segment of a scattered buffer */
+typedef struct EverCrypt_AEAD_iovec_s
+{
+  uint8_t *base;
+  uint32_t len;
+}
+EverCrypt_AEAD_iovec;
+
+typedef struct EverCrypt_AEAD_streaming_state_s_s EverCrypt_AEAD_streaming_state_s;
+
 bool EverCrypt_AEAD_uu___is_Ek(Spec_Agile_AEAD_alg a, EverCrypt_AEAD_state_s projectee);
 
 Spec_Cipher_Expansion_impl
@@ -56,6 +69,16 @@ uint8_t
 
 Spec_Agile_AEAD_alg EverCrypt_AEAD_alg_of_state(EverCrypt_AEAD_state_s *s);
 
+/*
+  The state holds the expanded key only: round keys and GHASH powers for
+  AES-GCM. AES-GCM uses Hacl_AES_GCM_VAES when the CPU has AVX-512 with VAES
+  and VPCLMULQDQ, then the Vale AES-GCM (AES-NI, PCLMULQDQ, AVX, SSE and
+  MOVBE). Otherwise it returns EverCrypt_Error_UnsupportedAlgorithm, unless
+  EverCrypt_AutoConfig2_enable_unverified was called, in which case it falls
+  back to the portable, unverified EverCrypt_Unverified_AES_GCM_CT64.
+  Encryption and decryption keep their scratch space on the stack and never
+  write to the state, so one state may be shared by several threads.
+*/
 EverCrypt_Error_error_code
 EverCrypt_AEAD_create_in(Spec_Agile_AEAD_alg a, EverCrypt_AEAD_state_s **dst, uint8_t *k);
 
@@ -191,6 +214,178 @@ EverCrypt_AEAD_decrypt_expand(
   uint8_t *dst
 );
 
+/*
+  Seals len independent records in one call. Record i is processed as
+  EverCrypt_AEAD_encrypt(s[i], iv[i], iv_len[i], ad[i], ad_len[i], plain[i],
+  plain_len[i], cipher[i], tag[i]) would, and res[i] receives its result; the
+  return value is the first error, or EverCrypt_Error_Success. The states may
+  use different keys and algorithms.
+
+  Consecutive records with 12-byte IVs are processed together where the
+  implementation allows it: ChaCha20-Poly1305 spreads their keystream and
+  Poly1305 blocks across the vector lanes, and AES-GCM on VAES runs several
+  records through each pass of the AES rounds. Other records are processed
+  one at a time.
+*/
+EverCrypt_Error_error_code
+EverCrypt_AEAD_encrypt_batch(
+  uint32_t len,
+  EverCrypt_AEAD_state_s **s,
+  uint8_t **iv,
+  uint32_t *iv_len,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **plain,
+  uint32_t *plain_len,
+  uint8_t **cipher,
+  uint8_t **tag,
+  EverCrypt_Error_error_code *res
+);
+
+/*
+  Opens len independent records, as EverCrypt_AEAD_encrypt_batch seals them.
+  res[i] is EverCrypt_Error_AuthenticationFailure for each record whose tag is
+  invalid; the other records are decrypted regardless.
+*/
+EverCrypt_Error_error_code
+EverCrypt_AEAD_decrypt_batch(
+  uint32_t len,
+  EverCrypt_AEAD_state_s **s,
+  uint8_t **iv,
+  uint32_t *iv_len,
+  uint8_t **ad,
+  uint32_t *ad_len,
+  uint8_t **cipher,
+  uint32_t *cipher_len,
+  uint8_t **tag,
+  uint8_t **dst,
+  EverCrypt_Error_error_code *res
+);
+
+/*
+  Header-protection masks, as QUIC and DTLS 1.3 derive them from a sample of
+  each record's ciphertext, for len records at once. s is created with the
+  header-protection key and the AEAD algorithm of the connection; mask + 16 * i
+  receives AES(key, sample[i]) for AES-GCM, and for ChaCha20-Poly1305 the
+  first 16 bytes of ChaCha20 keystream with sample[i][0..4] as little-endian
+  counter and sample[i][4..16] as nonce. Each sample is 16 bytes.
+*/
+EverCrypt_Error_error_code
+EverCrypt_AEAD_header_masks(
+  EverCrypt_AEAD_state_s *s,
+  uint32_t len,
+  uint8_t **sample,
+  uint8_t *mask
+);
+
+/*
+  Scatter-gather variants of EverCrypt_AEAD_encrypt and EverCrypt_AEAD_decrypt:
+  the additional data, the input and the output are each given as a list of
+  segments, processed in order as if they were concatenated. The segments may
+  have any length, and the input and output lists need not be cut at the same
+  places, but they must have the same total length (otherwise
+  EverCrypt_Error_DecodeError is returned).
+
+  decryptv verifies the tag before writing any plaintext, and leaves dst
+  untouched on EverCrypt_Error_AuthenticationFailure; it therefore reads the
+  ciphertext twice.
+*/
+EverCrypt_Error_error_code
+EverCrypt_AEAD_encryptv(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_iovec *ad,
+  uint32_t ad_cnt,
+  EverCrypt_AEAD_iovec *plain,
+  uint32_t plain_cnt,
+  EverCrypt_AEAD_iovec *cipher,
+  uint32_t cipher_cnt,
+  uint8_t *tag
+);
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_decryptv(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_iovec *ad,
+  uint32_t ad_cnt,
+  EverCrypt_AEAD_iovec *cipher,
+  uint32_t cipher_cnt,
+  uint8_t *tag,
+  EverCrypt_AEAD_iovec *dst,
+  uint32_t dst_cnt
+);
+
+/*
+  Streaming AEAD: one message is sealed or opened in as many calls as the
+  caller likes, in constant memory.
+
+  create_in (or init, to reuse a context for the next message) starts a message
+  under the expanded key s, which must stay alive until the context is done
+  with; it fails as EverCrypt_AEAD_encrypt does on a bad key or IV, and
+  create_in returns EverCrypt_Error_OutOfMemory if the context cannot be
+  allocated.
+
+  The following return EverCrypt_Error_DecodeError and leave the context
+  unchanged: additional data after the first encrypt_update or decrypt_update,
+  or after finish; an update or finish in the other direction than the first
+  update of the message; anything but init or free after finish; and an update
+  that would take the message past what a single IV can cover (2^36 - 32 bytes
+  for AES-GCM, 2^38 - 64 bytes for ChaCha20-Poly1305).
+
+  decrypt_finish checks the tag in constant time. Plaintext produced by
+  decrypt_update is not authenticated until decrypt_finish returns
+  EverCrypt_Error_Success, and must be discarded otherwise.
+*/
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_create_in(
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len,
+  EverCrypt_AEAD_streaming_state_s **dst
+);
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_init(
+  EverCrypt_AEAD_streaming_state_s *st,
+  EverCrypt_AEAD_state_s *s,
+  uint8_t *iv,
+  uint32_t iv_len
+);
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_update_aad(
+  EverCrypt_AEAD_streaming_state_s *st,
+  uint8_t *ad,
+  uint32_t ad_len
+);
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_encrypt_update(
+  EverCrypt_AEAD_streaming_state_s *st,
+  uint8_t *plain,
+  uint32_t plain_len,
+  uint8_t *cipher
+);
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_encrypt_finish(EverCrypt_AEAD_streaming_state_s *st, uint8_t *tag);
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_decrypt_update(
+  EverCrypt_AEAD_streaming_state_s *st,
+  uint8_t *cipher,
+  uint32_t cipher_len,
+  uint8_t *dst
+);
+
+EverCrypt_Error_error_code
+EverCrypt_AEAD_streaming_decrypt_finish(EverCrypt_AEAD_streaming_state_s *st, uint8_t *tag);
+
+void EverCrypt_AEAD_streaming_free(EverCrypt_AEAD_streaming_state_s *st);
+
 void EverCrypt_AEAD_free(EverCrypt_AEAD_state_s *s);
 
 #if defined(__cplusplus)
@@ -24,6 +24,8 @@
 
 #include "EverCrypt_AutoConfig2.h"
 
+#include <stdatomic.h>
+
 static bool cpu_has_shaext[1U] = { false };
 
 static bool cpu_has_aesni[1U] = { false };
@@ -46,6 +48,10 @@ static bool cpu_has_rdrand[1U] = { false };
 
 static bool cpu_has_avx512[1U] = { false };
 
+static bool cpu_has_vaes[1U] = { false };
+
+static bool cpu_has_ifma[1U] = { false };
+
 static bool user_wants_hacl[1U] = { true };
 
 static bool user_wants_vale[1U] = { true };
@@ -54,6 +60,8 @@ static bool user_wants_openssl[1U] = { true };
 
 static bool user_wants_bcrypt[1U] = { false };
 
+static bool user_wants_unverified[1U] = { false };
+
 bool EverCrypt_AutoConfig2_has_shaext()
 {
   return cpu_has_shaext[0U];
@@ -109,6 +117,16 @@ bool EverCrypt_AutoConfig2_has_avx512()
   return cpu_has_avx512[0U];
 }
 
+bool EverCrypt_AutoConfig2_has_vaes()
+{
+  return cpu_has_vaes[0U];
+}
+
+bool EverCrypt_AutoConfig2_has_ifma()
+{
+  return cpu_has_ifma[0U];
+}
+
 KRML_DEPRECATED("")
 
 bool EverCrypt_AutoConfig2_wants_vale()
@@ -131,11 +149,32 @@ bool EverCrypt_AutoConfig2_wants_bcrypt()
   return user_wants_bcrypt[0U];
 }
 
+bool EverCrypt_AutoConfig2_wants_unverified()
+{
+  return user_wants_unverified[0U];
+}
+
 void EverCrypt_AutoConfig2_recall()
 {
   
 }
 
+/*
+  Starts at 1 so that the modules, whose cached generation starts at 0, resolve
+  on their first call even if EverCrypt_AutoConfig2_init never runs.
+*/
+static _Atomic uint32_t generation = (uint32_t)1U;
+
+static void next_generation()
+{
+  atomic_fetch_add_explicit(&generation, (uint32_t)1U, memory_order_release);
+}
+
+uint32_t EverCrypt_AutoConfig2_generation()
+{
+  return atomic_load_explicit(&generation, memory_order_acquire);
+}
+
 void EverCrypt_AutoConfig2_init()
 {
   #if HACL_CAN_COMPILE_VALE
@@ -210,6 +249,16 @@ void EverCrypt_AutoConfig2_init()
         if (scrut10 != (uint64_t)0U)
         {
           cpu_has_avx512[0U] = true;
+          uint64_t scrut11 = check_vaes();
+          if (scrut11 != (uint64_t)0U)
+          {
+            cpu_has_vaes[0U] = true;
+          }
+          uint64_t scrut12 = check_ifma();
+          if (scrut12 != (uint64_t)0U)
+          {
+            cpu_has_ifma[0U] = true;
+          }
         }
       }
     }
@@ -219,81 +268,118 @@ void EverCrypt_AutoConfig2_init()
   user_wants_vale[0U] = true;
   user_wants_bcrypt[0U] = false;
   user_wants_openssl[0U] = true;
+  user_wants_unverified[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_avx2()
 {
   cpu_has_avx2[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_avx()
 {
   cpu_has_avx[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_bmi2()
 {
   cpu_has_bmi2[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_adx()
 {
   cpu_has_adx[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_shaext()
 {
   cpu_has_shaext[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_aesni()
 {
   cpu_has_aesni[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_pclmulqdq()
 {
   cpu_has_pclmulqdq[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_sse()
 {
   cpu_has_sse[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_movbe()
 {
   cpu_has_movbe[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_rdrand()
 {
   cpu_has_rdrand[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_avx512()
 {
   cpu_has_avx512[0U] = false;
+  cpu_has_vaes[0U] = false;
+  cpu_has_ifma[0U] = false;
+  next_generation();
+}
+
+void EverCrypt_AutoConfig2_disable_vaes()
+{
+  cpu_has_vaes[0U] = false;
+  next_generation();
+}
+
+void EverCrypt_AutoConfig2_disable_ifma()
+{
+  cpu_has_ifma[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_vale()
 {
   user_wants_vale[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_hacl()
 {
   user_wants_hacl[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_openssl()
 {
   user_wants_openssl[0U] = false;
+  next_generation();
 }
 
 void EverCrypt_AutoConfig2_disable_bcrypt()
 {
   user_wants_bcrypt[0U] = false;
+  next_generation();
+}
+
+void EverCrypt_AutoConfig2_enable_unverified()
+{
+  user_wants_unverified[0U] = true;
+  next_generation();
 }
 
 bool EverCrypt_AutoConfig2_has_vec128()
@@ -310,3 +396,10 @@ bool EverCrypt_AutoConfig2_has_vec256()
   return avx2 || other;
 }
 
+bool EverCrypt_AutoConfig2_has_vec512()
+{
+  bool avx512 = EverCrypt_AutoConfig2_has_avx512();
+  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
+  return avx512 && avx2;
+}
+
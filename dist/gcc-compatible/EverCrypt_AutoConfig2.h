@@ -61,6 +61,12 @@ bool EverCrypt_AutoConfig2_has_rdrand();
 
 bool EverCrypt_AutoConfig2_has_avx512();
 
+/* VAES and VPCLMULQDQ on 512-bit registers; only set when AVX-512 is usable. */
+bool EverCrypt_AutoConfig2_has_vaes();
+
+/* 52-bit integer multiply-add (AVX-512 IFMA); only set when AVX-512 is usable. */
+bool EverCrypt_AutoConfig2_has_ifma();
+
 KRML_DEPRECATED("")
 
 bool EverCrypt_AutoConfig2_wants_vale();
@@ -71,8 +77,26 @@ bool EverCrypt_AutoConfig2_wants_openssl();
 
 bool EverCrypt_AutoConfig2_wants_bcrypt();
 
+/*
+  Whether implementations that are not verified may be used; see
+  EverCrypt_AutoConfig2_enable_unverified.
+*/
+bool EverCrypt_AutoConfig2_wants_unverified();
+
 void EverCrypt_AutoConfig2_recall();
 
+/*
+  Incremented by init, the disable_* functions and enable_unverified. Modules
+  that cache a dispatch decision (Hash, Poly1305, Chacha20Poly1305, Curve25519,
+  MerkleTree) compare it with the generation they resolved at and re-resolve
+  when it differs, so a change of configuration costs one load per call.
+
+  The configuration functions write plain flags: they must complete before any
+  other thread calls into EverCrypt. The cached dispatch pointers themselves are
+  atomics, so concurrent first calls after a configuration change are safe.
+*/
+uint32_t EverCrypt_AutoConfig2_generation();
+
 void EverCrypt_AutoConfig2_init();
 
 typedef void (*EverCrypt_AutoConfig2_disabler)();
@@ -99,6 +123,10 @@ void EverCrypt_AutoConfig2_disable_rdrand();
 
 void EverCrypt_AutoConfig2_disable_avx512();
 
+void EverCrypt_AutoConfig2_disable_vaes();
+
+void EverCrypt_AutoConfig2_disable_ifma();
+
 void EverCrypt_AutoConfig2_disable_vale();
 
 void EverCrypt_AutoConfig2_disable_hacl();
@@ -107,10 +135,22 @@ void EverCrypt_AutoConfig2_disable_openssl();
 
 void EverCrypt_AutoConfig2_disable_bcrypt();
 
+/*
+  Off by default, and reset by EverCrypt_AutoConfig2_init. Once enabled,
+  EverCrypt may fall back to hand-written C that carries no proof where no
+  verified implementation runs on this CPU: today, AES-GCM without AES-NI and
+  PCLMULQDQ uses EverCrypt_Unverified_AES_GCM_CT64 instead of failing with
+  EverCrypt_Error_UnsupportedAlgorithm.
+*/
+void EverCrypt_AutoConfig2_enable_unverified();
+
 bool EverCrypt_AutoConfig2_has_vec128();
 
 bool EverCrypt_AutoConfig2_has_vec256();
 
+/* 512-bit integer vectors (AVX-512F/BW/VL); implies has_vec256. */
+bool EverCrypt_AutoConfig2_has_vec512();
+
 #if defined(__cplusplus)
 }
 #endif
@@ -24,37 +24,116 @@
 
 #include "EverCrypt_Chacha20Poly1305.h"
 
-void
-EverCrypt_Chacha20Poly1305_aead_encrypt(
-  uint8_t *k,
-  uint8_t *n,
-  uint32_t aadlen,
-  uint8_t *aad,
-  uint32_t mlen,
-  uint8_t *m,
-  uint8_t *cipher,
-  uint8_t *tag
-)
+#include <stdatomic.h>
+
+typedef void
+(*aead_encrypt_t)(
+  uint8_t *x0,
+  uint8_t *x1,
+  uint32_t x2,
+  uint8_t *x3,
+  uint32_t x4,
+  uint8_t *x5,
+  uint8_t *x6,
+  uint8_t *x7
+);
+
+typedef uint32_t
+(*aead_decrypt_t)(
+  uint8_t *x0,
+  uint8_t *x1,
+  uint32_t x2,
+  uint8_t *x3,
+  uint32_t x4,
+  uint8_t *x5,
+  uint8_t *x6,
+  uint8_t *x7
+);
+
+typedef struct aead_impl_s
+{
+  aead_encrypt_t encrypt;
+  aead_decrypt_t decrypt;
+}
+aead_impl;
+
+#if HACL_CAN_COMPILE_VEC512
+static const
+aead_impl
+aead_512 = { Hacl_Chacha20Poly1305_512_aead_encrypt, Hacl_Chacha20Poly1305_512_aead_decrypt };
+#endif
+
+#if HACL_CAN_COMPILE_VEC256
+static const
+aead_impl
+aead_256 = { Hacl_Chacha20Poly1305_256_aead_encrypt, Hacl_Chacha20Poly1305_256_aead_decrypt };
+#endif
+
+#if HACL_CAN_COMPILE_VEC128
+static const
+aead_impl
+aead_128 = { Hacl_Chacha20Poly1305_128_aead_encrypt, Hacl_Chacha20Poly1305_128_aead_decrypt };
+#endif
+
+static const
+aead_impl
+aead_32 = { Hacl_Chacha20Poly1305_32_aead_encrypt, Hacl_Chacha20Poly1305_32_aead_decrypt };
+
+static const aead_impl *_Atomic aead = NULL;
+
+/* The EverCrypt_AutoConfig2_generation at which aead was chosen. */
+static _Atomic uint32_t aead_generation = (uint32_t)0U;
+
+static const aead_impl *aead_choose()
 {
-  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
-  bool avx = EverCrypt_AutoConfig2_has_avx();
+  bool vec512 = EverCrypt_AutoConfig2_has_vec512();
   bool vec256 = EverCrypt_AutoConfig2_has_vec256();
   bool vec128 = EverCrypt_AutoConfig2_has_vec128();
+  #if HACL_CAN_COMPILE_VEC512
+  if (vec512)
+  {
+    return &aead_512;
+  }
+  #endif
   #if HACL_CAN_COMPILE_VEC256
   if (vec256)
   {
-    Hacl_Chacha20Poly1305_256_aead_encrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
-    return;
+    return &aead_256;
   }
   #endif
   #if HACL_CAN_COMPILE_VEC128
   if (vec128)
   {
-    Hacl_Chacha20Poly1305_128_aead_encrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
-    return;
+    return &aead_128;
   }
   #endif
-  Hacl_Chacha20Poly1305_32_aead_encrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
+  return &aead_32;
+}
+
+static const aead_impl *aead_resolve()
+{
+  uint32_t g = EverCrypt_AutoConfig2_generation();
+  if (atomic_load_explicit(&aead_generation, memory_order_acquire) != g)
+  {
+    atomic_store_explicit(&aead, aead_choose(), memory_order_relaxed);
+    atomic_store_explicit(&aead_generation, g, memory_order_release);
+  }
+  return atomic_load_explicit(&aead, memory_order_relaxed);
+}
+
+void
+EverCrypt_Chacha20Poly1305_aead_encrypt(
+  uint8_t *k,
+  uint8_t *n,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  aead_resolve()->encrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
 }
 
 uint32_t
@@ -69,22 +148,347 @@ EverCrypt_Chacha20Poly1305_aead_decrypt(
   uint8_t *tag
 )
 {
-  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
-  bool avx = EverCrypt_AutoConfig2_has_avx();
+  return aead_resolve()->decrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
+}
+
+void
+EverCrypt_Chacha20Poly1305_aead_encrypt_batch(
+  uint32_t len,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+)
+{
+  bool vec256 = EverCrypt_AutoConfig2_has_vec256();
+  #if HACL_CAN_COMPILE_VEC256
+  if (vec256)
+  {
+    Hacl_Chacha20Poly1305_256_aead_encrypt_batch(len, k, n, aadlen, aad, mlen, m, cipher, tag);
+    return;
+  }
+  #endif
+  for (uint32_t i = (uint32_t)0U; i < len; i++)
+  {
+    EverCrypt_Chacha20Poly1305_aead_encrypt(k[i],
+      n[i],
+      aadlen[i],
+      aad[i],
+      mlen[i],
+      m[i],
+      cipher[i],
+      tag[i]);
+  }
+}
+
+uint32_t
+EverCrypt_Chacha20Poly1305_aead_decrypt_batch(
+  uint32_t len,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+)
+{
   bool vec256 = EverCrypt_AutoConfig2_has_vec256();
-  bool vec128 = EverCrypt_AutoConfig2_has_vec128();
   #if HACL_CAN_COMPILE_VEC256
   if (vec256)
   {
-    return Hacl_Chacha20Poly1305_256_aead_decrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
+    return
+      Hacl_Chacha20Poly1305_256_aead_decrypt_batch(len,
+        k,
+        n,
+        aadlen,
+        aad,
+        mlen,
+        m,
+        cipher,
+        tag,
+        res);
+  }
+  #endif
+  uint32_t failed = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < len; i++)
+  {
+    res[i] =
+      EverCrypt_Chacha20Poly1305_aead_decrypt(k[i],
+        n[i],
+        aadlen[i],
+        aad[i],
+        mlen[i],
+        m[i],
+        cipher[i],
+        tag[i]);
+    failed = failed | res[i];
+  }
+  return failed;
+}
+
+/* Piecewise ChaCha20-Poly1305 */
+
+static void poly_init(EverCrypt_Chacha20Poly1305_state_s *st)
+{
+  #if HACL_CAN_COMPILE_VEC512
+  if (st->width == (uint32_t)512U)
+  {
+    Hacl_Poly1305_512_poly1305_init(st->poly.p512, st->otk);
+    return;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC256
+  if (st->width == (uint32_t)256U)
+  {
+    Hacl_Poly1305_256_poly1305_init(st->poly.p256, st->otk);
+    return;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC128
+  if (st->width == (uint32_t)128U)
+  {
+    Hacl_Poly1305_128_poly1305_init(st->poly.p128, st->otk);
+    return;
+  }
+  #endif
+  Hacl_Poly1305_32_poly1305_init(st->poly.p32, st->otk);
+}
+
+/* len is a multiple of 16 */
+static void poly_blocks(EverCrypt_Chacha20Poly1305_state_s *st, uint32_t len, uint8_t *text)
+{
+  #if HACL_CAN_COMPILE_VEC512
+  if (st->width == (uint32_t)512U)
+  {
+    Hacl_Poly1305_512_poly1305_update(st->poly.p512, len, text);
+    return;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC256
+  if (st->width == (uint32_t)256U)
+  {
+    Hacl_Poly1305_256_poly1305_update(st->poly.p256, len, text);
+    return;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC128
+  if (st->width == (uint32_t)128U)
+  {
+    Hacl_Poly1305_128_poly1305_update(st->poly.p128, len, text);
+    return;
+  }
+  #endif
+  Hacl_Poly1305_32_poly1305_update(st->poly.p32, len, text);
+}
+
+static void poly_finish(EverCrypt_Chacha20Poly1305_state_s *st, uint8_t *tag)
+{
+  #if HACL_CAN_COMPILE_VEC512
+  if (st->width == (uint32_t)512U)
+  {
+    Hacl_Poly1305_512_poly1305_finish(tag, st->otk, st->poly.p512);
+    return;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC256
+  if (st->width == (uint32_t)256U)
+  {
+    Hacl_Poly1305_256_poly1305_finish(tag, st->otk, st->poly.p256);
+    return;
   }
   #endif
   #if HACL_CAN_COMPILE_VEC128
+  if (st->width == (uint32_t)128U)
+  {
+    Hacl_Poly1305_128_poly1305_finish(tag, st->otk, st->poly.p128);
+    return;
+  }
+  #endif
+  Hacl_Poly1305_32_poly1305_finish(tag, st->otk, st->poly.p32);
+}
+
+/* len is a multiple of 64 */
+static void chacha20_blocks(EverCrypt_Chacha20Poly1305_state_s *st, uint32_t len, uint8_t *in, uint8_t *out)
+{
+  #if HACL_CAN_COMPILE_VEC512
+  if (st->width == (uint32_t)512U)
+  {
+    Hacl_Chacha20_Vec512_chacha20_encrypt_512(len, out, in, st->key, st->nonce, st->ctr);
+    return;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC256
+  if (st->width == (uint32_t)256U)
+  {
+    Hacl_Chacha20_Vec256_chacha20_encrypt_256(len, out, in, st->key, st->nonce, st->ctr);
+    return;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC128
+  if (st->width == (uint32_t)128U)
+  {
+    Hacl_Chacha20_Vec128_chacha20_encrypt_128(len, out, in, st->key, st->nonce, st->ctr);
+    return;
+  }
+  #endif
+  Hacl_Chacha20_chacha20_encrypt(len, out, in, st->key, st->nonce, st->ctr);
+}
+
+/* Absorbs a zero-padded partial block, closing the current part of the MAC input */
+static void poly_pad(EverCrypt_Chacha20Poly1305_state_s *st)
+{
+  if (st->buf_len > (uint32_t)0U)
+  {
+    memset(st->buf + st->buf_len, 0U, ((uint32_t)16U - st->buf_len) * sizeof (uint8_t));
+    poly_blocks(st, (uint32_t)16U, st->buf);
+    st->buf_len = (uint32_t)0U;
+  }
+}
+
+static void poly_absorb(EverCrypt_Chacha20Poly1305_state_s *st, uint32_t len, uint8_t *text)
+{
+  if (st->buf_len > (uint32_t)0U)
+  {
+    uint32_t n = (uint32_t)16U - st->buf_len;
+    if (n > len)
+    {
+      n = len;
+    }
+    memcpy(st->buf + st->buf_len, text, n * sizeof (uint8_t));
+    st->buf_len = st->buf_len + n;
+    text = text + n;
+    len = len - n;
+    if (st->buf_len < (uint32_t)16U)
+    {
+      return;
+    }
+    poly_blocks(st, (uint32_t)16U, st->buf);
+    st->buf_len = (uint32_t)0U;
+  }
+  uint32_t full = len / (uint32_t)16U * (uint32_t)16U;
+  if (full > (uint32_t)0U)
+  {
+    poly_blocks(st, full, text);
+  }
+  memcpy(st->buf, text + full, (len - full) * sizeof (uint8_t));
+  st->buf_len = len - full;
+}
+
+void EverCrypt_Chacha20Poly1305_init(EverCrypt_Chacha20Poly1305_state_s *st, uint8_t *k, uint8_t *n)
+{
+  bool vec512 = EverCrypt_AutoConfig2_has_vec512();
+  bool vec256 = EverCrypt_AutoConfig2_has_vec256();
+  bool vec128 = EverCrypt_AutoConfig2_has_vec128();
+  uint32_t width = (uint32_t)32U;
+  #if HACL_CAN_COMPILE_VEC128
   if (vec128)
   {
-    return Hacl_Chacha20Poly1305_128_aead_decrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
+    width = (uint32_t)128U;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC256
+  if (vec256)
+  {
+    width = (uint32_t)256U;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC512
+  if (vec512)
+  {
+    width = (uint32_t)512U;
   }
   #endif
-  return Hacl_Chacha20Poly1305_32_aead_decrypt(k, n, aadlen, aad, mlen, m, cipher, tag);
+  st->width = width;
+  memcpy(st->key, k, (uint32_t)32U * sizeof (uint8_t));
+  memcpy(st->nonce, n, (uint32_t)12U * sizeof (uint8_t));
+  /* The Poly1305 key is the start of block 0; the message starts at block 1 */
+  uint8_t block0[64U] = { 0U };
+  Hacl_Chacha20_chacha20_encrypt((uint32_t)64U, block0, block0, k, n, (uint32_t)0U);
+  memcpy(st->otk, block0, (uint32_t)32U * sizeof (uint8_t));
+  st->ctr = (uint32_t)1U;
+  st->ks_len = (uint32_t)0U;
+  st->buf_len = (uint32_t)0U;
+  st->aad_done = false;
+  st->aad_len = (uint64_t)0U;
+  st->len = (uint64_t)0U;
+  poly_init(st);
 }
 
+void
+EverCrypt_Chacha20Poly1305_update_aad(
+  EverCrypt_Chacha20Poly1305_state_s *st,
+  uint32_t len,
+  uint8_t *aad
+)
+{
+  poly_absorb(st, len, aad);
+  st->aad_len = st->aad_len + (uint64_t)len;
+}
+
+void
+EverCrypt_Chacha20Poly1305_xor_keystream(
+  EverCrypt_Chacha20Poly1305_state_s *st,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+)
+{
+  uint32_t i = (uint32_t)0U;
+  for (; i < len && st->ks_len > (uint32_t)0U; i++)
+  {
+    out[i] = in[i] ^ st->ks[(uint32_t)64U - st->ks_len];
+    st->ks_len = st->ks_len - (uint32_t)1U;
+  }
+  uint32_t full = (len - i) / (uint32_t)64U * (uint32_t)64U;
+  if (full > (uint32_t)0U)
+  {
+    chacha20_blocks(st, full, in + i, out + i);
+    st->ctr = st->ctr + full / (uint32_t)64U;
+    i = i + full;
+  }
+  if (i < len)
+  {
+    uint32_t rem = len - i;
+    memset(st->ks, 0U, (uint32_t)64U * sizeof (uint8_t));
+    Hacl_Chacha20_chacha20_encrypt((uint32_t)64U, st->ks, st->ks, st->key, st->nonce, st->ctr);
+    st->ctr = st->ctr + (uint32_t)1U;
+    for (uint32_t j = (uint32_t)0U; j < rem; j++)
+    {
+      out[i + j] = in[i + j] ^ st->ks[j];
+    }
+    st->ks_len = (uint32_t)64U - rem;
+  }
+}
+
+void
+EverCrypt_Chacha20Poly1305_update_cipher(
+  EverCrypt_Chacha20Poly1305_state_s *st,
+  uint32_t len,
+  uint8_t *cipher
+)
+{
+  if (!st->aad_done)
+  {
+    poly_pad(st);
+    st->aad_done = true;
+  }
+  poly_absorb(st, len, cipher);
+  st->len = st->len + (uint64_t)len;
+}
+
+void EverCrypt_Chacha20Poly1305_finish(EverCrypt_Chacha20Poly1305_state_s *st, uint8_t *tag)
+{
+  poly_pad(st);
+  uint8_t lens[16U] = { 0U };
+  store64_le(lens, st->aad_len);
+  store64_le(lens + (uint32_t)8U, st->len);
+  poly_blocks(st, (uint32_t)16U, lens);
+  poly_finish(st, tag);
+}
@@ -41,6 +41,7 @@ extern "C" {
 #include "Hacl_Chacha20Poly1305_128.h"
 #include "Hacl_Chacha20Poly1305_32.h"
 #include "Hacl_Chacha20Poly1305_256.h"
+#include "Hacl_Chacha20Poly1305_512.h"
 
 void
 EverCrypt_Chacha20Poly1305_aead_encrypt(
@@ -66,6 +67,103 @@ EverCrypt_Chacha20Poly1305_aead_decrypt(
   uint8_t *tag
 );
 
+/*
+  Multi-record variants, with the conventions of
+  Hacl_Chacha20Poly1305_256_aead_encrypt_batch and _decrypt_batch. The 256-bit
+  implementation interleaves the records across its lanes; elsewhere they are
+  processed one at a time.
+*/
+void
+EverCrypt_Chacha20Poly1305_aead_encrypt_batch(
+  uint32_t len,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+);
+
+uint32_t
+EverCrypt_Chacha20Poly1305_aead_decrypt_batch(
+  uint32_t len,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+);
+
+/*
+  ChaCha20-Poly1305 computed in pieces, for messages that are not in a single
+  buffer. The state keeps the ChaCha20 block counter with the unused end of the
+  last keystream block, and the Poly1305 accumulator with up to 15 bytes not
+  yet absorbed, so that the pieces may have any length. It uses the widest
+  vector implementation available when init is called.
+
+  A message is processed as: init; update_aad on each piece of the additional
+  data; then, in message order, xor_keystream to encrypt or decrypt each piece
+  and update_cipher on each piece of the ciphertext; finally finish, which
+  writes the tag. All additional data must come before the ciphertext.
+*/
+typedef union {
+  uint64_t p32[25U];
+  Lib_IntVector_Intrinsics_vec128 p128[25U];
+  Lib_IntVector_Intrinsics_vec256 p256[25U];
+  Lib_IntVector_Intrinsics_vec512 p512[25U];
+}
+EverCrypt_Chacha20Poly1305_poly_ctx;
+
+typedef struct EverCrypt_Chacha20Poly1305_state_s_s
+{
+  EverCrypt_Chacha20Poly1305_poly_ctx poly;
+  uint32_t width;
+  uint8_t key[32U];
+  uint8_t nonce[12U];
+  uint32_t ctr;
+  uint8_t ks[64U];
+  uint32_t ks_len;
+  uint8_t otk[32U];
+  uint8_t buf[16U];
+  uint32_t buf_len;
+  bool aad_done;
+  uint64_t aad_len;
+  uint64_t len;
+}
+EverCrypt_Chacha20Poly1305_state_s;
+
+void EverCrypt_Chacha20Poly1305_init(EverCrypt_Chacha20Poly1305_state_s *st, uint8_t *k, uint8_t *n);
+
+void
+EverCrypt_Chacha20Poly1305_update_aad(
+  EverCrypt_Chacha20Poly1305_state_s *st,
+  uint32_t len,
+  uint8_t *aad
+);
+
+void
+EverCrypt_Chacha20Poly1305_xor_keystream(
+  EverCrypt_Chacha20Poly1305_state_s *st,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+);
+
+void
+EverCrypt_Chacha20Poly1305_update_cipher(
+  EverCrypt_Chacha20Poly1305_state_s *st,
+  uint32_t len,
+  uint8_t *cipher
+);
+
+void EverCrypt_Chacha20Poly1305_finish(EverCrypt_Chacha20Poly1305_state_s *st, uint8_t *tag);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -24,6 +24,8 @@
 
 #include "EverCrypt_Curve25519.h"
 
+#include <stdatomic.h>
+
 static inline bool has_adx_bmi2()
 {
   bool has_bmi2 = EverCrypt_AutoConfig2_has_bmi2();
@@ -31,38 +33,137 @@ static inline bool has_adx_bmi2()
   return has_bmi2 && has_adx;
 }
 
-void EverCrypt_Curve25519_secret_to_public(uint8_t *pub, uint8_t *priv)
+typedef struct curve25519_impl_s
 {
-  #if HACL_CAN_COMPILE_VALE
-  if (has_adx_bmi2())
+  void (*secret_to_public)(uint8_t *x0, uint8_t *x1);
+  void (*scalarmult)(uint8_t *x0, uint8_t *x1, uint8_t *x2);
+  bool (*ecdh)(uint8_t *x0, uint8_t *x1, uint8_t *x2);
+}
+curve25519_impl;
+
+static const
+curve25519_impl
+curve25519_51 =
   {
-    Hacl_Curve25519_64_secret_to_public(pub, priv);
-    return;
+    Hacl_Curve25519_51_secret_to_public, Hacl_Curve25519_51_scalarmult,
+    Hacl_Curve25519_51_ecdh
+  };
+
+#if HACL_CAN_COMPILE_VALE
+static const
+curve25519_impl
+curve25519_64 =
+  {
+    Hacl_Curve25519_64_secret_to_public, Hacl_Curve25519_64_scalarmult,
+    Hacl_Curve25519_64_ecdh
+  };
+#endif
+
+static const curve25519_impl *_Atomic curve25519 = NULL;
+
+typedef void (*batch_scalarmult_t)(uint32_t x0, uint8_t **x1, uint8_t **x2, uint8_t **x3);
+
+static batch_scalarmult_t _Atomic curve25519_batch = NULL;
+
+/* The EverCrypt_AutoConfig2_generation at which the two pointers were chosen. */
+static _Atomic uint32_t curve25519_generation = (uint32_t)0U;
+
+static const curve25519_impl *curve25519_get();
+
+static void batch_loop(uint32_t n, uint8_t **outs, uint8_t **privs, uint8_t **pubs)
+{
+  const curve25519_impl *impl = curve25519_get();
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    impl->scalarmult(outs[i], privs[i], pubs[i]);
   }
-  #endif
-  Hacl_Curve25519_51_secret_to_public(pub, priv);
 }
 
-void EverCrypt_Curve25519_scalarmult(uint8_t *shared, uint8_t *my_priv, uint8_t *their_pub)
+#if HACL_CAN_COMPILE_IFMA
+/* Below this many leftover inputs, the single-input ladder beats a padded
+   eight-lane one. */
+#define IFMA_MIN_TAIL ((uint32_t)2U)
+
+static void batch_ifma(uint32_t n, uint8_t **outs, uint8_t **privs, uint8_t **pubs)
 {
-  #if HACL_CAN_COMPILE_VALE
-  if (has_adx_bmi2())
+  uint32_t n8 = n & ~(uint32_t)7U;
+  uint32_t rest = n - n8;
+  if (n8 > (uint32_t)0U)
+  {
+    Hacl_Curve25519_IFMA_batch_scalarmult(n8, outs, privs, pubs);
+  }
+  if (rest >= IFMA_MIN_TAIL)
   {
-    Hacl_Curve25519_64_scalarmult(shared, my_priv, their_pub);
+    Hacl_Curve25519_IFMA_batch_scalarmult(rest, outs + n8, privs + n8, pubs + n8);
     return;
   }
+  batch_loop(rest, outs + n8, privs + n8, pubs + n8);
+}
+#endif
+
+static batch_scalarmult_t batch_choose()
+{
+  #if HACL_CAN_COMPILE_IFMA
+  if (EverCrypt_AutoConfig2_has_ifma())
+  {
+    return batch_ifma;
+  }
   #endif
-  Hacl_Curve25519_51_scalarmult(shared, my_priv, their_pub);
+  return batch_loop;
 }
 
-bool EverCrypt_Curve25519_ecdh(uint8_t *shared, uint8_t *my_priv, uint8_t *their_pub)
+static const curve25519_impl *curve25519_choose()
 {
   #if HACL_CAN_COMPILE_VALE
   if (has_adx_bmi2())
   {
-    return Hacl_Curve25519_64_ecdh(shared, my_priv, their_pub);
+    return &curve25519_64;
   }
   #endif
-  return Hacl_Curve25519_51_ecdh(shared, my_priv, their_pub);
+  return &curve25519_51;
+}
+
+static void curve25519_resolve()
+{
+  uint32_t g = EverCrypt_AutoConfig2_generation();
+  if (atomic_load_explicit(&curve25519_generation, memory_order_acquire) != g)
+  {
+    atomic_store_explicit(&curve25519, curve25519_choose(), memory_order_relaxed);
+    atomic_store_explicit(&curve25519_batch, batch_choose(), memory_order_relaxed);
+    atomic_store_explicit(&curve25519_generation, g, memory_order_release);
+  }
+}
+
+static const curve25519_impl *curve25519_get()
+{
+  curve25519_resolve();
+  return atomic_load_explicit(&curve25519, memory_order_relaxed);
+}
+
+void EverCrypt_Curve25519_secret_to_public(uint8_t *pub, uint8_t *priv)
+{
+  curve25519_get()->secret_to_public(pub, priv);
+}
+
+void EverCrypt_Curve25519_scalarmult(uint8_t *shared, uint8_t *my_priv, uint8_t *their_pub)
+{
+  curve25519_get()->scalarmult(shared, my_priv, their_pub);
+}
+
+bool EverCrypt_Curve25519_ecdh(uint8_t *shared, uint8_t *my_priv, uint8_t *their_pub)
+{
+  return curve25519_get()->ecdh(shared, my_priv, their_pub);
+}
+
+void
+EverCrypt_Curve25519_batch_scalarmult(
+  uint32_t n,
+  uint8_t **outs,
+  uint8_t **privs,
+  uint8_t **pubs
+)
+{
+  curve25519_resolve();
+  atomic_load_explicit(&curve25519_batch, memory_order_relaxed)(n, outs, privs, pubs);
 }
 
@@ -40,6 +40,7 @@ extern "C" {
 #include "EverCrypt_AutoConfig2.h"
 #include "Hacl_Curve25519_64.h"
 #include "Hacl_Curve25519_51.h"
+#include "Hacl_Curve25519_IFMA.h"
 
 void EverCrypt_Curve25519_secret_to_public(uint8_t *pub, uint8_t *priv);
 
@@ -47,6 +48,20 @@ void EverCrypt_Curve25519_scalarmult(uint8_t *shared, uint8_t *my_priv, uint8_t
 
 bool EverCrypt_Curve25519_ecdh(uint8_t *shared, uint8_t *my_priv, uint8_t *their_pub);
 
+/*
+  outs[i] = X25519(privs[i], pubs[i]) for every i < n, as computed by
+  EverCrypt_Curve25519_scalarmult. With AVX-512 IFMA, groups of eight are
+  computed together by Hacl_Curve25519_IFMA; otherwise, and for short tails,
+  this loops over the single-input implementation.
+*/
+void
+EverCrypt_Curve25519_batch_scalarmult(
+  uint32_t n,
+  uint8_t **outs,
+  uint8_t **privs,
+  uint8_t **pubs
+);
+
 #if defined(__cplusplus)
 }
 #endif
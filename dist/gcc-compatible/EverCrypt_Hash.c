@@ -24,6 +24,8 @@
 
 #include "EverCrypt_Hash.h"
 
+#include <stdatomic.h>
+
 C_String_t EverCrypt_Hash_string_of_alg(Spec_Hash_Definitions_hash_alg uu___)
 {
   switch (uu___)
@@ -563,19 +565,97 @@ k224_256[64U] =
     (uint32_t)0x90befffaU, (uint32_t)0xa4506cebU, (uint32_t)0xbef9a3f7U, (uint32_t)0xc67178f2U
   };
 
-void EverCrypt_Hash_update_multi_256(uint32_t *s, uint8_t *blocks, uint32_t n)
+typedef void (*update_multi_256_t)(uint32_t *x0, uint8_t *x1, uint32_t x2);
+
+#if HACL_CAN_COMPILE_VALE
+static void update_multi_256_vale(uint32_t *s, uint8_t *blocks, uint32_t n)
+{
+  uint64_t n1 = (uint64_t)n;
+  uint64_t scrut = sha256_update(s, blocks, n1, k224_256);
+}
+#endif
+
+static update_multi_256_t _Atomic update_multi_256_impl = NULL;
+
+/* Vector kernels EverCrypt_Hash_hash_many may use, as a mask of the following. */
+#define HASH_MANY_SHA256_8 ((uint32_t)1U)
+#define HASH_MANY_SHA256_4 ((uint32_t)2U)
+#define HASH_MANY_SHA512_4 ((uint32_t)4U)
+#define HASH_MANY_SHA256_16 ((uint32_t)8U)
+
+static _Atomic uint32_t hash_many_kernels = (uint32_t)0U;
+
+/* The EverCrypt_AutoConfig2_generation at which the two above were chosen. */
+static _Atomic uint32_t hash_generation = (uint32_t)0U;
+
+static update_multi_256_t update_multi_256_choose()
 {
   bool has_shaext = EverCrypt_AutoConfig2_has_shaext();
   bool has_sse = EverCrypt_AutoConfig2_has_sse();
   #if HACL_CAN_COMPILE_VALE
   if (has_shaext && has_sse)
   {
-    uint64_t n1 = (uint64_t)n;
-    uint64_t scrut = sha256_update(s, blocks, n1, k224_256);
-    return;
+    return update_multi_256_vale;
+  }
+  #endif
+  return Hacl_Hash_SHA2_update_multi_256;
+}
+
+static uint32_t hash_many_choose()
+{
+  bool has_shaext = EverCrypt_AutoConfig2_has_shaext();
+  bool has_sse = EverCrypt_AutoConfig2_has_sse();
+  bool vec512 = EverCrypt_AutoConfig2_has_vec512();
+  bool vec256 = EverCrypt_AutoConfig2_has_vec256();
+  bool vec128 = EverCrypt_AutoConfig2_has_vec128();
+  uint32_t kernels = (uint32_t)0U;
+  #if HACL_CAN_COMPILE_VEC256
+  if (vec256)
+  {
+    kernels = kernels | HASH_MANY_SHA512_4;
   }
   #endif
-  Hacl_Hash_SHA2_update_multi_256(s, blocks, n);
+  /* With SHA-NI, one stream at a time already beats the vector lanes. */
+  if (has_shaext && has_sse)
+  {
+    return kernels;
+  }
+  #if HACL_CAN_COMPILE_VEC512
+  if (vec512)
+  {
+    kernels = kernels | HASH_MANY_SHA256_16;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC256
+  if (vec256)
+  {
+    kernels = kernels | HASH_MANY_SHA256_8;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC128
+  if (vec128)
+  {
+    kernels = kernels | HASH_MANY_SHA256_4;
+  }
+  #endif
+  return kernels;
+}
+
+static void hash_resolve()
+{
+  uint32_t g = EverCrypt_AutoConfig2_generation();
+  if (atomic_load_explicit(&hash_generation, memory_order_acquire) != g)
+  {
+    atomic_store_explicit(&update_multi_256_impl, update_multi_256_choose(), memory_order_relaxed);
+    atomic_store_explicit(&hash_many_kernels, hash_many_choose(), memory_order_relaxed);
+    atomic_store_explicit(&hash_generation, g, memory_order_release);
+  }
+}
+
+void EverCrypt_Hash_update_multi_256(uint32_t *s, uint8_t *blocks, uint32_t n)
+{
+  hash_resolve();
+  atomic_load_explicit(&update_multi_256_impl, memory_order_relaxed)(s, blocks, n);
 }
 
 void EverCrypt_Hash_update2(EverCrypt_Hash_state_s *s, uint64_t prevlen, uint8_t *block)
@@ -1268,6 +1348,75 @@ EverCrypt_Hash_hash(
   }
 }
 
+void
+EverCrypt_Hash_hash_many(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t n,
+  uint8_t **dst,
+  uint8_t **input,
+  uint32_t *input_len
+)
+{
+  hash_resolve();
+  uint32_t kernels = atomic_load_explicit(&hash_many_kernels, memory_order_relaxed);
+  uint32_t i = (uint32_t)0U;
+  switch (a)
+  {
+    case Spec_Hash_Definitions_SHA2_256:
+      {
+        #if HACL_CAN_COMPILE_VEC512
+        if (kernels & HASH_MANY_SHA256_16)
+        {
+          for (; i + (uint32_t)16U <= n; i = i + (uint32_t)16U)
+          {
+            Hacl_SHA2_Vec512_sha256_16(dst + i, input_len + i, input + i);
+          }
+        }
+        #endif
+        #if HACL_CAN_COMPILE_VEC256
+        if (kernels & HASH_MANY_SHA256_8)
+        {
+          for (; i + (uint32_t)8U <= n; i = i + (uint32_t)8U)
+          {
+            Hacl_SHA2_Vec256_sha256_8(dst + i, input_len + i, input + i);
+          }
+        }
+        #endif
+        #if HACL_CAN_COMPILE_VEC128
+        if (kernels & HASH_MANY_SHA256_4)
+        {
+          for (; i + (uint32_t)4U <= n; i = i + (uint32_t)4U)
+          {
+            Hacl_SHA2_Vec128_sha256_4(dst + i, input_len + i, input + i);
+          }
+        }
+        #endif
+        break;
+      }
+    case Spec_Hash_Definitions_SHA2_512:
+      {
+        #if HACL_CAN_COMPILE_VEC256
+        if (kernels & HASH_MANY_SHA512_4)
+        {
+          for (; i + (uint32_t)4U <= n; i = i + (uint32_t)4U)
+          {
+            Hacl_SHA2_Vec256_sha512_4(dst + i, input_len + i, input + i);
+          }
+        }
+        #endif
+        break;
+      }
+    default:
+      {
+        break;
+      }
+  }
+  for (; i < n; i++)
+  {
+    EverCrypt_Hash_hash(a, dst[i], input[i], input_len[i]);
+  }
+}
+
 uint32_t EverCrypt_Hash_Incremental_hash_len(Spec_Hash_Definitions_hash_alg a)
 {
   switch (a)
@@ -41,6 +41,9 @@ extern "C" {
 #include "Hacl_Impl_Blake2_Constants.h"
 #include "Vale.h"
 #include "Hacl_Hash.h"
+#include "Hacl_SHA2_Vec128.h"
+#include "Hacl_SHA2_Vec256.h"
+#include "Hacl_SHA2_Vec512.h"
 #include "EverCrypt_AutoConfig2.h"
 #include "Hacl_Spec.h"
 
@@ -244,6 +247,24 @@ EverCrypt_Hash_hash(
   uint32_t len
 );
 
+/*
+Hash n independent messages: message i is input[i], of input_len[i] bytes, and its
+digest is written to dst[i].
+
+  For SHA2-256 and SHA2-512, groups of messages are hashed in parallel in the lanes of
+  256-bit or 128-bit vectors when the CPU supports it (for SHA2-256, only when SHA-NI
+  is absent); any other algorithm, and the messages left over, go through
+  EverCrypt_Hash_hash one at a time.
+*/
+void
+EverCrypt_Hash_hash_many(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t n,
+  uint8_t **dst,
+  uint8_t **input,
+  uint32_t *input_len
+);
+
 uint32_t EverCrypt_Hash_Incremental_hash_len(Spec_Hash_Definitions_hash_alg a);
 
 uint32_t EverCrypt_Hash_Incremental_block_len(Spec_Hash_Definitions_hash_alg a);
@@ -24,6 +24,8 @@
 
 #include "EverCrypt_Poly1305.h"
 
+#include <stdatomic.h>
+
 static void poly1305_vale(uint8_t *dst, uint8_t *src, uint32_t len, uint8_t *key)
 {
   uint8_t ctx[192U] = { 0U };
@@ -52,34 +54,66 @@ static void poly1305_vale(uint8_t *dst, uint8_t *src, uint32_t len, uint8_t *key
   memcpy(dst, ctx, (uint32_t)16U * sizeof (uint8_t));
 }
 
-void EverCrypt_Poly1305_poly1305(uint8_t *dst, uint8_t *src, uint32_t len, uint8_t *key)
+typedef void (*poly1305_mac_t)(uint8_t *x0, uint32_t x1, uint8_t *x2, uint8_t *x3);
+
+#if HACL_CAN_COMPILE_VALE
+static void poly1305_vale_mac(uint8_t *dst, uint32_t len, uint8_t *src, uint8_t *key)
+{
+  poly1305_vale(dst, src, len, key);
+}
+#endif
+
+static poly1305_mac_t _Atomic poly1305_mac_impl = NULL;
+
+/* The EverCrypt_AutoConfig2_generation at which poly1305_mac_impl was chosen. */
+static _Atomic uint32_t poly1305_generation = (uint32_t)0U;
+
+static poly1305_mac_t poly1305_choose()
 {
-  bool avx2 = EverCrypt_AutoConfig2_has_avx2();
-  bool avx = EverCrypt_AutoConfig2_has_avx();
+  bool vec512 = EverCrypt_AutoConfig2_has_vec512();
   bool vec256 = EverCrypt_AutoConfig2_has_vec256();
   bool vec128 = EverCrypt_AutoConfig2_has_vec128();
   bool vale = EverCrypt_AutoConfig2_wants_vale();
+  #if HACL_CAN_COMPILE_VEC512
+  if (vec512)
+  {
+    return Hacl_Poly1305_512_poly1305_mac;
+  }
+  #endif
   #if HACL_CAN_COMPILE_VEC256
   if (vec256)
   {
-    Hacl_Poly1305_256_poly1305_mac(dst, len, src, key);
-    return;
+    return Hacl_Poly1305_256_poly1305_mac;
   }
   #endif
   #if HACL_CAN_COMPILE_VEC128
   if (vec128)
   {
-    Hacl_Poly1305_128_poly1305_mac(dst, len, src, key);
-    return;
+    return Hacl_Poly1305_128_poly1305_mac;
   }
   #endif
   #if HACL_CAN_COMPILE_VALE
   if (vale)
   {
-    poly1305_vale(dst, src, len, key);
-    return;
+    return poly1305_vale_mac;
   }
   #endif
-  Hacl_Poly1305_32_poly1305_mac(dst, len, src, key);
+  return Hacl_Poly1305_32_poly1305_mac;
+}
+
+static poly1305_mac_t poly1305_resolve()
+{
+  uint32_t g = EverCrypt_AutoConfig2_generation();
+  if (atomic_load_explicit(&poly1305_generation, memory_order_acquire) != g)
+  {
+    atomic_store_explicit(&poly1305_mac_impl, poly1305_choose(), memory_order_relaxed);
+    atomic_store_explicit(&poly1305_generation, g, memory_order_release);
+  }
+  return atomic_load_explicit(&poly1305_mac_impl, memory_order_relaxed);
+}
+
+void EverCrypt_Poly1305_poly1305(uint8_t *dst, uint8_t *src, uint32_t len, uint8_t *key)
+{
+  poly1305_resolve()(dst, len, src, key);
 }
 
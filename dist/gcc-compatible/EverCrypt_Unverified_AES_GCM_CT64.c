@@ -0,0 +1,876 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "EverCrypt_Unverified_AES_GCM_CT64.h"
+
+/* Hand-written, not extracted from F*: see EverCrypt_Unverified_AES_GCM_CT64.h. */
+
+/* Bitsliced AES: eight 64-bit words hold four blocks, one bit plane per word. */
+
+uint32_t EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len = (uint32_t)94U;
+
+uint32_t EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len = (uint32_t)126U;
+
+static inline void swapn(uint64_t cl, uint64_t ch, uint32_t s, uint64_t *x, uint64_t *y)
+{
+  uint64_t a = *x;
+  uint64_t b = *y;
+  *x = (a & cl) | (b & cl) << s;
+  *y = (a & ch) >> s | (b & ch);
+}
+
+static void ortho(uint64_t *q)
+{
+  uint64_t c1 = (uint64_t)0x5555555555555555U;
+  uint64_t d1 = (uint64_t)0xAAAAAAAAAAAAAAAAU;
+  uint64_t c2 = (uint64_t)0x3333333333333333U;
+  uint64_t d2 = (uint64_t)0xCCCCCCCCCCCCCCCCU;
+  uint64_t c4 = (uint64_t)0x0F0F0F0F0F0F0F0FU;
+  uint64_t d4 = (uint64_t)0xF0F0F0F0F0F0F0F0U;
+  swapn(c1, d1, (uint32_t)1U, q, q + (uint32_t)1U);
+  swapn(c1, d1, (uint32_t)1U, q + (uint32_t)2U, q + (uint32_t)3U);
+  swapn(c1, d1, (uint32_t)1U, q + (uint32_t)4U, q + (uint32_t)5U);
+  swapn(c1, d1, (uint32_t)1U, q + (uint32_t)6U, q + (uint32_t)7U);
+  swapn(c2, d2, (uint32_t)2U, q, q + (uint32_t)2U);
+  swapn(c2, d2, (uint32_t)2U, q + (uint32_t)1U, q + (uint32_t)3U);
+  swapn(c2, d2, (uint32_t)2U, q + (uint32_t)4U, q + (uint32_t)6U);
+  swapn(c2, d2, (uint32_t)2U, q + (uint32_t)5U, q + (uint32_t)7U);
+  swapn(c4, d4, (uint32_t)4U, q, q + (uint32_t)4U);
+  swapn(c4, d4, (uint32_t)4U, q + (uint32_t)1U, q + (uint32_t)5U);
+  swapn(c4, d4, (uint32_t)4U, q + (uint32_t)2U, q + (uint32_t)6U);
+  swapn(c4, d4, (uint32_t)4U, q + (uint32_t)3U, q + (uint32_t)7U);
+}
+
+/* The Boyar-Peralta S-box circuit: 113 gates, no lookups. */
+static void sub_bytes(uint64_t *q)
+{
+  uint64_t x0 = q[7U];
+  uint64_t x1 = q[6U];
+  uint64_t x2 = q[5U];
+  uint64_t x3 = q[4U];
+  uint64_t x4 = q[3U];
+  uint64_t x5 = q[2U];
+  uint64_t x6 = q[1U];
+  uint64_t x7 = q[0U];
+  uint64_t y14 = x3 ^ x5;
+  uint64_t y13 = x0 ^ x6;
+  uint64_t y9 = x0 ^ x3;
+  uint64_t y8 = x0 ^ x5;
+  uint64_t t0 = x1 ^ x2;
+  uint64_t y1 = t0 ^ x7;
+  uint64_t y4 = y1 ^ x3;
+  uint64_t y12 = y13 ^ y14;
+  uint64_t y2 = y1 ^ x0;
+  uint64_t y5 = y1 ^ x6;
+  uint64_t y3 = y5 ^ y8;
+  uint64_t t1 = x4 ^ y12;
+  uint64_t y15 = t1 ^ x5;
+  uint64_t y20 = t1 ^ x1;
+  uint64_t y6 = y15 ^ x7;
+  uint64_t y10 = y15 ^ t0;
+  uint64_t y11 = y20 ^ y9;
+  uint64_t y7 = x7 ^ y11;
+  uint64_t y17 = y10 ^ y11;
+  uint64_t y19 = y10 ^ y8;
+  uint64_t y16 = t0 ^ y11;
+  uint64_t y21 = y13 ^ y16;
+  uint64_t y18 = x0 ^ y16;
+  uint64_t t2 = y12 & y15;
+  uint64_t t3 = y3 & y6;
+  uint64_t t4 = t3 ^ t2;
+  uint64_t t5 = y4 & x7;
+  uint64_t t6 = t5 ^ t2;
+  uint64_t t7 = y13 & y16;
+  uint64_t t8 = y5 & y1;
+  uint64_t t9 = t8 ^ t7;
+  uint64_t t10 = y2 & y7;
+  uint64_t t11 = t10 ^ t7;
+  uint64_t t12 = y9 & y11;
+  uint64_t t13 = y14 & y17;
+  uint64_t t14 = t13 ^ t12;
+  uint64_t t15 = y8 & y10;
+  uint64_t t16 = t15 ^ t12;
+  uint64_t t17 = t4 ^ t14;
+  uint64_t t18 = t6 ^ t16;
+  uint64_t t19 = t9 ^ t14;
+  uint64_t t20 = t11 ^ t16;
+  uint64_t t21 = t17 ^ y20;
+  uint64_t t22 = t18 ^ y19;
+  uint64_t t23 = t19 ^ y21;
+  uint64_t t24 = t20 ^ y18;
+  uint64_t t25 = t21 ^ t22;
+  uint64_t t26 = t21 & t23;
+  uint64_t t27 = t24 ^ t26;
+  uint64_t t28 = t25 & t27;
+  uint64_t t29 = t28 ^ t22;
+  uint64_t t30 = t23 ^ t24;
+  uint64_t t31 = t22 ^ t26;
+  uint64_t t32 = t31 & t30;
+  uint64_t t33 = t32 ^ t24;
+  uint64_t t34 = t23 ^ t33;
+  uint64_t t35 = t27 ^ t33;
+  uint64_t t36 = t24 & t35;
+  uint64_t t37 = t36 ^ t34;
+  uint64_t t38 = t27 ^ t36;
+  uint64_t t39 = t29 & t38;
+  uint64_t t40 = t25 ^ t39;
+  uint64_t t41 = t40 ^ t37;
+  uint64_t t42 = t29 ^ t33;
+  uint64_t t43 = t29 ^ t40;
+  uint64_t t44 = t33 ^ t37;
+  uint64_t t45 = t42 ^ t41;
+  uint64_t z0 = t44 & y15;
+  uint64_t z1 = t37 & y6;
+  uint64_t z2 = t33 & x7;
+  uint64_t z3 = t43 & y16;
+  uint64_t z4 = t40 & y1;
+  uint64_t z5 = t29 & y7;
+  uint64_t z6 = t42 & y11;
+  uint64_t z7 = t45 & y17;
+  uint64_t z8 = t41 & y10;
+  uint64_t z9 = t44 & y12;
+  uint64_t z10 = t37 & y3;
+  uint64_t z11 = t33 & y4;
+  uint64_t z12 = t43 & y13;
+  uint64_t z13 = t40 & y5;
+  uint64_t z14 = t29 & y2;
+  uint64_t z15 = t42 & y9;
+  uint64_t z16 = t45 & y14;
+  uint64_t z17 = t41 & y8;
+  uint64_t t46 = z15 ^ z16;
+  uint64_t t47 = z10 ^ z11;
+  uint64_t t48 = z5 ^ z13;
+  uint64_t t49 = z9 ^ z10;
+  uint64_t t50 = z2 ^ z12;
+  uint64_t t51 = z2 ^ z5;
+  uint64_t t52 = z7 ^ z8;
+  uint64_t t53 = z0 ^ z3;
+  uint64_t t54 = z6 ^ z7;
+  uint64_t t55 = z16 ^ z17;
+  uint64_t t56 = z12 ^ t48;
+  uint64_t t57 = t50 ^ t53;
+  uint64_t t58 = z4 ^ t46;
+  uint64_t t59 = z3 ^ t54;
+  uint64_t t60 = t46 ^ t57;
+  uint64_t t61 = z14 ^ t57;
+  uint64_t t62 = t52 ^ t58;
+  uint64_t t63 = t49 ^ t58;
+  uint64_t t64 = z4 ^ t59;
+  uint64_t t65 = t61 ^ t62;
+  uint64_t t66 = z1 ^ t63;
+  uint64_t s0 = t59 ^ t63;
+  uint64_t s6 = t56 ^ ~t62;
+  uint64_t s7 = t48 ^ ~t60;
+  uint64_t t67 = t64 ^ t65;
+  uint64_t s3 = t53 ^ t66;
+  uint64_t s4 = t51 ^ t66;
+  uint64_t s5 = t47 ^ t65;
+  uint64_t s1 = t64 ^ ~s3;
+  uint64_t s2 = t55 ^ ~t67;
+  q[7U] = s0;
+  q[6U] = s1;
+  q[5U] = s2;
+  q[4U] = s3;
+  q[3U] = s4;
+  q[2U] = s5;
+  q[1U] = s6;
+  q[0U] = s7;
+}
+
+static inline uint64_t spread16(uint64_t x)
+{
+  uint64_t x1 = (x | x << (uint32_t)16U) & (uint64_t)0x0000FFFF0000FFFFU;
+  return (x1 | x1 << (uint32_t)8U) & (uint64_t)0x00FF00FF00FF00FFU;
+}
+
+static inline uint32_t unspread16(uint64_t x)
+{
+  uint64_t x1 = (x | x >> (uint32_t)8U) & (uint64_t)0x0000FFFF0000FFFFU;
+  return (uint32_t)x1 | (uint32_t)(x1 >> (uint32_t)16U);
+}
+
+static inline void interleave_in(uint64_t *q0, uint64_t *q1, uint32_t *w)
+{
+  uint64_t x0 = spread16((uint64_t)w[0U]);
+  uint64_t x1 = spread16((uint64_t)w[1U]);
+  uint64_t x2 = spread16((uint64_t)w[2U]);
+  uint64_t x3 = spread16((uint64_t)w[3U]);
+  *q0 = x0 | x2 << (uint32_t)8U;
+  *q1 = x1 | x3 << (uint32_t)8U;
+}
+
+static inline void interleave_out(uint32_t *w, uint64_t q0, uint64_t q1)
+{
+  uint64_t m = (uint64_t)0x00FF00FF00FF00FFU;
+  w[0U] = unspread16(q0 & m);
+  w[1U] = unspread16(q1 & m);
+  w[2U] = unspread16(q0 >> (uint32_t)8U & m);
+  w[3U] = unspread16(q1 >> (uint32_t)8U & m);
+}
+
+static inline void add_round_key(uint64_t *q, uint64_t *sk)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    q[i] = q[i] ^ sk[i];
+  }
+}
+
+static inline void shift_rows(uint64_t *q)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    uint64_t x = q[i];
+    q[i] =
+      (x & (uint64_t)0x000000000000FFFFU)
+      | (x & (uint64_t)0x00000000FFF00000U) >> (uint32_t)4U
+      | (x & (uint64_t)0x00000000000F0000U) << (uint32_t)12U
+      | (x & (uint64_t)0x0000FF0000000000U) >> (uint32_t)8U
+      | (x & (uint64_t)0x000000FF00000000U) << (uint32_t)8U
+      | (x & (uint64_t)0xF000000000000000U) >> (uint32_t)12U
+      | (x & (uint64_t)0x0FFF000000000000U) << (uint32_t)4U;
+  }
+}
+
+static inline uint64_t rotr32(uint64_t x)
+{
+  return x << (uint32_t)32U | x >> (uint32_t)32U;
+}
+
+static inline void mix_columns(uint64_t *q)
+{
+  uint64_t q0 = q[0U];
+  uint64_t q1 = q[1U];
+  uint64_t q2 = q[2U];
+  uint64_t q3 = q[3U];
+  uint64_t q4 = q[4U];
+  uint64_t q5 = q[5U];
+  uint64_t q6 = q[6U];
+  uint64_t q7 = q[7U];
+  uint64_t r0 = q0 >> (uint32_t)16U | q0 << (uint32_t)48U;
+  uint64_t r1 = q1 >> (uint32_t)16U | q1 << (uint32_t)48U;
+  uint64_t r2 = q2 >> (uint32_t)16U | q2 << (uint32_t)48U;
+  uint64_t r3 = q3 >> (uint32_t)16U | q3 << (uint32_t)48U;
+  uint64_t r4 = q4 >> (uint32_t)16U | q4 << (uint32_t)48U;
+  uint64_t r5 = q5 >> (uint32_t)16U | q5 << (uint32_t)48U;
+  uint64_t r6 = q6 >> (uint32_t)16U | q6 << (uint32_t)48U;
+  uint64_t r7 = q7 >> (uint32_t)16U | q7 << (uint32_t)48U;
+  q[0U] = q7 ^ r7 ^ r0 ^ rotr32(q0 ^ r0);
+  q[1U] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ rotr32(q1 ^ r1);
+  q[2U] = q1 ^ r1 ^ r2 ^ rotr32(q2 ^ r2);
+  q[3U] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ rotr32(q3 ^ r3);
+  q[4U] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ rotr32(q4 ^ r4);
+  q[5U] = q4 ^ r4 ^ r5 ^ rotr32(q5 ^ r5);
+  q[6U] = q5 ^ r5 ^ r6 ^ rotr32(q6 ^ r6);
+  q[7U] = q6 ^ r6 ^ r7 ^ rotr32(q7 ^ r7);
+}
+
+static void aes_rounds(uint32_t nr, uint64_t *skey, uint64_t *q)
+{
+  add_round_key(q, skey);
+  for (uint32_t i = (uint32_t)1U; i < nr; i++)
+  {
+    sub_bytes(q);
+    shift_rows(q);
+    mix_columns(q);
+    add_round_key(q, skey + i * (uint32_t)8U);
+  }
+  sub_bytes(q);
+  shift_rows(q);
+  add_round_key(q, skey + nr * (uint32_t)8U);
+}
+
+/* Encrypts the four blocks held in w, as little-endian words, in place. */
+static void aes_encrypt4(uint32_t nr, uint64_t *skey, uint32_t *w)
+{
+  uint64_t q[8U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    interleave_in(q + i, q + i + (uint32_t)4U, w + i * (uint32_t)4U);
+  }
+  ortho(q);
+  aes_rounds(nr, skey, q);
+  ortho(q);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    interleave_out(w + i * (uint32_t)4U, q[i], q[i + (uint32_t)4U]);
+  }
+}
+
+static uint32_t sub_word(uint32_t x)
+{
+  uint64_t q[8U] = { 0U };
+  q[0U] = (uint64_t)x;
+  ortho(q);
+  sub_bytes(q);
+  ortho(q);
+  return (uint32_t)q[0U];
+}
+
+static void key_expansion(uint32_t nk, uint32_t nr, uint8_t *key, uint64_t *skey)
+{
+  uint8_t rcon[10U] = { 0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U, 0x1bU, 0x36U };
+  uint32_t w[60U] = { 0U };
+  uint32_t nw = (nr + (uint32_t)1U) * (uint32_t)4U;
+  for (uint32_t i = (uint32_t)0U; i < nk; i++)
+  {
+    w[i] = load32_le(key + i * (uint32_t)4U);
+  }
+  uint32_t tmp = w[nk - (uint32_t)1U];
+  uint32_t j = (uint32_t)0U;
+  uint32_t k = (uint32_t)0U;
+  for (uint32_t i = nk; i < nw; i++)
+  {
+    if (j == (uint32_t)0U)
+    {
+      tmp = tmp << (uint32_t)24U | tmp >> (uint32_t)8U;
+      tmp = sub_word(tmp) ^ (uint32_t)rcon[k];
+    }
+    else if (nk > (uint32_t)6U && j == (uint32_t)4U)
+    {
+      tmp = sub_word(tmp);
+    }
+    tmp = tmp ^ w[i - nk];
+    w[i] = tmp;
+    j++;
+    if (j == nk)
+    {
+      j = (uint32_t)0U;
+      k++;
+    }
+  }
+  /* Bitslice each round key, replicated in the four block positions. */
+  for (uint32_t i = (uint32_t)0U; i < nw; i = i + (uint32_t)4U)
+  {
+    uint64_t q[8U] = { 0U };
+    interleave_in(q, q + (uint32_t)4U, w + i);
+    q[1U] = q[0U];
+    q[2U] = q[0U];
+    q[3U] = q[0U];
+    q[5U] = q[4U];
+    q[6U] = q[4U];
+    q[7U] = q[4U];
+    ortho(q);
+    uint64_t *sk = skey + i * (uint32_t)2U;
+    for (uint32_t h = (uint32_t)0U; h < (uint32_t)2U; h++)
+    {
+      uint64_t *qh = q + h * (uint32_t)4U;
+      uint64_t x0 = qh[0U] & (uint64_t)0x1111111111111111U;
+      uint64_t x1 = (qh[1U] & (uint64_t)0x2222222222222222U) >> (uint32_t)1U;
+      uint64_t x2 = (qh[2U] & (uint64_t)0x4444444444444444U) >> (uint32_t)2U;
+      uint64_t x3 = (qh[3U] & (uint64_t)0x8888888888888888U) >> (uint32_t)3U;
+      sk[h * (uint32_t)4U] = (x0 << (uint32_t)4U) - x0;
+      sk[h * (uint32_t)4U + (uint32_t)1U] = (x1 << (uint32_t)4U) - x1;
+      sk[h * (uint32_t)4U + (uint32_t)2U] = (x2 << (uint32_t)4U) - x2;
+      sk[h * (uint32_t)4U + (uint32_t)3U] = (x3 << (uint32_t)4U) - x3;
+    }
+  }
+}
+
+static inline uint32_t bswap32(uint32_t x)
+{
+  return
+    x
+    << (uint32_t)24U
+    | (x & (uint32_t)0xff00U) << (uint32_t)8U
+    | (x >> (uint32_t)8U & (uint32_t)0xff00U)
+    | x >> (uint32_t)24U;
+}
+
+/* Keystream for the counter blocks iv || ctr, ..., iv || ctr + 3. */
+static void keystream4(uint32_t nr, uint64_t *skey, uint32_t *ivw, uint32_t ctr, uint8_t *ks)
+{
+  uint32_t w[16U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    w[i * (uint32_t)4U] = ivw[0U];
+    w[i * (uint32_t)4U + (uint32_t)1U] = ivw[1U];
+    w[i * (uint32_t)4U + (uint32_t)2U] = ivw[2U];
+    w[i * (uint32_t)4U + (uint32_t)3U] = bswap32(ctr + i);
+  }
+  aes_encrypt4(nr, skey, w);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    store32_le(ks + i * (uint32_t)4U, w[i]);
+  }
+}
+
+static inline void xor_bytes(uint8_t *out, uint8_t *in, uint8_t *ks, uint32_t len)
+{
+  for (uint32_t i = (uint32_t)0U; i < len; i++)
+  {
+    out[i] = in[i] ^ ks[i];
+  }
+}
+
+/*
+  CTR encryption from counter ctr + 1, given ks0, the keystream of the pass
+  starting at ctr (whose first block is the tag mask).
+*/
+static void
+ctr_from(
+  uint32_t nr,
+  uint64_t *skey,
+  uint32_t *ivw,
+  uint32_t ctr,
+  uint8_t *ks0,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+)
+{
+  uint32_t n0 = len;
+  if (n0 > (uint32_t)48U)
+  {
+    n0 = (uint32_t)48U;
+  }
+  xor_bytes(out, in, ks0 + (uint32_t)16U, n0);
+  uint8_t ks[64U] = { 0U };
+  uint32_t c = ctr + (uint32_t)4U;
+  for (uint32_t pos = n0; pos < len; pos = pos + (uint32_t)64U)
+  {
+    keystream4(nr, skey, ivw, c, ks);
+    uint32_t n = len - pos;
+    if (n > (uint32_t)64U)
+    {
+      n = (uint32_t)64U;
+    }
+    xor_bytes(out + pos, in + pos, ks, n);
+    c = c + (uint32_t)4U;
+  }
+}
+
+/* GHASH: GF(2^128) multiplication with masked integer products. */
+
+static inline uint64_t bmul64(uint64_t x, uint64_t y)
+{
+  uint64_t m0 = (uint64_t)0x1111111111111111U;
+  uint64_t m1 = (uint64_t)0x2222222222222222U;
+  uint64_t m2 = (uint64_t)0x4444444444444444U;
+  uint64_t m3 = (uint64_t)0x8888888888888888U;
+  uint64_t x0 = x & m0;
+  uint64_t x1 = x & m1;
+  uint64_t x2 = x & m2;
+  uint64_t x3 = x & m3;
+  uint64_t y0 = y & m0;
+  uint64_t y1 = y & m1;
+  uint64_t y2 = y & m2;
+  uint64_t y3 = y & m3;
+  uint64_t z0 = (x0 * y0 ^ x1 * y3 ^ x2 * y2 ^ x3 * y1) & m0;
+  uint64_t z1 = (x0 * y1 ^ x1 * y0 ^ x2 * y3 ^ x3 * y2) & m1;
+  uint64_t z2 = (x0 * y2 ^ x1 * y1 ^ x2 * y0 ^ x3 * y3) & m2;
+  uint64_t z3 = (x0 * y3 ^ x1 * y2 ^ x2 * y1 ^ x3 * y0) & m3;
+  return z0 | z1 | z2 | z3;
+}
+
+static inline uint64_t rev64(uint64_t x)
+{
+  uint64_t x1 =
+    (x & (uint64_t)0x5555555555555555U)
+    << (uint32_t)1U
+    | (x >> (uint32_t)1U & (uint64_t)0x5555555555555555U);
+  uint64_t x2 =
+    (x1 & (uint64_t)0x3333333333333333U)
+    << (uint32_t)2U
+    | (x1 >> (uint32_t)2U & (uint64_t)0x3333333333333333U);
+  uint64_t x3 =
+    (x2 & (uint64_t)0x0F0F0F0F0F0F0F0FU)
+    << (uint32_t)4U
+    | (x2 >> (uint32_t)4U & (uint64_t)0x0F0F0F0F0F0F0F0FU);
+  uint64_t x4 =
+    (x3 & (uint64_t)0x00FF00FF00FF00FFU)
+    << (uint32_t)8U
+    | (x3 >> (uint32_t)8U & (uint64_t)0x00FF00FF00FF00FFU);
+  uint64_t x5 =
+    (x4 & (uint64_t)0x0000FFFF0000FFFFU)
+    << (uint32_t)16U
+    | (x4 >> (uint32_t)16U & (uint64_t)0x0000FFFF0000FFFFU);
+  return x5 << (uint32_t)32U | x5 >> (uint32_t)32U;
+}
+
+/* y = (y1, y0) := y * H, where gh = [h0; h1; h0 ^ h1; rev h0; rev h1; rev h0 ^ rev h1] */
+static inline void gf128_mul(uint64_t *gh, uint64_t *y)
+{
+  uint64_t y1 = y[0U];
+  uint64_t y0 = y[1U];
+  uint64_t y0r = rev64(y0);
+  uint64_t y1r = rev64(y1);
+  uint64_t y2 = y0 ^ y1;
+  uint64_t y2r = y0r ^ y1r;
+  uint64_t z0 = bmul64(y0, gh[0U]);
+  uint64_t z1 = bmul64(y1, gh[1U]);
+  uint64_t z2 = bmul64(y2, gh[2U]);
+  uint64_t z0h = bmul64(y0r, gh[3U]);
+  uint64_t z1h = bmul64(y1r, gh[4U]);
+  uint64_t z2h = bmul64(y2r, gh[5U]);
+  z2 = z2 ^ (z0 ^ z1);
+  z2h = z2h ^ (z0h ^ z1h);
+  z0h = rev64(z0h) >> (uint32_t)1U;
+  z1h = rev64(z1h) >> (uint32_t)1U;
+  z2h = rev64(z2h) >> (uint32_t)1U;
+  uint64_t v0 = z0;
+  uint64_t v1 = z0h ^ z2;
+  uint64_t v2 = z1 ^ z2h;
+  uint64_t v3 = z1h;
+  v3 = v3 << (uint32_t)1U | v2 >> (uint32_t)63U;
+  v2 = v2 << (uint32_t)1U | v1 >> (uint32_t)63U;
+  v1 = v1 << (uint32_t)1U | v0 >> (uint32_t)63U;
+  v0 = v0 << (uint32_t)1U;
+  v2 = v2 ^ (v0 ^ v0 >> (uint32_t)1U ^ v0 >> (uint32_t)2U ^ v0 >> (uint32_t)7U);
+  v1 = v1 ^ (v0 << (uint32_t)63U ^ v0 << (uint32_t)62U ^ v0 << (uint32_t)57U);
+  v3 = v3 ^ (v1 ^ v1 >> (uint32_t)1U ^ v1 >> (uint32_t)2U ^ v1 >> (uint32_t)7U);
+  v2 = v2 ^ (v1 << (uint32_t)63U ^ v1 << (uint32_t)62U ^ v1 << (uint32_t)57U);
+  y[0U] = v3;
+  y[1U] = v2;
+}
+
+/* Absorbs len bytes of data, the last block padded with zeros. */
+static void ghash(uint64_t *gh, uint64_t *y, uint32_t len, uint8_t *data)
+{
+  uint32_t nb = len / (uint32_t)16U;
+  uint32_t rem = len % (uint32_t)16U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    uint8_t *b = data + i * (uint32_t)16U;
+    y[0U] = y[0U] ^ load64_be(b);
+    y[1U] = y[1U] ^ load64_be(b + (uint32_t)8U);
+    gf128_mul(gh, y);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    uint8_t b[16U] = { 0U };
+    memcpy(b, data + nb * (uint32_t)16U, rem * sizeof (uint8_t));
+    y[0U] = y[0U] ^ load64_be(b);
+    y[1U] = y[1U] ^ load64_be(b + (uint32_t)8U);
+    gf128_mul(gh, y);
+  }
+}
+
+static void gcm_init(uint32_t nk, uint32_t nr, uint64_t *ctx, uint8_t *key)
+{
+  uint64_t *skey = ctx;
+  uint64_t *gh = ctx + (nr + (uint32_t)1U) * (uint32_t)8U;
+  key_expansion(nk, nr, key, skey);
+  uint32_t w[16U] = { 0U };
+  aes_encrypt4(nr, skey, w);
+  uint8_t h[16U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    store32_le(h + i * (uint32_t)4U, w[i]);
+  }
+  uint64_t h1 = load64_be(h);
+  uint64_t h0 = load64_be(h + (uint32_t)8U);
+  gh[0U] = h0;
+  gh[1U] = h1;
+  gh[2U] = h0 ^ h1;
+  gh[3U] = rev64(h0);
+  gh[4U] = rev64(h1);
+  gh[5U] = gh[3U] ^ gh[4U];
+}
+
+/* Splits the pre-counter block J0 into its first 12 bytes and its counter. */
+static uint32_t gcm_j0(uint64_t *gh, uint32_t iv_len, uint8_t *iv, uint32_t *ivw)
+{
+  if (iv_len == (uint32_t)12U)
+  {
+    ivw[0U] = load32_le(iv);
+    ivw[1U] = load32_le(iv + (uint32_t)4U);
+    ivw[2U] = load32_le(iv + (uint32_t)8U);
+    return (uint32_t)1U;
+  }
+  uint64_t y[2U] = { 0U };
+  ghash(gh, y, iv_len, iv);
+  y[1U] = y[1U] ^ (uint64_t)iv_len * (uint64_t)8U;
+  gf128_mul(gh, y);
+  uint8_t j0[16U] = { 0U };
+  store64_be(j0, y[0U]);
+  store64_be(j0 + (uint32_t)8U, y[1U]);
+  ivw[0U] = load32_le(j0);
+  ivw[1U] = load32_le(j0 + (uint32_t)4U);
+  ivw[2U] = load32_le(j0 + (uint32_t)8U);
+  return load32_be(j0 + (uint32_t)12U);
+}
+
+static void
+gcm_tag(
+  uint64_t *gh,
+  uint8_t *mask,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t len,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  uint64_t y[2U] = { 0U };
+  ghash(gh, y, aadlen, aad);
+  ghash(gh, y, len, cipher);
+  y[0U] = y[0U] ^ (uint64_t)aadlen * (uint64_t)8U;
+  y[1U] = y[1U] ^ (uint64_t)len * (uint64_t)8U;
+  gf128_mul(gh, y);
+  store64_be(tag, y[0U]);
+  store64_be(tag + (uint32_t)8U, y[1U]);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    tag[i] = tag[i] ^ mask[i];
+  }
+}
+
+static void
+gcm_encrypt(
+  uint32_t nr,
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  uint64_t *skey = ctx;
+  uint64_t *gh = ctx + (nr + (uint32_t)1U) * (uint32_t)8U;
+  uint32_t ivw[3U] = { 0U };
+  uint32_t ctr = gcm_j0(gh, iv_len, iv, ivw);
+  uint8_t ks0[64U] = { 0U };
+  keystream4(nr, skey, ivw, ctr, ks0);
+  ctr_from(nr, skey, ivw, ctr, ks0, mlen, m, cipher);
+  gcm_tag(gh, ks0, aadlen, aad, mlen, cipher, tag);
+}
+
+static uint32_t
+gcm_decrypt(
+  uint32_t nr,
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  uint64_t *skey = ctx;
+  uint64_t *gh = ctx + (nr + (uint32_t)1U) * (uint32_t)8U;
+  uint32_t ivw[3U] = { 0U };
+  uint32_t ctr = gcm_j0(gh, iv_len, iv, ivw);
+  uint8_t ks0[64U] = { 0U };
+  keystream4(nr, skey, ivw, ctr, ks0);
+  uint8_t computed_tag[16U] = { 0U };
+  gcm_tag(gh, ks0, aadlen, aad, mlen, cipher, computed_tag);
+  uint8_t res = (uint8_t)255U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    uint8_t uu____0 = FStar_UInt8_eq_mask(computed_tag[i], tag[i]);
+    res = uu____0 & res;
+  }
+  uint8_t z = res;
+  if (z == (uint8_t)255U)
+  {
+    ctr_from(nr, skey, ivw, ctr, ks0, mlen, cipher, m);
+    return (uint32_t)0U;
+  }
+  return (uint32_t)1U;
+}
+
+/* Pieces of AES-GCM, on a counter block and an accumulator held by the caller. */
+
+static void gcm_ctr(uint32_t nr, uint64_t *ctx, uint8_t *ctr, uint32_t len, uint8_t *in, uint8_t *out)
+{
+  uint32_t ivw[3U] = { 0U };
+  ivw[0U] = load32_le(ctr);
+  ivw[1U] = load32_le(ctr + (uint32_t)4U);
+  ivw[2U] = load32_le(ctr + (uint32_t)8U);
+  uint32_t c = load32_be(ctr + (uint32_t)12U);
+  uint8_t ks[64U] = { 0U };
+  for (uint32_t pos = (uint32_t)0U; pos < len; pos = pos + (uint32_t)64U)
+  {
+    keystream4(nr, ctx, ivw, c, ks);
+    uint32_t n = len - pos;
+    if (n > (uint32_t)64U)
+    {
+      n = (uint32_t)64U;
+    }
+    xor_bytes(out + pos, in + pos, ks, n);
+    c = c + (uint32_t)4U;
+  }
+}
+
+static void gcm_ghash(uint32_t nr, uint64_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text)
+{
+  uint64_t *gh = ctx + (nr + (uint32_t)1U) * (uint32_t)8U;
+  uint64_t y[2U] = { 0U };
+  y[0U] = load64_be(acc);
+  y[1U] = load64_be(acc + (uint32_t)8U);
+  ghash(gh, y, len, text);
+  store64_be(acc, y[0U]);
+  store64_be(acc + (uint32_t)8U, y[1U]);
+}
+
+static void ecb(uint32_t nr, uint64_t *ctx, uint32_t n, uint8_t **in, uint8_t *out)
+{
+  for (uint32_t i = (uint32_t)0U; i < n; i = i + (uint32_t)4U)
+  {
+    uint32_t w[16U] = { 0U };
+    uint32_t m = n - i;
+    if (m > (uint32_t)4U)
+    {
+      m = (uint32_t)4U;
+    }
+    for (uint32_t j = (uint32_t)0U; j < m; j++)
+    {
+      for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+      {
+        w[j * (uint32_t)4U + k] = load32_le(in[i + j] + k * (uint32_t)4U);
+      }
+    }
+    aes_encrypt4(nr, ctx, w);
+    for (uint32_t j = (uint32_t)0U; j < m * (uint32_t)4U; j++)
+    {
+      store32_le(out + i * (uint32_t)16U + j * (uint32_t)4U, w[j]);
+    }
+  }
+}
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes128_init(uint64_t *ctx, uint8_t *key)
+{
+  gcm_init((uint32_t)4U, (uint32_t)10U, ctx, key);
+}
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes256_init(uint64_t *ctx, uint8_t *key)
+{
+  gcm_init((uint32_t)8U, (uint32_t)14U, ctx, key);
+}
+
+void
+EverCrypt_Unverified_AES_GCM_CT64_aes128_encrypt(
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  gcm_encrypt((uint32_t)10U, ctx, iv_len, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+uint32_t
+EverCrypt_Unverified_AES_GCM_CT64_aes128_decrypt(
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  return gcm_decrypt((uint32_t)10U, ctx, iv_len, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+void
+EverCrypt_Unverified_AES_GCM_CT64_aes256_encrypt(
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  gcm_encrypt((uint32_t)14U, ctx, iv_len, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+uint32_t
+EverCrypt_Unverified_AES_GCM_CT64_aes256_decrypt(
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  return gcm_decrypt((uint32_t)14U, ctx, iv_len, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+void
+EverCrypt_Unverified_AES_GCM_CT64_aes128_ctr(
+  uint64_t *ctx,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+)
+{
+  gcm_ctr((uint32_t)10U, ctx, ctr, len, in, out);
+}
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes128_ghash(uint64_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text)
+{
+  gcm_ghash((uint32_t)10U, ctx, acc, len, text);
+}
+
+void
+EverCrypt_Unverified_AES_GCM_CT64_aes256_ctr(
+  uint64_t *ctx,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+)
+{
+  gcm_ctr((uint32_t)14U, ctx, ctr, len, in, out);
+}
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes256_ghash(uint64_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text)
+{
+  gcm_ghash((uint32_t)14U, ctx, acc, len, text);
+}
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes128_ecb(uint64_t *ctx, uint32_t n, uint8_t **in, uint8_t *out)
+{
+  ecb((uint32_t)10U, ctx, n, in, out);
+}
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes256_ecb(uint64_t *ctx, uint32_t n, uint8_t **in, uint8_t *out)
+{
+  ecb((uint32_t)14U, ctx, n, in, out);
+}
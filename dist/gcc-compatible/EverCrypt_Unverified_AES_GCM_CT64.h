@@ -0,0 +1,159 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __EverCrypt_Unverified_AES_GCM_CT64_H
+#define __EverCrypt_Unverified_AES_GCM_CT64_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+
+/*
+  Portable, constant-time AES-GCM.
+
+  AES is bitsliced over 64-bit words: four blocks go through each pass of the
+  round function, without any secret-dependent table lookup or branch. GHASH
+  multiplies in GF(2^128) with integer multiplications whose carries are
+  masked out, so no carry-less multiplication instruction is needed.
+
+  A context holds the expanded round keys followed by the GHASH key; it is
+  only read by encrypt and decrypt and may be shared between threads. Its size
+  in uint64_t is EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len (resp. aes256).
+
+  This implementation is hand-written C that follows the layout of the
+  generated code; it is not extracted from F* and carries no proof. It is
+  tested against the verified Vale AES-GCM.
+*/
+
+extern uint32_t EverCrypt_Unverified_AES_GCM_CT64_aes128_ctx_len;
+
+extern uint32_t EverCrypt_Unverified_AES_GCM_CT64_aes256_ctx_len;
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes128_init(uint64_t *ctx, uint8_t *key);
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes256_init(uint64_t *ctx, uint8_t *key);
+
+void
+EverCrypt_Unverified_AES_GCM_CT64_aes128_encrypt(
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+/*
+  Returns 0 and writes the plaintext to m if the tag is valid; returns 1 and
+  leaves m untouched otherwise.
+*/
+uint32_t
+EverCrypt_Unverified_AES_GCM_CT64_aes128_decrypt(
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+void
+EverCrypt_Unverified_AES_GCM_CT64_aes256_encrypt(
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+uint32_t
+EverCrypt_Unverified_AES_GCM_CT64_aes256_decrypt(
+  uint64_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+/*
+  Pieces of AES-GCM, with the same contract as Hacl_AES_GCM_VAES_aes128_ctr
+  and Hacl_AES_GCM_VAES_aes128_ghash.
+*/
+void
+EverCrypt_Unverified_AES_GCM_CT64_aes128_ctr(
+  uint64_t *ctx,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+);
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes128_ghash(uint64_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text);
+
+void
+EverCrypt_Unverified_AES_GCM_CT64_aes256_ctr(
+  uint64_t *ctx,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+);
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes256_ghash(uint64_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text);
+
+/* Same contract as Hacl_AES_GCM_VAES_aes128_ecb */
+void EverCrypt_Unverified_AES_GCM_CT64_aes128_ecb(uint64_t *ctx, uint32_t n, uint8_t **in, uint8_t *out);
+
+void EverCrypt_Unverified_AES_GCM_CT64_aes256_ecb(uint64_t *ctx, uint32_t n, uint8_t **in, uint8_t *out);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __EverCrypt_Unverified_AES_GCM_CT64_H_DEFINED
+#endif
@@ -0,0 +1,1037 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#include "Hacl_AES_GCM_VAES.h"
+
+#include "Hacl_Impl_Gf128_NI.h"
+
+/*
+  Byte order: GHASH is computed on byte-reversed blocks, see
+  Hacl_Impl_Gf128_NI.h. Counters are kept byte-reversed too, so that inc32 is
+  a 32-bit lane add.
+*/
+
+uint32_t Hacl_AES_GCM_VAES_aes128_ctx_len = (uint32_t)432U;
+
+uint32_t Hacl_AES_GCM_VAES_aes256_ctx_len = (uint32_t)496U;
+
+static inline __m512i bswap512(__m512i x)
+{
+  return
+    _mm512_shuffle_epi8(x,
+      _mm512_broadcast_i32x4(_mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+}
+
+static inline __m512i xor3(__m512i a, __m512i b, __m512i c)
+{
+  return _mm512_ternarylogic_epi64(a, b, c, 0x96);
+}
+
+/* Key schedule */
+
+static inline __m128i expand_step(__m128i k, __m128i t)
+{
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  return _mm_xor_si128(k, t);
+}
+
+#define EXPAND_1(rk, i, rcon) \
+  rk[i] = \
+    expand_step(rk[(i) - 1U], \
+      _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[(i) - 1U], rcon), 0xff))
+
+#define EXPAND_2(rk, i, rcon) \
+  rk[i] = \
+    expand_step(rk[(i) - 2U], \
+      _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[(i) - 1U], rcon), 0xff))
+
+#define EXPAND_2_ODD(rk, i) \
+  rk[i] = \
+    expand_step(rk[(i) - 2U], \
+      _mm_shuffle_epi32(_mm_aeskeygenassist_si128(rk[(i) - 1U], 0x00), 0xaa))
+
+static void key_expansion128(uint8_t *ctx, uint8_t *key)
+{
+  __m128i rk[11U];
+  rk[0U] = _mm_loadu_si128((const __m128i *)key);
+  EXPAND_1(rk, 1U, 0x01);
+  EXPAND_1(rk, 2U, 0x02);
+  EXPAND_1(rk, 3U, 0x04);
+  EXPAND_1(rk, 4U, 0x08);
+  EXPAND_1(rk, 5U, 0x10);
+  EXPAND_1(rk, 6U, 0x20);
+  EXPAND_1(rk, 7U, 0x40);
+  EXPAND_1(rk, 8U, 0x80);
+  EXPAND_1(rk, 9U, 0x1b);
+  EXPAND_1(rk, 10U, 0x36);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)11U; i++)
+  {
+    _mm_storeu_si128((__m128i *)(ctx + i * (uint32_t)16U), rk[i]);
+  }
+}
+
+static void key_expansion256(uint8_t *ctx, uint8_t *key)
+{
+  __m128i rk[15U];
+  rk[0U] = _mm_loadu_si128((const __m128i *)key);
+  rk[1U] = _mm_loadu_si128((const __m128i *)(key + (uint32_t)16U));
+  EXPAND_2(rk, 2U, 0x01);
+  EXPAND_2_ODD(rk, 3U);
+  EXPAND_2(rk, 4U, 0x02);
+  EXPAND_2_ODD(rk, 5U);
+  EXPAND_2(rk, 6U, 0x04);
+  EXPAND_2_ODD(rk, 7U);
+  EXPAND_2(rk, 8U, 0x08);
+  EXPAND_2_ODD(rk, 9U);
+  EXPAND_2(rk, 10U, 0x10);
+  EXPAND_2_ODD(rk, 11U);
+  EXPAND_2(rk, 12U, 0x20);
+  EXPAND_2_ODD(rk, 13U);
+  EXPAND_2(rk, 14U, 0x40);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)15U; i++)
+  {
+    _mm_storeu_si128((__m128i *)(ctx + i * (uint32_t)16U), rk[i]);
+  }
+}
+
+/* AES rounds: one block, or sixteen blocks in four registers */
+
+static inline __m128i aes_block(uint8_t *ctx, uint32_t nr, __m128i b)
+{
+  b = _mm_xor_si128(b, _mm_loadu_si128((const __m128i *)ctx));
+  for (uint32_t i = (uint32_t)1U; i < nr; i++)
+  {
+    b = _mm_aesenc_si128(b, _mm_loadu_si128((const __m128i *)(ctx + i * (uint32_t)16U)));
+  }
+  return _mm_aesenclast_si128(b, _mm_loadu_si128((const __m128i *)(ctx + nr * (uint32_t)16U)));
+}
+
+static inline void aes_x16(__m512i *rk, uint32_t nr, __m512i *b)
+{
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    b[j] = _mm512_xor_si512(b[j], rk[0U]);
+  }
+  for (uint32_t i = (uint32_t)1U; i < nr; i++)
+  {
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      b[j] = _mm512_aesenc_epi128(b[j], rk[i]);
+    }
+  }
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    b[j] = _mm512_aesenclast_epi128(b[j], rk[nr]);
+  }
+}
+
+static inline void load_round_keys(uint8_t *ctx, uint32_t nr, __m512i *rk)
+{
+  for (uint32_t i = (uint32_t)0U; i <= nr; i++)
+  {
+    rk[i] = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(ctx + i * (uint32_t)16U)));
+  }
+}
+
+/* Counter blocks i + 1, i + 2, i + 3 and i + 4 of a byte-reversed counter i */
+static inline __m512i ctr_init(__m128i j0)
+{
+  return
+    _mm512_add_epi32(_mm512_broadcast_i32x4(j0),
+      _mm512_set_epi32(0, 0, 0, 4, 0, 0, 0, 3, 0, 0, 0, 2, 0, 0, 0, 1));
+}
+
+static inline void ctr_next16(__m512i *ctr, __m512i *b)
+{
+  __m512i four = _mm512_set_epi32(0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4);
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    b[j] = bswap512(*ctr);
+    *ctr = _mm512_add_epi32(*ctr, four);
+  }
+}
+
+/* GHASH */
+
+static inline __m128i gf128_mul(__m128i a, __m128i b)
+{
+  __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+  __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+  __m128i
+  mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x01), _mm_clmulepi64_si128(a, b, 0x10));
+  return Hacl_Impl_Gf128_NI_reduce(lo, mid, hi);
+}
+
+static inline __m128i hxor(__m512i v)
+{
+  __m256i
+  t = _mm256_xor_si256(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1));
+  return _mm_xor_si128(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1));
+}
+
+/* Accumulates the unreduced products of four blocks with four key powers */
+static inline void
+mul_acc(__m512i *lo, __m512i *mid, __m512i *hi, __m512i d, __m512i h)
+{
+  *lo = _mm512_xor_si512(*lo, _mm512_clmulepi64_epi128(d, h, 0x00));
+  *hi = _mm512_xor_si512(*hi, _mm512_clmulepi64_epi128(d, h, 0x11));
+  *mid = xor3(*mid, _mm512_clmulepi64_epi128(d, h, 0x01), _mm512_clmulepi64_epi128(d, h, 0x10));
+}
+
+/*
+  Folds sixteen byte-reversed blocks d[0..3] into acc; hp[j] holds the powers
+  H^(16-4j) .. H^(13-4j).
+*/
+static inline __m128i ghash16(__m512i *hp, __m128i acc, __m512i *d)
+{
+  __m512i lo = _mm512_setzero_si512();
+  __m512i mid = _mm512_setzero_si512();
+  __m512i hi = _mm512_setzero_si512();
+  __m512i d0 = _mm512_xor_si512(d[0U], _mm512_inserti32x4(_mm512_setzero_si512(), acc, 0));
+  mul_acc(&lo, &mid, &hi, d0, hp[0U]);
+  mul_acc(&lo, &mid, &hi, d[1U], hp[1U]);
+  mul_acc(&lo, &mid, &hi, d[2U], hp[2U]);
+  mul_acc(&lo, &mid, &hi, d[3U], hp[3U]);
+  return Hacl_Impl_Gf128_NI_reduce(hxor(lo), hxor(mid), hxor(hi));
+}
+
+static inline __mmask64 byte_mask(uint32_t len)
+{
+  if (len >= (uint32_t)64U)
+  {
+    return (__mmask64)0xffffffffffffffffULL;
+  }
+  return (__mmask64)(((uint64_t)1U << len) - (uint64_t)1U);
+}
+
+/*
+  Folds len bytes into acc, the last block being zero-padded. Each chunk of up
+  to sixteen blocks costs one reduction: with n blocks in the chunk, block i is
+  multiplied by H^(n-i), read from the table of powers at offset 16 - n.
+*/
+static __m128i ghash_bytes(uint8_t *tab, __m128i acc, uint8_t *p, uint32_t len)
+{
+  while (len > (uint32_t)0U)
+  {
+    uint32_t chunk = len;
+    if (chunk > (uint32_t)256U)
+    {
+      chunk = (uint32_t)256U;
+    }
+    uint32_t n = (chunk + (uint32_t)15U) / (uint32_t)16U;
+    uint8_t *h = tab + ((uint32_t)16U - n) * (uint32_t)16U;
+    __m512i lo = _mm512_setzero_si512();
+    __m512i mid = _mm512_setzero_si512();
+    __m512i hi = _mm512_setzero_si512();
+    for (uint32_t j = (uint32_t)0U; j * (uint32_t)4U < n; j++)
+    {
+      uint32_t nb = n - j * (uint32_t)4U;
+      if (nb > (uint32_t)4U)
+      {
+        nb = (uint32_t)4U;
+      }
+      __mmask8 kh = (__mmask8)(((uint32_t)1U << (uint32_t)2U * nb) - (uint32_t)1U);
+      __m512i
+      d =
+        bswap512(_mm512_maskz_loadu_epi8(byte_mask(chunk - j * (uint32_t)64U),
+            p + j * (uint32_t)64U));
+      if (j == (uint32_t)0U)
+      {
+        d = _mm512_xor_si512(d, _mm512_inserti32x4(_mm512_setzero_si512(), acc, 0));
+      }
+      mul_acc(&lo, &mid, &hi, d, _mm512_maskz_loadu_epi64(kh, h + j * (uint32_t)64U));
+    }
+    acc = Hacl_Impl_Gf128_NI_reduce(hxor(lo), hxor(mid), hxor(hi));
+    p = p + chunk;
+    len = len - chunk;
+  }
+  return acc;
+}
+
+static void gcm_init(uint8_t *ctx, uint32_t nr)
+{
+  uint8_t *tab = ctx + (nr + (uint32_t)1U) * (uint32_t)16U;
+  __m128i
+  h = Hacl_Impl_Gf128_NI_mul_x(Hacl_Impl_Gf128_NI_bswap128(aes_block(ctx, nr, _mm_setzero_si128())));
+  __m128i p = h;
+  _mm_storeu_si128((__m128i *)(tab + (uint32_t)240U), h);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)16U; i++)
+  {
+    p = gf128_mul(p, h);
+    _mm_storeu_si128((__m128i *)(tab + ((uint32_t)15U - i) * (uint32_t)16U), p);
+  }
+}
+
+/* Returns the byte-reversed pre-counter block J0 */
+static inline __m128i gcm_j0(uint8_t *tab, uint32_t iv_len, uint8_t *iv)
+{
+  if (iv_len == (uint32_t)12U)
+  {
+    uint8_t b[16U] = { 0U };
+    memcpy(b, iv, (uint32_t)12U * sizeof (uint8_t));
+    b[15U] = (uint8_t)1U;
+    return Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)b));
+  }
+  __m128i acc = ghash_bytes(tab, _mm_setzero_si128(), iv, iv_len);
+  acc = _mm_xor_si128(acc, _mm_set_epi64x((int64_t)0, (int64_t)((uint64_t)iv_len * (uint64_t)8U)));
+  return gf128_mul(acc, _mm_loadu_si128((const __m128i *)(tab + (uint32_t)240U)));
+}
+
+static inline __m128i
+gcm_tag(uint8_t *ctx, uint32_t nr, __m128i j0, __m128i acc, uint32_t aadlen, uint32_t mlen)
+{
+  uint8_t *tab = ctx + (nr + (uint32_t)1U) * (uint32_t)16U;
+  __m128i
+  len =
+    _mm_set_epi64x((int64_t)((uint64_t)aadlen * (uint64_t)8U),
+      (int64_t)((uint64_t)mlen * (uint64_t)8U));
+  acc =
+    gf128_mul(_mm_xor_si128(acc, len),
+      _mm_loadu_si128((const __m128i *)(tab + (uint32_t)240U)));
+  return
+    _mm_xor_si128(aes_block(ctx, nr, Hacl_Impl_Gf128_NI_bswap128(j0)),
+      Hacl_Impl_Gf128_NI_bswap128(acc));
+}
+
+/* Encrypts the last mlen < 256 bytes with counters ctr, ctr + 1, ... */
+static inline void
+ctr_tail(__m512i *rk, uint32_t nr, __m512i ctr, uint32_t mlen, uint8_t *m, uint8_t *out)
+{
+  __m512i b[4U];
+  ctr_next16(&ctr, b);
+  aes_x16(rk, nr, b);
+  for (uint32_t j = (uint32_t)0U; j * (uint32_t)64U < mlen; j++)
+  {
+    __mmask64 k = byte_mask(mlen - j * (uint32_t)64U);
+    __m512i x = _mm512_maskz_loadu_epi8(k, m + j * (uint32_t)64U);
+    _mm512_mask_storeu_epi8(out + j * (uint32_t)64U, k, _mm512_xor_si512(x, b[j]));
+  }
+}
+
+static inline void
+gcm_encrypt(
+  uint8_t *ctx,
+  uint32_t nr,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  uint8_t *tab = ctx + (nr + (uint32_t)1U) * (uint32_t)16U;
+  __m512i rk[15U];
+  __m512i hp[4U];
+  load_round_keys(ctx, nr, rk);
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    hp[j] = _mm512_loadu_si512((const void *)(tab + j * (uint32_t)64U));
+  }
+  __m128i j0 = gcm_j0(tab, iv_len, iv);
+  __m128i acc = ghash_bytes(tab, _mm_setzero_si128(), aad, aadlen);
+  __m512i ctr = ctr_init(j0);
+  uint32_t i = (uint32_t)0U;
+  for (; i + (uint32_t)256U <= mlen; i = i + (uint32_t)256U)
+  {
+    __m512i b[4U];
+    ctr_next16(&ctr, b);
+    aes_x16(rk, nr, b);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      __m512i x = _mm512_loadu_si512((const void *)(m + i + j * (uint32_t)64U));
+      b[j] = _mm512_xor_si512(b[j], x);
+      _mm512_storeu_si512((void *)(cipher + i + j * (uint32_t)64U), b[j]);
+      b[j] = bswap512(b[j]);
+    }
+    acc = ghash16(hp, acc, b);
+  }
+  if (i < mlen)
+  {
+    ctr_tail(rk, nr, ctr, mlen - i, m + i, cipher + i);
+    acc = ghash_bytes(tab, acc, cipher + i, mlen - i);
+  }
+  _mm_storeu_si128((__m128i *)tag, gcm_tag(ctx, nr, j0, acc, aadlen, mlen));
+}
+
+static inline uint32_t
+gcm_decrypt(
+  uint8_t *ctx,
+  uint32_t nr,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  uint8_t *tab = ctx + (nr + (uint32_t)1U) * (uint32_t)16U;
+  __m512i rk[15U];
+  __m512i hp[4U];
+  load_round_keys(ctx, nr, rk);
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    hp[j] = _mm512_loadu_si512((const void *)(tab + j * (uint32_t)64U));
+  }
+  __m128i j0 = gcm_j0(tab, iv_len, iv);
+  __m128i acc = ghash_bytes(tab, _mm_setzero_si128(), aad, aadlen);
+  __m512i ctr = ctr_init(j0);
+  uint32_t i = (uint32_t)0U;
+  for (; i + (uint32_t)256U <= mlen; i = i + (uint32_t)256U)
+  {
+    __m512i b[4U];
+    __m512i c[4U];
+    __m512i d[4U];
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      c[j] = _mm512_loadu_si512((const void *)(cipher + i + j * (uint32_t)64U));
+      d[j] = bswap512(c[j]);
+    }
+    acc = ghash16(hp, acc, d);
+    ctr_next16(&ctr, b);
+    aes_x16(rk, nr, b);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      _mm512_storeu_si512((void *)(m + i + j * (uint32_t)64U), _mm512_xor_si512(b[j], c[j]));
+    }
+  }
+  if (i < mlen)
+  {
+    acc = ghash_bytes(tab, acc, cipher + i, mlen - i);
+    ctr_tail(rk, nr, ctr, mlen - i, cipher + i, m + i);
+  }
+  __m128i computed = gcm_tag(ctx, nr, j0, acc, aadlen, mlen);
+  __m128i expected = _mm_loadu_si128((const __m128i *)tag);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(computed, expected)) == 0xffff)
+  {
+    return (uint32_t)0U;
+  }
+  memset(m, 0U, mlen * sizeof (uint8_t));
+  return (uint32_t)1U;
+}
+
+/*
+  Multi-record mode. The single-record code is throughput-bound from 256 bytes
+  on, so longer records go through it unchanged. Shorter ones are dominated by
+  latency: the rounds for E(J0), a reduction per GHASH segment, and the final
+  multiplication by H. Up to four of them, each under its own key, are
+  therefore processed together: E(J0) of all four is one register whose lanes
+  use different round keys, their counter blocks go through the same pass of
+  the AES rounds, and the whole GHASH of each record, length block included,
+  costs a single reduction. All IVs are 12 bytes long.
+*/
+
+#define BATCH_SHORT (uint32_t)256U
+
+/* Round key i of ctx[j] in lane j */
+static inline __m512i lane_keys(uint8_t **ctx, uint32_t i)
+{
+  __m512i k = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *)(ctx[0U] + i * (uint32_t)16U)));
+  k = _mm512_inserti32x4(k, _mm_loadu_si128((const __m128i *)(ctx[1U] + i * (uint32_t)16U)), 1);
+  k = _mm512_inserti32x4(k, _mm_loadu_si128((const __m128i *)(ctx[2U] + i * (uint32_t)16U)), 2);
+  return _mm512_inserti32x4(k, _mm_loadu_si128((const __m128i *)(ctx[3U] + i * (uint32_t)16U)), 3);
+}
+
+/*
+  Sets ctr[j] to the first counter blocks of record j and returns E(J0) of
+  record j in lane j
+*/
+static inline __m512i j0_x4(uint8_t **ctx, uint32_t nr, uint8_t **iv, __m512i *ctr)
+{
+  uint8_t b[64U] = { 0U };
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    memcpy(b + j * (uint32_t)16U, iv[j], (uint32_t)12U * sizeof (uint8_t));
+    b[j * (uint32_t)16U + (uint32_t)15U] = (uint8_t)1U;
+    ctr[j] =
+      ctr_init(Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)(b + j * (uint32_t)16U))));
+  }
+  __m512i e = _mm512_xor_si512(_mm512_loadu_si512((const void *)b), lane_keys(ctx, (uint32_t)0U));
+  for (uint32_t i = (uint32_t)1U; i < nr; i++)
+  {
+    e = _mm512_aesenc_epi128(e, lane_keys(ctx, i));
+  }
+  return _mm512_aesenclast_epi128(e, lane_keys(ctx, nr));
+}
+
+static inline void aes_x4(uint8_t **ctx, uint32_t nr, __m512i *b)
+{
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    b[j] =
+      _mm512_xor_si512(b[j],
+        _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)ctx[j])));
+  }
+  for (uint32_t i = (uint32_t)1U; i < nr; i++)
+  {
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      b[j] =
+        _mm512_aesenc_epi128(b[j],
+          _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(ctx[j] + i * (uint32_t)16U))));
+    }
+  }
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    b[j] =
+      _mm512_aesenclast_epi128(b[j],
+        _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(ctx[j] + nr * (uint32_t)16U))));
+  }
+}
+
+/* Counter-mode pass over four records of fewer than 256 bytes each */
+static inline void
+ctr_x4(uint8_t **ctx, uint32_t nr, __m512i *ctr, uint32_t *len, uint8_t **in, uint8_t **out)
+{
+  uint32_t max = (uint32_t)0U;
+  __m512i four = _mm512_set_epi32(0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4, 0, 0, 0, 4);
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+  {
+    if (len[j] > max)
+    {
+      max = len[j];
+    }
+  }
+  for (uint32_t i = (uint32_t)0U; i < max; i = i + (uint32_t)64U)
+  {
+    __m512i b[4U];
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      b[j] = bswap512(ctr[j]);
+      ctr[j] = _mm512_add_epi32(ctr[j], four);
+    }
+    aes_x4(ctx, nr, b);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      if (i < len[j])
+      {
+        __mmask64 k = byte_mask(len[j] - i);
+        __m512i x = _mm512_maskz_loadu_epi8(k, in[j] + i);
+        _mm512_mask_storeu_epi8(out[j] + i, k, _mm512_xor_si512(x, b[j]));
+      }
+    }
+  }
+}
+
+/*
+  Accumulates the unreduced products of the zero-padded blocks of p with the
+  powers of H read from h onwards
+*/
+static inline void
+ghash_acc(uint8_t *h, uint8_t *p, uint32_t len, __m512i *lo, __m512i *mid, __m512i *hi)
+{
+  uint32_t n = (len + (uint32_t)15U) / (uint32_t)16U;
+  for (uint32_t j = (uint32_t)0U; j * (uint32_t)4U < n; j++)
+  {
+    uint32_t nb = n - j * (uint32_t)4U;
+    if (nb > (uint32_t)4U)
+    {
+      nb = (uint32_t)4U;
+    }
+    __mmask8 kh = (__mmask8)(((uint32_t)1U << (uint32_t)2U * nb) - (uint32_t)1U);
+    __m512i
+    d = bswap512(_mm512_maskz_loadu_epi8(byte_mask(len - j * (uint32_t)64U), p + j * (uint32_t)64U));
+    mul_acc(lo, mid, hi, d, _mm512_maskz_loadu_epi64(kh, h + j * (uint32_t)64U));
+  }
+}
+
+/* The tag of a record, given E(J0) */
+static inline __m128i
+tag_x1(
+  uint8_t *ctx,
+  uint32_t nr,
+  __m128i ej0,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *cipher
+)
+{
+  uint8_t *tab = ctx + (nr + (uint32_t)1U) * (uint32_t)16U;
+  uint32_t na = (aadlen + (uint32_t)15U) / (uint32_t)16U;
+  uint32_t nc = (mlen + (uint32_t)15U) / (uint32_t)16U;
+  __m128i
+  len =
+    _mm_set_epi64x((int64_t)((uint64_t)aadlen * (uint64_t)8U),
+      (int64_t)((uint64_t)mlen * (uint64_t)8U));
+  __m128i acc;
+  if (na + nc < (uint32_t)16U)
+  {
+    /* Block i of n = na + nc + 1, the length block last, is multiplied by H^(n - i) */
+    __m512i lo = _mm512_setzero_si512();
+    __m512i mid = _mm512_setzero_si512();
+    __m512i hi = _mm512_setzero_si512();
+    ghash_acc(tab + ((uint32_t)15U - na - nc) * (uint32_t)16U, aad, aadlen, &lo, &mid, &hi);
+    ghash_acc(tab + ((uint32_t)15U - nc) * (uint32_t)16U, cipher, mlen, &lo, &mid, &hi);
+    mul_acc(&lo,
+      &mid,
+      &hi,
+      _mm512_castsi128_si512(len),
+      _mm512_maskz_loadu_epi64((__mmask8)3U, tab + (uint32_t)240U));
+    acc = Hacl_Impl_Gf128_NI_reduce(hxor(lo), hxor(mid), hxor(hi));
+  }
+  else
+  {
+    acc = ghash_bytes(tab, _mm_setzero_si128(), aad, aadlen);
+    acc = ghash_bytes(tab, acc, cipher, mlen);
+    acc =
+      gf128_mul(_mm_xor_si128(acc, len),
+        _mm_loadu_si128((const __m128i *)(tab + (uint32_t)240U)));
+  }
+  return _mm_xor_si128(ej0, Hacl_Impl_Gf128_NI_bswap128(acc));
+}
+
+/*
+  Gathers up to four consecutive short records starting at i into j[], skipping
+  the long ones, which the caller processes on its own; returns how many were
+  gathered and sets *next past the last record looked at
+*/
+static inline uint32_t
+gather_short(uint32_t len, uint32_t *mlen, uint32_t i, uint32_t *j, uint32_t *next)
+{
+  uint32_t cnt = (uint32_t)0U;
+  while (i < len && cnt < (uint32_t)4U && mlen[i] < BATCH_SHORT)
+  {
+    j[cnt] = i;
+    cnt++;
+    i++;
+  }
+  *next = i;
+  return cnt;
+}
+
+static void
+gcm_encrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint32_t nr,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+)
+{
+  uint32_t i = (uint32_t)0U;
+  while (i < len)
+  {
+    if (mlen[i] >= BATCH_SHORT)
+    {
+      gcm_encrypt(ctx[i], nr, (uint32_t)12U, iv[i], aadlen[i], aad[i], mlen[i], m[i], cipher[i], tag[i]);
+      i++;
+    }
+    else
+    {
+      uint32_t r[4U] = { 0U };
+      uint32_t next;
+      uint32_t cnt = gather_short(len, mlen, i, r, &next);
+      uint8_t *kx[4U];
+      uint8_t *ivx[4U];
+      uint8_t *in[4U];
+      uint8_t *out[4U];
+      uint32_t lx[4U];
+      __m512i ctr[4U];
+      uint8_t e[64U];
+      /* Idle lanes repeat the first record with nothing to encrypt */
+      for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+      {
+        uint32_t r1 = j < cnt ? r[j] : r[0U];
+        kx[j] = ctx[r1];
+        ivx[j] = iv[r1];
+        in[j] = m[r1];
+        out[j] = cipher[r1];
+        lx[j] = j < cnt ? mlen[r1] : (uint32_t)0U;
+      }
+      _mm512_storeu_si512((void *)e, j0_x4(kx, nr, ivx, ctr));
+      ctr_x4(kx, nr, ctr, lx, in, out);
+      for (uint32_t j = (uint32_t)0U; j < cnt; j++)
+      {
+        uint32_t r1 = r[j];
+        __m128i ej0 = _mm_loadu_si128((const __m128i *)(e + j * (uint32_t)16U));
+        _mm_storeu_si128((__m128i *)tag[r1],
+          tag_x1(ctx[r1], nr, ej0, aadlen[r1], aad[r1], mlen[r1], cipher[r1]));
+      }
+      i = next;
+    }
+  }
+}
+
+static uint32_t
+gcm_decrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint32_t nr,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+)
+{
+  uint32_t failed = (uint32_t)0U;
+  uint32_t i = (uint32_t)0U;
+  while (i < len)
+  {
+    if (mlen[i] >= BATCH_SHORT)
+    {
+      res[i] =
+        gcm_decrypt(ctx[i], nr, (uint32_t)12U, iv[i], aadlen[i], aad[i], mlen[i], m[i], cipher[i],
+          tag[i]);
+      failed = failed | res[i];
+      i++;
+    }
+    else
+    {
+      uint32_t r[4U] = { 0U };
+      uint32_t next;
+      uint32_t cnt = gather_short(len, mlen, i, r, &next);
+      uint8_t *kx[4U];
+      uint8_t *ivx[4U];
+      uint8_t *in[4U];
+      uint8_t *out[4U];
+      uint32_t lx[4U] = { 0U };
+      __m512i ctr[4U];
+      uint8_t e[64U];
+      for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+      {
+        uint32_t r1 = j < cnt ? r[j] : r[0U];
+        kx[j] = ctx[r1];
+        ivx[j] = iv[r1];
+        in[j] = cipher[r1];
+        out[j] = m[r1];
+      }
+      _mm512_storeu_si512((void *)e, j0_x4(kx, nr, ivx, ctr));
+      /* Only the records whose tag checks out are decrypted */
+      for (uint32_t j = (uint32_t)0U; j < cnt; j++)
+      {
+        uint32_t r1 = r[j];
+        __m128i ej0 = _mm_loadu_si128((const __m128i *)(e + j * (uint32_t)16U));
+        __m128i computed = tag_x1(ctx[r1], nr, ej0, aadlen[r1], aad[r1], mlen[r1], cipher[r1]);
+        __m128i expected = _mm_loadu_si128((const __m128i *)tag[r1]);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(computed, expected)) == 0xffff)
+        {
+          res[r1] = (uint32_t)0U;
+          lx[j] = mlen[r1];
+        }
+        else
+        {
+          res[r1] = (uint32_t)1U;
+          failed = (uint32_t)1U;
+          memset(m[r1], 0U, mlen[r1] * sizeof (uint8_t));
+        }
+      }
+      ctr_x4(kx, nr, ctr, lx, in, out);
+      i = next;
+    }
+  }
+  return failed;
+}
+
+/*
+  Building blocks for AES-GCM computed in pieces: the counter block and the
+  GHASH accumulator live with the caller, in the byte order of the standard.
+*/
+
+static void gcm_ctr(uint8_t *ctx, uint32_t nr, uint8_t *ctr0, uint32_t len, uint8_t *in, uint8_t *out)
+{
+  __m512i rk[15U];
+  load_round_keys(ctx, nr, rk);
+  /* ctr_next16 starts from the block after ctr, hence the - 1 */
+  __m128i c0 = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)ctr0));
+  __m512i
+  ctr =
+    _mm512_add_epi32(_mm512_broadcast_i32x4(c0),
+      _mm512_set_epi32(0, 0, 0, 3, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 0));
+  uint32_t i = (uint32_t)0U;
+  for (; i + (uint32_t)256U <= len; i = i + (uint32_t)256U)
+  {
+    __m512i b[4U];
+    ctr_next16(&ctr, b);
+    aes_x16(rk, nr, b);
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      __m512i x = _mm512_loadu_si512((const void *)(in + i + j * (uint32_t)64U));
+      _mm512_storeu_si512((void *)(out + i + j * (uint32_t)64U), _mm512_xor_si512(b[j], x));
+    }
+  }
+  if (i < len)
+  {
+    ctr_tail(rk, nr, ctr, len - i, in + i, out + i);
+  }
+}
+
+static void gcm_ghash(uint8_t *ctx, uint32_t nr, uint8_t *acc, uint32_t len, uint8_t *text)
+{
+  uint8_t *tab = ctx + (nr + (uint32_t)1U) * (uint32_t)16U;
+  __m128i y = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)acc));
+  _mm_storeu_si128((__m128i *)acc, Hacl_Impl_Gf128_NI_bswap128(ghash_bytes(tab, y, text, len)));
+}
+
+/* Sixteen independent blocks per pass, gathered from wherever they are */
+static void ecb(uint8_t *ctx, uint32_t nr, uint32_t n, uint8_t **in, uint8_t *out)
+{
+  __m512i rk[15U];
+  load_round_keys(ctx, nr, rk);
+  for (uint32_t i = (uint32_t)0U; i < n; i = i + (uint32_t)16U)
+  {
+    __m512i b[4U] = { _mm512_setzero_si512() };
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)16U && i + j < n; j++)
+    {
+      __m128i x = _mm_loadu_si128((const __m128i *)in[i + j]);
+      switch (j % (uint32_t)4U)
+      {
+        case 0U:
+          {
+            b[j / (uint32_t)4U] = _mm512_inserti32x4(b[j / (uint32_t)4U], x, 0);
+            break;
+          }
+        case 1U:
+          {
+            b[j / (uint32_t)4U] = _mm512_inserti32x4(b[j / (uint32_t)4U], x, 1);
+            break;
+          }
+        case 2U:
+          {
+            b[j / (uint32_t)4U] = _mm512_inserti32x4(b[j / (uint32_t)4U], x, 2);
+            break;
+          }
+        default:
+          {
+            b[j / (uint32_t)4U] = _mm512_inserti32x4(b[j / (uint32_t)4U], x, 3);
+          }
+      }
+    }
+    aes_x16(rk, nr, b);
+    uint32_t left = n - i;
+    if (left > (uint32_t)16U)
+    {
+      left = (uint32_t)16U;
+    }
+    for (uint32_t j = (uint32_t)0U; j * (uint32_t)4U < left; j++)
+    {
+      __mmask64 k = byte_mask((left - j * (uint32_t)4U) * (uint32_t)16U);
+      _mm512_mask_storeu_epi8(out + (i + j * (uint32_t)4U) * (uint32_t)16U, k, b[j]);
+    }
+  }
+}
+
+void Hacl_AES_GCM_VAES_aes128_init(uint8_t *ctx, uint8_t *key)
+{
+  key_expansion128(ctx, key);
+  gcm_init(ctx, (uint32_t)10U);
+}
+
+void Hacl_AES_GCM_VAES_aes256_init(uint8_t *ctx, uint8_t *key)
+{
+  key_expansion256(ctx, key);
+  gcm_init(ctx, (uint32_t)14U);
+}
+
+void
+Hacl_AES_GCM_VAES_aes128_encrypt(
+  uint8_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  gcm_encrypt(ctx, (uint32_t)10U, iv_len, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+uint32_t
+Hacl_AES_GCM_VAES_aes128_decrypt(
+  uint8_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  return gcm_decrypt(ctx, (uint32_t)10U, iv_len, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+void
+Hacl_AES_GCM_VAES_aes256_encrypt(
+  uint8_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  gcm_encrypt(ctx, (uint32_t)14U, iv_len, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+uint32_t
+Hacl_AES_GCM_VAES_aes256_decrypt(
+  uint8_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+)
+{
+  return gcm_decrypt(ctx, (uint32_t)14U, iv_len, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+
+void
+Hacl_AES_GCM_VAES_aes128_encrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+)
+{
+  gcm_encrypt_batch(len, ctx, (uint32_t)10U, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+uint32_t
+Hacl_AES_GCM_VAES_aes128_decrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+)
+{
+  return gcm_decrypt_batch(len, ctx, (uint32_t)10U, iv, aadlen, aad, mlen, m, cipher, tag, res);
+}
+
+void
+Hacl_AES_GCM_VAES_aes256_encrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+)
+{
+  gcm_encrypt_batch(len, ctx, (uint32_t)14U, iv, aadlen, aad, mlen, m, cipher, tag);
+}
+
+uint32_t
+Hacl_AES_GCM_VAES_aes256_decrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+)
+{
+  return gcm_decrypt_batch(len, ctx, (uint32_t)14U, iv, aadlen, aad, mlen, m, cipher, tag, res);
+}
+
+void
+Hacl_AES_GCM_VAES_aes128_ctr(
+  uint8_t *ctx,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+)
+{
+  gcm_ctr(ctx, (uint32_t)10U, ctr, len, in, out);
+}
+
+void Hacl_AES_GCM_VAES_aes128_ghash(uint8_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text)
+{
+  gcm_ghash(ctx, (uint32_t)10U, acc, len, text);
+}
+
+void
+Hacl_AES_GCM_VAES_aes256_ctr(
+  uint8_t *ctx,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+)
+{
+  gcm_ctr(ctx, (uint32_t)14U, ctr, len, in, out);
+}
+
+void Hacl_AES_GCM_VAES_aes256_ghash(uint8_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text)
+{
+  gcm_ghash(ctx, (uint32_t)14U, acc, len, text);
+}
+
+void Hacl_AES_GCM_VAES_aes128_ecb(uint8_t *ctx, uint32_t n, uint8_t **in, uint8_t *out)
+{
+  ecb(ctx, (uint32_t)10U, n, in, out);
+}
+
+void Hacl_AES_GCM_VAES_aes256_ecb(uint8_t *ctx, uint32_t n, uint8_t **in, uint8_t *out)
+{
+  ecb(ctx, (uint32_t)14U, n, in, out);
+}
@@ -0,0 +1,224 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#ifndef __Hacl_AES_GCM_VAES_H
+#define __Hacl_AES_GCM_VAES_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+
+/*
+  AES-GCM on 512-bit registers, for CPUs with AVX-512, VAES and VPCLMULQDQ.
+
+  Each 512-bit register holds four 128-bit lanes, and sixteen counter blocks
+  (four registers) go through the AES rounds together. GHASH runs in the
+  bit-reflected (POLYVAL) domain with one multiplication per block against
+  precomputed powers H^1 .. H^16 and a single reduction per sixteen blocks.
+
+  A context holds the AES round keys followed by the sixteen powers of the
+  hash key; it is read-only after init and may be shared between threads. Its
+  size in bytes is Hacl_AES_GCM_VAES_aes128_ctx_len (resp. aes256).
+
+  Callers must check EverCrypt_AutoConfig2_has_vaes() first.
+*/
+
+extern uint32_t Hacl_AES_GCM_VAES_aes128_ctx_len;
+
+extern uint32_t Hacl_AES_GCM_VAES_aes256_ctx_len;
+
+void Hacl_AES_GCM_VAES_aes128_init(uint8_t *ctx, uint8_t *key);
+
+void Hacl_AES_GCM_VAES_aes256_init(uint8_t *ctx, uint8_t *key);
+
+void
+Hacl_AES_GCM_VAES_aes128_encrypt(
+  uint8_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+/*
+  Decryption and authentication share a single pass over the input. Returns 0
+  if the tag is valid; otherwise returns 1 and zeroes the mlen bytes of m.
+*/
+uint32_t
+Hacl_AES_GCM_VAES_aes128_decrypt(
+  uint8_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+void
+Hacl_AES_GCM_VAES_aes256_encrypt(
+  uint8_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+uint32_t
+Hacl_AES_GCM_VAES_aes256_decrypt(
+  uint8_t *ctx,
+  uint32_t iv_len,
+  uint8_t *iv,
+  uint32_t aadlen,
+  uint8_t *aad,
+  uint32_t mlen,
+  uint8_t *m,
+  uint8_t *cipher,
+  uint8_t *tag
+);
+
+/*
+  Multi-record variants: record i uses context ctx[i] and a 12-byte IV iv[i].
+  Records shorter than 256 bytes are processed four at a time, possibly under
+  different keys; longer ones as by the single-record functions. Decryption sets res[i] to 0 or 1 as the single-record version
+  would return, zeroes m[i] on failure, and returns 1 if any record failed.
+*/
+void
+Hacl_AES_GCM_VAES_aes128_encrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+);
+
+uint32_t
+Hacl_AES_GCM_VAES_aes128_decrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+);
+
+void
+Hacl_AES_GCM_VAES_aes256_encrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag
+);
+
+uint32_t
+Hacl_AES_GCM_VAES_aes256_decrypt_batch(
+  uint32_t len,
+  uint8_t **ctx,
+  uint8_t **iv,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **tag,
+  uint32_t *res
+);
+
+/*
+  Pieces of AES-GCM, for callers that do not have the whole message at hand.
+  ctr XORs len bytes of in with the keystream of the counter blocks ctr,
+  ctr + 1, ... (ctr is not updated) into out. ghash absorbs len bytes of text
+  into the 16-byte accumulator acc, the last block padded with zeros. Both
+  work in the byte order of the standard.
+*/
+void
+Hacl_AES_GCM_VAES_aes128_ctr(
+  uint8_t *ctx,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+);
+
+void Hacl_AES_GCM_VAES_aes128_ghash(uint8_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text);
+
+void
+Hacl_AES_GCM_VAES_aes256_ctr(
+  uint8_t *ctx,
+  uint8_t *ctr,
+  uint32_t len,
+  uint8_t *in,
+  uint8_t *out
+);
+
+void Hacl_AES_GCM_VAES_aes256_ghash(uint8_t *ctx, uint8_t *acc, uint32_t len, uint8_t *text);
+
+/*
+  ecb encrypts n independent blocks: in[i] points to block i, and its
+  encryption is written to out + 16 * i.
+*/
+void Hacl_AES_GCM_VAES_aes128_ecb(uint8_t *ctx, uint32_t n, uint8_t **in, uint8_t *out);
+
+void Hacl_AES_GCM_VAES_aes256_ecb(uint8_t *ctx, uint32_t n, uint8_t **in, uint8_t *out);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_AES_GCM_VAES_H_DEFINED
+#endif
@@ -1189,3 +1189,562 @@ Hacl_Chacha20Poly1305_256_aead_decrypt(
   return (uint32_t)1U;
 }
 
+/*
+  Multi-record sealing and opening. The keystream blocks of all records,
+  including the block at counter 0 that yields each one-time Poly1305 key, are
+  queued as independent jobs and computed eight at a time, one job per lane.
+  Poly1305 then runs four records side by side, one per 64-bit lane, each lane
+  with its own key.
+*/
+
+#define BATCH_CHUNK (uint32_t)32U
+
+static inline void
+chacha20_flush_256(
+  uint32_t nj,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *ctr,
+  uint32_t *rec,
+  uint32_t *len,
+  uint8_t **in,
+  uint8_t **out,
+  uint8_t *keys
+)
+{
+  uint8_t ks[512U];
+  for (uint32_t j = nj; j < (uint32_t)8U; j++)
+  {
+    k[j] = k[0U];
+    n[j] = n[0U];
+    ctr[j] = ctr[0U];
+  }
+  Hacl_Chacha20_Vec256_chacha20_blocks_256(ks, k, n, ctr);
+  for (uint32_t j = (uint32_t)0U; j < nj; j++)
+  {
+    uint32_t r = rec[j];
+    uint8_t *b = ks + j * (uint32_t)64U;
+    if (ctr[j] == (uint32_t)0U)
+    {
+      memcpy(keys + r * (uint32_t)32U, b, (uint32_t)32U * sizeof (uint8_t));
+    }
+    else
+    {
+      uint32_t off = (ctr[j] - (uint32_t)1U) * (uint32_t)64U;
+      uint32_t l = len[r] - off;
+      uint8_t *src = in[r] + off;
+      uint8_t *dst = out[r] + off;
+      if (l >= (uint32_t)64U)
+      {
+        for (uint32_t i = (uint32_t)0U; i < (uint32_t)2U; i++)
+        {
+          Lib_IntVector_Intrinsics_vec256
+          x = Lib_IntVector_Intrinsics_vec256_load32_le(src + i * (uint32_t)32U);
+          Lib_IntVector_Intrinsics_vec256
+          y =
+            Lib_IntVector_Intrinsics_vec256_xor(x,
+              Lib_IntVector_Intrinsics_vec256_load32_le(b + i * (uint32_t)32U));
+          Lib_IntVector_Intrinsics_vec256_store32_le(dst + i * (uint32_t)32U, y);
+        }
+      }
+      else
+      {
+        for (uint32_t i = (uint32_t)0U; i < l; i++)
+        {
+          dst[i] = src[i] ^ b[i];
+        }
+      }
+    }
+  }
+}
+
+/*
+  For each of the cnt records: if keys is not NULL, writes the Poly1305 key to
+  keys + 32 * r; if in is not NULL and skip[r] is false (or skip is NULL),
+  xors len[r] bytes of keystream (counters 1, 2, ...) from in[r] into out[r].
+*/
+static void
+chacha20_batch_256(
+  uint32_t cnt,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *len,
+  uint8_t **in,
+  uint8_t **out,
+  uint8_t *keys,
+  bool *skip
+)
+{
+  uint8_t *kj[8U];
+  uint8_t *nj[8U];
+  uint32_t cj[8U];
+  uint32_t rj[8U];
+  uint32_t nl = (uint32_t)0U;
+  for (uint32_t r = (uint32_t)0U; r < cnt; r++)
+  {
+    uint32_t first = (uint32_t)0U;
+    uint32_t last = (uint32_t)0U;
+    if (keys == NULL)
+    {
+      first = (uint32_t)1U;
+    }
+    if (in != NULL && !(skip != NULL && skip[r]))
+    {
+      last = (len[r] + (uint32_t)63U) / (uint32_t)64U;
+    }
+    for (uint32_t b = first; b <= last; b++)
+    {
+      kj[nl] = k[r];
+      nj[nl] = n[r];
+      cj[nl] = b;
+      rj[nl] = r;
+      nl++;
+      if (nl == (uint32_t)8U)
+      {
+        chacha20_flush_256(nl, kj, nj, cj, rj, len, in, out, keys);
+        nl = (uint32_t)0U;
+      }
+    }
+  }
+  if (nl > (uint32_t)0U)
+  {
+    chacha20_flush_256(nl, kj, nj, cj, rj, len, in, out, keys);
+  }
+}
+
+/* Clamped r (and 5 * r) of four independent Poly1305 keys, one per lane */
+static inline void
+poly1305_load_r_x4(
+  Lib_IntVector_Intrinsics_vec256 *r,
+  Lib_IntVector_Intrinsics_vec256 *r5,
+  uint8_t **key
+)
+{
+  uint64_t lo[4U];
+  uint64_t hi[4U];
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)4U; l++)
+  {
+    lo[l] = load64_le(key[l]) & (uint64_t)0x0ffffffc0fffffffU;
+    hi[l] = load64_le(key[l] + (uint32_t)8U) & (uint64_t)0x0ffffffc0ffffffcU;
+  }
+  Lib_IntVector_Intrinsics_vec256
+  f0 = Lib_IntVector_Intrinsics_vec256_load64s(lo[0U], lo[1U], lo[2U], lo[3U]);
+  Lib_IntVector_Intrinsics_vec256
+  f1 = Lib_IntVector_Intrinsics_vec256_load64s(hi[0U], hi[1U], hi[2U], hi[3U]);
+  Lib_IntVector_Intrinsics_vec256
+  mask26 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU);
+  r[0U] = Lib_IntVector_Intrinsics_vec256_and(f0, mask26);
+  r[1U] =
+    Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_shift_right64(f0,
+        (uint32_t)26U),
+      mask26);
+  r[2U] =
+    Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(f0,
+        (uint32_t)52U),
+      Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(f1,
+          Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3fffU)),
+        (uint32_t)12U));
+  r[3U] =
+    Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_shift_right64(f1,
+        (uint32_t)14U),
+      mask26);
+  r[4U] = Lib_IntVector_Intrinsics_vec256_shift_right64(f1, (uint32_t)40U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    r5[i] = Lib_IntVector_Intrinsics_vec256_smul64(r[i], (uint64_t)5U);
+  }
+}
+
+/* acc = (acc + b) * r lanewise, where b holds one full 16-byte block per lane */
+static inline void
+poly1305_fadd_mul_x4(
+  Lib_IntVector_Intrinsics_vec256 *acc,
+  uint8_t **b,
+  Lib_IntVector_Intrinsics_vec256 *r,
+  Lib_IntVector_Intrinsics_vec256 *r5
+)
+{
+  Lib_IntVector_Intrinsics_vec256
+  f0 =
+    Lib_IntVector_Intrinsics_vec256_load64s(load64_le(b[0U]),
+      load64_le(b[1U]),
+      load64_le(b[2U]),
+      load64_le(b[3U]));
+  Lib_IntVector_Intrinsics_vec256
+  f1 =
+    Lib_IntVector_Intrinsics_vec256_load64s(load64_le(b[0U] + (uint32_t)8U),
+      load64_le(b[1U] + (uint32_t)8U),
+      load64_le(b[2U] + (uint32_t)8U),
+      load64_le(b[3U] + (uint32_t)8U));
+  Lib_IntVector_Intrinsics_vec256
+  mask26 = Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3ffffffU);
+  Lib_IntVector_Intrinsics_vec256
+  a0 = Lib_IntVector_Intrinsics_vec256_add64(acc[0U], Lib_IntVector_Intrinsics_vec256_and(f0, mask26));
+  Lib_IntVector_Intrinsics_vec256
+  a1 =
+    Lib_IntVector_Intrinsics_vec256_add64(acc[1U],
+      Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_shift_right64(f0,
+          (uint32_t)26U),
+        mask26));
+  Lib_IntVector_Intrinsics_vec256
+  a2 =
+    Lib_IntVector_Intrinsics_vec256_add64(acc[2U],
+      Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(f0,
+          (uint32_t)52U),
+        Lib_IntVector_Intrinsics_vec256_shift_left64(Lib_IntVector_Intrinsics_vec256_and(f1,
+            Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x3fffU)),
+          (uint32_t)12U)));
+  Lib_IntVector_Intrinsics_vec256
+  a3 =
+    Lib_IntVector_Intrinsics_vec256_add64(acc[3U],
+      Lib_IntVector_Intrinsics_vec256_and(Lib_IntVector_Intrinsics_vec256_shift_right64(f1,
+          (uint32_t)14U),
+        mask26));
+  Lib_IntVector_Intrinsics_vec256
+  a4 =
+    Lib_IntVector_Intrinsics_vec256_add64(acc[4U],
+      Lib_IntVector_Intrinsics_vec256_or(Lib_IntVector_Intrinsics_vec256_shift_right64(f1,
+          (uint32_t)40U),
+        Lib_IntVector_Intrinsics_vec256_load64((uint64_t)0x1000000U)));
+  Lib_IntVector_Intrinsics_vec256
+  t0 =
+    Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r[0U],
+          a0),
+        Lib_IntVector_Intrinsics_vec256_mul64(r5[4U], a1)),
+      Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r5[3U],
+            a2),
+          Lib_IntVector_Intrinsics_vec256_mul64(r5[2U], a3)),
+        Lib_IntVector_Intrinsics_vec256_mul64(r5[1U], a4)));
+  Lib_IntVector_Intrinsics_vec256
+  t1 =
+    Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r[1U],
+          a0),
+        Lib_IntVector_Intrinsics_vec256_mul64(r[0U], a1)),
+      Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r5[4U],
+            a2),
+          Lib_IntVector_Intrinsics_vec256_mul64(r5[3U], a3)),
+        Lib_IntVector_Intrinsics_vec256_mul64(r5[2U], a4)));
+  Lib_IntVector_Intrinsics_vec256
+  t2 =
+    Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r[2U],
+          a0),
+        Lib_IntVector_Intrinsics_vec256_mul64(r[1U], a1)),
+      Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r[0U],
+            a2),
+          Lib_IntVector_Intrinsics_vec256_mul64(r5[4U], a3)),
+        Lib_IntVector_Intrinsics_vec256_mul64(r5[3U], a4)));
+  Lib_IntVector_Intrinsics_vec256
+  t3 =
+    Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r[3U],
+          a0),
+        Lib_IntVector_Intrinsics_vec256_mul64(r[2U], a1)),
+      Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r[1U],
+            a2),
+          Lib_IntVector_Intrinsics_vec256_mul64(r[0U], a3)),
+        Lib_IntVector_Intrinsics_vec256_mul64(r5[4U], a4)));
+  Lib_IntVector_Intrinsics_vec256
+  t4 =
+    Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r[4U],
+          a0),
+        Lib_IntVector_Intrinsics_vec256_mul64(r[3U], a1)),
+      Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_add64(Lib_IntVector_Intrinsics_vec256_mul64(r[2U],
+            a2),
+          Lib_IntVector_Intrinsics_vec256_mul64(r[1U], a3)),
+        Lib_IntVector_Intrinsics_vec256_mul64(r[0U], a4)));
+  Lib_IntVector_Intrinsics_vec256
+  z0 = Lib_IntVector_Intrinsics_vec256_shift_right64(t0, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256
+  z1 = Lib_IntVector_Intrinsics_vec256_shift_right64(t3, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 x0 = Lib_IntVector_Intrinsics_vec256_and(t0, mask26);
+  Lib_IntVector_Intrinsics_vec256 x3 = Lib_IntVector_Intrinsics_vec256_and(t3, mask26);
+  Lib_IntVector_Intrinsics_vec256 x1 = Lib_IntVector_Intrinsics_vec256_add64(t1, z0);
+  Lib_IntVector_Intrinsics_vec256 x4 = Lib_IntVector_Intrinsics_vec256_add64(t4, z1);
+  Lib_IntVector_Intrinsics_vec256
+  z01 = Lib_IntVector_Intrinsics_vec256_shift_right64(x1, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256
+  z11 = Lib_IntVector_Intrinsics_vec256_shift_right64(x4, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256
+  t = Lib_IntVector_Intrinsics_vec256_shift_left64(z11, (uint32_t)2U);
+  Lib_IntVector_Intrinsics_vec256 z12 = Lib_IntVector_Intrinsics_vec256_add64(z11, t);
+  Lib_IntVector_Intrinsics_vec256 x11 = Lib_IntVector_Intrinsics_vec256_and(x1, mask26);
+  Lib_IntVector_Intrinsics_vec256 x41 = Lib_IntVector_Intrinsics_vec256_and(x4, mask26);
+  Lib_IntVector_Intrinsics_vec256 x2 = Lib_IntVector_Intrinsics_vec256_add64(t2, z01);
+  Lib_IntVector_Intrinsics_vec256 x01 = Lib_IntVector_Intrinsics_vec256_add64(x0, z12);
+  Lib_IntVector_Intrinsics_vec256
+  z02 = Lib_IntVector_Intrinsics_vec256_shift_right64(x2, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256
+  z13 = Lib_IntVector_Intrinsics_vec256_shift_right64(x01, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 x21 = Lib_IntVector_Intrinsics_vec256_and(x2, mask26);
+  Lib_IntVector_Intrinsics_vec256 x02 = Lib_IntVector_Intrinsics_vec256_and(x01, mask26);
+  Lib_IntVector_Intrinsics_vec256 x31 = Lib_IntVector_Intrinsics_vec256_add64(x3, z02);
+  Lib_IntVector_Intrinsics_vec256 x12 = Lib_IntVector_Intrinsics_vec256_add64(x11, z13);
+  Lib_IntVector_Intrinsics_vec256
+  z03 = Lib_IntVector_Intrinsics_vec256_shift_right64(x31, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec256 x32 = Lib_IntVector_Intrinsics_vec256_and(x31, mask26);
+  Lib_IntVector_Intrinsics_vec256 x42 = Lib_IntVector_Intrinsics_vec256_add64(x41, z03);
+  acc[0U] = x02;
+  acc[1U] = x12;
+  acc[2U] = x21;
+  acc[3U] = x32;
+  acc[4U] = x42;
+}
+
+/*
+  Returns the next block of the MAC input of a record: the zero-padded AAD,
+  the zero-padded ciphertext, then the lengths. seg tracks which of the three
+  is being read, src and left the position within it; partial blocks are
+  padded into buf. Once the length block is returned, seg is 3.
+*/
+static inline uint8_t
+*poly1305_next(
+  uint8_t *buf,
+  uint32_t *seg,
+  uint8_t **src,
+  uint32_t *left,
+  uint32_t aadlen,
+  uint32_t mlen,
+  uint8_t *m
+)
+{
+  while (seg[0U] < (uint32_t)2U && left[0U] == (uint32_t)0U)
+  {
+    seg[0U]++;
+    src[0U] = m;
+    left[0U] = mlen;
+  }
+  if (seg[0U] == (uint32_t)2U)
+  {
+    store64_le(buf, (uint64_t)aadlen);
+    store64_le(buf + (uint32_t)8U, (uint64_t)mlen);
+    seg[0U] = (uint32_t)3U;
+    left[0U] = (uint32_t)0U;
+    return buf;
+  }
+  uint8_t *p = src[0U];
+  uint32_t l = left[0U];
+  if (l >= (uint32_t)16U)
+  {
+    src[0U] = p + (uint32_t)16U;
+    left[0U] = l - (uint32_t)16U;
+    return p;
+  }
+  memset(buf, 0U, (uint32_t)16U * sizeof (uint8_t));
+  memcpy(buf, p, l * sizeof (uint8_t));
+  left[0U] = (uint32_t)0U;
+  return buf;
+}
+
+static inline void
+poly1305_finish_lane(
+  uint8_t *tag,
+  uint8_t *key,
+  Lib_IntVector_Intrinsics_vec256 *acc,
+  uint32_t l
+)
+{
+  Lib_IntVector_Intrinsics_vec256 ctx[25U];
+  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec256_zero;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    uint8_t tmp[32U];
+    Lib_IntVector_Intrinsics_vec256_store64_le(tmp, acc[i]);
+    ctx[i] = Lib_IntVector_Intrinsics_vec256_load64(load64_le(tmp + l * (uint32_t)8U));
+  }
+  Hacl_Poly1305_256_poly1305_finish(tag, key, ctx);
+}
+
+/*
+  Computes the AEAD tags of cnt records (key r at keys + 32 * r) eight at a
+  time, in two independent groups of four lanes so that the latencies of the
+  two multiplications overlap. Whenever a lane finishes its record, it is
+  refilled with the next one.
+*/
+static void
+poly1305_batch_256(
+  uint32_t cnt,
+  uint8_t *keys,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **tag
+)
+{
+  Lib_IntVector_Intrinsics_vec256 acc[2U][5U];
+  Lib_IntVector_Intrinsics_vec256 r[2U][5U];
+  Lib_IntVector_Intrinsics_vec256 r5[2U][5U];
+  uint8_t buf[8U][16U] = { { 0U } };
+  uint8_t *b[8U];
+  uint8_t *kl[8U];
+  uint8_t *src[8U];
+  uint32_t rec[8U];
+  uint32_t seg[8U];
+  uint32_t left[8U];
+  uint32_t next = (uint32_t)0U;
+  uint32_t active = (uint32_t)0U;
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+  {
+    rec[l] = cnt;
+    kl[l] = keys;
+    src[l] = NULL;
+    seg[l] = (uint32_t)3U;
+    left[l] = (uint32_t)0U;
+    if (next < cnt)
+    {
+      rec[l] = next;
+      kl[l] = keys + next * (uint32_t)32U;
+      seg[l] = (uint32_t)0U;
+      src[l] = aad[next];
+      left[l] = aadlen[next];
+      next++;
+      active++;
+    }
+  }
+  for (uint32_t g = (uint32_t)0U; g < (uint32_t)2U; g++)
+  {
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+    {
+      acc[g][i] = Lib_IntVector_Intrinsics_vec256_zero;
+    }
+    poly1305_load_r_x4(r[g], r5[g], kl + g * (uint32_t)4U);
+  }
+  while (active > (uint32_t)0U)
+  {
+    for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+    {
+      uint32_t j = rec[l];
+      if (left[l] >= (uint32_t)16U)
+      {
+        b[l] = src[l];
+        src[l] = src[l] + (uint32_t)16U;
+        left[l] = left[l] - (uint32_t)16U;
+      }
+      else if (j < cnt)
+      {
+        b[l] = poly1305_next(buf[l], seg + l, src + l, left + l, aadlen[j], mlen[j], m[j]);
+      }
+      else
+      {
+        b[l] = buf[l];
+      }
+    }
+    poly1305_fadd_mul_x4(acc[0U], b, r[0U], r5[0U]);
+    poly1305_fadd_mul_x4(acc[1U], b + (uint32_t)4U, r[1U], r5[1U]);
+    bool refill[2U] = { false, false };
+    for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+    {
+      uint32_t j = rec[l];
+      uint32_t g = l / (uint32_t)4U;
+      uint32_t ll = l % (uint32_t)4U;
+      if (j < cnt && seg[l] == (uint32_t)3U)
+      {
+        poly1305_finish_lane(tag[j], kl[l], acc[g], ll);
+        uint64_t keep[4U] = { ~(uint64_t)0U, ~(uint64_t)0U, ~(uint64_t)0U, ~(uint64_t)0U };
+        keep[ll] = (uint64_t)0U;
+        Lib_IntVector_Intrinsics_vec256
+        mask = Lib_IntVector_Intrinsics_vec256_load64s(keep[0U], keep[1U], keep[2U], keep[3U]);
+        for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+        {
+          acc[g][i] = Lib_IntVector_Intrinsics_vec256_and(acc[g][i], mask);
+        }
+        rec[l] = cnt;
+        active--;
+        if (next < cnt)
+        {
+          rec[l] = next;
+          kl[l] = keys + next * (uint32_t)32U;
+          seg[l] = (uint32_t)0U;
+          src[l] = aad[next];
+          left[l] = aadlen[next];
+          next++;
+          active++;
+          refill[g] = true;
+        }
+      }
+    }
+    for (uint32_t g = (uint32_t)0U; g < (uint32_t)2U; g++)
+    {
+      if (refill[g])
+      {
+        poly1305_load_r_x4(r[g], r5[g], kl + g * (uint32_t)4U);
+      }
+    }
+  }
+}
+
+void
+Hacl_Chacha20Poly1305_256_aead_encrypt_batch(
+  uint32_t len,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **mac
+)
+{
+  uint8_t keys[BATCH_CHUNK * (uint32_t)32U];
+  for (uint32_t i = (uint32_t)0U; i < len; i = i + BATCH_CHUNK)
+  {
+    uint32_t cnt = len - i;
+    if (cnt > BATCH_CHUNK)
+    {
+      cnt = BATCH_CHUNK;
+    }
+    chacha20_batch_256(cnt, k + i, n + i, mlen + i, m + i, cipher + i, keys, NULL);
+    poly1305_batch_256(cnt, keys, aadlen + i, aad + i, mlen + i, cipher + i, mac + i);
+  }
+}
+
+uint32_t
+Hacl_Chacha20Poly1305_256_aead_decrypt_batch(
+  uint32_t len,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **mac,
+  uint32_t *res
+)
+{
+  uint8_t keys[BATCH_CHUNK * (uint32_t)32U];
+  uint8_t computed[BATCH_CHUNK * (uint32_t)16U];
+  uint8_t *computed_mac[BATCH_CHUNK];
+  bool skip[BATCH_CHUNK];
+  uint32_t failed = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < BATCH_CHUNK; i++)
+  {
+    computed_mac[i] = computed + i * (uint32_t)16U;
+  }
+  for (uint32_t i = (uint32_t)0U; i < len; i = i + BATCH_CHUNK)
+  {
+    uint32_t cnt = len - i;
+    if (cnt > BATCH_CHUNK)
+    {
+      cnt = BATCH_CHUNK;
+    }
+    chacha20_batch_256(cnt, k + i, n + i, mlen + i, NULL, NULL, keys, NULL);
+    poly1305_batch_256(cnt, keys, aadlen + i, aad + i, mlen + i, cipher + i, computed_mac);
+    for (uint32_t j = (uint32_t)0U; j < cnt; j++)
+    {
+      uint8_t r = (uint8_t)255U;
+      for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)16U; i0++)
+      {
+        uint8_t uu____0 = FStar_UInt8_eq_mask(computed_mac[j][i0], mac[i + j][i0]);
+        r = uu____0 & r;
+      }
+      skip[j] = r != (uint8_t)255U;
+      res[i + j] = (uint32_t)skip[j];
+      failed = failed | res[i + j];
+    }
+    chacha20_batch_256(cnt, k + i, n + i, mlen + i, cipher + i, m + i, NULL, skip);
+  }
+  return failed;
+}
+
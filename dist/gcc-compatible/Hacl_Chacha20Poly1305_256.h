@@ -65,6 +65,44 @@ Hacl_Chacha20Poly1305_256_aead_decrypt(
   uint8_t *mac
 );
 
+/*
+  Seals len independent records in one call: record i is encrypted under key
+  k[i] and nonce n[i] exactly as Hacl_Chacha20Poly1305_256_aead_encrypt would.
+  Keystream blocks of different records share the vector lanes, which pays off
+  for short records where most lanes of a single call would go unused.
+*/
+void
+Hacl_Chacha20Poly1305_256_aead_encrypt_batch(
+  uint32_t len,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **mac
+);
+
+/*
+  Opens len independent records. res[i] is 0 if the tag of record i is valid,
+  in which case m[i] holds the plaintext, and 1 otherwise, in which case m[i]
+  is left untouched. Returns 0 if all tags are valid and 1 otherwise.
+*/
+uint32_t
+Hacl_Chacha20Poly1305_256_aead_decrypt_batch(
+  uint32_t len,
+  uint8_t **k,
+  uint8_t **n,
+  uint32_t *aadlen,
+  uint8_t **aad,
+  uint32_t *mlen,
+  uint8_t **m,
+  uint8_t **cipher,
+  uint8_t **mac,
+  uint32_t *res
+);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -891,3 +891,80 @@ Hacl_Chacha20_Vec256_chacha20_decrypt_256(
   }
 }
 
+static inline void transpose8_256(Lib_IntVector_Intrinsics_vec256 *v)
+{
+  Lib_IntVector_Intrinsics_vec256 v0_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v[0U], v[1U]);
+  Lib_IntVector_Intrinsics_vec256 v1_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v[0U], v[1U]);
+  Lib_IntVector_Intrinsics_vec256 v2_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v[2U], v[3U]);
+  Lib_IntVector_Intrinsics_vec256 v3_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v[2U], v[3U]);
+  Lib_IntVector_Intrinsics_vec256 v4_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v[4U], v[5U]);
+  Lib_IntVector_Intrinsics_vec256 v5_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v[4U], v[5U]);
+  Lib_IntVector_Intrinsics_vec256 v6_ = Lib_IntVector_Intrinsics_vec256_interleave_low32(v[6U], v[7U]);
+  Lib_IntVector_Intrinsics_vec256 v7_ = Lib_IntVector_Intrinsics_vec256_interleave_high32(v[6U], v[7U]);
+  Lib_IntVector_Intrinsics_vec256 v0__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v0_, v2_);
+  Lib_IntVector_Intrinsics_vec256 v1__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v0_, v2_);
+  Lib_IntVector_Intrinsics_vec256 v2__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v1_, v3_);
+  Lib_IntVector_Intrinsics_vec256 v3__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v1_, v3_);
+  Lib_IntVector_Intrinsics_vec256 v4__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v4_, v6_);
+  Lib_IntVector_Intrinsics_vec256 v5__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v4_, v6_);
+  Lib_IntVector_Intrinsics_vec256 v6__ = Lib_IntVector_Intrinsics_vec256_interleave_low64(v5_, v7_);
+  Lib_IntVector_Intrinsics_vec256 v7__ = Lib_IntVector_Intrinsics_vec256_interleave_high64(v5_, v7_);
+  v[0U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v0__, v4__);
+  v[4U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v0__, v4__);
+  v[1U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v1__, v5__);
+  v[5U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v1__, v5__);
+  v[2U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v2__, v6__);
+  v[6U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v2__, v6__);
+  v[3U] = Lib_IntVector_Intrinsics_vec256_interleave_low128(v3__, v7__);
+  v[7U] = Lib_IntVector_Intrinsics_vec256_interleave_high128(v3__, v7__);
+}
+
+void
+Hacl_Chacha20_Vec256_chacha20_blocks_256(
+  uint8_t *out,
+  uint8_t **key,
+  uint8_t **n,
+  uint32_t *ctr
+)
+{
+  uint32_t st[8U][16U];
+  Lib_IntVector_Intrinsics_vec256 ctx[16U];
+  Lib_IntVector_Intrinsics_vec256 k[16U];
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+  {
+    memcpy(st[l], Hacl_Impl_Chacha20_Vec_chacha20_constants, (uint32_t)4U * sizeof (uint32_t));
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+    {
+      st[l][(uint32_t)4U + i] = load32_le(key[l] + i * (uint32_t)4U);
+    }
+    st[l][12U] = ctr[l];
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)3U; i++)
+    {
+      st[l][(uint32_t)13U + i] = load32_le(n[l] + i * (uint32_t)4U);
+    }
+    ctx[l] = Lib_IntVector_Intrinsics_vec256_load32_le((uint8_t *)st[l]);
+    ctx[(uint32_t)8U + l] =
+      Lib_IntVector_Intrinsics_vec256_load32_le((uint8_t *)(st[l] + (uint32_t)8U));
+  }
+  /* Lane-major to word-major: ctx[i] now holds word i of all eight states */
+  transpose8_256(ctx);
+  transpose8_256(ctx + (uint32_t)8U);
+  memcpy(k, ctx, (uint32_t)16U * sizeof (Lib_IntVector_Intrinsics_vec256));
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)10U; i++)
+  {
+    double_round_256(k);
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+  {
+    k[i] = Lib_IntVector_Intrinsics_vec256_add32(k[i], ctx[i]);
+  }
+  transpose8_256(k);
+  transpose8_256(k + (uint32_t)8U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec256_store32_le(out + i * (uint32_t)64U, k[i]);
+    Lib_IntVector_Intrinsics_vec256_store32_le(out + i * (uint32_t)64U + (uint32_t)32U,
+      k[(uint32_t)8U + i]);
+  }
+}
+
@@ -60,6 +60,19 @@ Hacl_Chacha20_Vec256_chacha20_decrypt_256(
   uint32_t ctr
 );
 
+/*
+  Computes eight independent keystream blocks in one pass: block i uses key[i],
+  n[i] and counter ctr[i], and is written to out + 64 * i. This lets callers
+  spread the blocks of several short messages across the vector lanes.
+*/
+void
+Hacl_Chacha20_Vec256_chacha20_blocks_256(
+  uint8_t *out,
+  uint8_t **key,
+  uint8_t **n,
+  uint32_t *ctr
+);
+
 #if defined(__cplusplus)
 }
 #endif
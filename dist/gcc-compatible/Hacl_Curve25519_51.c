@@ -24,7 +24,7 @@
 
 #include "Hacl_Curve25519_51.h"
 
-static const uint8_t g25519[32U] = { (uint8_t)9U };
+#include "Hacl_Impl_Ed25519_PointMulG.h"
 
 static void point_add_and_double(uint64_t *q, uint64_t *p01_tmp1, FStar_UInt128_uint128 *tmp2)
 {
@@ -265,16 +265,13 @@ void Hacl_Curve25519_51_scalarmult(uint8_t *out, uint8_t *priv, uint8_t *pub)
   encode_point(out, init);
 }
 
+/*
+  [k]g25519 for the clamped scalar k, computed with the edwards25519 fixed-base
+  table (see Hacl_Impl_Ed25519_PointMulG.h). Same result as the ladder on u = 9.
+*/
 void Hacl_Curve25519_51_secret_to_public(uint8_t *pub, uint8_t *priv)
 {
-  uint8_t basepoint[32U] = { 0U };
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)32U; i++)
-  {
-    uint8_t *os = basepoint;
-    uint8_t x = g25519[i];
-    os[i] = x;
-  }
-  Hacl_Curve25519_51_scalarmult(pub, priv, basepoint);
+  Hacl_Impl_Ed25519_PointMulG_x25519_secret_to_public(pub, priv);
 }
 
 bool Hacl_Curve25519_51_ecdh(uint8_t *out, uint8_t *priv, uint8_t *pub)
@@ -24,6 +24,8 @@
 
 #include "Hacl_Curve25519_64.h"
 
+#include "Hacl_Impl_Ed25519_PointMulG.h"
+
 static inline uint64_t add_scalar0(uint64_t *out, uint64_t *f1, uint64_t f2)
 {
   #if HACL_CAN_COMPILE_INLINE_ASM
@@ -106,8 +108,6 @@ static inline void cswap20(uint64_t bit, uint64_t *p1, uint64_t *p2)
   #endif
 }
 
-static const uint8_t g25519[32U] = { (uint8_t)9U };
-
 static void point_add_and_double(uint64_t *q, uint64_t *p01_tmp1, uint64_t *tmp2)
 {
   uint64_t *nq = p01_tmp1;
@@ -358,14 +358,7 @@ void Hacl_Curve25519_64_scalarmult(uint8_t *out, uint8_t *priv, uint8_t *pub)
 
 void Hacl_Curve25519_64_secret_to_public(uint8_t *pub, uint8_t *priv)
 {
-  uint8_t basepoint[32U] = { 0U };
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)32U; i++)
-  {
-    uint8_t *os = basepoint;
-    uint8_t x = g25519[i];
-    os[i] = x;
-  }
-  Hacl_Curve25519_64_scalarmult(pub, priv, basepoint);
+  Hacl_Impl_Ed25519_PointMulG_x25519_secret_to_public(pub, priv);
 }
 
 bool Hacl_Curve25519_64_ecdh(uint8_t *out, uint8_t *priv, uint8_t *pub)
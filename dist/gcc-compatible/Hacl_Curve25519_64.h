@@ -43,6 +43,10 @@ extern "C" {
 
 void Hacl_Curve25519_64_scalarmult(uint8_t *out, uint8_t *priv, uint8_t *pub);
 
+/*
+  Fixed-base X25519 key generation. It uses the radix-2^51 edwards25519 table
+  shared with Ed25519 rather than the Vale field arithmetic of this module.
+*/
 void Hacl_Curve25519_64_secret_to_public(uint8_t *pub, uint8_t *priv);
 
 bool Hacl_Curve25519_64_ecdh(uint8_t *out, uint8_t *priv, uint8_t *pub);
@@ -0,0 +1,445 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#include "Hacl_Curve25519_IFMA.h"
+
+#define MASK51 ((uint64_t)0x7ffffffffffffU)
+
+/*
+  Field arithmetic. An element is five vectors of radix-2^51 limbs. IFMA only
+  reads the low 52 bits of its operands, so every value fed to fmul or fsqr has
+  limbs below 2^52; the functions below all return limbs below 2^51 + 2^15.
+*/
+
+static inline void carry_wide(Lib_IntVector_Intrinsics_vec512 *out, Lib_IntVector_Intrinsics_vec512 *r)
+{
+  /* One parallel carry pass suffices: the inputs are below 2^61, so every
+     carry is below 2^10. */
+  Lib_IntVector_Intrinsics_vec512 mask = Lib_IntVector_Intrinsics_vec512_load64(MASK51);
+  Lib_IntVector_Intrinsics_vec512 c0 = Lib_IntVector_Intrinsics_vec512_shift_right64(r[0U], (uint32_t)51U);
+  Lib_IntVector_Intrinsics_vec512 c1 = Lib_IntVector_Intrinsics_vec512_shift_right64(r[1U], (uint32_t)51U);
+  Lib_IntVector_Intrinsics_vec512 c2 = Lib_IntVector_Intrinsics_vec512_shift_right64(r[2U], (uint32_t)51U);
+  Lib_IntVector_Intrinsics_vec512 c3 = Lib_IntVector_Intrinsics_vec512_shift_right64(r[3U], (uint32_t)51U);
+  Lib_IntVector_Intrinsics_vec512 c4 = Lib_IntVector_Intrinsics_vec512_shift_right64(r[4U], (uint32_t)51U);
+  Lib_IntVector_Intrinsics_vec512
+  c4_19 =
+    Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_shift_left64(c4,
+          (uint32_t)4U),
+        Lib_IntVector_Intrinsics_vec512_shift_left64(c4, (uint32_t)1U)),
+      c4);
+  out[0U] = Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_and(r[0U], mask), c4_19);
+  out[1U] = Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_and(r[1U], mask), c0);
+  out[2U] = Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_and(r[2U], mask), c1);
+  out[3U] = Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_and(r[3U], mask), c2);
+  out[4U] = Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_and(r[4U], mask), c3);
+}
+
+static inline Lib_IntVector_Intrinsics_vec512 times19(Lib_IntVector_Intrinsics_vec512 x)
+{
+  return
+    Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_add64(Lib_IntVector_Intrinsics_vec512_shift_left64(x,
+          (uint32_t)4U),
+        Lib_IntVector_Intrinsics_vec512_shift_left64(x, (uint32_t)1U)),
+      x);
+}
+
+/*
+  Folds the ten columns of a product back to five limbs. Column k holds lo[k],
+  the sum of the low halves a_i*b_j mod 2^52 with i + j = k, and hi[k], the sum
+  of the high halves with i + j = k - 1. A high half weighs 2^52 = 2 * 2^51 in
+  column k, hence the doubling; columns 5..9 wrap around with 2^255 = 19.
+*/
+static inline void
+reduce_columns(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *lo,
+  Lib_IntVector_Intrinsics_vec512 *hi
+)
+{
+  Lib_IntVector_Intrinsics_vec512 z[10U];
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)10U; k++)
+  {
+    z[k] =
+      Lib_IntVector_Intrinsics_vec512_add64(lo[k],
+        Lib_IntVector_Intrinsics_vec512_shift_left64(hi[k], (uint32_t)1U));
+  }
+  Lib_IntVector_Intrinsics_vec512 r[5U];
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)5U; k++)
+  {
+    r[k] = Lib_IntVector_Intrinsics_vec512_add64(z[k], times19(z[k + (uint32_t)5U]));
+  }
+  carry_wide(out, r);
+}
+
+static inline void
+fmul(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *f,
+  Lib_IntVector_Intrinsics_vec512 *g
+)
+{
+  Lib_IntVector_Intrinsics_vec512 lo[10U];
+  Lib_IntVector_Intrinsics_vec512 hi[10U];
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)10U; k++)
+  {
+    lo[k] = Lib_IntVector_Intrinsics_vec512_zero;
+    hi[k] = Lib_IntVector_Intrinsics_vec512_zero;
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)5U; j++)
+    {
+      lo[i + j] = Lib_IntVector_Intrinsics_vec512_mul52lo_add(lo[i + j], f[i], g[j]);
+      hi[i + j + (uint32_t)1U] =
+        Lib_IntVector_Intrinsics_vec512_mul52hi_add(hi[i + j + (uint32_t)1U],
+          f[i],
+          g[j]);
+    }
+  }
+  reduce_columns(out, lo, hi);
+}
+
+static inline void fsqr(Lib_IntVector_Intrinsics_vec512 *out, Lib_IntVector_Intrinsics_vec512 *f)
+{
+  /* Cross products are accumulated once and doubled, which IFMA cannot do on
+     its operands: 2 * f_i may exceed 52 bits. */
+  Lib_IntVector_Intrinsics_vec512 lo[10U];
+  Lib_IntVector_Intrinsics_vec512 hi[10U];
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)10U; k++)
+  {
+    lo[k] = Lib_IntVector_Intrinsics_vec512_zero;
+    hi[k] = Lib_IntVector_Intrinsics_vec512_zero;
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    for (uint32_t j = i + (uint32_t)1U; j < (uint32_t)5U; j++)
+    {
+      lo[i + j] = Lib_IntVector_Intrinsics_vec512_mul52lo_add(lo[i + j], f[i], f[j]);
+      hi[i + j + (uint32_t)1U] =
+        Lib_IntVector_Intrinsics_vec512_mul52hi_add(hi[i + j + (uint32_t)1U],
+          f[i],
+          f[j]);
+    }
+  }
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)10U; k++)
+  {
+    lo[k] = Lib_IntVector_Intrinsics_vec512_shift_left64(lo[k], (uint32_t)1U);
+    hi[k] = Lib_IntVector_Intrinsics_vec512_shift_left64(hi[k], (uint32_t)1U);
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    lo[i + i] = Lib_IntVector_Intrinsics_vec512_mul52lo_add(lo[i + i], f[i], f[i]);
+    hi[i + i + (uint32_t)1U] =
+      Lib_IntVector_Intrinsics_vec512_mul52hi_add(hi[i + i + (uint32_t)1U],
+        f[i],
+        f[i]);
+  }
+  reduce_columns(out, lo, hi);
+}
+
+static inline void
+fsqr_times(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *f,
+  uint32_t n
+)
+{
+  fsqr(out, f);
+  for (uint32_t i = (uint32_t)0U; i < n - (uint32_t)1U; i++)
+  {
+    fsqr(out, out);
+  }
+}
+
+static inline void
+fadd(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *f,
+  Lib_IntVector_Intrinsics_vec512 *g
+)
+{
+  Lib_IntVector_Intrinsics_vec512 r[5U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    r[i] = Lib_IntVector_Intrinsics_vec512_add64(f[i], g[i]);
+  }
+  carry_wide(out, r);
+}
+
+static inline void
+fsub(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *f,
+  Lib_IntVector_Intrinsics_vec512 *g
+)
+{
+  /* Adds 4p, whose limbs exceed any g limb below 2^52. */
+  Lib_IntVector_Intrinsics_vec512
+  p0 = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x1fffffffffffb4U);
+  Lib_IntVector_Intrinsics_vec512
+  p1 = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x1ffffffffffffcU);
+  Lib_IntVector_Intrinsics_vec512 r[5U];
+  r[0U] =
+    Lib_IntVector_Intrinsics_vec512_sub64(Lib_IntVector_Intrinsics_vec512_add64(f[0U], p0),
+      g[0U]);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)5U; i++)
+  {
+    r[i] =
+      Lib_IntVector_Intrinsics_vec512_sub64(Lib_IntVector_Intrinsics_vec512_add64(f[i], p1),
+        g[i]);
+  }
+  carry_wide(out, r);
+}
+
+static inline void fmul_a24(Lib_IntVector_Intrinsics_vec512 *out, Lib_IntVector_Intrinsics_vec512 *f)
+{
+  Lib_IntVector_Intrinsics_vec512 a24 = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)121665U);
+  Lib_IntVector_Intrinsics_vec512 lo[5U];
+  Lib_IntVector_Intrinsics_vec512 hi[6U];
+  hi[0U] = Lib_IntVector_Intrinsics_vec512_zero;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    lo[i] =
+      Lib_IntVector_Intrinsics_vec512_mul52lo_add(Lib_IntVector_Intrinsics_vec512_zero,
+        f[i],
+        a24);
+    hi[i + (uint32_t)1U] =
+      Lib_IntVector_Intrinsics_vec512_mul52hi_add(Lib_IntVector_Intrinsics_vec512_zero,
+        f[i],
+        a24);
+  }
+  Lib_IntVector_Intrinsics_vec512 r[5U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    r[i] =
+      Lib_IntVector_Intrinsics_vec512_add64(lo[i],
+        Lib_IntVector_Intrinsics_vec512_shift_left64(hi[i], (uint32_t)1U));
+  }
+  r[0U] =
+    Lib_IntVector_Intrinsics_vec512_add64(r[0U],
+      times19(Lib_IntVector_Intrinsics_vec512_shift_left64(hi[5U], (uint32_t)1U)));
+  carry_wide(out, r);
+}
+
+static inline void
+cswap(
+  Lib_IntVector_Intrinsics_vec512 mask,
+  Lib_IntVector_Intrinsics_vec512 *f,
+  Lib_IntVector_Intrinsics_vec512 *g
+)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512
+    d = Lib_IntVector_Intrinsics_vec512_and(mask, Lib_IntVector_Intrinsics_vec512_xor(f[i], g[i]));
+    f[i] = Lib_IntVector_Intrinsics_vec512_xor(f[i], d);
+    g[i] = Lib_IntVector_Intrinsics_vec512_xor(g[i], d);
+  }
+}
+
+/* The addition chain of Hacl_Curve25519_51_finv, computing i^(p - 2). */
+static void finv(Lib_IntVector_Intrinsics_vec512 *o, Lib_IntVector_Intrinsics_vec512 *i)
+{
+  Lib_IntVector_Intrinsics_vec512 a[5U];
+  Lib_IntVector_Intrinsics_vec512 b[5U];
+  Lib_IntVector_Intrinsics_vec512 c[5U];
+  Lib_IntVector_Intrinsics_vec512 t0[5U];
+  fsqr_times(a, i, (uint32_t)1U);
+  fsqr_times(t0, a, (uint32_t)2U);
+  fmul(b, t0, i);
+  fmul(a, b, a);
+  fsqr_times(t0, a, (uint32_t)1U);
+  fmul(b, t0, b);
+  fsqr_times(t0, b, (uint32_t)5U);
+  fmul(b, t0, b);
+  fsqr_times(t0, b, (uint32_t)10U);
+  fmul(c, t0, b);
+  fsqr_times(t0, c, (uint32_t)20U);
+  fmul(t0, t0, c);
+  fsqr_times(t0, t0, (uint32_t)10U);
+  fmul(b, t0, b);
+  fsqr_times(t0, b, (uint32_t)50U);
+  fmul(c, t0, b);
+  fsqr_times(t0, c, (uint32_t)100U);
+  fmul(t0, t0, c);
+  fsqr_times(t0, t0, (uint32_t)50U);
+  fmul(t0, t0, b);
+  fsqr_times(t0, t0, (uint32_t)5U);
+  fmul(o, t0, a);
+}
+
+/*
+  RFC 7748 ladder on eight lanes. k holds the clamped scalars as four vectors of
+  64-bit words; u is the input coordinate; on return, out holds x2 / z2.
+*/
+static void
+montgomery_ladder(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *k,
+  Lib_IntVector_Intrinsics_vec512 *u
+)
+{
+  Lib_IntVector_Intrinsics_vec512 x2[5U];
+  Lib_IntVector_Intrinsics_vec512 z2[5U];
+  Lib_IntVector_Intrinsics_vec512 x3[5U];
+  Lib_IntVector_Intrinsics_vec512 z3[5U];
+  Lib_IntVector_Intrinsics_vec512 a[5U];
+  Lib_IntVector_Intrinsics_vec512 aa[5U];
+  Lib_IntVector_Intrinsics_vec512 b[5U];
+  Lib_IntVector_Intrinsics_vec512 bb[5U];
+  Lib_IntVector_Intrinsics_vec512 e[5U];
+  Lib_IntVector_Intrinsics_vec512 c[5U];
+  Lib_IntVector_Intrinsics_vec512 d[5U];
+  Lib_IntVector_Intrinsics_vec512 da[5U];
+  Lib_IntVector_Intrinsics_vec512 cb[5U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    x2[i] = Lib_IntVector_Intrinsics_vec512_zero;
+    z2[i] = Lib_IntVector_Intrinsics_vec512_zero;
+    x3[i] = u[i];
+    z3[i] = Lib_IntVector_Intrinsics_vec512_zero;
+  }
+  x2[0U] = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)1U);
+  z3[0U] = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)1U);
+  Lib_IntVector_Intrinsics_vec512 one = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)1U);
+  Lib_IntVector_Intrinsics_vec512 swap = Lib_IntVector_Intrinsics_vec512_zero;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)255U; i++)
+  {
+    uint32_t t = (uint32_t)254U - i;
+    Lib_IntVector_Intrinsics_vec512
+    bit =
+      Lib_IntVector_Intrinsics_vec512_and(Lib_IntVector_Intrinsics_vec512_shift_right64(k[t
+          / (uint32_t)64U],
+          t % (uint32_t)64U),
+        one);
+    Lib_IntVector_Intrinsics_vec512 sw = Lib_IntVector_Intrinsics_vec512_xor(swap, bit);
+    Lib_IntVector_Intrinsics_vec512
+    mask = Lib_IntVector_Intrinsics_vec512_sub64(Lib_IntVector_Intrinsics_vec512_zero, sw);
+    cswap(mask, x2, x3);
+    cswap(mask, z2, z3);
+    swap = bit;
+    fadd(a, x2, z2);
+    fsqr(aa, a);
+    fsub(b, x2, z2);
+    fsqr(bb, b);
+    fsub(e, aa, bb);
+    fadd(c, x3, z3);
+    fsub(d, x3, z3);
+    fmul(da, d, a);
+    fmul(cb, c, b);
+    fadd(x3, da, cb);
+    fsqr(x3, x3);
+    fsub(z3, da, cb);
+    fsqr(z3, z3);
+    fmul(z3, z3, u);
+    fmul(x2, aa, bb);
+    fmul_a24(z2, e);
+    fadd(z2, z2, aa);
+    fmul(z2, z2, e);
+  }
+  Lib_IntVector_Intrinsics_vec512
+  mask = Lib_IntVector_Intrinsics_vec512_sub64(Lib_IntVector_Intrinsics_vec512_zero, swap);
+  cswap(mask, x2, x3);
+  cswap(mask, z2, z3);
+  finv(z2, z2);
+  fmul(out, x2, z2);
+}
+
+/* Eight lanes; lanes at or above n repeat lane 0 and are not written back. */
+static void
+scalarmult8(uint32_t n, uint8_t **outs, uint8_t **privs, uint8_t **pubs)
+{
+  uint64_t kw[4U][8U];
+  uint64_t uw[5U][8U];
+  for (uint32_t l = (uint32_t)0U; l < (uint32_t)8U; l++)
+  {
+    uint32_t src = l < n ? l : (uint32_t)0U;
+    uint8_t key[32U];
+    memcpy(key, privs[src], (uint32_t)32U * sizeof (uint8_t));
+    key[0U] = key[0U] & (uint8_t)248U;
+    key[31U] = (key[31U] & (uint8_t)127U) | (uint8_t)64U;
+    for (uint32_t w = (uint32_t)0U; w < (uint32_t)4U; w++)
+    {
+      kw[w][l] = load64_le(key + w * (uint32_t)8U);
+    }
+    Lib_Memzero0_memzero(key, (uint32_t)32U * sizeof (key[0U]));
+    uint8_t *pub = pubs[src];
+    uint64_t t0 = load64_le(pub);
+    uint64_t t1 = load64_le(pub + (uint32_t)8U);
+    uint64_t t2 = load64_le(pub + (uint32_t)16U);
+    uint64_t t3 = load64_le(pub + (uint32_t)24U) & (uint64_t)0x7fffffffffffffffU;
+    uw[0U][l] = t0 & MASK51;
+    uw[1U][l] = (t0 >> (uint32_t)51U | t1 << (uint32_t)13U) & MASK51;
+    uw[2U][l] = (t1 >> (uint32_t)38U | t2 << (uint32_t)26U) & MASK51;
+    uw[3U][l] = (t2 >> (uint32_t)25U | t3 << (uint32_t)39U) & MASK51;
+    uw[4U][l] = t3 >> (uint32_t)12U;
+  }
+  Lib_IntVector_Intrinsics_vec512 k[4U];
+  Lib_IntVector_Intrinsics_vec512 u[5U];
+  Lib_IntVector_Intrinsics_vec512 r[5U];
+  for (uint32_t w = (uint32_t)0U; w < (uint32_t)4U; w++)
+  {
+    k[w] = Lib_IntVector_Intrinsics_vec512_load64_le(kw[w]);
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    u[i] = Lib_IntVector_Intrinsics_vec512_load64_le(uw[i]);
+  }
+  Lib_Memzero0_memzero(kw, (uint32_t)32U * sizeof (kw[0U][0U]));
+  montgomery_ladder(r, k, u);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512_store64_le(uw[i], r[i]);
+  }
+  for (uint32_t l = (uint32_t)0U; l < n && l < (uint32_t)8U; l++)
+  {
+    uint64_t f[5U];
+    uint64_t u64s[4U];
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+    {
+      f[i] = uw[i][l];
+    }
+    Hacl_Impl_Curve25519_Field51_store_felem(u64s, f);
+    for (uint32_t w = (uint32_t)0U; w < (uint32_t)4U; w++)
+    {
+      store64_le(outs[l] + w * (uint32_t)8U, u64s[w]);
+    }
+  }
+}
+
+void
+Hacl_Curve25519_IFMA_batch_scalarmult(
+  uint32_t n,
+  uint8_t **outs,
+  uint8_t **privs,
+  uint8_t **pubs
+)
+{
+  for (uint32_t i = (uint32_t)0U; i < n; i = i + (uint32_t)8U)
+  {
+    scalarmult8(n - i, outs + i, privs + i, pubs + i);
+  }
+}
+
@@ -0,0 +1,73 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#ifndef __Hacl_Curve25519_IFMA_H
+#define __Hacl_Curve25519_IFMA_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+#include "Lib_Memzero0.h"
+#include "Hacl_Bignum25519_51.h"
+
+/*
+  X25519 on eight independent inputs at once, for CPUs with AVX-512 IFMA.
+
+  Each 512-bit register holds one limb of the same field element for eight
+  lanes. Field elements use the radix-2^51 representation of
+  Hacl_Curve25519_51, and products are computed with vpmadd52luq/vpmadd52huq.
+  Every lane runs its own constant-time Montgomery ladder: the conditional
+  swaps are driven by per-lane masks, so no lane's scalar affects the
+  instruction stream.
+
+  outs[i] receives the X25519 function of privs[i] and pubs[i], exactly as
+  Hacl_Curve25519_51_scalarmult computes it, for i < n. Any n is accepted; the
+  last group is padded by repeating its first input. Callers must check
+  EverCrypt_AutoConfig2_has_ifma() first.
+*/
+void
+Hacl_Curve25519_IFMA_batch_scalarmult(
+  uint32_t n,
+  uint8_t **outs,
+  uint8_t **privs,
+  uint8_t **pubs
+);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_Curve25519_IFMA_H_DEFINED
+#endif
@@ -24,6 +24,9 @@
 
 #include "Hacl_Ed25519.h"
 
+#include "Hacl_Ed25519_PrecompTable.h"
+#include "Hacl_Impl_Ed25519_PointMulG.h"
+
 static inline void fsum(uint64_t *a, uint64_t *b)
 {
   Hacl_Impl_Curve25519_Field51_fadd(a, a, b);
@@ -455,9 +458,8 @@ void Hacl_Impl_Ed25519_Ladder_point_mul(uint64_t *result, uint8_t *scalar, uint6
   memcpy(result, nq, (uint32_t)20U * sizeof (uint64_t));
 }
 
-static inline void point_mul_g(uint64_t *result, uint8_t *scalar)
+static inline void make_g(uint64_t *g)
 {
-  uint64_t g[20U] = { 0U };
   uint64_t *gx = g;
   uint64_t *gy = g + (uint32_t)5U;
   uint64_t *gz = g + (uint32_t)10U;
@@ -482,7 +484,64 @@ static inline void point_mul_g(uint64_t *result, uint8_t *scalar)
   gt[2U] = (uint64_t)0x0002af8df483c27eU;
   gt[3U] = (uint64_t)0x000332b375274732U;
   gt[4U] = (uint64_t)0x00067875f0fd78b7U;
-  Hacl_Impl_Ed25519_Ladder_point_mul(result, scalar, g);
+}
+
+static inline void make_point_inf(uint64_t *b)
+{
+  uint64_t *x = b;
+  uint64_t *y = b + (uint32_t)5U;
+  uint64_t *z = b + (uint32_t)10U;
+  uint64_t *t = b + (uint32_t)15U;
+  memset(x, 0U, (uint32_t)5U * sizeof (uint64_t));
+  memset(y, 0U, (uint32_t)5U * sizeof (uint64_t));
+  y[0U] = (uint64_t)1U;
+  memset(z, 0U, (uint32_t)5U * sizeof (uint64_t));
+  z[0U] = (uint64_t)1U;
+  memset(t, 0U, (uint32_t)5U * sizeof (uint64_t));
+}
+
+static inline void point_add_precomp(uint64_t *out, uint64_t *p, uint64_t *q)
+{
+  uint64_t tmp[40U] = { 0U };
+  uint64_t *a = tmp;
+  uint64_t *b = tmp + (uint32_t)5U;
+  uint64_t *c = tmp + (uint32_t)10U;
+  uint64_t *d = tmp + (uint32_t)15U;
+  uint64_t *e = tmp + (uint32_t)20U;
+  uint64_t *f = tmp + (uint32_t)25U;
+  uint64_t *g = tmp + (uint32_t)30U;
+  uint64_t *h = tmp + (uint32_t)35U;
+  uint64_t *x1 = p;
+  uint64_t *y1 = p + (uint32_t)5U;
+  uint64_t *z1 = p + (uint32_t)10U;
+  uint64_t *t1 = p + (uint32_t)15U;
+  uint64_t *ypx2 = q;
+  uint64_t *ymx2 = q + (uint32_t)5U;
+  uint64_t *xy2d2 = q + (uint32_t)10U;
+  memcpy(e, x1, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(e, y1);
+  fmul0(a, e, ymx2);
+  memcpy(e, y1, (uint32_t)5U * sizeof (uint64_t));
+  fsum(e, x1);
+  fmul0(b, e, ypx2);
+  fmul0(c, t1, xy2d2);
+  times_2(d, z1);
+  memcpy(e, a, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(e, b);
+  memcpy(f, c, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(f, d);
+  memcpy(g, d, (uint32_t)5U * sizeof (uint64_t));
+  fsum(g, c);
+  memcpy(h, b, (uint32_t)5U * sizeof (uint64_t));
+  fsum(h, a);
+  uint64_t *x3 = out;
+  uint64_t *y3 = out + (uint32_t)5U;
+  uint64_t *z3 = out + (uint32_t)10U;
+  uint64_t *t3 = out + (uint32_t)15U;
+  fmul0(x3, e, f);
+  fmul0(y3, g, h);
+  fmul0(t3, e, h);
+  fmul0(z3, f, g);
 }
 
 void Hacl_Impl_Ed25519_PointCompress_point_compress(uint8_t *z, uint64_t *p)
@@ -525,7 +584,7 @@ static inline void secret_to_public(uint8_t *out, uint8_t *secret)
   uint64_t res[20U] = { 0U };
   secret_expand(expanded_secret, secret);
   uint8_t *a = expanded_secret;
-  point_mul_g(res, a);
+  Hacl_Impl_Ed25519_PointMulG_point_mul_g(res, a);
   Hacl_Impl_Ed25519_PointCompress_point_compress(out, res);
 }
 
@@ -1283,7 +1342,7 @@ sha512_modq_pre_pre2(
 static inline void point_mul_g_compress(uint8_t *out, uint8_t *s)
 {
   uint64_t tmp[20U] = { 0U };
-  point_mul_g(tmp, s);
+  Hacl_Impl_Ed25519_PointMulG_point_mul_g(tmp, s);
   Hacl_Impl_Ed25519_PointCompress_point_compress(out, tmp);
 }
 
@@ -1659,6 +1718,130 @@ void Hacl_Impl_Ed25519_PointNegate_point_negate(uint64_t *p, uint64_t *out)
   Hacl_Bignum25519_reduce_513(t1);
 }
 
+/*
+  Width-w non-adjacent form of a 32-byte little-endian scalar < 2^253: every
+  non-zero digit is odd, lies in (-2^(w-1), 2^(w-1)) and is followed by at least
+  w - 1 zeros. Variable-time: only used on public scalars.
+*/
+static inline void recode_wnaf(int8_t *naf, uint8_t *scalar, uint32_t w)
+{
+  uint64_t k[5U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    k[i] = load64_le(scalar + i * (uint32_t)8U);
+  }
+  memset(naf, 0U, (uint32_t)256U * sizeof (int8_t));
+  uint64_t window = ((uint64_t)1U << w) - (uint64_t)1U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)256U; i++)
+  {
+    if (k[0U] & (uint64_t)1U)
+    {
+      int64_t d = (int64_t)(k[0U] & window);
+      if (d >= (int64_t)1 << (w - (uint32_t)1U))
+      {
+        d = d - ((int64_t)1 << w);
+      }
+      naf[i] = (int8_t)d;
+      if (d > (int64_t)0)
+      {
+        k[0U] = k[0U] - (uint64_t)d;
+      }
+      else
+      {
+        uint64_t c = (uint64_t)(-d);
+        for (uint32_t j = (uint32_t)0U; j < (uint32_t)5U; j++)
+        {
+          uint64_t kj = k[j] + c;
+          c = (uint64_t)(kj < c);
+          k[j] = kj;
+        }
+      }
+    }
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      k[j] = k[j] >> (uint32_t)1U | k[j + (uint32_t)1U] << (uint32_t)63U;
+    }
+    k[4U] = k[4U] >> (uint32_t)1U;
+  }
+}
+
+static inline void precomp_negate(uint64_t *out, const uint64_t *q)
+{
+  uint64_t zero[5U] = { 0U };
+  memcpy(out, q + (uint32_t)5U, (uint32_t)5U * sizeof (uint64_t));
+  memcpy(out + (uint32_t)5U, q, (uint32_t)5U * sizeof (uint64_t));
+  memcpy(out + (uint32_t)10U, q + (uint32_t)10U, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(out + (uint32_t)10U, zero);
+  Hacl_Bignum25519_reduce_513(out + (uint32_t)10U);
+}
+
+/*
+  Variable-time double-scalar multiplication out = [s]B - [h]A (Straus'
+  interleaving): s is recoded in width-8 NAF against the static table of odd
+  multiples of B, h in width-5 NAF against a table of [1]A, [3]A, ..., [15]A
+  built on the fly. Both scalars are 32-byte little-endian values < q; all
+  inputs are public.
+*/
+static void point_mul_g_double_vartime(uint64_t *out, uint8_t *s, uint8_t *h, uint64_t *a)
+{
+  int8_t naf_s[256U] = { 0U };
+  int8_t naf_h[256U] = { 0U };
+  uint64_t table_a[160U] = { 0U };
+  uint64_t tmp[40U] = { 0U };
+  uint64_t *a2 = tmp;
+  uint64_t *neg = tmp + (uint32_t)20U;
+  uint64_t q[15U] = { 0U };
+  recode_wnaf(naf_s, s, (uint32_t)8U);
+  recode_wnaf(naf_h, h, (uint32_t)5U);
+  Hacl_Impl_Ed25519_PointNegate_point_negate(a, table_a);
+  point_double(a2, table_a);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)8U; i++)
+  {
+    Hacl_Impl_Ed25519_PointAdd_point_add(table_a + i * (uint32_t)20U,
+      table_a + (i - (uint32_t)1U) * (uint32_t)20U,
+      a2);
+  }
+  uint32_t top = (uint32_t)256U;
+  while (top > (uint32_t)0U && naf_s[top - (uint32_t)1U] == (int8_t)0 && naf_h[top - (uint32_t)1U] == (int8_t)0)
+  {
+    top = top - (uint32_t)1U;
+  }
+  make_point_inf(out);
+  for (uint32_t i0 = (uint32_t)0U; i0 < top; i0++)
+  {
+    uint32_t i = top - (uint32_t)1U - i0;
+    if (i0 > (uint32_t)0U)
+    {
+      point_double(out, out);
+    }
+    int8_t ds = naf_s[i];
+    if (ds > (int8_t)0)
+    {
+      memcpy(q,
+        Hacl_Ed25519_PrecompTable_precomp_basepoint_odd_w8 + (uint32_t)(ds / (int8_t)2) * (uint32_t)15U,
+        (uint32_t)15U * sizeof (uint64_t));
+      point_add_precomp(out, out, q);
+    }
+    else if (ds < (int8_t)0)
+    {
+      precomp_negate(q,
+        Hacl_Ed25519_PrecompTable_precomp_basepoint_odd_w8 + (uint32_t)(-ds / (int8_t)2) * (uint32_t)15U);
+      point_add_precomp(out, out, q);
+    }
+    int8_t dh = naf_h[i];
+    if (dh > (int8_t)0)
+    {
+      Hacl_Impl_Ed25519_PointAdd_point_add(out, out, table_a + (uint32_t)(dh / (int8_t)2) * (uint32_t)20U);
+    }
+    else if (dh < (int8_t)0)
+    {
+      Hacl_Impl_Ed25519_PointNegate_point_negate(table_a + (uint32_t)(-dh / (int8_t)2) * (uint32_t)20U,
+        neg);
+      Hacl_Impl_Ed25519_PointAdd_point_add(out, out, neg);
+    }
+  }
+}
+
 void Hacl_Ed25519_sign(uint8_t *signature, uint8_t *priv, uint32_t len, uint8_t *msg)
 {
   uint8_t ks[96U] = { 0U };
@@ -1697,14 +1880,9 @@ bool Hacl_Ed25519_verify(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *sign
         sha512_modq_pre_pre2(r_2, rs1, pub, len, msg);
         store_56(tmp_, r_2);
         uint8_t *uu____0 = signature + (uint32_t)32U;
-        uint64_t tmp1[60U] = { 0U };
-        uint64_t *hA = tmp1;
-        uint64_t *rhA = tmp1 + (uint32_t)20U;
-        uint64_t *sB = tmp1 + (uint32_t)40U;
-        point_mul_g(sB, uu____0);
-        Hacl_Impl_Ed25519_Ladder_point_mul(hA, tmp_, a_1);
-        Hacl_Impl_Ed25519_PointAdd_point_add(rhA, r_1, hA);
-        bool b1 = Hacl_Impl_Ed25519_PointEqual_point_equal(sB, rhA);
+        uint64_t sBmhA[20U] = { 0U };
+        point_mul_g_double_vartime(sBmhA, uu____0, tmp_, a_1);
+        bool b1 = Hacl_Impl_Ed25519_PointEqual_point_equal(sBmhA, r_1);
         bool b10 = b1;
         res = b10;
       }
@@ -1722,6 +1900,308 @@ bool Hacl_Ed25519_verify(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *sign
   return res0;
 }
 
+/*
+  Signed radix-2^5 recoding of a 32-byte little-endian scalar s < 2^253 into
+  52 digits in [-15, 16], least significant first. Variable-time callers only.
+*/
+static inline void recode_signed_w5(int8_t *digits, uint8_t *scalar)
+{
+  uint32_t carry = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)52U; i++)
+  {
+    uint32_t bit = i * (uint32_t)5U;
+    uint32_t k = bit >> (uint32_t)3U;
+    uint32_t lo = (uint32_t)0U;
+    uint32_t hi = (uint32_t)0U;
+    if (k < (uint32_t)32U)
+    {
+      lo = (uint32_t)scalar[k];
+    }
+    if (k + (uint32_t)1U < (uint32_t)32U)
+    {
+      hi = (uint32_t)scalar[k + (uint32_t)1U];
+    }
+    uint32_t w = ((lo | hi << (uint32_t)8U) >> (bit & (uint32_t)7U) & (uint32_t)31U) + carry;
+    if (w > (uint32_t)16U)
+    {
+      digits[i] = (int8_t)((int32_t)w - (int32_t)32);
+      carry = (uint32_t)1U;
+    }
+    else
+    {
+      digits[i] = (int8_t)w;
+      carry = (uint32_t)0U;
+    }
+  }
+}
+
+/*
+  Variable-time multi-scalar multiplication (Pippenger's bucket method with
+  signed 5-bit windows): out = sum_j [scalars_j] points_j. Points are in
+  extended coordinates (20 limbs each); scalars are 32-byte little-endian and
+  must be < 2^253. Only ever call this on public data.
+*/
+static void
+msm_vartime(uint64_t *out, uint32_t len, uint64_t *points, uint8_t *scalars, int8_t *digits)
+{
+  uint64_t buckets[320U] = { 0U };
+  bool used[16U] = { 0U };
+  uint64_t tmp[60U] = { 0U };
+  uint64_t *neg = tmp;
+  uint64_t *running = tmp + (uint32_t)20U;
+  uint64_t *window = tmp + (uint32_t)40U;
+  bool acc_inf = true;
+  for (uint32_t j = (uint32_t)0U; j < len; j++)
+  {
+    recode_signed_w5(digits + j * (uint32_t)52U, scalars + j * (uint32_t)32U);
+  }
+  make_point_inf(out);
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)52U; i0++)
+  {
+    uint32_t w = (uint32_t)51U - i0;
+    if (!acc_inf)
+    {
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+      {
+        point_double(out, out);
+      }
+    }
+    memset(used, 0U, (uint32_t)16U * sizeof (bool));
+    for (uint32_t j = (uint32_t)0U; j < len; j++)
+    {
+      int8_t d = digits[j * (uint32_t)52U + w];
+      if (d != (int8_t)0)
+      {
+        uint64_t *p = points + j * (uint32_t)20U;
+        uint32_t b;
+        if (d > (int8_t)0)
+        {
+          b = (uint32_t)d - (uint32_t)1U;
+        }
+        else
+        {
+          Hacl_Impl_Ed25519_PointNegate_point_negate(p, neg);
+          p = neg;
+          b = (uint32_t)(-(int32_t)d) - (uint32_t)1U;
+        }
+        uint64_t *bucket = buckets + b * (uint32_t)20U;
+        if (used[b])
+        {
+          Hacl_Impl_Ed25519_PointAdd_point_add(bucket, bucket, p);
+        }
+        else
+        {
+          memcpy(bucket, p, (uint32_t)20U * sizeof (uint64_t));
+          used[b] = true;
+        }
+      }
+    }
+    /* window = sum_b (b + 1) * bucket_b, via a running sum from the top bucket down */
+    bool running_inf = true;
+    bool window_inf = true;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+    {
+      uint32_t b = (uint32_t)15U - i;
+      if (used[b])
+      {
+        uint64_t *bucket = buckets + b * (uint32_t)20U;
+        if (running_inf)
+        {
+          memcpy(running, bucket, (uint32_t)20U * sizeof (uint64_t));
+          running_inf = false;
+        }
+        else
+        {
+          Hacl_Impl_Ed25519_PointAdd_point_add(running, running, bucket);
+        }
+      }
+      if (!running_inf)
+      {
+        if (window_inf)
+        {
+          memcpy(window, running, (uint32_t)20U * sizeof (uint64_t));
+          window_inf = false;
+        }
+        else
+        {
+          Hacl_Impl_Ed25519_PointAdd_point_add(window, window, running);
+        }
+      }
+    }
+    if (!window_inf)
+    {
+      if (acc_inf)
+      {
+        memcpy(out, window, (uint32_t)20U * sizeof (uint64_t));
+        acc_inf = false;
+      }
+      else
+      {
+        Hacl_Impl_Ed25519_PointAdd_point_add(out, out, window);
+      }
+    }
+  }
+}
+
+/*
+  The cofactored equation [8]([s]B - [h]A - R) == 0 for one signature, with the
+  same decoding and s < q checks as Hacl_Ed25519_verify. This is what
+  Hacl_Ed25519_verify_batch decides for each signature.
+*/
+static bool verify_cofactored(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *signature)
+{
+  uint64_t tmp[60U] = { 0U };
+  uint64_t *a_ = tmp;
+  uint64_t *r_ = tmp + (uint32_t)20U;
+  uint64_t *t = tmp + (uint32_t)40U;
+  uint64_t s[5U] = { 0U };
+  uint64_t h[5U] = { 0U };
+  uint8_t hbytes[32U] = { 0U };
+  if
+  (
+    !(Hacl_Impl_Ed25519_PointDecompress_point_decompress(a_, pub)
+    && Hacl_Impl_Ed25519_PointDecompress_point_decompress(r_, signature))
+  )
+  {
+    return false;
+  }
+  load_32_bytes(s, signature + (uint32_t)32U);
+  if (gte_q(s))
+  {
+    return false;
+  }
+  sha512_modq_pre_pre2(h, signature, pub, len, msg);
+  store_56(hbytes, h);
+  point_mul_g_double_vartime(t, signature + (uint32_t)32U, hbytes, a_);
+  Hacl_Impl_Ed25519_PointNegate_point_negate(r_, a_);
+  Hacl_Impl_Ed25519_PointAdd_point_add(t, t, a_);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)3U; i++)
+  {
+    point_double(t, t);
+  }
+  make_point_inf(a_);
+  return Hacl_Impl_Ed25519_PointEqual_point_equal(t, a_);
+}
+
+/*
+  Checks up to 64 signatures with one random linear combination
+    [8]([sum z_i s_i](-B) + sum [z_i] R_i + sum [z_i h_i] A_i) == 0
+  where the z_i are fresh 128-bit random coefficients. The factor 8 clears the
+  small-order components of the A_i and R_i, so the outcome does not depend on
+  the z_i: it is that of verify_cofactored on every signature, except with
+  probability below 2^-120 when some signature is invalid. Signatures that fail
+  decoding or the s < q check are rejected up front; if the combined equation
+  does not hold, every remaining signature is re-checked with verify_cofactored
+  so that results pinpoints the invalid ones.
+*/
+static bool
+verify_batch_chunk(
+  uint32_t n,
+  uint8_t **pubs,
+  uint32_t *lens,
+  uint8_t **msgs,
+  uint8_t **sigs,
+  bool *results
+)
+{
+  uint64_t points[2580U] = { 0U };
+  uint8_t scalars[4128U] = { 0U };
+  int8_t digits[6708U] = { 0U };
+  uint8_t zs[1024U] = { 0U };
+  uint64_t tmp[25U] = { 0U };
+  uint64_t *zi = tmp;
+  uint64_t *hi = tmp + (uint32_t)5U;
+  uint64_t *si = tmp + (uint32_t)10U;
+  uint64_t *prod = tmp + (uint32_t)15U;
+  uint64_t *sum_zs = tmp + (uint32_t)20U;
+  uint8_t zbytes[32U] = { 0U };
+  uint32_t k = (uint32_t)0U;
+  bool ok = true;
+  Lib_RandomBuffer_System_crypto_random(zs, n * (uint32_t)16U);
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    uint8_t *sig = sigs[i];
+    uint64_t *a_ = points + k * (uint32_t)20U;
+    uint64_t *r_ = points + (k + (uint32_t)1U) * (uint32_t)20U;
+    results[i] = false;
+    if
+    (
+      Hacl_Impl_Ed25519_PointDecompress_point_decompress(a_, pubs[i])
+      && Hacl_Impl_Ed25519_PointDecompress_point_decompress(r_, sig)
+    )
+    {
+      load_32_bytes(si, sig + (uint32_t)32U);
+      if (!gte_q(si))
+      {
+        sha512_modq_pre_pre2(hi, sig, pubs[i], lens[i], msgs[i]);
+        memcpy(zbytes, zs + i * (uint32_t)16U, (uint32_t)16U * sizeof (uint8_t));
+        load_32_bytes(zi, zbytes);
+        mul_modq(prod, zi, hi);
+        store_56(scalars + k * (uint32_t)32U, prod);
+        memcpy(scalars + (k + (uint32_t)1U) * (uint32_t)32U, zbytes, (uint32_t)32U * sizeof (uint8_t));
+        mul_modq(prod, zi, si);
+        add_modq(sum_zs, sum_zs, prod);
+        results[i] = true;
+        k = k + (uint32_t)2U;
+      }
+    }
+    ok = ok && results[i];
+  }
+  if (k == (uint32_t)0U)
+  {
+    return ok;
+  }
+  uint64_t g[20U] = { 0U };
+  make_g(g);
+  Hacl_Impl_Ed25519_PointNegate_point_negate(g, points + k * (uint32_t)20U);
+  store_56(scalars + k * (uint32_t)32U, sum_zs);
+  k = k + (uint32_t)1U;
+  uint64_t res[20U] = { 0U };
+  uint64_t inf[20U] = { 0U };
+  msm_vartime(res, k, points, scalars, digits);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)3U; i++)
+  {
+    point_double(res, res);
+  }
+  make_point_inf(inf);
+  if (Hacl_Impl_Ed25519_PointEqual_point_equal(res, inf))
+  {
+    return ok;
+  }
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    if (results[i])
+    {
+      results[i] = verify_cofactored(pubs[i], lens[i], msgs[i], sigs[i]);
+    }
+  }
+  return false;
+}
+
+bool
+Hacl_Ed25519_verify_batch(
+  uint32_t n,
+  uint8_t **pubs,
+  uint32_t *lens,
+  uint8_t **msgs,
+  uint8_t **sigs,
+  bool *results
+)
+{
+  bool ok = true;
+  for (uint32_t i = (uint32_t)0U; i < n; i = i + (uint32_t)64U)
+  {
+    uint32_t len = n - i;
+    if (len > (uint32_t)64U)
+    {
+      len = (uint32_t)64U;
+    }
+    bool b = verify_batch_chunk(len, pubs + i, lens + i, msgs + i, sigs + i, results + i);
+    ok = ok && b;
+  }
+  return ok;
+}
+
 void Hacl_Ed25519_secret_to_public(uint8_t *pub, uint8_t *priv)
 {
   secret_to_public(pub, priv);
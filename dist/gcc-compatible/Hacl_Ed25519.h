@@ -42,6 +42,7 @@ extern "C" {
 #include "Hacl_Hash.h"
 #include "Hacl_Bignum25519_51.h"
 #include "Hacl_Curve25519_51.h"
+#include "Lib_RandomBuffer_System.h"
 
 void Hacl_Bignum25519_reduce_513(uint64_t *a);
 
@@ -67,6 +68,36 @@ void Hacl_Ed25519_sign(uint8_t *signature, uint8_t *priv, uint32_t len, uint8_t
 
 bool Hacl_Ed25519_verify(uint8_t *pub, uint32_t len, uint8_t *msg, uint8_t *signature);
 
+/*
+Verify n independent signatures at once.
+
+  Signature sigs[i] (64 bytes) is checked against the lens[i]-byte message msgs[i]
+  under the public key pubs[i] (32 bytes). The outcome for each signature is
+  written to results[i]; the function returns true iff all n signatures are valid.
+
+  Each signature is checked against the cofactored equation
+  [8][s]B == [8]R + [8][h]A, which a random linear combination can check for
+  the whole batch at once; Hacl_Ed25519_verify checks the cofactorless
+  [s]B == R + [h]A. The two agree on every signature produced by
+  Hacl_Ed25519_sign, and on any signature whose A and R have no small-order
+  component. A crafted signature with such a component may be accepted here and
+  rejected by Hacl_Ed25519_verify; the outcome here does not depend on the
+  random coefficients or on the other signatures of the batch. Callers that
+  must match Hacl_Ed25519_verify exactly (e.g. for consensus) must use it.
+
+  The whole batch is first checked with a single multi-scalar multiplication;
+  signatures are only re-checked one by one when that combined check fails.
+*/
+bool
+Hacl_Ed25519_verify_batch(
+  uint32_t n,
+  uint8_t **pubs,
+  uint32_t *lens,
+  uint8_t **msgs,
+  uint8_t **sigs,
+  bool *results
+);
+
 void Hacl_Ed25519_secret_to_public(uint8_t *pub, uint8_t *priv);
 
 void Hacl_Ed25519_expand_keys(uint8_t *ks, uint8_t *priv);
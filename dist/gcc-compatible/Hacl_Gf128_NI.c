@@ -0,0 +1,105 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#include "Hacl_Gf128_NI.h"
+
+#include "Hacl_Impl_Gf128_NI.h"
+
+/* Same representation as the VAES kernel, see Hacl_Impl_Gf128_NI.h */
+
+static inline void mul_acc(__m128i *lo, __m128i *mid, __m128i *hi, __m128i a, __m128i b)
+{
+  *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+  *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+  *mid =
+    _mm_xor_si128(*mid,
+      _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x01), _mm_clmulepi64_si128(a, b, 0x10)));
+}
+
+static inline __m128i gf128_mul(__m128i a, __m128i b)
+{
+  __m128i lo = _mm_setzero_si128();
+  __m128i mid = _mm_setzero_si128();
+  __m128i hi = _mm_setzero_si128();
+  mul_acc(&lo, &mid, &hi, a, b);
+  return Hacl_Impl_Gf128_NI_reduce(lo, mid, hi);
+}
+
+void Hacl_Gf128_NI_gcm_init(uint8_t *hkey, uint8_t *h)
+{
+  __m128i
+  h1 =
+    Hacl_Impl_Gf128_NI_mul_x(Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)h)));
+  __m128i p = h1;
+  _mm_storeu_si128((__m128i *)(hkey + (uint32_t)48U), h1);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)4U; i++)
+  {
+    p = gf128_mul(p, h1);
+    _mm_storeu_si128((__m128i *)(hkey + ((uint32_t)3U - i) * (uint32_t)16U), p);
+  }
+}
+
+void Hacl_Gf128_NI_gcm_update_padded(uint8_t *acc, uint8_t *hkey, uint32_t len, uint8_t *text)
+{
+  __m128i h4 = _mm_loadu_si128((const __m128i *)hkey);
+  __m128i h3 = _mm_loadu_si128((const __m128i *)(hkey + (uint32_t)16U));
+  __m128i h2 = _mm_loadu_si128((const __m128i *)(hkey + (uint32_t)32U));
+  __m128i h1 = _mm_loadu_si128((const __m128i *)(hkey + (uint32_t)48U));
+  __m128i y = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)acc));
+  uint32_t i = (uint32_t)0U;
+  /* Four blocks per reduction */
+  for (; i + (uint32_t)64U <= len; i = i + (uint32_t)64U)
+  {
+    __m128i lo = _mm_setzero_si128();
+    __m128i mid = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+    __m128i d0 = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)(text + i)));
+    __m128i
+    d1 = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)(text + i + (uint32_t)16U)));
+    __m128i
+    d2 = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)(text + i + (uint32_t)32U)));
+    __m128i
+    d3 = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)(text + i + (uint32_t)48U)));
+    mul_acc(&lo, &mid, &hi, _mm_xor_si128(y, d0), h4);
+    mul_acc(&lo, &mid, &hi, d1, h3);
+    mul_acc(&lo, &mid, &hi, d2, h2);
+    mul_acc(&lo, &mid, &hi, d3, h1);
+    y = Hacl_Impl_Gf128_NI_reduce(lo, mid, hi);
+  }
+  for (; i + (uint32_t)16U <= len; i = i + (uint32_t)16U)
+  {
+    __m128i d = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)(text + i)));
+    y = gf128_mul(_mm_xor_si128(y, d), h1);
+  }
+  if (i < len)
+  {
+    uint8_t b[16U] = { 0U };
+    memcpy(b, text + i, (len - i) * sizeof (uint8_t));
+    __m128i d = Hacl_Impl_Gf128_NI_bswap128(_mm_loadu_si128((const __m128i *)b));
+    y = gf128_mul(_mm_xor_si128(y, d), h1);
+  }
+  _mm_storeu_si128((__m128i *)acc, Hacl_Impl_Gf128_NI_bswap128(y));
+}
+
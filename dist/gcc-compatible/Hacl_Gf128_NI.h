@@ -0,0 +1,69 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#ifndef __Hacl_Gf128_NI_H
+#define __Hacl_Gf128_NI_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+
+/*
+  GHASH with PCLMULQDQ, for CPUs with AES-NI but without VAES, where the Vale
+  AES-GCM code only offers one-shot calls. It lets AES-GCM be computed in
+  pieces: the keystream comes from the Vale CTR code, and the hash from here.
+
+  The accumulator is 16 bytes in the byte order of the tag, so that the caller
+  only has to XOR in E(J0) at the end. Callers must check
+  EverCrypt_AutoConfig2_has_pclmulqdq() first.
+*/
+
+/*
+  Sets hkey (64 bytes) to the powers H^4 .. H^1 of the hash key h = E(K, 0^128)
+*/
+void Hacl_Gf128_NI_gcm_init(uint8_t *hkey, uint8_t *h);
+
+/*
+  Absorbs len bytes of text into acc, the last block padded with zeros; len
+  should only be a non-multiple of 16 on the last call for a given input.
+*/
+void Hacl_Gf128_NI_gcm_update_padded(uint8_t *acc, uint8_t *hkey, uint32_t len, uint8_t *text);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_Gf128_NI_H_DEFINED
+#endif
@@ -0,0 +1,374 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#include "Hacl_Impl_Ed25519_PointMulG.h"
+
+#include "Hacl_Ed25519_PrecompTable.h"
+#include "Lib_Memzero0.h"
+
+static inline void fsum(uint64_t *a, uint64_t *b)
+{
+  Hacl_Impl_Curve25519_Field51_fadd(a, a, b);
+}
+
+static inline void fdifference(uint64_t *a, uint64_t *b)
+{
+  Hacl_Impl_Curve25519_Field51_fsub(a, b, a);
+}
+
+static inline void reduce_513(uint64_t *a)
+{
+  uint64_t f0 = a[0U];
+  uint64_t f1 = a[1U];
+  uint64_t f2 = a[2U];
+  uint64_t f3 = a[3U];
+  uint64_t f4 = a[4U];
+  uint64_t l_ = f0 + (uint64_t)0U;
+  uint64_t tmp0 = l_ & (uint64_t)0x7ffffffffffffU;
+  uint64_t c0 = l_ >> (uint32_t)51U;
+  uint64_t l_0 = f1 + c0;
+  uint64_t tmp1 = l_0 & (uint64_t)0x7ffffffffffffU;
+  uint64_t c1 = l_0 >> (uint32_t)51U;
+  uint64_t l_1 = f2 + c1;
+  uint64_t tmp2 = l_1 & (uint64_t)0x7ffffffffffffU;
+  uint64_t c2 = l_1 >> (uint32_t)51U;
+  uint64_t l_2 = f3 + c2;
+  uint64_t tmp3 = l_2 & (uint64_t)0x7ffffffffffffU;
+  uint64_t c3 = l_2 >> (uint32_t)51U;
+  uint64_t l_3 = f4 + c3;
+  uint64_t tmp4 = l_3 & (uint64_t)0x7ffffffffffffU;
+  uint64_t c4 = l_3 >> (uint32_t)51U;
+  uint64_t l_4 = tmp0 + c4 * (uint64_t)19U;
+  uint64_t tmp0_ = l_4 & (uint64_t)0x7ffffffffffffU;
+  uint64_t c5 = l_4 >> (uint32_t)51U;
+  a[0U] = tmp0_;
+  a[1U] = tmp1 + c5;
+  a[2U] = tmp2;
+  a[3U] = tmp3;
+  a[4U] = tmp4;
+}
+
+static inline void fmul0(uint64_t *output, uint64_t *input, uint64_t *input2)
+{
+  FStar_UInt128_uint128 tmp[10U];
+  for (uint32_t _i = 0U; _i < (uint32_t)10U; ++_i)
+    tmp[_i] = FStar_UInt128_uint64_to_uint128((uint64_t)0U);
+  Hacl_Impl_Curve25519_Field51_fmul(output, input, input2, tmp);
+}
+
+static inline void times_2(uint64_t *out, uint64_t *a)
+{
+  uint64_t a0 = a[0U];
+  uint64_t a1 = a[1U];
+  uint64_t a2 = a[2U];
+  uint64_t a3 = a[3U];
+  uint64_t a4 = a[4U];
+  uint64_t o0 = (uint64_t)2U * a0;
+  uint64_t o1 = (uint64_t)2U * a1;
+  uint64_t o2 = (uint64_t)2U * a2;
+  uint64_t o3 = (uint64_t)2U * a3;
+  uint64_t o4 = (uint64_t)2U * a4;
+  out[0U] = o0;
+  out[1U] = o1;
+  out[2U] = o2;
+  out[3U] = o3;
+  out[4U] = o4;
+}
+
+static inline void fsquare(uint64_t *out, uint64_t *a)
+{
+  FStar_UInt128_uint128 tmp[5U];
+  for (uint32_t _i = 0U; _i < (uint32_t)5U; ++_i)
+    tmp[_i] = FStar_UInt128_uint64_to_uint128((uint64_t)0U);
+  Hacl_Impl_Curve25519_Field51_fsqr(out, a, tmp);
+}
+
+static inline void point_double(uint64_t *out, uint64_t *p)
+{
+  uint64_t tmp[30U] = { 0U };
+  uint64_t *tmp2 = tmp + (uint32_t)5U;
+  uint64_t *tmp3 = tmp + (uint32_t)10U;
+  uint64_t *tmp4 = tmp + (uint32_t)15U;
+  uint64_t *tmp6 = tmp + (uint32_t)25U;
+  uint64_t *x3 = out;
+  uint64_t *y3 = out + (uint32_t)5U;
+  uint64_t *z3 = out + (uint32_t)10U;
+  uint64_t *t3 = out + (uint32_t)15U;
+  uint64_t *tmp11 = tmp;
+  uint64_t *tmp210 = tmp + (uint32_t)5U;
+  uint64_t *tmp310 = tmp + (uint32_t)10U;
+  uint64_t *tmp410 = tmp + (uint32_t)15U;
+  uint64_t *x10 = p;
+  uint64_t *y10 = p + (uint32_t)5U;
+  uint64_t *z1 = p + (uint32_t)10U;
+  fsquare(tmp11, x10);
+  fsquare(tmp210, y10);
+  fsquare(tmp310, z1);
+  times_2(tmp410, tmp310);
+  memcpy(tmp310, tmp11, (uint32_t)5U * sizeof (uint64_t));
+  fsum(tmp310, tmp210);
+  uint64_t *tmp110 = tmp;
+  uint64_t *tmp21 = tmp + (uint32_t)5U;
+  uint64_t *tmp31 = tmp + (uint32_t)10U;
+  uint64_t *tmp41 = tmp + (uint32_t)15U;
+  uint64_t *tmp51 = tmp + (uint32_t)20U;
+  uint64_t *tmp61 = tmp + (uint32_t)25U;
+  uint64_t *x1 = p;
+  uint64_t *y1 = p + (uint32_t)5U;
+  memcpy(tmp51, x1, (uint32_t)5U * sizeof (uint64_t));
+  fsum(tmp51, y1);
+  fsquare(tmp61, tmp51);
+  memcpy(tmp51, tmp31, (uint32_t)5U * sizeof (uint64_t));
+  reduce_513(tmp51);
+  fdifference(tmp61, tmp51);
+  fdifference(tmp21, tmp110);
+  reduce_513(tmp21);
+  reduce_513(tmp41);
+  fsum(tmp41, tmp21);
+  fmul0(x3, tmp4, tmp6);
+  fmul0(y3, tmp2, tmp3);
+  fmul0(t3, tmp6, tmp3);
+  fmul0(z3, tmp4, tmp2);
+}
+
+static inline void make_point_inf(uint64_t *b)
+{
+  uint64_t *x = b;
+  uint64_t *y = b + (uint32_t)5U;
+  uint64_t *z = b + (uint32_t)10U;
+  uint64_t *t = b + (uint32_t)15U;
+  memset(x, 0U, (uint32_t)5U * sizeof (uint64_t));
+  memset(y, 0U, (uint32_t)5U * sizeof (uint64_t));
+  y[0U] = (uint64_t)1U;
+  memset(z, 0U, (uint32_t)5U * sizeof (uint64_t));
+  z[0U] = (uint64_t)1U;
+  memset(t, 0U, (uint32_t)5U * sizeof (uint64_t));
+}
+
+static inline void point_add_precomp(uint64_t *out, uint64_t *p, uint64_t *q)
+{
+  uint64_t tmp[40U] = { 0U };
+  uint64_t *a = tmp;
+  uint64_t *b = tmp + (uint32_t)5U;
+  uint64_t *c = tmp + (uint32_t)10U;
+  uint64_t *d = tmp + (uint32_t)15U;
+  uint64_t *e = tmp + (uint32_t)20U;
+  uint64_t *f = tmp + (uint32_t)25U;
+  uint64_t *g = tmp + (uint32_t)30U;
+  uint64_t *h = tmp + (uint32_t)35U;
+  uint64_t *x1 = p;
+  uint64_t *y1 = p + (uint32_t)5U;
+  uint64_t *z1 = p + (uint32_t)10U;
+  uint64_t *t1 = p + (uint32_t)15U;
+  uint64_t *ypx2 = q;
+  uint64_t *ymx2 = q + (uint32_t)5U;
+  uint64_t *xy2d2 = q + (uint32_t)10U;
+  memcpy(e, x1, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(e, y1);
+  fmul0(a, e, ymx2);
+  memcpy(e, y1, (uint32_t)5U * sizeof (uint64_t));
+  fsum(e, x1);
+  fmul0(b, e, ypx2);
+  fmul0(c, t1, xy2d2);
+  times_2(d, z1);
+  memcpy(e, a, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(e, b);
+  memcpy(f, c, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(f, d);
+  memcpy(g, d, (uint32_t)5U * sizeof (uint64_t));
+  fsum(g, c);
+  memcpy(h, b, (uint32_t)5U * sizeof (uint64_t));
+  fsum(h, a);
+  uint64_t *x3 = out;
+  uint64_t *y3 = out + (uint32_t)5U;
+  uint64_t *z3 = out + (uint32_t)10U;
+  uint64_t *t3 = out + (uint32_t)15U;
+  fmul0(x3, e, f);
+  fmul0(y3, g, h);
+  fmul0(t3, e, h);
+  fmul0(z3, f, g);
+}
+
+/*
+  Constant-time selection of [digit * 256^row]B, digit in [-8, 8], from the
+  precomputed table. Every entry of the row is read regardless of the digit;
+  a negative digit swaps y + x with y - x and negates 2dxy.
+*/
+static inline void precomp_get_consttime(uint64_t *out, uint32_t row, int8_t digit)
+{
+  uint64_t tmp[15U] = { 0U };
+  uint64_t zero[5U] = { 0U };
+  uint64_t b = (uint64_t)(int64_t)digit;
+  uint64_t neg = (uint64_t)0U - (b >> (uint32_t)63U);
+  uint64_t babs = (b ^ neg) - neg;
+  memset(out, 0U, (uint32_t)15U * sizeof (uint64_t));
+  out[0U] = (uint64_t)1U;
+  out[5U] = (uint64_t)1U;
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)8U; j++)
+  {
+    uint64_t mask = FStar_UInt64_eq_mask(babs, (uint64_t)(j + (uint32_t)1U));
+    const
+    uint64_t
+    *entry =
+      Hacl_Ed25519_PrecompTable_precomp_basepoint_table_w4
+      + (row * (uint32_t)8U + j) * (uint32_t)15U;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)15U; i++)
+    {
+      uint64_t x = out[i] ^ (mask & (out[i] ^ entry[i]));
+      out[i] = x;
+    }
+  }
+  memcpy(tmp, out + (uint32_t)5U, (uint32_t)5U * sizeof (uint64_t));
+  memcpy(tmp + (uint32_t)5U, out, (uint32_t)5U * sizeof (uint64_t));
+  memcpy(tmp + (uint32_t)10U, out + (uint32_t)10U, (uint32_t)5U * sizeof (uint64_t));
+  fdifference(tmp + (uint32_t)10U, zero);
+  reduce_513(tmp + (uint32_t)10U);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)15U; i++)
+  {
+    uint64_t x = out[i] ^ (neg & (out[i] ^ tmp[i]));
+    out[i] = x;
+  }
+}
+
+/*
+  Constant-time fixed-base scalar multiplication [scalar]B for a 32-byte
+  little-endian scalar < 2^255. The scalar is recoded into 64 signed radix-16
+  digits e_i in [-8, 8] so that
+
+    [scalar]B = sum_i [e_{2i}  * 256^i]B + 16 * sum_i [e_{2i+1} * 256^i]B
+
+  and each term is a lookup into the precomputed table followed by a mixed
+  addition, for a total of 64 additions and 4 doublings.
+*/
+void Hacl_Impl_Ed25519_PointMulG_point_mul_g(uint64_t *result, uint8_t *scalar)
+{
+  int8_t e[64U] = { 0U };
+  uint64_t q[15U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)32U; i++)
+  {
+    uint8_t si = scalar[i];
+    e[(uint32_t)2U * i] = (int8_t)(si & (uint8_t)15U);
+    e[(uint32_t)2U * i + (uint32_t)1U] = (int8_t)(si >> (uint32_t)4U);
+  }
+  int8_t carry = (int8_t)0;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)63U; i++)
+  {
+    int8_t ei = e[i] + carry;
+    carry = (ei + (int8_t)8) >> (uint32_t)4U;
+    e[i] = ei - (carry << (uint32_t)4U);
+  }
+  e[63U] = e[63U] + carry;
+  make_point_inf(result);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)32U; i++)
+  {
+    precomp_get_consttime(q, i, e[(uint32_t)2U * i + (uint32_t)1U]);
+    point_add_precomp(result, result, q);
+  }
+  point_double(result, result);
+  point_double(result, result);
+  point_double(result, result);
+  point_double(result, result);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)32U; i++)
+  {
+    precomp_get_consttime(q, i, e[(uint32_t)2U * i]);
+    point_add_precomp(result, result, q);
+  }
+}
+
+static inline void fsquare_times(uint64_t *o, uint64_t *inp, FStar_UInt128_uint128 *tmp, uint32_t n)
+{
+  Hacl_Impl_Curve25519_Field51_fsqr(o, inp, tmp);
+  for (uint32_t i = (uint32_t)0U; i < n - (uint32_t)1U; i++)
+  {
+    Hacl_Impl_Curve25519_Field51_fsqr(o, o, tmp);
+  }
+}
+
+/* o = i^(p - 2), with the addition chain of Hacl_Curve25519_51_finv */
+static void finv(uint64_t *o, uint64_t *i, FStar_UInt128_uint128 *tmp)
+{
+  uint64_t t1[20U] = { 0U };
+  uint64_t *a = t1;
+  uint64_t *b = t1 + (uint32_t)5U;
+  uint64_t *c = t1 + (uint32_t)10U;
+  uint64_t *t0 = t1 + (uint32_t)15U;
+  fsquare_times(a, i, tmp, (uint32_t)1U);
+  fsquare_times(t0, a, tmp, (uint32_t)2U);
+  Hacl_Impl_Curve25519_Field51_fmul(b, t0, i, tmp);
+  Hacl_Impl_Curve25519_Field51_fmul(a, b, a, tmp);
+  fsquare_times(t0, a, tmp, (uint32_t)1U);
+  Hacl_Impl_Curve25519_Field51_fmul(b, t0, b, tmp);
+  fsquare_times(t0, b, tmp, (uint32_t)5U);
+  Hacl_Impl_Curve25519_Field51_fmul(b, t0, b, tmp);
+  fsquare_times(t0, b, tmp, (uint32_t)10U);
+  Hacl_Impl_Curve25519_Field51_fmul(c, t0, b, tmp);
+  fsquare_times(t0, c, tmp, (uint32_t)20U);
+  Hacl_Impl_Curve25519_Field51_fmul(t0, t0, c, tmp);
+  fsquare_times(t0, t0, tmp, (uint32_t)10U);
+  Hacl_Impl_Curve25519_Field51_fmul(b, t0, b, tmp);
+  fsquare_times(t0, b, tmp, (uint32_t)50U);
+  Hacl_Impl_Curve25519_Field51_fmul(c, t0, b, tmp);
+  fsquare_times(t0, c, tmp, (uint32_t)100U);
+  Hacl_Impl_Curve25519_Field51_fmul(t0, t0, c, tmp);
+  fsquare_times(t0, t0, tmp, (uint32_t)50U);
+  Hacl_Impl_Curve25519_Field51_fmul(t0, t0, b, tmp);
+  fsquare_times(t0, t0, tmp, (uint32_t)5U);
+  Hacl_Impl_Curve25519_Field51_fmul(o, t0, a, tmp);
+}
+
+/*
+  [k]B is computed on edwards25519 and mapped to the Montgomery u-coordinate
+  u = (1 + y) / (1 - y) = (Z + Y) / (Z - Y). k is a multiple of 8 below 2^255,
+  so [k]B is never the identity, for which Z - Y would vanish.
+*/
+void Hacl_Impl_Ed25519_PointMulG_x25519_secret_to_public(uint8_t *pub, uint8_t *priv)
+{
+  uint8_t k[32U] = { 0U };
+  uint64_t p[20U] = { 0U };
+  uint64_t num[5U] = { 0U };
+  uint64_t den[5U] = { 0U };
+  uint64_t u64s[4U] = { 0U };
+  FStar_UInt128_uint128 tmp[10U];
+  for (uint32_t _i = 0U; _i < (uint32_t)10U; ++_i)
+    tmp[_i] = FStar_UInt128_uint64_to_uint128((uint64_t)0U);
+  memcpy(k, priv, (uint32_t)32U * sizeof (uint8_t));
+  k[0U] = k[0U] & (uint8_t)248U;
+  k[31U] = (k[31U] & (uint8_t)127U) | (uint8_t)64U;
+  Hacl_Impl_Ed25519_PointMulG_point_mul_g(p, k);
+  uint64_t *y = p + (uint32_t)5U;
+  uint64_t *z = p + (uint32_t)10U;
+  Hacl_Impl_Curve25519_Field51_fadd(num, z, y);
+  Hacl_Impl_Curve25519_Field51_fsub(den, z, y);
+  finv(den, den, tmp);
+  Hacl_Impl_Curve25519_Field51_fmul(num, num, den, tmp);
+  Hacl_Impl_Curve25519_Field51_store_felem(u64s, num);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    store64_le(pub + i * (uint32_t)8U, u64s[i]);
+  }
+  Lib_Memzero0_memzero(k, (uint32_t)32U * sizeof (k[0U]));
+  Lib_Memzero0_memzero(p, (uint32_t)20U * sizeof (p[0U]));
+}
+
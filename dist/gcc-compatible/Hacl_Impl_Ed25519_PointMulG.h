@@ -0,0 +1,67 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#ifndef __Hacl_Impl_Ed25519_PointMulG_H
+#define __Hacl_Impl_Ed25519_PointMulG_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_Kremlib.h"
+#include "Hacl_Bignum25519_51.h"
+
+/*
+  Constant-time fixed-base multiplication on edwards25519, shared by Hacl_Ed25519
+  and the X25519 key generation of Hacl_Curve25519_51 and Hacl_Curve25519_64. It
+  only depends on the radix-2^51 field arithmetic of Hacl_Bignum25519_51.h.
+
+  This header is internal to the library: no public header includes it, and its
+  functions are not part of the exported API.
+*/
+
+/* [scalar]B in extended coordinates, for a 32-byte little-endian scalar < 2^255. */
+void Hacl_Impl_Ed25519_PointMulG_point_mul_g(uint64_t *result, uint8_t *scalar);
+
+/*
+  The X25519 public key of priv, i.e. the ladder on u = 9 for the clamped scalar,
+  computed as [k]B on the birationally equivalent edwards25519.
+*/
+void Hacl_Impl_Ed25519_PointMulG_x25519_secret_to_public(uint8_t *pub, uint8_t *priv);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_Impl_Ed25519_PointMulG_H_DEFINED
+#endif
@@ -0,0 +1,81 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#ifndef __Hacl_Impl_Gf128_NI_H
+#define __Hacl_Impl_Gf128_NI_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "kremlin/internal/types.h"
+#include <immintrin.h>
+
+/*
+  GF(2^128) helpers shared by Hacl_Gf128_NI and Hacl_AES_GCM_VAES.
+
+  Blocks are byte-reversed (the POLYVAL view of RFC 8452, appendix A), which
+  turns the bit-reflected GHASH product into plain carry-less multiplications
+  followed by a two-step folding reduction. The hash key is multiplied by x
+  once, when the key is set up.
+*/
+
+static inline __m128i Hacl_Impl_Gf128_NI_bswap128(__m128i x)
+{
+  return
+    _mm_shuffle_epi8(x,
+      _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+/* Reduces the 256-bit product lo + mid * x^64 + hi * x^128 */
+static inline __m128i Hacl_Impl_Gf128_NI_reduce(__m128i lo, __m128i mid, __m128i hi)
+{
+  __m128i poly = _mm_set_epi64x((int64_t)0xC200000000000000ULL, (int64_t)1);
+  lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+  hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+  __m128i t = _mm_clmulepi64_si128(lo, poly, 0x10);
+  lo = _mm_xor_si128(_mm_shuffle_epi32(lo, 0x4e), t);
+  t = _mm_clmulepi64_si128(lo, poly, 0x10);
+  lo = _mm_xor_si128(_mm_shuffle_epi32(lo, 0x4e), t);
+  return _mm_xor_si128(hi, lo);
+}
+
+/* Multiplication by x, to move the hash key into the POLYVAL domain */
+static inline __m128i Hacl_Impl_Gf128_NI_mul_x(__m128i v)
+{
+  __m128i poly = _mm_set_epi64x((int64_t)0xC200000000000000ULL, (int64_t)1);
+  __m128i top = _mm_shuffle_epi32(_mm_srai_epi32(v, 31), 0xff);
+  __m128i carry = _mm_slli_si128(_mm_srli_epi64(v, 63), 8);
+  v = _mm_or_si128(_mm_slli_epi64(v, 1), carry);
+  return _mm_xor_si128(v, _mm_and_si128(top, poly));
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_Impl_Gf128_NI_H_DEFINED
+#endif
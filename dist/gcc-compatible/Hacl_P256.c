@@ -1525,22 +1525,6 @@ scalarMultiplicationC(
   norm(q, result, buff);
 }
 
-static void uploadBasePoint(uint64_t *p)
-{
-  p[0U] = (uint64_t)8784043285714375740U;
-  p[1U] = (uint64_t)8483257759279461889U;
-  p[2U] = (uint64_t)8789745728267363600U;
-  p[3U] = (uint64_t)1770019616739251654U;
-  p[4U] = (uint64_t)15992936863339206154U;
-  p[5U] = (uint64_t)10037038012062884956U;
-  p[6U] = (uint64_t)15197544864945402661U;
-  p[7U] = (uint64_t)9615747158586711429U;
-  p[8U] = (uint64_t)1U;
-  p[9U] = (uint64_t)18446744069414584320U;
-  p[10U] = (uint64_t)18446744073709551615U;
-  p[11U] = (uint64_t)4294967294U;
-}
-
 static void
 scalarMultiplicationWithoutNorm(
   uint64_t *p,
@@ -1567,47 +1551,117 @@ scalarMultiplicationWithoutNorm(
   copy_point(q, result);
 }
 
-void
-Hacl_Impl_P256_Core_secretToPublic(uint64_t *result, uint8_t *scalar, uint64_t *tempBuffer)
+/*
+  Mixed addition of a Jacobian point p and an affine point q = (qX, qY) (both in
+  the Montgomery domain). Constant-time: if p is the point at infinity the
+  result is (qX, qY, 1), and if isInf is all ones (q stands for the point at
+  infinity) the result is p. The case p = q is not handled; callers guarantee
+  it does not occur.
+*/
+static void
+point_add_mixed(uint64_t *p, uint64_t *q, uint64_t isInf, uint64_t *result, uint64_t *tempBuffer)
+{
+  uint64_t *z1Square = tempBuffer;
+  uint64_t *z1Cube = tempBuffer + (uint32_t)4U;
+  uint64_t *u2 = tempBuffer + (uint32_t)8U;
+  uint64_t *s2 = tempBuffer + (uint32_t)12U;
+  uint64_t *h = tempBuffer + (uint32_t)16U;
+  uint64_t *r = tempBuffer + (uint32_t)20U;
+  uint64_t *hSquare = tempBuffer + (uint32_t)24U;
+  uint64_t *hCube = tempBuffer + (uint32_t)28U;
+  uint64_t *uh = tempBuffer + (uint32_t)32U;
+  uint64_t *x3 = tempBuffer + (uint32_t)36U;
+  uint64_t *y3 = tempBuffer + (uint32_t)40U;
+  uint64_t *z3 = tempBuffer + (uint32_t)44U;
+  uint64_t *t = tempBuffer + (uint32_t)48U;
+  uint64_t *pX = p;
+  uint64_t *pY = p + (uint32_t)4U;
+  uint64_t *pZ = p + (uint32_t)8U;
+  uint64_t *qX = q;
+  uint64_t *qY = q + (uint32_t)4U;
+  montgomery_square_buffer(pZ, z1Square);
+  montgomery_multiplication_buffer(z1Square, pZ, z1Cube);
+  montgomery_multiplication_buffer(z1Square, qX, u2);
+  montgomery_multiplication_buffer(z1Cube, qY, s2);
+  p256_sub(u2, pX, h);
+  p256_sub(s2, pY, r);
+  montgomery_square_buffer(h, hSquare);
+  montgomery_multiplication_buffer(hSquare, h, hCube);
+  montgomery_multiplication_buffer(hSquare, pX, uh);
+  montgomery_square_buffer(r, x3);
+  p256_sub(x3, hCube, x3);
+  multByTwo(uh, t);
+  p256_sub(x3, t, x3);
+  p256_sub(uh, x3, t);
+  montgomery_multiplication_buffer(t, r, y3);
+  montgomery_multiplication_buffer(hCube, pY, t);
+  p256_sub(y3, t, y3);
+  montgomery_multiplication_buffer(pZ, h, z3);
+  uint64_t pInf = isZero_uint64_CT(pZ);
+  uint64_t one[4U] = { 0U };
+  one[0U] = (uint64_t)1U;
+  one[1U] = (uint64_t)18446744069414584320U;
+  one[2U] = (uint64_t)18446744073709551615U;
+  one[3U] = (uint64_t)4294967294U;
+  copy_conditional(x3, qX, pInf);
+  copy_conditional(y3, qY, pInf);
+  copy_conditional(z3, one, pInf);
+  copy_conditional(x3, pX, isInf);
+  copy_conditional(y3, pY, isInf);
+  copy_conditional(z3, pZ, isInf);
+  memcpy(result, x3, (uint32_t)4U * sizeof (uint64_t));
+  memcpy(result + (uint32_t)4U, y3, (uint32_t)4U * sizeof (uint64_t));
+  memcpy(result + (uint32_t)8U, z3, (uint32_t)4U * sizeof (uint64_t));
+}
+
+/*
+  Constant-time fixed-base scalar multiplication [scalar]G (Jacobian, Montgomery
+  domain) for a 32-byte big-endian scalar. Each of the 64 4-bit digits d_i
+  selects [d_i * 16^i]G from the precomputed table by scanning the whole row,
+  and is accumulated with one mixed addition; no doublings are needed.
+
+  Every partial sum and every d_i * 16^i is below the group order, so the
+  accumulator never equals the point being added and the mixed addition never
+  hits its doubling case; a scalar equal to the order yields the point at
+  infinity, as with the ladder.
+*/
+static void secretToPublicWithoutNorm(uint64_t *result, uint8_t *scalar, uint64_t *tempBuffer)
 {
-  uint64_t basePoint[12U] = { 0U };
-  uploadBasePoint(basePoint);
-  uint64_t *q = tempBuffer;
-  uint64_t *buff = tempBuffer + (uint32_t)12U;
-  zero_buffer(q);
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)256U; i++)
+  uint64_t q[8U] = { 0U };
+  uint64_t *buff = tempBuffer;
+  zero_buffer(result);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)64U; i++)
   {
-    uint32_t bit0 = (uint32_t)255U - i;
+    uint8_t byte = scalar[(uint32_t)31U - i / (uint32_t)2U];
     uint64_t
-    bit =
-      (uint64_t)(scalar[(uint32_t)31U - bit0 / (uint32_t)8U] >> bit0 % (uint32_t)8U & (uint8_t)1U);
-    cswap(bit, q, basePoint);
-    point_add(q, basePoint, basePoint, buff);
-    point_double(q, q, buff);
-    cswap(bit, q, basePoint);
+    digit = (uint64_t)(byte >> (uint32_t)4U * (i % (uint32_t)2U) & (uint8_t)15U);
+    memset(q, 0U, (uint32_t)8U * sizeof (uint64_t));
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)15U; j++)
+    {
+      uint64_t mask = FStar_UInt64_eq_mask(digit, (uint64_t)(j + (uint32_t)1U));
+      const
+      uint64_t
+      *entry =
+        Hacl_P256_PrecompTable_precomp_basepoint_table_w4
+        + (i * (uint32_t)15U + j) * (uint32_t)8U;
+      for (uint32_t k = (uint32_t)0U; k < (uint32_t)8U; k++)
+      {
+        uint64_t x = q[k] ^ (mask & (q[k] ^ entry[k]));
+        q[k] = x;
+      }
+    }
+    uint64_t isInf = FStar_UInt64_eq_mask(digit, (uint64_t)0U);
+    point_add_mixed(result, q, isInf, result, buff);
   }
-  norm(q, result, buff);
 }
 
-static void secretToPublicWithoutNorm(uint64_t *result, uint8_t *scalar, uint64_t *tempBuffer)
+void
+Hacl_Impl_P256_Core_secretToPublic(uint64_t *result, uint8_t *scalar, uint64_t *tempBuffer)
 {
-  uint64_t basePoint[12U] = { 0U };
-  uploadBasePoint(basePoint);
   uint64_t *q = tempBuffer;
   uint64_t *buff = tempBuffer + (uint32_t)12U;
-  zero_buffer(q);
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)256U; i++)
-  {
-    uint32_t bit0 = (uint32_t)255U - i;
-    uint64_t
-    bit =
-      (uint64_t)(scalar[(uint32_t)31U - bit0 / (uint32_t)8U] >> bit0 % (uint32_t)8U & (uint8_t)1U);
-    cswap(bit, q, basePoint);
-    point_add(q, basePoint, basePoint, buff);
-    point_double(q, q, buff);
-    cswap(bit, q, basePoint);
-  }
-  copy_point(q, result);
+  secretToPublicWithoutNorm(q, scalar, buff);
+  norm(q, result, buff);
 }
 
 static const
@@ -2057,6 +2111,265 @@ static bool compare_felem_bool(uint64_t *a, uint64_t *b)
   return a_0 == b_0 && a_1 == b_1 && a_2 == b_2 && a_3 == b_3;
 }
 
+/*
+  Width-w non-adjacent form of a scalar given as 4 little-endian limbs: every
+  non-zero digit is odd, lies in (-2^(w-1), 2^(w-1)) and is followed by at least
+  w - 1 zeros. 257 digits are produced since the recoding can carry out of
+  the top bit.
+*/
+static void recode_wnaf(int8_t *naf, uint64_t *scalar, uint32_t w)
+{
+  uint64_t k[5U] = { 0U };
+  memcpy(k, scalar, (uint32_t)4U * sizeof (uint64_t));
+  memset(naf, 0U, (uint32_t)257U * sizeof (int8_t));
+  uint64_t window = ((uint64_t)1U << w) - (uint64_t)1U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)257U; i++)
+  {
+    if (k[0U] & (uint64_t)1U)
+    {
+      int64_t d = (int64_t)(k[0U] & window);
+      if (d >= (int64_t)1 << (w - (uint32_t)1U))
+      {
+        d = d - ((int64_t)1 << w);
+      }
+      naf[i] = (int8_t)d;
+      if (d > (int64_t)0)
+      {
+        k[0U] = k[0U] - (uint64_t)d;
+      }
+      else
+      {
+        uint64_t c = (uint64_t)(-d);
+        for (uint32_t j = (uint32_t)0U; j < (uint32_t)5U; j++)
+        {
+          uint64_t kj = k[j] + c;
+          c = (uint64_t)(kj < c);
+          k[j] = kj;
+        }
+      }
+    }
+    for (uint32_t j = (uint32_t)0U; j < (uint32_t)4U; j++)
+    {
+      k[j] = k[j] >> (uint32_t)1U | k[j + (uint32_t)1U] << (uint32_t)63U;
+    }
+    k[4U] = k[4U] >> (uint32_t)1U;
+  }
+}
+
+/*
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+
+  Computes p + q (Jacobian, Montgomery domain) with point_add and fixes up the
+  case p = q, which point_add does not handle: h and r are read back from the
+  scratch space of point_add.
+*/
+static void point_add_public(uint64_t *p, uint64_t *q, uint64_t *result, uint64_t *tempBuffer)
+{
+  uint64_t sum[12U] = { 0U };
+  uint64_t *h = tempBuffer + (uint32_t)32U;
+  uint64_t *r = tempBuffer + (uint32_t)36U;
+  point_add(p, q, sum, tempBuffer);
+  if
+  (
+    !isPointAtInfinityPublic(p)
+    && !isPointAtInfinityPublic(q)
+    && isZero_uint64_CT(h) == (uint64_t)0xFFFFFFFFFFFFFFFFU
+    && isZero_uint64_CT(r) == (uint64_t)0xFFFFFFFFFFFFFFFFU
+  )
+  {
+    point_double(p, result, tempBuffer);
+  }
+  else
+  {
+    copy_point(sum, result);
+  }
+}
+
+/*
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+
+  Same as point_add_public for an affine q, using point_add_mixed.
+*/
+static void
+point_add_mixed_public(uint64_t *p, uint64_t *q, uint64_t *result, uint64_t *tempBuffer)
+{
+  uint64_t sum[12U] = { 0U };
+  uint64_t *h = tempBuffer + (uint32_t)16U;
+  uint64_t *r = tempBuffer + (uint32_t)20U;
+  point_add_mixed(p, q, (uint64_t)0U, sum, tempBuffer);
+  if
+  (
+    !isPointAtInfinityPublic(p)
+    && isZero_uint64_CT(h) == (uint64_t)0xFFFFFFFFFFFFFFFFU
+    && isZero_uint64_CT(r) == (uint64_t)0xFFFFFFFFFFFFFFFFU
+  )
+  {
+    point_double(p, result, tempBuffer);
+  }
+  else
+  {
+    copy_point(sum, result);
+  }
+}
+
+/*
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+
+  Double-scalar multiplication result = [u1]G + [u2]Q (Straus' interleaving)
+  for scalars given as 4 little-endian limbs and Q in the Montgomery domain.
+  Both scalars are recoded in width-5 NAF: the odd multiples [1]G, ..., [15]G
+  are the first row of the fixed-base table used for signing, and [1]Q, [3]Q,
+  ..., [15]Q are computed on the fly.
+*/
+static void
+point_mul_double_public(
+  uint64_t *result,
+  uint64_t *u1,
+  uint64_t *u2,
+  uint64_t *q,
+  uint64_t *tempBuffer
+)
+{
+  int8_t naf1[257U] = { 0U };
+  int8_t naf2[257U] = { 0U };
+  uint64_t tableQ[96U] = { 0U };
+  uint64_t q2[12U] = { 0U };
+  uint64_t t[12U] = { 0U };
+  uint64_t zero[4U] = { 0U };
+  recode_wnaf(naf1, u1, (uint32_t)5U);
+  recode_wnaf(naf2, u2, (uint32_t)5U);
+  copy_point(q, tableQ);
+  point_double(q, q2, tempBuffer);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)8U; i++)
+  {
+    point_add(tableQ + (i - (uint32_t)1U) * (uint32_t)12U,
+      q2,
+      tableQ + i * (uint32_t)12U,
+      tempBuffer);
+  }
+  zero_buffer(result);
+  bool started = false;
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)257U; i0++)
+  {
+    uint32_t i = (uint32_t)256U - i0;
+    if (started)
+    {
+      point_double(result, result, tempBuffer);
+    }
+    int8_t d1 = naf1[i];
+    if (d1 != (int8_t)0)
+    {
+      int8_t a1 = d1 < (int8_t)0 ? -d1 : d1;
+      memcpy(t,
+        Hacl_P256_PrecompTable_precomp_basepoint_table_w4 + (uint32_t)(a1 - (int8_t)1) * (uint32_t)8U,
+        (uint32_t)8U * sizeof (uint64_t));
+      if (d1 < (int8_t)0)
+      {
+        p256_sub(zero, t + (uint32_t)4U, t + (uint32_t)4U);
+      }
+      point_add_mixed_public(result, t, result, tempBuffer);
+      started = true;
+    }
+    int8_t d2 = naf2[i];
+    if (d2 != (int8_t)0)
+    {
+      int8_t a2 = d2 < (int8_t)0 ? -d2 : d2;
+      copy_point(tableQ + (uint32_t)(a2 / (int8_t)2) * (uint32_t)12U, t);
+      if (d2 < (int8_t)0)
+      {
+        p256_sub(zero, t + (uint32_t)4U, t + (uint32_t)4U);
+      }
+      point_add_public(result, t, result, tempBuffer);
+      started = true;
+    }
+  }
+}
+
+/*
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+
+  Checks x(p) mod n == r for a Jacobian p (Montgomery domain) without an
+  inversion: x(p) = X / Z^2 is below p, so it reduces to r exactly when it is
+  r or, if r + n < p, r + n.
+*/
+static bool compare_x_mod_order_public(uint64_t *p, uint64_t *r)
+{
+  uint64_t *pX = p;
+  uint64_t *pZ = p + (uint32_t)8U;
+  uint64_t z2[4U] = { 0U };
+  uint64_t rn[4U] = { 0U };
+  uint64_t multBuffer[8U] = { 0U };
+  uint64_t rDomain[4U] = { 0U };
+  uint64_t rz2[4U] = { 0U };
+  uint64_t tmp[4U] = { 0U };
+  montgomery_square_buffer(pZ, z2);
+  shift_256_impl(r, multBuffer);
+  solinas_reduction_impl(multBuffer, rDomain);
+  montgomery_multiplication_buffer(rDomain, z2, rz2);
+  if (compare_felem_bool(rz2, pX))
+  {
+    return true;
+  }
+  uint64_t c = add4_variables(r,
+      (uint64_t)0U,
+      prime256order_buffer[0U],
+      prime256order_buffer[1U],
+      prime256order_buffer[2U],
+      prime256order_buffer[3U],
+      rn);
+  uint64_t less = sub4_il(rn, prime256_buffer, tmp);
+  if (c == (uint64_t)1U || less == (uint64_t)0U)
+  {
+    return false;
+  }
+  memset(multBuffer, 0U, (uint32_t)8U * sizeof (uint64_t));
+  shift_256_impl(rn, multBuffer);
+  solinas_reduction_impl(multBuffer, rDomain);
+  montgomery_multiplication_buffer(rDomain, z2, rz2);
+  return compare_felem_bool(rz2, pX);
+}
+
+/*
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+
+  The part of the verification that follows the computation of s^-1 mod n
+  (inverseS, as returned by montgomery_ladder_exponent): the public key is
+  expected to be already validated, r and s to be in range.
+*/
+static bool
+ecdsa_verification_core(
+  uint64_t *publicKeyBuffer,
+  uint64_t *hashAsFelem,
+  uint64_t *r,
+  uint64_t *inverseS,
+  uint64_t *tempBuffer
+)
+{
+  uint64_t tempBuffer1[8U] = { 0U };
+  uint64_t *u1 = tempBuffer1;
+  uint64_t *u2 = tempBuffer1 + (uint32_t)4U;
+  multPowerPartial(inverseS, hashAsFelem, u1);
+  multPowerPartial(inverseS, r, u2);
+  uint64_t pointSum[12U] = { 0U };
+  uint64_t *buff = tempBuffer + (uint32_t)12U;
+  pointToDomain(publicKeyBuffer, publicKeyBuffer);
+  point_mul_double_public(pointSum, u1, u2, publicKeyBuffer, buff);
+  bool resultIsPAI = isPointAtInfinityPublic(pointSum);
+  bool r1 = !resultIsPAI;
+  bool state = r1;
+  if (state == false)
+  {
+    return false;
+  }
+  bool result = compare_x_mod_order_public(pointSum, r);
+  return result;
+}
+
 /*
    The input of the function is considered to be public,
 thus this code is not secret independent with respect to the operations done over the input.
@@ -2075,7 +2388,6 @@ ecdsa_verification_(
   uint64_t *publicKeyBuffer = tempBufferU64;
   uint64_t *hashAsFelem = tempBufferU64 + (uint32_t)12U;
   uint64_t *tempBuffer = tempBufferU64 + (uint32_t)16U;
-  uint64_t *xBuffer = tempBufferU64 + (uint32_t)116U;
   bufferToJac(pubKey, publicKeyBuffer);
   bool publicKeyCorrect = verifyQValidCurvePoint(publicKeyBuffer, tempBuffer);
   if (publicKeyCorrect == false)
@@ -2089,9 +2401,6 @@ ecdsa_verification_(
   {
     return false;
   }
-  uint8_t tempBufferU8[64U] = { 0U };
-  uint8_t *bufferU1 = tempBufferU8;
-  uint8_t *bufferU2 = tempBufferU8 + (uint32_t)32U;
   uint32_t sz;
   if (alg.tag == Spec_ECDSA_NoHash)
   {
@@ -2198,66 +2507,10 @@ ecdsa_verification_(
   uint8_t *cutHash = mHash;
   Hacl_Impl_P256_LowLevel_toUint64ChangeEndian(cutHash, hashAsFelem);
   reduction_prime_2prime_order(hashAsFelem, hashAsFelem);
-  uint64_t tempBuffer1[12U] = { 0U };
-  uint64_t *inverseS = tempBuffer1;
-  uint64_t *u1 = tempBuffer1 + (uint32_t)4U;
-  uint64_t *u2 = tempBuffer1 + (uint32_t)8U;
+  uint64_t inverseS[4U] = { 0U };
   fromDomainImpl(s, inverseS);
   montgomery_ladder_exponent(inverseS);
-  multPowerPartial(inverseS, hashAsFelem, u1);
-  multPowerPartial(inverseS, r, u2);
-  Hacl_Impl_P256_LowLevel_changeEndian(u1);
-  Hacl_Impl_P256_LowLevel_changeEndian(u2);
-  Hacl_Impl_P256_LowLevel_toUint8(u1, bufferU1);
-  Hacl_Impl_P256_LowLevel_toUint8(u2, bufferU2);
-  uint64_t pointSum[12U] = { 0U };
-  uint64_t points[24U] = { 0U };
-  uint64_t *buff = tempBuffer + (uint32_t)12U;
-  uint64_t *pointU1G = points;
-  uint64_t *pointU2Q0 = points + (uint32_t)12U;
-  secretToPublicWithoutNorm(pointU1G, bufferU1, tempBuffer);
-  scalarMultiplicationWithoutNorm(publicKeyBuffer, pointU2Q0, bufferU2, tempBuffer);
-  uint64_t *pointU1G0 = points;
-  uint64_t *pointU2Q = points + (uint32_t)12U;
-  uint64_t tmp[112U] = { 0U };
-  uint64_t *tmpForNorm = tmp;
-  uint64_t *result0Norm = tmp + (uint32_t)88U;
-  uint64_t *result1Norm = tmp + (uint32_t)100U;
-  uint64_t *pointU1G1 = points;
-  uint64_t *pointU2Q1 = points + (uint32_t)12U;
-  norm(pointU1G1, result0Norm, tmpForNorm);
-  norm(pointU2Q1, result1Norm, tmpForNorm);
-  uint64_t *x0 = result0Norm;
-  uint64_t *y0 = result0Norm + (uint32_t)4U;
-  uint64_t *z0 = result0Norm + (uint32_t)8U;
-  uint64_t *x1 = result1Norm;
-  uint64_t *y1 = result1Norm + (uint32_t)4U;
-  uint64_t *z1 = result1Norm + (uint32_t)8U;
-  bool xEqual = compare_felem_bool(x0, x1);
-  bool yEqual = compare_felem_bool(y0, y1);
-  bool zEqual = compare_felem_bool(z0, z1);
-  bool equalX = xEqual && yEqual && zEqual;
-  bool equalX0 = equalX;
-  if (equalX0)
-  {
-    point_double(pointU1G0, pointSum, buff);
-  }
-  else
-  {
-    point_add(pointU1G0, pointU2Q, pointSum, buff);
-  }
-  norm(pointSum, pointSum, buff);
-  bool resultIsPAI = isPointAtInfinityPublic(pointSum);
-  uint64_t *xCoordinateSum = pointSum;
-  memcpy(xBuffer, xCoordinateSum, (uint32_t)4U * sizeof (uint64_t));
-  reduction_prime_2prime_order(xBuffer, xBuffer);
-  bool r1 = !resultIsPAI;
-  bool state = r1;
-  if (state == false)
-  {
-    return false;
-  }
-  bool result = compare_felem_bool(xBuffer, r);
+  bool result = ecdsa_verification_core(publicKeyBuffer, hashAsFelem, r, inverseS, tempBuffer);
   return result;
 }
 
@@ -2407,47 +2660,31 @@ ecdsa_signature_core(
   return step5Flag | sIsZero;
 }
 
-static inline void cswap1(uint64_t bit, uint64_t *p1, uint64_t *p2)
-{
-  uint64_t mask = (uint64_t)0U - bit;
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
-  {
-    uint64_t dummy = mask & (p1[i] ^ p2[i]);
-    p1[i] = p1[i] ^ dummy;
-    p2[i] = p2[i] ^ dummy;
-  }
-}
-
-static void montgomery_ladder_power(uint64_t *a, const uint8_t *scalar, uint64_t *result)
+/*
+  Square root candidate a^((p + 1) / 4) in the Montgomery domain, with
+  (p + 1) / 4 = (2^32 - 1) * 2^222 + 2^190 + 2^94: a fixed chain of 253
+  squarings and 7 multiplications.
+*/
+static void square_root(uint64_t *a, uint64_t *result)
 {
-  uint64_t p[4U] = { 0U };
-  p[0U] = (uint64_t)1U;
-  p[1U] = (uint64_t)18446744069414584320U;
-  p[2U] = (uint64_t)18446744073709551615U;
-  p[3U] = (uint64_t)4294967294U;
-  for (uint32_t i = (uint32_t)0U; i < (uint32_t)256U; i++)
+  uint64_t t[4U] = { 0U };
+  uint64_t r[4U] = { 0U };
+  montgomery_square_buffer(a, r);
+  montgomery_multiplication_buffer(r, a, r);
+  for (uint32_t i = (uint32_t)1U; i < (uint32_t)5U; i++)
   {
-    uint32_t bit0 = (uint32_t)255U - i;
-    uint64_t bit = (uint64_t)(scalar[bit0 / (uint32_t)8U] >> bit0 % (uint32_t)8U & (uint8_t)1U);
-    cswap1(bit, p, a);
-    montgomery_multiplication_buffer(p, a, a);
-    montgomery_square_buffer(p, p);
-    cswap1(bit, p, a);
+    memcpy(t, r, (uint32_t)4U * sizeof (uint64_t));
+    fsquarePowN((uint32_t)1U << i, t);
+    montgomery_multiplication_buffer(t, r, r);
   }
-  memcpy(result, p, (uint32_t)4U * sizeof (uint64_t));
+  fsquarePowN((uint32_t)32U, r);
+  montgomery_multiplication_buffer(r, a, r);
+  fsquarePowN((uint32_t)96U, r);
+  montgomery_multiplication_buffer(r, a, r);
+  fsquarePowN((uint32_t)94U, r);
+  memcpy(result, r, (uint32_t)4U * sizeof (uint64_t));
 }
 
-static const
-uint8_t
-sqPower_buffer[32U] =
-  {
-    (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U,
-    (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)64U, (uint8_t)0U, (uint8_t)0U,
-    (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U,
-    (uint8_t)0U, (uint8_t)0U, (uint8_t)64U, (uint8_t)0U, (uint8_t)0U, (uint8_t)0U, (uint8_t)192U,
-    (uint8_t)255U, (uint8_t)255U, (uint8_t)255U, (uint8_t)63U
-  };
-
 static void computeYFromX(uint64_t *x, uint64_t *result, uint64_t sign)
 {
   uint64_t aCoordinateBuffer[4U] = { 0U };
@@ -2465,7 +2702,7 @@ static void computeYFromX(uint64_t *x, uint64_t *result, uint64_t sign)
   p256_add(result, aCoordinateBuffer, result);
   p256_add(result, bCoordinateBuffer, result);
   uploadZeroImpl(aCoordinateBuffer);
-  montgomery_ladder_power(result, sqPower_buffer, result);
+  square_root(result, result);
   montgomery_multiplication_buffer_by_one(result, result);
   p256_sub(aCoordinateBuffer, result, bCoordinateBuffer);
   uint64_t word = result[0U];
@@ -2822,6 +3059,131 @@ Hacl_P256_ecdsa_verif_without_hash(
   return result;
 }
 
+/*
+   The input of the function is considered to be public,
+thus this code is not secret independent with respect to the operations done over the input.
+
+  Verifies up to 64 signatures, sharing a single inversion modulo the order
+  between all of them (Montgomery's trick): the values s_i are multiplied
+  together, the product is inverted once with montgomery_ladder_exponent and
+  each s_i^-1 is recovered with two multiplications. Signatures with r or s
+  out of range and invalid public keys are excluded from the product.
+
+  The public keys are checked to have coordinates below p and to lie on the
+  curve; unlike verifyQValidCurvePoint, the check [n]Q = O is skipped since it
+  holds for every point of the curve (its cofactor is 1).
+*/
+static void
+ecdsa_verif_batch_chunk(
+  uint32_t n,
+  uint8_t **pubKeys,
+  uint8_t **hashes,
+  uint8_t **r,
+  uint8_t **s,
+  bool *results
+)
+{
+  uint64_t publicKeyBuffer[768U] = { 0U };
+  uint64_t hashAsFelem[256U] = { 0U };
+  uint64_t rAsFelem[256U] = { 0U };
+  uint64_t sAsFelem[256U] = { 0U };
+  uint64_t prefix[256U] = { 0U };
+  uint64_t tempBuffer[100U] = { 0U };
+  uint64_t acc[4U] = { 0U };
+  uint64_t inverseS[4U] = { 0U };
+  bool valid[64U] = { 0U };
+  acc[0U] = (uint64_t)884452912994769583U;
+  acc[1U] = (uint64_t)4834901526196019579U;
+  acc[2U] = (uint64_t)0U;
+  acc[3U] = (uint64_t)4294967295U;
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    uint64_t *pk = publicKeyBuffer + i * (uint32_t)12U;
+    uint64_t *h = hashAsFelem + i * (uint32_t)4U;
+    uint64_t *ri = rAsFelem + i * (uint32_t)4U;
+    uint64_t *si = sAsFelem + i * (uint32_t)4U;
+    uint64_t publicKeyAsFelem[8U] = { 0U };
+    Hacl_Impl_P256_LowLevel_toUint64ChangeEndian(pubKeys[i], publicKeyAsFelem);
+    Hacl_Impl_P256_LowLevel_toUint64ChangeEndian(pubKeys[i] + (uint32_t)32U,
+      publicKeyAsFelem + (uint32_t)4U);
+    Hacl_Impl_P256_LowLevel_toUint64ChangeEndian(r[i], ri);
+    Hacl_Impl_P256_LowLevel_toUint64ChangeEndian(s[i], si);
+    Hacl_Impl_P256_LowLevel_toUint64ChangeEndian(hashes[i], h);
+    reduction_prime_2prime_order(h, h);
+    bufferToJac(publicKeyAsFelem, pk);
+    bool publicKeyCorrect = isCoordinateValid(pk) && isPointOnCurvePublic(pk);
+    bool isRCorrect = isMoreThanZeroLessThanOrderMinusOne(ri);
+    bool isSCorrect = isMoreThanZeroLessThanOrderMinusOne(si);
+    valid[i] = publicKeyCorrect && isRCorrect && isSCorrect;
+    memcpy(prefix + i * (uint32_t)4U, acc, (uint32_t)4U * sizeof (uint64_t));
+    if (valid[i])
+    {
+      fromDomainImpl(si, si);
+      montgomery_multiplication_ecdsa_module(acc, si, acc);
+    }
+  }
+  montgomery_ladder_exponent(acc);
+  for (uint32_t i0 = (uint32_t)0U; i0 < n; i0++)
+  {
+    uint32_t i = n - (uint32_t)1U - i0;
+    if (valid[i])
+    {
+      uint64_t *si = sAsFelem + i * (uint32_t)4U;
+      montgomery_multiplication_ecdsa_module(acc, prefix + i * (uint32_t)4U, inverseS);
+      montgomery_multiplication_ecdsa_module(acc, si, acc);
+      memcpy(si, inverseS, (uint32_t)4U * sizeof (uint64_t));
+    }
+  }
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    results[i] =
+      valid[i]
+      &&
+        ecdsa_verification_core(publicKeyBuffer + i * (uint32_t)12U,
+          hashAsFelem + i * (uint32_t)4U,
+          rAsFelem + i * (uint32_t)4U,
+          sAsFelem + i * (uint32_t)4U,
+          tempBuffer);
+  }
+}
+
+/*
+ The input of the function is considered to be public, 
+  thus this code is not secret independent with respect to the operations done over the input.
+  
+ Input: n: the number of signatures, 
+ pub(lic)Keys: n pointers to uint8[64], 
+ hashes: n pointers to uint8[32], the hashed messages, 
+ r, s: n pointers to uint8[32] each. 
+  
+ Output: bool, true iff all n signatures are correct. The result for signature i (as
+  Hacl_P256_ecdsa_verif_without_hash would return it for mLen = 32) is written to results[i].
+  
+ The signatures are processed by chunks of 64, sharing the inversion of s modulo the order.
+*/
+bool
+Hacl_P256_ecdsa_verif_batch(
+  uint32_t n,
+  uint8_t **pubKeys,
+  uint8_t **hashes,
+  uint8_t **r,
+  uint8_t **s,
+  bool *results
+)
+{
+  for (uint32_t i = (uint32_t)0U; i < n; i = i + (uint32_t)64U)
+  {
+    uint32_t len = n - i < (uint32_t)64U ? n - i : (uint32_t)64U;
+    ecdsa_verif_batch_chunk(len, pubKeys + i, hashes + i, r + i, s + i, results + i);
+  }
+  bool ok = true;
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    ok = ok && results[i];
+  }
+  return ok;
+}
+
 /*
  Public key verification function. 
   
@@ -2924,6 +3286,32 @@ bool Hacl_P256_decompression_compressed_form(uint8_t *b, uint8_t *result)
   return false;
 }
 
+/*
+ Input: n: the number of points, 
+ b: n pointers to points in compressed form (uint8[33]), 
+ result: n pointers to uint8[64] (internal point representation), 
+ results: bool[n]. 
+  
+ Output: bool, true iff all n points were decompressed correctly; the result of
+  Hacl_P256_decompression_compressed_form for point i is written to results[i].
+*/
+bool
+Hacl_P256_decompression_compressed_form_batch(
+  uint32_t n,
+  uint8_t **b,
+  uint8_t **result,
+  bool *results
+)
+{
+  bool ok = true;
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    results[i] = Hacl_P256_decompression_compressed_form(b[i], result[i]);
+    ok = ok && results[i];
+  }
+  return ok;
+}
+
 /*
  Input: a point buffer (internal representation: uint8[64]), 
  result: a point in not compressed form (uint8[65]).
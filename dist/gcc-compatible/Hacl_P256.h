@@ -41,6 +41,7 @@ extern "C" {
 #include "Hacl_Kremlib.h"
 #include "Hacl_Hash.h"
 #include "Hacl_Spec.h"
+#include "Hacl_P256_PrecompTable.h"
 
 void Hacl_Impl_P256_LowLevel_toUint8(uint64_t *i, uint8_t *o);
 
@@ -219,6 +220,30 @@ Hacl_P256_ecdsa_verif_without_hash(
   uint8_t *s
 );
 
+/*
+ The input of the function is considered to be public, 
+  thus this code is not secret independent with respect to the operations done over the input.
+  
+ Input: n: the number of signatures, 
+ pub(lic)Keys: n pointers to uint8[64], 
+ hashes: n pointers to uint8[32], the hashed messages, 
+ r, s: n pointers to uint8[32] each. 
+  
+ Output: bool, true iff all n signatures are correct. The result for signature i (as
+  Hacl_P256_ecdsa_verif_without_hash would return it for mLen = 32) is written to results[i].
+  
+ The signatures are processed by chunks of 64, sharing the inversion of s modulo the order.
+*/
+bool
+Hacl_P256_ecdsa_verif_batch(
+  uint32_t n,
+  uint8_t **pubKeys,
+  uint8_t **hashes,
+  uint8_t **r,
+  uint8_t **s,
+  bool *results
+);
+
 /*
  Public key verification function. 
   
@@ -265,6 +290,23 @@ bool Hacl_P256_decompression_not_compressed_form(uint8_t *b, uint8_t *result);
 */
 bool Hacl_P256_decompression_compressed_form(uint8_t *b, uint8_t *result);
 
+/*
+ Input: n: the number of points, 
+ b: n pointers to points in compressed form (uint8[33]), 
+ result: n pointers to uint8[64] (internal point representation), 
+ results: bool[n]. 
+  
+ Output: bool, true iff all n points were decompressed correctly; the result of
+  Hacl_P256_decompression_compressed_form for point i is written to results[i].
+*/
+bool
+Hacl_P256_decompression_compressed_form_batch(
+  uint32_t n,
+  uint8_t **b,
+  uint8_t **result,
+  bool *results
+);
+
 /*
  Input: a point buffer (internal representation: uint8[64]), 
  result: a point in not compressed form (uint8[65]).
@@ -0,0 +1,486 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#include "Hacl_Poly1305_512.h"
+
+/* Same 5x26-bit limb representation as Hacl_Poly1305_256, with eight
+   independent accumulators: lane i absorbs blocks i, i + 8, i + 16, ... and
+   the lanes are combined with r^8 .. r^1 once the bulk loop is done. */
+
+static inline void
+carry_wide_512(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 t0,
+  Lib_IntVector_Intrinsics_vec512 t1,
+  Lib_IntVector_Intrinsics_vec512 t2,
+  Lib_IntVector_Intrinsics_vec512 t3,
+  Lib_IntVector_Intrinsics_vec512 t4
+)
+{
+  Lib_IntVector_Intrinsics_vec512
+  mask26 = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3ffffffU);
+  Lib_IntVector_Intrinsics_vec512
+  z0 = Lib_IntVector_Intrinsics_vec512_shift_right64(t0, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512
+  z1 = Lib_IntVector_Intrinsics_vec512_shift_right64(t3, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512 x0 = Lib_IntVector_Intrinsics_vec512_and(t0, mask26);
+  Lib_IntVector_Intrinsics_vec512 x3 = Lib_IntVector_Intrinsics_vec512_and(t3, mask26);
+  Lib_IntVector_Intrinsics_vec512 x1 = Lib_IntVector_Intrinsics_vec512_add64(t1, z0);
+  Lib_IntVector_Intrinsics_vec512 x4 = Lib_IntVector_Intrinsics_vec512_add64(t4, z1);
+  Lib_IntVector_Intrinsics_vec512
+  z01 = Lib_IntVector_Intrinsics_vec512_shift_right64(x1, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512
+  z11 = Lib_IntVector_Intrinsics_vec512_shift_right64(x4, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512
+  t = Lib_IntVector_Intrinsics_vec512_shift_left64(z11, (uint32_t)2U);
+  Lib_IntVector_Intrinsics_vec512 z12 = Lib_IntVector_Intrinsics_vec512_add64(z11, t);
+  Lib_IntVector_Intrinsics_vec512 x11 = Lib_IntVector_Intrinsics_vec512_and(x1, mask26);
+  Lib_IntVector_Intrinsics_vec512 x41 = Lib_IntVector_Intrinsics_vec512_and(x4, mask26);
+  Lib_IntVector_Intrinsics_vec512 x2 = Lib_IntVector_Intrinsics_vec512_add64(t2, z01);
+  Lib_IntVector_Intrinsics_vec512 x01 = Lib_IntVector_Intrinsics_vec512_add64(x0, z12);
+  Lib_IntVector_Intrinsics_vec512
+  z02 = Lib_IntVector_Intrinsics_vec512_shift_right64(x2, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512
+  z13 = Lib_IntVector_Intrinsics_vec512_shift_right64(x01, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512 x21 = Lib_IntVector_Intrinsics_vec512_and(x2, mask26);
+  Lib_IntVector_Intrinsics_vec512 x02 = Lib_IntVector_Intrinsics_vec512_and(x01, mask26);
+  Lib_IntVector_Intrinsics_vec512 x31 = Lib_IntVector_Intrinsics_vec512_add64(x3, z02);
+  Lib_IntVector_Intrinsics_vec512 x12 = Lib_IntVector_Intrinsics_vec512_add64(x11, z13);
+  Lib_IntVector_Intrinsics_vec512
+  z03 = Lib_IntVector_Intrinsics_vec512_shift_right64(x31, (uint32_t)26U);
+  Lib_IntVector_Intrinsics_vec512 x32 = Lib_IntVector_Intrinsics_vec512_and(x31, mask26);
+  Lib_IntVector_Intrinsics_vec512 x42 = Lib_IntVector_Intrinsics_vec512_add64(x41, z03);
+  out[0U] = x02;
+  out[1U] = x12;
+  out[2U] = x21;
+  out[3U] = x32;
+  out[4U] = x42;
+}
+
+/* out = f1 * r, where r5 = 5 * r */
+static inline void
+fmul_r_512(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *f1,
+  Lib_IntVector_Intrinsics_vec512 *r,
+  Lib_IntVector_Intrinsics_vec512 *r5
+)
+{
+  Lib_IntVector_Intrinsics_vec512 r0 = r[0U];
+  Lib_IntVector_Intrinsics_vec512 r1 = r[1U];
+  Lib_IntVector_Intrinsics_vec512 r2 = r[2U];
+  Lib_IntVector_Intrinsics_vec512 r3 = r[3U];
+  Lib_IntVector_Intrinsics_vec512 r4 = r[4U];
+  Lib_IntVector_Intrinsics_vec512 r51 = r5[1U];
+  Lib_IntVector_Intrinsics_vec512 r52 = r5[2U];
+  Lib_IntVector_Intrinsics_vec512 r53 = r5[3U];
+  Lib_IntVector_Intrinsics_vec512 r54 = r5[4U];
+  Lib_IntVector_Intrinsics_vec512 f10 = f1[0U];
+  Lib_IntVector_Intrinsics_vec512 f11 = f1[1U];
+  Lib_IntVector_Intrinsics_vec512 f12 = f1[2U];
+  Lib_IntVector_Intrinsics_vec512 f13 = f1[3U];
+  Lib_IntVector_Intrinsics_vec512 f14 = f1[4U];
+  Lib_IntVector_Intrinsics_vec512 a0 = Lib_IntVector_Intrinsics_vec512_mul64(r0, f10);
+  Lib_IntVector_Intrinsics_vec512 a1 = Lib_IntVector_Intrinsics_vec512_mul64(r1, f10);
+  Lib_IntVector_Intrinsics_vec512 a2 = Lib_IntVector_Intrinsics_vec512_mul64(r2, f10);
+  Lib_IntVector_Intrinsics_vec512 a3 = Lib_IntVector_Intrinsics_vec512_mul64(r3, f10);
+  Lib_IntVector_Intrinsics_vec512 a4 = Lib_IntVector_Intrinsics_vec512_mul64(r4, f10);
+  a0 = Lib_IntVector_Intrinsics_vec512_add64(a0, Lib_IntVector_Intrinsics_vec512_mul64(r54, f11));
+  a1 = Lib_IntVector_Intrinsics_vec512_add64(a1, Lib_IntVector_Intrinsics_vec512_mul64(r0, f11));
+  a2 = Lib_IntVector_Intrinsics_vec512_add64(a2, Lib_IntVector_Intrinsics_vec512_mul64(r1, f11));
+  a3 = Lib_IntVector_Intrinsics_vec512_add64(a3, Lib_IntVector_Intrinsics_vec512_mul64(r2, f11));
+  a4 = Lib_IntVector_Intrinsics_vec512_add64(a4, Lib_IntVector_Intrinsics_vec512_mul64(r3, f11));
+  a0 = Lib_IntVector_Intrinsics_vec512_add64(a0, Lib_IntVector_Intrinsics_vec512_mul64(r53, f12));
+  a1 = Lib_IntVector_Intrinsics_vec512_add64(a1, Lib_IntVector_Intrinsics_vec512_mul64(r54, f12));
+  a2 = Lib_IntVector_Intrinsics_vec512_add64(a2, Lib_IntVector_Intrinsics_vec512_mul64(r0, f12));
+  a3 = Lib_IntVector_Intrinsics_vec512_add64(a3, Lib_IntVector_Intrinsics_vec512_mul64(r1, f12));
+  a4 = Lib_IntVector_Intrinsics_vec512_add64(a4, Lib_IntVector_Intrinsics_vec512_mul64(r2, f12));
+  a0 = Lib_IntVector_Intrinsics_vec512_add64(a0, Lib_IntVector_Intrinsics_vec512_mul64(r52, f13));
+  a1 = Lib_IntVector_Intrinsics_vec512_add64(a1, Lib_IntVector_Intrinsics_vec512_mul64(r53, f13));
+  a2 = Lib_IntVector_Intrinsics_vec512_add64(a2, Lib_IntVector_Intrinsics_vec512_mul64(r54, f13));
+  a3 = Lib_IntVector_Intrinsics_vec512_add64(a3, Lib_IntVector_Intrinsics_vec512_mul64(r0, f13));
+  a4 = Lib_IntVector_Intrinsics_vec512_add64(a4, Lib_IntVector_Intrinsics_vec512_mul64(r1, f13));
+  a0 = Lib_IntVector_Intrinsics_vec512_add64(a0, Lib_IntVector_Intrinsics_vec512_mul64(r51, f14));
+  a1 = Lib_IntVector_Intrinsics_vec512_add64(a1, Lib_IntVector_Intrinsics_vec512_mul64(r52, f14));
+  a2 = Lib_IntVector_Intrinsics_vec512_add64(a2, Lib_IntVector_Intrinsics_vec512_mul64(r53, f14));
+  a3 = Lib_IntVector_Intrinsics_vec512_add64(a3, Lib_IntVector_Intrinsics_vec512_mul64(r54, f14));
+  a4 = Lib_IntVector_Intrinsics_vec512_add64(a4, Lib_IntVector_Intrinsics_vec512_mul64(r0, f14));
+  carry_wide_512(out, a0, a1, a2, a3, a4);
+}
+
+static inline void
+smul5_512(Lib_IntVector_Intrinsics_vec512 *out, Lib_IntVector_Intrinsics_vec512 *f)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    out[i] = Lib_IntVector_Intrinsics_vec512_smul64(f[i], (uint64_t)5U);
+  }
+}
+
+static inline void
+fadd_512(Lib_IntVector_Intrinsics_vec512 *out, Lib_IntVector_Intrinsics_vec512 *f)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    out[i] = Lib_IntVector_Intrinsics_vec512_add64(out[i], f[i]);
+  }
+}
+
+/* Splits a 128-bit value given as two 64-bit words per lane into limbs. */
+static inline void
+load_felem_512(
+  Lib_IntVector_Intrinsics_vec512 *e,
+  Lib_IntVector_Intrinsics_vec512 lo,
+  Lib_IntVector_Intrinsics_vec512 hi
+)
+{
+  Lib_IntVector_Intrinsics_vec512
+  mask26 = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3ffffffU);
+  e[0U] = Lib_IntVector_Intrinsics_vec512_and(lo, mask26);
+  e[1U] =
+    Lib_IntVector_Intrinsics_vec512_and(Lib_IntVector_Intrinsics_vec512_shift_right64(lo,
+        (uint32_t)26U),
+      mask26);
+  e[2U] =
+    Lib_IntVector_Intrinsics_vec512_or(Lib_IntVector_Intrinsics_vec512_shift_right64(lo,
+        (uint32_t)52U),
+      Lib_IntVector_Intrinsics_vec512_shift_left64(Lib_IntVector_Intrinsics_vec512_and(hi,
+          Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3fffU)),
+        (uint32_t)12U));
+  e[3U] =
+    Lib_IntVector_Intrinsics_vec512_and(Lib_IntVector_Intrinsics_vec512_shift_right64(hi,
+        (uint32_t)14U),
+      mask26);
+  e[4U] = Lib_IntVector_Intrinsics_vec512_shift_right64(hi, (uint32_t)40U);
+}
+
+/* Loads eight consecutive blocks, block i going to lane i. */
+static inline void load_blocks8_512(Lib_IntVector_Intrinsics_vec512 *e, uint8_t *b)
+{
+  Lib_IntVector_Intrinsics_vec512 b0 = Lib_IntVector_Intrinsics_vec512_load64_le(b);
+  Lib_IntVector_Intrinsics_vec512
+  b1 = Lib_IntVector_Intrinsics_vec512_load64_le(b + (uint32_t)64U);
+  Lib_IntVector_Intrinsics_vec512 m0 = Lib_IntVector_Intrinsics_vec512_interleave_low256(b0, b1);
+  Lib_IntVector_Intrinsics_vec512
+  m1 = Lib_IntVector_Intrinsics_vec512_interleave_high256(b0, b1);
+  Lib_IntVector_Intrinsics_vec512 m2 = Lib_IntVector_Intrinsics_vec512_interleave_low128(m0, m1);
+  Lib_IntVector_Intrinsics_vec512
+  m3 = Lib_IntVector_Intrinsics_vec512_interleave_high128(m0, m1);
+  Lib_IntVector_Intrinsics_vec512 lo = Lib_IntVector_Intrinsics_vec512_interleave_low64(m2, m3);
+  Lib_IntVector_Intrinsics_vec512 hi = Lib_IntVector_Intrinsics_vec512_interleave_high64(m2, m3);
+  load_felem_512(e, lo, hi);
+  e[4U] =
+    Lib_IntVector_Intrinsics_vec512_or(e[4U],
+      Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x1000000U));
+}
+
+/* Loads a single block of len <= 16 bytes into every lane. */
+static inline void
+load_block1_512(Lib_IntVector_Intrinsics_vec512 *e, uint32_t len, uint8_t *b)
+{
+  uint8_t tmp[16U] = { 0U };
+  memcpy(tmp, b, len * sizeof (uint8_t));
+  uint64_t lo = load64_le(tmp);
+  uint64_t hi = load64_le(tmp + (uint32_t)8U);
+  load_felem_512(e,
+    Lib_IntVector_Intrinsics_vec512_load64(lo),
+    Lib_IntVector_Intrinsics_vec512_load64(hi));
+  uint32_t pos = len * (uint32_t)8U;
+  e[pos / (uint32_t)26U] =
+    Lib_IntVector_Intrinsics_vec512_or(e[pos / (uint32_t)26U],
+      Lib_IntVector_Intrinsics_vec512_load64((uint64_t)1U << pos % (uint32_t)26U));
+}
+
+/* acc = (acc + e) * r */
+static inline void
+fadd_mul_r_512(
+  Lib_IntVector_Intrinsics_vec512 *acc,
+  Lib_IntVector_Intrinsics_vec512 *e,
+  Lib_IntVector_Intrinsics_vec512 *pre
+)
+{
+  fadd_512(acc, e);
+  fmul_r_512(acc, acc, pre, pre + (uint32_t)5U);
+}
+
+void
+Hacl_Impl_Poly1305_Field32xN_512_load_acc8(Lib_IntVector_Intrinsics_vec512 *acc, uint8_t *b)
+{
+  Lib_IntVector_Intrinsics_vec512 e[5U];
+  load_blocks8_512(e, b);
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512
+    a0 =
+      Lib_IntVector_Intrinsics_vec512_insert64(Lib_IntVector_Intrinsics_vec512_zero,
+        Lib_IntVector_Intrinsics_vec512_extract64(acc[i], (uint32_t)0U),
+        (uint32_t)0U);
+    acc[i] = Lib_IntVector_Intrinsics_vec512_add64(a0, e[i]);
+  }
+}
+
+void
+Hacl_Impl_Poly1305_Field32xN_512_fmul_r8_normalize(
+  Lib_IntVector_Intrinsics_vec512 *out,
+  Lib_IntVector_Intrinsics_vec512 *p
+)
+{
+  Lib_IntVector_Intrinsics_vec512 *r = p;
+  Lib_IntVector_Intrinsics_vec512 *r5 = p + (uint32_t)5U;
+  Lib_IntVector_Intrinsics_vec512 r2[5U];
+  Lib_IntVector_Intrinsics_vec512 r2_5[5U];
+  Lib_IntVector_Intrinsics_vec512 r3[5U];
+  Lib_IntVector_Intrinsics_vec512 r4[5U];
+  fmul_r_512(r2, r, r, r5);
+  smul5_512(r2_5, r2);
+  fmul_r_512(r3, r2, r, r5);
+  fmul_r_512(r4, r2, r2, r2_5);
+  /* rs = [r^4, r^3, r^2, r^1, r^4, r^3, r^2, r^1] and
+     s = [r^4, r^4, r^4, r^4, 1, 1, 1, 1], so rs * s = [r^8, ..., r^1] */
+  Lib_IntVector_Intrinsics_vec512 rs[5U];
+  Lib_IntVector_Intrinsics_vec512 rs5[5U];
+  Lib_IntVector_Intrinsics_vec512 s[5U];
+  Lib_IntVector_Intrinsics_vec512 s5[5U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512
+    v12 = Lib_IntVector_Intrinsics_vec512_interleave_low64(r2[i], r[i]);
+    Lib_IntVector_Intrinsics_vec512
+    v34 = Lib_IntVector_Intrinsics_vec512_interleave_low64(r4[i], r3[i]);
+    rs[i] = Lib_IntVector_Intrinsics_vec512_interleave_low128(v34, v12);
+    Lib_IntVector_Intrinsics_vec512
+    one =
+      i == (uint32_t)0U
+        ? Lib_IntVector_Intrinsics_vec512_load64((uint64_t)1U)
+        : Lib_IntVector_Intrinsics_vec512_zero;
+    s[i] = Lib_IntVector_Intrinsics_vec512_interleave_low256(r4[i], one);
+  }
+  smul5_512(s5, s);
+  fmul_r_512(rs, rs, s, s5);
+  smul5_512(rs5, rs);
+  fmul_r_512(out, out, rs, rs5);
+  Lib_IntVector_Intrinsics_vec512 v[5U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512 o = out[i];
+    Lib_IntVector_Intrinsics_vec512
+    v0 =
+      Lib_IntVector_Intrinsics_vec512_add64(o,
+        Lib_IntVector_Intrinsics_vec512_interleave_high256(o, o));
+    Lib_IntVector_Intrinsics_vec512
+    v1 =
+      Lib_IntVector_Intrinsics_vec512_add64(v0,
+        Lib_IntVector_Intrinsics_vec512_interleave_high128(v0, v0));
+    v[i] =
+      Lib_IntVector_Intrinsics_vec512_add64(v1,
+        Lib_IntVector_Intrinsics_vec512_interleave_high64(v1, v1));
+  }
+  Lib_IntVector_Intrinsics_vec512
+  mask26 = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3ffffffU);
+  Lib_IntVector_Intrinsics_vec512 c = Lib_IntVector_Intrinsics_vec512_zero;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512 l = Lib_IntVector_Intrinsics_vec512_add64(v[i], c);
+    out[i] = Lib_IntVector_Intrinsics_vec512_and(l, mask26);
+    c = Lib_IntVector_Intrinsics_vec512_shift_right64(l, (uint32_t)26U);
+  }
+  out[0U] =
+    Lib_IntVector_Intrinsics_vec512_add64(out[0U],
+      Lib_IntVector_Intrinsics_vec512_smul64(c, (uint64_t)5U));
+}
+
+uint32_t Hacl_Poly1305_512_blocklen = (uint32_t)16U;
+
+void Hacl_Poly1305_512_poly1305_init(Lib_IntVector_Intrinsics_vec512 *ctx, uint8_t *key)
+{
+  Lib_IntVector_Intrinsics_vec512 *acc = ctx;
+  Lib_IntVector_Intrinsics_vec512 *pre = ctx + (uint32_t)5U;
+  uint8_t *kr = key;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+  {
+    acc[i] = Lib_IntVector_Intrinsics_vec512_zero;
+  }
+  uint64_t u0 = load64_le(kr);
+  uint64_t lo = u0;
+  uint64_t u = load64_le(kr + (uint32_t)8U);
+  uint64_t hi = u;
+  uint64_t mask0 = (uint64_t)0x0ffffffc0fffffffU;
+  uint64_t mask1 = (uint64_t)0x0ffffffc0ffffffcU;
+  uint64_t lo1 = lo & mask0;
+  uint64_t hi1 = hi & mask1;
+  Lib_IntVector_Intrinsics_vec512 *r = pre;
+  Lib_IntVector_Intrinsics_vec512 *r5 = pre + (uint32_t)5U;
+  Lib_IntVector_Intrinsics_vec512 *rn = pre + (uint32_t)10U;
+  Lib_IntVector_Intrinsics_vec512 *rn_5 = pre + (uint32_t)15U;
+  load_felem_512(r,
+    Lib_IntVector_Intrinsics_vec512_load64(lo1),
+    Lib_IntVector_Intrinsics_vec512_load64(hi1));
+  smul5_512(r5, r);
+  /* rn = r^8, by three successive squarings */
+  fmul_r_512(rn, r, r, r5);
+  smul5_512(rn_5, rn);
+  fmul_r_512(rn, rn, rn, rn_5);
+  smul5_512(rn_5, rn);
+  fmul_r_512(rn, rn, rn, rn_5);
+  smul5_512(rn_5, rn);
+}
+
+void Hacl_Poly1305_512_poly1305_update1(Lib_IntVector_Intrinsics_vec512 *ctx, uint8_t *text)
+{
+  Lib_IntVector_Intrinsics_vec512 *pre = ctx + (uint32_t)5U;
+  Lib_IntVector_Intrinsics_vec512 *acc = ctx;
+  Lib_IntVector_Intrinsics_vec512 e[5U];
+  load_block1_512(e, (uint32_t)16U, text);
+  fadd_mul_r_512(acc, e, pre);
+}
+
+void
+Hacl_Poly1305_512_poly1305_update(
+  Lib_IntVector_Intrinsics_vec512 *ctx,
+  uint32_t len,
+  uint8_t *text
+)
+{
+  Lib_IntVector_Intrinsics_vec512 *pre = ctx + (uint32_t)5U;
+  Lib_IntVector_Intrinsics_vec512 *acc = ctx;
+  uint32_t sz_block = (uint32_t)128U;
+  uint32_t len0 = len / sz_block * sz_block;
+  uint8_t *t0 = text;
+  if (len0 > (uint32_t)0U)
+  {
+    uint32_t bs = (uint32_t)128U;
+    uint8_t *text0 = t0;
+    Hacl_Impl_Poly1305_Field32xN_512_load_acc8(acc, text0);
+    uint32_t len1 = len0 - bs;
+    uint8_t *text1 = t0 + bs;
+    uint32_t nb = len1 / bs;
+    for (uint32_t i = (uint32_t)0U; i < nb; i++)
+    {
+      uint8_t *block = text1 + i * bs;
+      Lib_IntVector_Intrinsics_vec512 e[5U];
+      load_blocks8_512(e, block);
+      fmul_r_512(acc, acc, pre + (uint32_t)10U, pre + (uint32_t)15U);
+      fadd_512(acc, e);
+    }
+    Hacl_Impl_Poly1305_Field32xN_512_fmul_r8_normalize(acc, pre);
+  }
+  uint32_t len1 = len - len0;
+  uint8_t *t1 = text + len0;
+  uint32_t nb = len1 / (uint32_t)16U;
+  uint32_t rem = len1 % (uint32_t)16U;
+  for (uint32_t i = (uint32_t)0U; i < nb; i++)
+  {
+    Lib_IntVector_Intrinsics_vec512 e[5U];
+    load_block1_512(e, (uint32_t)16U, t1 + i * (uint32_t)16U);
+    fadd_mul_r_512(acc, e, pre);
+  }
+  if (rem > (uint32_t)0U)
+  {
+    Lib_IntVector_Intrinsics_vec512 e[5U];
+    load_block1_512(e, rem, t1 + nb * (uint32_t)16U);
+    fadd_mul_r_512(acc, e, pre);
+  }
+}
+
+void
+Hacl_Poly1305_512_poly1305_finish(
+  uint8_t *tag,
+  uint8_t *key,
+  Lib_IntVector_Intrinsics_vec512 *ctx
+)
+{
+  Lib_IntVector_Intrinsics_vec512 *acc = ctx;
+  uint8_t *ks = key + (uint32_t)16U;
+  Lib_IntVector_Intrinsics_vec512
+  mh = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3ffffffU);
+  Lib_IntVector_Intrinsics_vec512
+  ml = Lib_IntVector_Intrinsics_vec512_load64((uint64_t)0x3fffffbU);
+  Lib_IntVector_Intrinsics_vec512 f[5U];
+  memcpy(f, acc, (uint32_t)5U * sizeof (Lib_IntVector_Intrinsics_vec512));
+  for (uint32_t j = (uint32_t)0U; j < (uint32_t)2U; j++)
+  {
+    Lib_IntVector_Intrinsics_vec512 c = Lib_IntVector_Intrinsics_vec512_zero;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)5U; i++)
+    {
+      Lib_IntVector_Intrinsics_vec512 l = Lib_IntVector_Intrinsics_vec512_add64(f[i], c);
+      f[i] = Lib_IntVector_Intrinsics_vec512_and(l, mh);
+      c = Lib_IntVector_Intrinsics_vec512_shift_right64(l, (uint32_t)26U);
+    }
+    f[0U] =
+      Lib_IntVector_Intrinsics_vec512_add64(f[0U],
+        Lib_IntVector_Intrinsics_vec512_smul64(c, (uint64_t)5U));
+  }
+  /* Subtract p = 2^130 - 5 if f >= p, in constant time */
+  Lib_IntVector_Intrinsics_vec512 mask = Lib_IntVector_Intrinsics_vec512_eq64(f[4U], mh);
+  mask = Lib_IntVector_Intrinsics_vec512_and(mask, Lib_IntVector_Intrinsics_vec512_eq64(f[3U], mh));
+  mask = Lib_IntVector_Intrinsics_vec512_and(mask, Lib_IntVector_Intrinsics_vec512_eq64(f[2U], mh));
+  mask = Lib_IntVector_Intrinsics_vec512_and(mask, Lib_IntVector_Intrinsics_vec512_eq64(f[1U], mh));
+  mask =
+    Lib_IntVector_Intrinsics_vec512_and(mask,
+      Lib_IntVector_Intrinsics_vec512_lognot(Lib_IntVector_Intrinsics_vec512_gt64(ml, f[0U])));
+  Lib_IntVector_Intrinsics_vec512 ph = Lib_IntVector_Intrinsics_vec512_and(mask, mh);
+  Lib_IntVector_Intrinsics_vec512 pl = Lib_IntVector_Intrinsics_vec512_and(mask, ml);
+  uint64_t
+  f0 =
+    Lib_IntVector_Intrinsics_vec512_extract64(Lib_IntVector_Intrinsics_vec512_sub64(f[0U], pl),
+      (uint32_t)0U);
+  uint64_t
+  f1 =
+    Lib_IntVector_Intrinsics_vec512_extract64(Lib_IntVector_Intrinsics_vec512_sub64(f[1U], ph),
+      (uint32_t)0U);
+  uint64_t
+  f2 =
+    Lib_IntVector_Intrinsics_vec512_extract64(Lib_IntVector_Intrinsics_vec512_sub64(f[2U], ph),
+      (uint32_t)0U);
+  uint64_t
+  f3 =
+    Lib_IntVector_Intrinsics_vec512_extract64(Lib_IntVector_Intrinsics_vec512_sub64(f[3U], ph),
+      (uint32_t)0U);
+  uint64_t
+  f4 =
+    Lib_IntVector_Intrinsics_vec512_extract64(Lib_IntVector_Intrinsics_vec512_sub64(f[4U], ph),
+      (uint32_t)0U);
+  uint64_t lo = (f0 | f1 << (uint32_t)26U) | f2 << (uint32_t)52U;
+  uint64_t hi = (f2 >> (uint32_t)12U | f3 << (uint32_t)14U) | f4 << (uint32_t)40U;
+  uint64_t lo0 = load64_le(ks);
+  uint64_t hi0 = load64_le(ks + (uint32_t)8U);
+  uint64_t r0 = lo + lo0;
+  uint64_t r1 = hi + hi0;
+  uint64_t c = (r0 ^ ((r0 ^ lo0) | ((r0 - lo0) ^ lo0))) >> (uint32_t)63U;
+  uint64_t r11 = r1 + c;
+  store64_le(tag, r0);
+  store64_le(tag + (uint32_t)8U, r11);
+}
+
+void Hacl_Poly1305_512_poly1305_mac(uint8_t *tag, uint32_t len, uint8_t *text, uint8_t *key)
+{
+  Lib_IntVector_Intrinsics_vec512 ctx[25U];
+  for (uint32_t _i = 0U; _i < (uint32_t)25U; ++_i)
+    ctx[_i] = Lib_IntVector_Intrinsics_vec512_zero;
+  Hacl_Poly1305_512_poly1305_init(ctx, key);
+  Hacl_Poly1305_512_poly1305_update(ctx, len, text);
+  Hacl_Poly1305_512_poly1305_finish(tag, key, ctx);
+}
+
@@ -379,13 +379,17 @@ load_skey(
   return b && m1 == (uint64_t)0xFFFFFFFFFFFFFFFFU;
 }
 
-bool
-Hacl_RSAPSS_rsapss_sign(
+static inline bool
+rsapss_sign_precomp(
   Spec_Hash_Definitions_hash_alg a,
   uint32_t modBits,
   uint32_t eBits,
   uint32_t dBits,
-  uint64_t *skey,
+  uint64_t *n,
+  uint64_t mu,
+  uint64_t *r2,
+  uint64_t *e,
+  uint64_t *d,
   uint32_t saltLen,
   uint8_t *salt,
   uint32_t msgLen,
@@ -416,51 +420,24 @@ Hacl_RSAPSS_rsapss_sign(
     memset(em, 0U, emLen * sizeof (uint8_t));
     pss_encode(a, saltLen, salt, msgLen, msg, emBits, em);
     Hacl_Bignum_Convert_bn_from_bytes_be_uint64(emLen, em, m);
-    uint32_t nLen1 = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
     uint32_t k = (modBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
-    KRML_CHECK_SIZE(sizeof (uint64_t), nLen1);
-    uint64_t s[nLen1];
-    memset(s, 0U, nLen1 * sizeof (uint64_t));
-    KRML_CHECK_SIZE(sizeof (uint64_t), nLen1);
-    uint64_t m_[nLen1];
-    memset(m_, 0U, nLen1 * sizeof (uint64_t));
-    uint32_t nLen2 = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
-    uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
-    uint64_t *n = skey;
-    uint64_t *r2 = skey + nLen2;
-    uint64_t *e = skey + nLen2 + nLen2;
-    uint64_t *d = skey + nLen2 + nLen2 + eLen;
-    uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0U]);
-    Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64((modBits - (uint32_t)1U)
-      / (uint32_t)64U
-      + (uint32_t)1U,
-      n,
-      mu,
-      r2,
-      m,
-      dBits,
-      d,
-      s);
-    uint64_t mu0 = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0U]);
-    Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64((modBits - (uint32_t)1U)
-      / (uint32_t)64U
-      + (uint32_t)1U,
-      n,
-      mu0,
-      r2,
-      s,
-      eBits,
-      e,
-      m_);
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t s[nLen];
+    memset(s, 0U, nLen * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t m_[nLen];
+    memset(m_, 0U, nLen * sizeof (uint64_t));
+    Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(nLen, n, mu, r2, m, dBits, d, s);
+    Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(nLen, n, mu, r2, s, eBits, e, m_);
     uint64_t mask = (uint64_t)0xFFFFFFFFFFFFFFFFU;
-    for (uint32_t i = (uint32_t)0U; i < nLen2; i++)
+    for (uint32_t i = (uint32_t)0U; i < nLen; i++)
     {
       uint64_t uu____0 = FStar_UInt64_eq_mask(m[i], m_[i]);
       mask = uu____0 & mask;
     }
     uint64_t mask1 = mask;
     uint64_t eq_m = mask1;
-    for (uint32_t i = (uint32_t)0U; i < nLen2; i++)
+    for (uint32_t i = (uint32_t)0U; i < nLen; i++)
     {
       uint64_t *os = s;
       uint64_t x = s[i];
@@ -475,12 +452,15 @@ Hacl_RSAPSS_rsapss_sign(
   return false;
 }
 
-bool
-Hacl_RSAPSS_rsapss_verify(
+static inline bool
+rsapss_verify_precomp(
   Spec_Hash_Definitions_hash_alg a,
   uint32_t modBits,
   uint32_t eBits,
-  uint64_t *pkey,
+  uint64_t *n,
+  uint64_t mu,
+  uint64_t *r2,
+  uint64_t *e,
   uint32_t saltLen,
   uint32_t sgntLen,
   uint8_t *sgnt,
@@ -500,18 +480,13 @@ Hacl_RSAPSS_rsapss_verify(
     KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
     uint64_t m[nLen];
     memset(m, 0U, nLen * sizeof (uint64_t));
-    uint32_t nLen1 = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
     uint32_t k = (modBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
-    KRML_CHECK_SIZE(sizeof (uint64_t), nLen1);
-    uint64_t s[nLen1];
-    memset(s, 0U, nLen1 * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t s[nLen];
+    memset(s, 0U, nLen * sizeof (uint64_t));
     Hacl_Bignum_Convert_bn_from_bytes_be_uint64(k, sgnt, s);
-    uint32_t nLen2 = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
-    uint64_t *n = pkey;
-    uint64_t *r2 = pkey + nLen2;
-    uint64_t *e = pkey + nLen2 + nLen2;
     uint64_t acc = (uint64_t)0U;
-    for (uint32_t i = (uint32_t)0U; i < nLen2; i++)
+    for (uint32_t i = (uint32_t)0U; i < nLen; i++)
     {
       uint64_t beq = FStar_UInt64_eq_mask(s[i], n[i]);
       uint64_t blt = ~FStar_UInt64_gte_mask(s[i], n[i]);
@@ -521,17 +496,7 @@ Hacl_RSAPSS_rsapss_verify(
     bool res;
     if (mask == (uint64_t)0xFFFFFFFFFFFFFFFFU)
     {
-      uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0U]);
-      Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64((modBits - (uint32_t)1U)
-        / (uint32_t)64U
-        + (uint32_t)1U,
-        n,
-        mu,
-        r2,
-        s,
-        eBits,
-        e,
-        m);
+      Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(nLen, n, mu, r2, s, eBits, e, m);
       bool ite;
       if (!((modBits - (uint32_t)1U) % (uint32_t)8U == (uint32_t)0U))
       {
@@ -577,6 +542,77 @@ Hacl_RSAPSS_rsapss_verify(
   return false;
 }
 
+bool
+Hacl_RSAPSS_rsapss_sign(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t dBits,
+  uint64_t *skey,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+)
+{
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint64_t *n = skey;
+  uint64_t *r2 = skey + nLen;
+  uint64_t *e = skey + nLen + nLen;
+  uint64_t *d = skey + nLen + nLen + eLen;
+  uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0U]);
+  return
+    rsapss_sign_precomp(a,
+      modBits,
+      eBits,
+      dBits,
+      n,
+      mu,
+      r2,
+      e,
+      d,
+      saltLen,
+      salt,
+      msgLen,
+      msg,
+      sgnt);
+}
+
+bool
+Hacl_RSAPSS_rsapss_verify(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint64_t *pkey,
+  uint32_t saltLen,
+  uint32_t sgntLen,
+  uint8_t *sgnt,
+  uint32_t msgLen,
+  uint8_t *msg
+)
+{
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint64_t *n = pkey;
+  uint64_t *r2 = pkey + nLen;
+  uint64_t *e = pkey + nLen + nLen;
+  uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0U]);
+  return
+    rsapss_verify_precomp(a,
+      modBits,
+      eBits,
+      n,
+      mu,
+      r2,
+      e,
+      saltLen,
+      sgntLen,
+      sgnt,
+      msgLen,
+      msg);
+}
+
 uint64_t
 *Hacl_RSAPSS_new_rsapss_load_pkey(uint32_t modBits, uint32_t eBits, uint8_t *nb, uint8_t *eb)
 {
@@ -809,3 +845,578 @@ Hacl_RSAPSS_rsapss_pkey_verify(
   return false;
 }
 
+
+static inline bool
+load_skey_crt(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pqBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb,
+  uint64_t *skey
+)
+{
+  uint32_t pbLen = (pqBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t pLen = (pqBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t pkeyLen = nLen + nLen + eLen;
+  uint64_t *pkey = skey;
+  uint64_t *n = skey;
+  uint64_t *p = skey + pkeyLen;
+  uint64_t *r2p = p + pLen;
+  uint64_t *q = p + (uint32_t)2U * pLen;
+  uint64_t *r2q = p + (uint32_t)3U * pLen;
+  uint64_t *dP = p + (uint32_t)4U * pLen;
+  uint64_t *dQ = p + (uint32_t)5U * pLen;
+  uint64_t *qInv = p + (uint32_t)6U * pLen;
+  bool b = load_pkey(modBits, eBits, nb, eb, pkey);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, pb, p);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, qb, q);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, dPb, dP);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, dQb, dQ);
+  Hacl_Bignum_Convert_bn_from_bytes_be_uint64(pbLen, qInvb, qInv);
+  uint64_t m0 = ((uint64_t)0U - (p[0U] & (uint64_t)1U)) & ((uint64_t)0U - (q[0U] & (uint64_t)1U));
+  uint64_t m1 = check_num_bits_u64(pqBits, p) & check_num_bits_u64(pqBits, q);
+  uint64_t m2 = check_exponent_u64(pqBits, dP) & check_exponent_u64(pqBits, dQ);
+  uint64_t acc = (uint64_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < pLen; i++)
+  {
+    uint64_t beq = FStar_UInt64_eq_mask(qInv[i], p[i]);
+    uint64_t blt = ~FStar_UInt64_gte_mask(qInv[i], p[i]);
+    acc = (beq & acc) | (~beq & ((blt & (uint64_t)0xFFFFFFFFFFFFFFFFU) | (~blt & (uint64_t)0U)));
+  }
+  uint64_t m3 = acc;
+  KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)4U * pLen);
+  uint64_t tmp[(uint32_t)4U * pLen];
+  memset(tmp, 0U, (uint32_t)4U * pLen * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), pLen + pLen);
+  uint64_t pq[pLen + pLen];
+  memset(pq, 0U, (pLen + pLen) * sizeof (uint64_t));
+  Hacl_Bignum_Karatsuba_bn_karatsuba_mul_uint64(pLen, p, q, tmp, pq);
+  uint64_t m4 = (uint64_t)0xFFFFFFFFFFFFFFFFU;
+  for (uint32_t i = (uint32_t)0U; i < pLen + pLen; i++)
+  {
+    uint64_t ni;
+    if (i < nLen)
+    {
+      ni = n[i];
+    }
+    else
+    {
+      ni = (uint64_t)0U;
+    }
+    uint64_t uu____0 = FStar_UInt64_eq_mask(pq[i], ni);
+    m4 = uu____0 & m4;
+  }
+  Hacl_Bignum_Montgomery_bn_precomp_r2_mod_n_u64(pLen,
+    (uint32_t)64U * (uint32_t)Hacl_Bignum_Lib_bn_get_top_index_u64(pLen, p),
+    p,
+    r2p);
+  Hacl_Bignum_Montgomery_bn_precomp_r2_mod_n_u64(pLen,
+    (uint32_t)64U * (uint32_t)Hacl_Bignum_Lib_bn_get_top_index_u64(pLen, q),
+    q,
+    r2q);
+  uint64_t m = m0 & m1 & m2 & m3 & m4;
+  return b && nLen <= pLen + pLen && m == (uint64_t)0xFFFFFFFFFFFFFFFFU;
+}
+
+/*
+  Computes s = m ^ d mod n from the CRT components (p, q, dP, dQ, qInv) laid out
+  as in Hacl_RSAPSS_new_rsapss_load_skey_crt: two constant-time exponentiations
+  modulo p and q followed by Garner's recombination s = sq + q * (qInv * (sp - sq) mod p).
+*/
+static inline void
+bn_mod_exp_crt_u64(
+  uint32_t nLen,
+  uint32_t pqBits,
+  uint64_t *crt,
+  uint64_t *m,
+  uint64_t *s
+)
+{
+  uint32_t pLen = (pqBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint64_t *p = crt;
+  uint64_t *r2p = crt + pLen;
+  uint64_t *q = crt + (uint32_t)2U * pLen;
+  uint64_t *r2q = crt + (uint32_t)3U * pLen;
+  uint64_t *dP = crt + (uint32_t)4U * pLen;
+  uint64_t *dQ = crt + (uint32_t)5U * pLen;
+  uint64_t *qInv = crt + (uint32_t)6U * pLen;
+  uint64_t muP = Hacl_Bignum_ModInvLimb_mod_inv_uint64(p[0U]);
+  uint64_t muQ = Hacl_Bignum_ModInvLimb_mod_inv_uint64(q[0U]);
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 kp = { .len = pLen, .n = p, .mu = muP, .r2 = r2p };
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 kq = { .len = pLen, .n = q, .mu = muQ, .r2 = r2q };
+  KRML_CHECK_SIZE(sizeof (uint64_t), pLen + pLen);
+  uint64_t m2[pLen + pLen];
+  memset(m2, 0U, (pLen + pLen) * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)6U * pLen);
+  uint64_t tmp[(uint32_t)6U * pLen];
+  memset(tmp, 0U, (uint32_t)6U * pLen * sizeof (uint64_t));
+  uint64_t *mp = tmp;
+  uint64_t *mq = tmp + pLen;
+  uint64_t *sp = tmp + (uint32_t)2U * pLen;
+  uint64_t *sq = tmp + (uint32_t)3U * pLen;
+  uint64_t *t = tmp + (uint32_t)4U * pLen;
+  uint64_t *h = tmp + (uint32_t)5U * pLen;
+  memcpy(m2, m, nLen * sizeof (uint64_t));
+  Hacl_Bignum64_mod_precomp(&kp, m2, mp);
+  Hacl_Bignum64_mod_precomp(&kq, m2, mq);
+  Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(pLen, p, muP, r2p, mp, pqBits, dP, sp);
+  Hacl_Bignum_Exponentiation_bn_mod_exp_consttime_precomp_u64(pLen, q, muQ, r2q, mq, pqBits, dQ, sq);
+  memset(m2, 0U, (pLen + pLen) * sizeof (uint64_t));
+  memcpy(m2, sq, pLen * sizeof (uint64_t));
+  Hacl_Bignum64_mod_precomp(&kp, m2, t);
+  Hacl_Bignum_bn_sub_mod_n_u64(pLen, p, sp, t, mp);
+  Hacl_Bignum_Montgomery_bn_mont_mul_u64(pLen, p, muP, qInv, mp, t);
+  Hacl_Bignum_Montgomery_bn_to_mont_u64(pLen, p, muP, r2p, t, h);
+  KRML_CHECK_SIZE(sizeof (uint64_t), (uint32_t)4U * pLen);
+  uint64_t tmp1[(uint32_t)4U * pLen];
+  memset(tmp1, 0U, (uint32_t)4U * pLen * sizeof (uint64_t));
+  KRML_CHECK_SIZE(sizeof (uint64_t), pLen + pLen);
+  uint64_t qh[pLen + pLen];
+  memset(qh, 0U, (pLen + pLen) * sizeof (uint64_t));
+  Hacl_Bignum_Karatsuba_bn_karatsuba_mul_uint64(pLen, q, h, tmp1, qh);
+  uint64_t c = Hacl_Bignum_Addition_bn_add_eq_len_u64(pLen + pLen, qh, m2, qh);
+  memcpy(s, qh, nLen * sizeof (uint64_t));
+}
+
+static inline bool
+rsapss_sign_crt_precomp(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pqBits,
+  uint64_t *n,
+  uint64_t mu,
+  uint64_t *r2,
+  uint64_t *e,
+  uint64_t *crt,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+)
+{
+  uint32_t hLen = hash_len(a);
+  bool
+  b =
+    saltLen
+    <= (uint32_t)0xffffffffU - hLen - (uint32_t)8U
+    &&
+      saltLen
+      + hLen
+      + (uint32_t)2U
+      <= (modBits - (uint32_t)1U - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+  if (b)
+  {
+    uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t m[nLen];
+    memset(m, 0U, nLen * sizeof (uint64_t));
+    uint32_t emBits = modBits - (uint32_t)1U;
+    uint32_t emLen = (emBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+    KRML_CHECK_SIZE(sizeof (uint8_t), emLen);
+    uint8_t em[emLen];
+    memset(em, 0U, emLen * sizeof (uint8_t));
+    pss_encode(a, saltLen, salt, msgLen, msg, emBits, em);
+    Hacl_Bignum_Convert_bn_from_bytes_be_uint64(emLen, em, m);
+    uint32_t k = (modBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t s[nLen];
+    memset(s, 0U, nLen * sizeof (uint64_t));
+    KRML_CHECK_SIZE(sizeof (uint64_t), nLen);
+    uint64_t m_[nLen];
+    memset(m_, 0U, nLen * sizeof (uint64_t));
+    bn_mod_exp_crt_u64(nLen, pqBits, crt, m, s);
+    Hacl_Bignum_Exponentiation_bn_mod_exp_vartime_precomp_u64(nLen, n, mu, r2, s, eBits, e, m_);
+    uint64_t mask = (uint64_t)0xFFFFFFFFFFFFFFFFU;
+    for (uint32_t i = (uint32_t)0U; i < nLen; i++)
+    {
+      uint64_t uu____0 = FStar_UInt64_eq_mask(m[i], m_[i]);
+      mask = uu____0 & mask;
+    }
+    uint64_t eq_m = mask;
+    for (uint32_t i = (uint32_t)0U; i < nLen; i++)
+    {
+      uint64_t *os = s;
+      uint64_t x = s[i];
+      uint64_t x0 = eq_m & x;
+      os[i] = x0;
+    }
+    bool eq_b = eq_m == (uint64_t)0xFFFFFFFFFFFFFFFFU;
+    Hacl_Bignum_Convert_bn_to_bytes_be_uint64(k, s, sgnt);
+    return eq_b;
+  }
+  return false;
+}
+
+bool
+Hacl_RSAPSS_rsapss_sign_crt(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pqBits,
+  uint64_t *skey,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+)
+{
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint64_t *n = skey;
+  uint64_t *r2 = skey + nLen;
+  uint64_t *e = skey + nLen + nLen;
+  uint64_t *crt = skey + nLen + nLen + eLen;
+  uint64_t mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(n[0U]);
+  return
+    rsapss_sign_crt_precomp(a,
+      modBits,
+      eBits,
+      pqBits,
+      n,
+      mu,
+      r2,
+      e,
+      crt,
+      saltLen,
+      salt,
+      msgLen,
+      msg,
+      sgnt);
+}
+
+uint64_t
+*Hacl_RSAPSS_new_rsapss_load_skey_crt(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pqBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb
+)
+{
+  bool ite0;
+  if ((uint32_t)1U < modBits && (uint32_t)0U < eBits)
+  {
+    uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    ite0 =
+      nLen
+      <= (uint32_t)33554431U
+      && eLen <= (uint32_t)67108863U
+      && nLen + nLen <= (uint32_t)0xffffffffU - eLen;
+  }
+  else
+  {
+    ite0 = false;
+  }
+  bool ite;
+  if (ite0 && (uint32_t)1U < pqBits)
+  {
+    uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t pLen = (pqBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    ite =
+      pLen
+      <= (uint32_t)67108863U / (uint32_t)7U
+      && (uint32_t)2U * nLen <= (uint32_t)0xffffffffU - eLen - (uint32_t)7U * pLen;
+  }
+  else
+  {
+    ite = false;
+  }
+  if (!ite)
+  {
+    return NULL;
+  }
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t pLen = (pqBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t skeyLen = nLen + nLen + eLen + (uint32_t)7U * pLen;
+  KRML_CHECK_SIZE(sizeof (uint64_t), skeyLen);
+  uint64_t *skey = KRML_HOST_CALLOC(skeyLen, sizeof (uint64_t));
+  if (skey == NULL)
+  {
+    return skey;
+  }
+  bool b = load_skey_crt(modBits, eBits, pqBits, nb, eb, pb, qb, dPb, dQb, qInvb, skey);
+  if (b)
+  {
+    return skey;
+  }
+  KRML_HOST_FREE(skey);
+  return NULL;
+}
+
+struct Hacl_RSAPSS_pkey_s
+{
+  uint32_t modBits;
+  uint32_t eBits;
+  Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64 k;
+  uint64_t *e;
+};
+
+/* A private key holds either d (crt == NULL) or the CRT components laid out as
+   in Hacl_RSAPSS_new_rsapss_load_skey_crt (d == NULL). */
+struct Hacl_RSAPSS_skey_s
+{
+  Hacl_RSAPSS_pkey pk;
+  uint32_t dBits;
+  uint64_t *d;
+  uint32_t pqBits;
+  uint64_t *crt;
+};
+
+Hacl_RSAPSS_pkey
+*Hacl_RSAPSS_pkey_init(uint32_t modBits, uint32_t eBits, uint8_t *nb, uint8_t *eb)
+{
+  uint64_t *pkey = Hacl_RSAPSS_new_rsapss_load_pkey(modBits, eBits, nb, eb);
+  if (pkey == NULL)
+  {
+    return NULL;
+  }
+  Hacl_RSAPSS_pkey *pk = KRML_HOST_MALLOC(sizeof (Hacl_RSAPSS_pkey));
+  if (pk == NULL)
+  {
+    KRML_HOST_FREE(pkey);
+    return NULL;
+  }
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  pk->modBits = modBits;
+  pk->eBits = eBits;
+  pk->k =
+    (
+      (Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64){
+        .len = nLen,
+        .n = pkey,
+        .mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(pkey[0U]),
+        .r2 = pkey + nLen
+      }
+    );
+  pk->e = pkey + nLen + nLen;
+  return pk;
+}
+
+void Hacl_RSAPSS_pkey_free(Hacl_RSAPSS_pkey *pk)
+{
+  if (pk == NULL)
+  {
+    return;
+  }
+  KRML_HOST_FREE(pk->k.n);
+  KRML_HOST_FREE(pk);
+}
+
+Hacl_RSAPSS_skey
+*Hacl_RSAPSS_skey_init(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t dBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *db
+)
+{
+  uint64_t *skey = Hacl_RSAPSS_new_rsapss_load_skey(modBits, eBits, dBits, nb, eb, db);
+  if (skey == NULL)
+  {
+    return NULL;
+  }
+  Hacl_RSAPSS_skey *sk = KRML_HOST_MALLOC(sizeof (Hacl_RSAPSS_skey));
+  if (sk == NULL)
+  {
+    uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    uint32_t dLen = (dBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    Lib_Memzero0_memzero(skey, (nLen + nLen + eLen + dLen) * sizeof (uint64_t));
+    KRML_HOST_FREE(skey);
+    return NULL;
+  }
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  sk->pk.modBits = modBits;
+  sk->pk.eBits = eBits;
+  sk->pk.k =
+    (
+      (Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64){
+        .len = nLen,
+        .n = skey,
+        .mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(skey[0U]),
+        .r2 = skey + nLen
+      }
+    );
+  sk->pk.e = skey + nLen + nLen;
+  sk->dBits = dBits;
+  sk->d = skey + nLen + nLen + eLen;
+  sk->pqBits = (uint32_t)0U;
+  sk->crt = NULL;
+  return sk;
+}
+
+Hacl_RSAPSS_skey
+*Hacl_RSAPSS_skey_init_crt(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pqBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb
+)
+{
+  uint64_t
+  *skey =
+    Hacl_RSAPSS_new_rsapss_load_skey_crt(modBits,
+      eBits,
+      pqBits,
+      nb,
+      eb,
+      pb,
+      qb,
+      dPb,
+      dQb,
+      qInvb);
+  if (skey == NULL)
+  {
+    return NULL;
+  }
+  uint32_t nLen = (modBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t eLen = (eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  Hacl_RSAPSS_skey *sk = KRML_HOST_MALLOC(sizeof (Hacl_RSAPSS_skey));
+  if (sk == NULL)
+  {
+    uint32_t pLen = (pqBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+    Lib_Memzero0_memzero(skey, (nLen + nLen + eLen + (uint32_t)7U * pLen) * sizeof (uint64_t));
+    KRML_HOST_FREE(skey);
+    return NULL;
+  }
+  sk->pk.modBits = modBits;
+  sk->pk.eBits = eBits;
+  sk->pk.k =
+    (
+      (Hacl_Bignum_MontArithmetic_bn_mont_ctx_u64){
+        .len = nLen,
+        .n = skey,
+        .mu = Hacl_Bignum_ModInvLimb_mod_inv_uint64(skey[0U]),
+        .r2 = skey + nLen
+      }
+    );
+  sk->pk.e = skey + nLen + nLen;
+  sk->dBits = (uint32_t)0U;
+  sk->d = NULL;
+  sk->pqBits = pqBits;
+  sk->crt = skey + nLen + nLen + eLen;
+  return sk;
+}
+
+void Hacl_RSAPSS_skey_free(Hacl_RSAPSS_skey *sk)
+{
+  if (sk == NULL)
+  {
+    return;
+  }
+  uint32_t nLen = sk->pk.k.len;
+  uint32_t eLen = (sk->pk.eBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  uint32_t privLen;
+  if (sk->crt == NULL)
+  {
+    privLen = (sk->dBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U;
+  }
+  else
+  {
+    privLen = (uint32_t)7U * ((sk->pqBits - (uint32_t)1U) / (uint32_t)64U + (uint32_t)1U);
+  }
+  Lib_Memzero0_memzero(sk->pk.k.n, (nLen + nLen + eLen + privLen) * sizeof (uint64_t));
+  KRML_HOST_FREE(sk->pk.k.n);
+  KRML_HOST_FREE(sk);
+}
+
+bool
+Hacl_RSAPSS_rsapss_sign_key(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_skey *sk,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+)
+{
+  if (sk->crt != NULL)
+  {
+    return
+      rsapss_sign_crt_precomp(a,
+        sk->pk.modBits,
+        sk->pk.eBits,
+        sk->pqBits,
+        sk->pk.k.n,
+        sk->pk.k.mu,
+        sk->pk.k.r2,
+        sk->pk.e,
+        sk->crt,
+        saltLen,
+        salt,
+        msgLen,
+        msg,
+        sgnt);
+  }
+  return
+    rsapss_sign_precomp(a,
+      sk->pk.modBits,
+      sk->pk.eBits,
+      sk->dBits,
+      sk->pk.k.n,
+      sk->pk.k.mu,
+      sk->pk.k.r2,
+      sk->pk.e,
+      sk->d,
+      saltLen,
+      salt,
+      msgLen,
+      msg,
+      sgnt);
+}
+
+bool
+Hacl_RSAPSS_rsapss_verify_key(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_pkey *pk,
+  uint32_t saltLen,
+  uint32_t sgntLen,
+  uint8_t *sgnt,
+  uint32_t msgLen,
+  uint8_t *msg
+)
+{
+  return
+    rsapss_verify_precomp(a,
+      pk->modBits,
+      pk->eBits,
+      pk->k.n,
+      pk->k.mu,
+      pk->k.r2,
+      pk->e,
+      saltLen,
+      sgntLen,
+      sgnt,
+      msgLen,
+      msg);
+}
+
@@ -39,9 +39,15 @@ extern "C" {
 
 #include "Hacl_Kremlib.h"
 #include "Hacl_Bignum.h"
+#include "Hacl_Bignum64.h"
+#include "Lib_Memzero0.h"
 #include "Hacl_Hash.h"
 #include "Hacl_Spec.h"
 
+typedef struct Hacl_RSAPSS_pkey_s Hacl_RSAPSS_pkey;
+
+typedef struct Hacl_RSAPSS_skey_s Hacl_RSAPSS_skey;
+
 bool
 Hacl_RSAPSS_rsapss_sign(
   Spec_Hash_Definitions_hash_alg a,
@@ -112,6 +118,160 @@ Hacl_RSAPSS_rsapss_pkey_verify(
   uint8_t *msg
 );
 
+/*
+Sign a message with a private key in CRT form.
+
+  The argument skey is obtained through Hacl_RSAPSS_new_rsapss_load_skey_crt; pqBits
+  is the bound on the size of the primes given to it. The signature is computed
+  with two exponentiations modulo p and q (Garner's recombination) and is checked
+  against the public exponent e before being released, as in Hacl_RSAPSS_rsapss_sign.
+*/
+bool
+Hacl_RSAPSS_rsapss_sign_crt(
+  Spec_Hash_Definitions_hash_alg a,
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pqBits,
+  uint64_t *skey,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+);
+
+/*
+Load a private key in CRT form.
+
+  The arguments nb and eb are the modulus and the public exponent, as for
+  Hacl_RSAPSS_new_rsapss_load_skey. The arguments pb, qb, dPb, dQb and qInvb are the
+  primes p and q, d mod (p - 1), d mod (q - 1) and q^(-1) mod p, each meant to be
+  `(pqBits - 1) / 8 + 1` bytes in big-endian order, where pqBits is an upper bound on
+  the number of bits of p and q.
+
+  The function returns NULL if the key is malformed, in particular if p * q != n.
+  The caller will need to free the returned key to avoid memory leaks.
+*/
+uint64_t
+*Hacl_RSAPSS_new_rsapss_load_skey_crt(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pqBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb
+);
+
+/*
+Load a public key into a reusable key object.
+
+  The arguments nb and eb are as for Hacl_RSAPSS_new_rsapss_load_pkey. The returned
+  object caches the Montgomery context of the modulus (R^2 mod n and mu) so that
+  Hacl_RSAPSS_rsapss_verify_key does no per-call setup.
+
+  The function returns NULL if the key is malformed.
+  The caller will need to call Hacl_RSAPSS_pkey_free on the return value.
+*/
+Hacl_RSAPSS_pkey
+*Hacl_RSAPSS_pkey_init(uint32_t modBits, uint32_t eBits, uint8_t *nb, uint8_t *eb);
+
+/*
+Deallocate the memory previously allocated by Hacl_RSAPSS_pkey_init.
+
+  Passing NULL is a no-op.
+*/
+void Hacl_RSAPSS_pkey_free(Hacl_RSAPSS_pkey *pk);
+
+/*
+Load a private key into a reusable key object.
+
+  The arguments nb, eb and db are as for Hacl_RSAPSS_new_rsapss_load_skey.
+
+  The function returns NULL if the key is malformed.
+  The caller will need to call Hacl_RSAPSS_skey_free on the return value; the key
+  material is zeroed before being released.
+*/
+Hacl_RSAPSS_skey
+*Hacl_RSAPSS_skey_init(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t dBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *db
+);
+
+/*
+Load a private key in CRT form into a reusable key object.
+
+  The arguments are as for Hacl_RSAPSS_new_rsapss_load_skey_crt. The returned object
+  keeps p, q, dP, dQ and qInv next to the Montgomery context of the modulus, so
+  Hacl_RSAPSS_rsapss_sign_key signs with the CRT.
+
+  The function returns NULL if the key is malformed.
+  The caller will need to call Hacl_RSAPSS_skey_free on the return value; the key
+  material is zeroed before being released.
+*/
+Hacl_RSAPSS_skey
+*Hacl_RSAPSS_skey_init_crt(
+  uint32_t modBits,
+  uint32_t eBits,
+  uint32_t pqBits,
+  uint8_t *nb,
+  uint8_t *eb,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb
+);
+
+/*
+Deallocate the memory previously allocated by Hacl_RSAPSS_skey_init or
+Hacl_RSAPSS_skey_init_crt.
+
+  Passing NULL is a no-op.
+*/
+void Hacl_RSAPSS_skey_free(Hacl_RSAPSS_skey *sk);
+
+/*
+Sign a message with a key object obtained through Hacl_RSAPSS_skey_init or
+Hacl_RSAPSS_skey_init_crt.
+
+  The signature is `(modBits - 1) / 8 + 1` bytes long; see Hacl_RSAPSS_rsapss_sign.
+  Keys loaded in CRT form are used as in Hacl_RSAPSS_rsapss_sign_crt.
+*/
+bool
+Hacl_RSAPSS_rsapss_sign_key(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_skey *sk,
+  uint32_t saltLen,
+  uint8_t *salt,
+  uint32_t msgLen,
+  uint8_t *msg,
+  uint8_t *sgnt
+);
+
+/*
+Verify a signature with a key object obtained through Hacl_RSAPSS_pkey_init.
+
+  The key object is only read, so it may be shared between threads.
+*/
+bool
+Hacl_RSAPSS_rsapss_verify_key(
+  Spec_Hash_Definitions_hash_alg a,
+  Hacl_RSAPSS_pkey *pk,
+  uint32_t saltLen,
+  uint32_t sgntLen,
+  uint8_t *sgnt,
+  uint32_t msgLen,
+  uint8_t *msg
+);
+
 #if defined(__cplusplus)
 }
 #endif
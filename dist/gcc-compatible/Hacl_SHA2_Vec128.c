@@ -0,0 +1,223 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#include "Hacl_SHA2_Vec128.h"
+
+static inline void sha256_update4(Lib_IntVector_Intrinsics_vec128 *hash, Lib_IntVector_Intrinsics_vec128 *ws)
+{
+  Lib_IntVector_Intrinsics_vec128 hash_old[8U];
+  for (uint32_t _i = 0U; _i < (uint32_t)8U; ++_i)
+    hash_old[_i] = Lib_IntVector_Intrinsics_vec128_zero;
+  memcpy(hash_old, hash, (uint32_t)8U * sizeof (Lib_IntVector_Intrinsics_vec128));
+  for (uint32_t i0 = (uint32_t)0U; i0 < (uint32_t)4U; i0++)
+  {
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+    {
+      uint32_t k_t = Hacl_Impl_SHA2_Generic_k224_256[(uint32_t)16U * i0 + i];
+      Lib_IntVector_Intrinsics_vec128 ws_t = ws[i];
+      Lib_IntVector_Intrinsics_vec128 a0 = hash[0U];
+      Lib_IntVector_Intrinsics_vec128 b0 = hash[1U];
+      Lib_IntVector_Intrinsics_vec128 c0 = hash[2U];
+      Lib_IntVector_Intrinsics_vec128 d0 = hash[3U];
+      Lib_IntVector_Intrinsics_vec128 e0 = hash[4U];
+      Lib_IntVector_Intrinsics_vec128 f0 = hash[5U];
+      Lib_IntVector_Intrinsics_vec128 g0 = hash[6U];
+      Lib_IntVector_Intrinsics_vec128 h02 = hash[7U];
+      Lib_IntVector_Intrinsics_vec128 k_e_t = Lib_IntVector_Intrinsics_vec128_load32(k_t);
+      Lib_IntVector_Intrinsics_vec128
+      t1 =
+        Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(h02,
+                Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(e0, (uint32_t)6U), Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(e0, (uint32_t)11U), Lib_IntVector_Intrinsics_vec128_rotate_right32(e0, (uint32_t)25U)))),
+              Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_and(e0, f0), Lib_IntVector_Intrinsics_vec128_and(Lib_IntVector_Intrinsics_vec128_lognot(e0), g0))),
+            k_e_t),
+          ws_t);
+      Lib_IntVector_Intrinsics_vec128
+      t2 =
+        Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(a0, (uint32_t)2U), Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(a0, (uint32_t)13U), Lib_IntVector_Intrinsics_vec128_rotate_right32(a0, (uint32_t)22U))),
+          Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_and(a0, b0), Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_and(a0, c0), Lib_IntVector_Intrinsics_vec128_and(b0, c0))));
+      hash[0U] = Lib_IntVector_Intrinsics_vec128_add32(t1, t2);
+      hash[1U] = a0;
+      hash[2U] = b0;
+      hash[3U] = c0;
+      hash[4U] = Lib_IntVector_Intrinsics_vec128_add32(d0, t1);
+      hash[5U] = e0;
+      hash[6U] = f0;
+      hash[7U] = g0;
+    }
+    if (i0 < (uint32_t)3U)
+    {
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)16U; i++)
+      {
+        Lib_IntVector_Intrinsics_vec128 t16 = ws[i];
+        Lib_IntVector_Intrinsics_vec128 t15 = ws[(i + (uint32_t)1U) % (uint32_t)16U];
+        Lib_IntVector_Intrinsics_vec128 t7 = ws[(i + (uint32_t)9U) % (uint32_t)16U];
+        Lib_IntVector_Intrinsics_vec128 t2 = ws[(i + (uint32_t)14U) % (uint32_t)16U];
+        Lib_IntVector_Intrinsics_vec128
+        s1 =
+          Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(t2, (uint32_t)17U), Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(t2, (uint32_t)19U), Lib_IntVector_Intrinsics_vec128_shift_right32(t2, (uint32_t)10U)));
+        Lib_IntVector_Intrinsics_vec128
+        s0 =
+          Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(t15, (uint32_t)7U), Lib_IntVector_Intrinsics_vec128_xor(Lib_IntVector_Intrinsics_vec128_rotate_right32(t15, (uint32_t)18U), Lib_IntVector_Intrinsics_vec128_shift_right32(t15, (uint32_t)3U)));
+        ws[i] = Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(Lib_IntVector_Intrinsics_vec128_add32(s1, t7), s0), t16);
+      }
+    }
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec128 *os = hash;
+    Lib_IntVector_Intrinsics_vec128 x = Lib_IntVector_Intrinsics_vec128_add32(hash[i], hash_old[i]);
+    os[i] = x;
+  }
+}
+
+static inline void load_blocks4_256(uint8_t **b, Lib_IntVector_Intrinsics_vec128 *ws)
+{
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec128 v0 = Lib_IntVector_Intrinsics_vec128_load32_be(b[0U] + (uint32_t)16U * i);
+    Lib_IntVector_Intrinsics_vec128 v1 = Lib_IntVector_Intrinsics_vec128_load32_be(b[1U] + (uint32_t)16U * i);
+    Lib_IntVector_Intrinsics_vec128 v2 = Lib_IntVector_Intrinsics_vec128_load32_be(b[2U] + (uint32_t)16U * i);
+    Lib_IntVector_Intrinsics_vec128 v3 = Lib_IntVector_Intrinsics_vec128_load32_be(b[3U] + (uint32_t)16U * i);
+    Lib_IntVector_Intrinsics_vec128 v0_ = Lib_IntVector_Intrinsics_vec128_interleave_low32(v0, v1);
+    Lib_IntVector_Intrinsics_vec128 v1_ = Lib_IntVector_Intrinsics_vec128_interleave_high32(v0, v1);
+    Lib_IntVector_Intrinsics_vec128 v2_ = Lib_IntVector_Intrinsics_vec128_interleave_low32(v2, v3);
+    Lib_IntVector_Intrinsics_vec128 v3_ = Lib_IntVector_Intrinsics_vec128_interleave_high32(v2, v3);
+    ws[(uint32_t)4U * i] = Lib_IntVector_Intrinsics_vec128_interleave_low64(v0_, v2_);
+    ws[(uint32_t)4U * i + (uint32_t)1U] = Lib_IntVector_Intrinsics_vec128_interleave_high64(v0_, v2_);
+    ws[(uint32_t)4U * i + (uint32_t)2U] = Lib_IntVector_Intrinsics_vec128_interleave_low64(v1_, v3_);
+    ws[(uint32_t)4U * i + (uint32_t)3U] = Lib_IntVector_Intrinsics_vec128_interleave_high64(v1_, v3_);
+  }
+}
+
+void
+Hacl_SHA2_Vec128_sha256_4(uint8_t **dst, uint32_t *input_len, uint8_t **input)
+{
+  uint32_t n_full[4U] = { 0U };
+  uint32_t n_blocks[4U] = { 0U };
+  uint8_t last[4U * 128U] = { 0U };
+  uint8_t zero[64U] = { 0U };
+  uint32_t max_blocks = (uint32_t)0U;
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    uint32_t len = input_len[i];
+    uint32_t rem = len % (uint32_t)64U;
+    uint32_t n_last;
+    if (rem + (uint32_t)9U <= (uint32_t)64U)
+    {
+      n_last = (uint32_t)1U;
+    }
+    else
+    {
+      n_last = (uint32_t)2U;
+    }
+    uint8_t *last_i = last + i * (uint32_t)128U;
+    n_full[i] = len / (uint32_t)64U;
+    n_blocks[i] = n_full[i] + n_last;
+    memcpy(last_i, input[i] + n_full[i] * (uint32_t)64U, rem * sizeof (uint8_t));
+    last_i[rem] = (uint8_t)0x80U;
+    store64_be(last_i + n_last * (uint32_t)64U - (uint32_t)8U, (uint64_t)len << (uint32_t)3U);
+    if (n_blocks[i] > max_blocks)
+    {
+      max_blocks = n_blocks[i];
+    }
+  }
+  Lib_IntVector_Intrinsics_vec128 hash[8U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec128_load32(Hacl_Impl_SHA2_Generic_h256[i]);
+  }
+  Lib_IntVector_Intrinsics_vec128 ws[16U];
+  uint8_t *b[4U] = { 0U };
+  uint8_t st[(uint32_t)8U * (uint32_t)16U] = { 0U };
+  for (uint32_t j = (uint32_t)0U; j < max_blocks; j++)
+  {
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    {
+      if (j < n_full[i])
+      {
+        b[i] = input[i] + j * (uint32_t)64U;
+      }
+      else if (j < n_blocks[i])
+      {
+        b[i] = last + i * (uint32_t)128U + (j - n_full[i]) * (uint32_t)64U;
+      }
+      else
+      {
+        b[i] = zero;
+      }
+    }
+    load_blocks4_256(b, ws);
+    sha256_update4(hash, ws);
+    bool done = false;
+    for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+    {
+      done = done || n_blocks[i] == j + (uint32_t)1U;
+    }
+    if (done)
+    {
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+      {
+        Lib_IntVector_Intrinsics_vec128_store32_le(st + i * (uint32_t)16U, hash[i]);
+      }
+      for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+      {
+        if (n_blocks[i] == j + (uint32_t)1U)
+        {
+          for (uint32_t k = (uint32_t)0U; k < (uint32_t)8U; k++)
+          {
+            uint32_t x = load32_le(st + k * (uint32_t)16U + i * (uint32_t)4U);
+            store32_be(dst[i] + k * (uint32_t)4U, x);
+          }
+        }
+      }
+    }
+  }
+}
+
+void Hacl_SHA2_Vec128_sha256_compress_4(uint8_t **dst, uint8_t **block)
+{
+  Lib_IntVector_Intrinsics_vec128 hash[8U];
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    hash[i] = Lib_IntVector_Intrinsics_vec128_load32(Hacl_Impl_SHA2_Generic_h256[i]);
+  }
+  Lib_IntVector_Intrinsics_vec128 ws[16U];
+  load_blocks4_256(block, ws);
+  sha256_update4(hash, ws);
+  uint8_t st[(uint32_t)8U * (uint32_t)16U] = { 0U };
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)8U; i++)
+  {
+    Lib_IntVector_Intrinsics_vec128_store32_le(st + i * (uint32_t)16U, hash[i]);
+  }
+  for (uint32_t i = (uint32_t)0U; i < (uint32_t)4U; i++)
+  {
+    for (uint32_t k = (uint32_t)0U; k < (uint32_t)8U; k++)
+    {
+      uint32_t x = load32_le(st + k * (uint32_t)16U + i * (uint32_t)4U);
+      store32_be(dst[i] + k * (uint32_t)4U, x);
+    }
+  }
+}
+
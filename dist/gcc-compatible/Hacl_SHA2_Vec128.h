@@ -0,0 +1,69 @@
+/* MIT License
+ *
+ * Copyright (c) 2016-2020 INRIA, CMU and Microsoft Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Hand-written, not extracted from F* and not verified: see UNVERIFIED.md. */
+
+#ifndef __Hacl_SHA2_Vec128_H
+#define __Hacl_SHA2_Vec128_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "evercrypt_targetconfig.h"
+#include "libintvector.h"
+#include "kremlin/internal/types.h"
+#include "kremlin/lowstar_endianness.h"
+#include <string.h>
+#include "kremlin/internal/target.h"
+
+
+#include "Hacl_SHA2_Generic.h"
+
+/*
+Hash 4 independent messages with SHA2-256 in parallel, one per vector lane.
+
+  The arguments input, input_len and dst are arrays of 4 entries: message i is
+  input[i], of input_len[i] bytes, and its 32-byte digest is written to dst[i].
+  Messages may have different lengths; lanes whose message is exhausted idle until
+  the longest one has been processed, so grouping messages of similar length gives
+  the best throughput.
+*/
+void
+Hacl_SHA2_Vec128_sha256_4(uint8_t **dst, uint32_t *input_len, uint8_t **input);
+
+/*
+Apply the SHA2-256 compression function to 4 independent 64-byte blocks.
+
+  Each block[i] is compressed once, starting from the SHA2-256 initial state and
+  without any padding, and the resulting 32-byte state is written to dst[i] in
+  big-endian order. This is the node hash of the default Merkle tree hash function.
+*/
+void Hacl_SHA2_Vec128_sha256_compress_4(uint8_t **dst, uint8_t **block);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define __Hacl_SHA2_Vec128_H_DEFINED
+#endif
@@ -24,6 +24,15 @@
 
 #include "MerkleTree.h"
 
+#include <stdatomic.h>
+
+#if !(defined(_WIN32) || defined(_WIN64))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 static uint8_t *hash_r_alloc(uint32_t s)
 {
   KRML_CHECK_SIZE(sizeof (uint8_t), s);
@@ -270,6 +279,32 @@ inline bool mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *v)
   return MerkleTree_Low_mt_insert_pre(mt, v);
 }
 
+/*
+  Batch insertion
+
+  @param[in]  mt      The Merkle tree
+  @param[in]  n       The number of hashes to insert
+  @param[in]  leaves  An array of n hashes; the tree copies their content and does
+                      not take ownership of them.
+
+ The resulting tree is the same as after n calls to mt_insert, but each level is
+ only visited once and all its new nodes are hashed together, which lets the
+ default hash function compress several nodes per call. Unlike mt_insert, the
+ content of the hashes is left untouched.
+*/
+inline void mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint32_t n, uint8_t **leaves)
+{
+  MerkleTree_Low_mt_insert_batch(mt, n, leaves);
+}
+
+/*
+  Precondition predicate for mt_insert_batch
+*/
+inline bool mt_insert_batch_pre(const MerkleTree_Low_merkle_tree *mt, uint32_t n)
+{
+  return MerkleTree_Low_mt_insert_batch_pre(mt, n);
+}
+
 /*
   Getting the Merkle root
 
@@ -330,6 +365,51 @@ mt_get_path_pre(
   return MerkleTree_Low_mt_get_path_pre(mt, idx, path1, root);
 }
 
+/*
+  Getting several Merkle paths at once
+
+  @param[in]  mt    The Merkle tree
+  @param[in]  n     The number of paths to get
+  @param[in]  idxs  The n indices of the target hashes
+  @param[out] paths n empty paths, each receiving the Merkle path of the
+                    corresponding index (leaf hash included)
+  @param[out] root  The Merkle root
+
+  return The number of elements in the tree
+
+  Notes:
+  - Equivalent to n calls to mt_get_path, except that the root and right
+    hashes are computed once for all paths, and each path is allocated at its
+    final length.
+  - Each index must satisfy the requirements of mt_get_path.
+*/
+inline uint32_t
+mt_get_paths(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *idxs,
+  MerkleTree_Low_path **paths,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_get_paths(mt, n, idxs, paths, root);
+}
+
+/*
+  Precondition predicate for mt_get_paths
+*/
+inline bool
+mt_get_paths_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *idxs,
+  MerkleTree_Low_path **paths,
+  uint8_t *root
+)
+{
+  return MerkleTree_Low_mt_get_paths_pre(mt, n, idxs, paths, root);
+}
+
 /*
   Flush the Merkle tree
 
@@ -428,6 +508,42 @@ mt_verify_pre(
   return MerkleTree_Low_mt_verify_pre(mt, tgt, max, path1, root);
 }
 
+/*
+  Client-side verification of several paths against one root
+
+  @param[in]  mt      The Merkle tree
+  @param[in]  n       The number of paths to verify
+  @param[in]  tgts    The n indices of the target hashes
+  @param[in]  max     The maximum index + 1 of the tree when the paths were
+                      generated
+  @param[in]  paths   The n Merkle paths to verify
+  @param[in]  root
+  @param[out] results results[i] is set to the outcome of verifying paths[i]
+
+  return true if all the verifications succeeded, false otherwise
+
+  Notes:
+  - results[i] is the value mt_verify would return for (tgts[i], paths[i]),
+    except that malformed paths are rejected instead of being read out of
+    bounds.
+  - Paths that reach the same interior node with the same hash and the same
+    remaining siblings share the hashing from that node up, so each distinct
+    node is hashed once per batch.
+*/
+inline bool
+mt_verify_batch(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *tgts,
+  uint64_t max,
+  MerkleTree_Low_path **paths,
+  uint8_t *root,
+  bool *results
+)
+{
+  return MerkleTree_Low_mt_verify_batch(mt, n, tgts, max, paths, root, results);
+}
+
 /*
   Serialization size
 
@@ -508,6 +624,60 @@ inline MerkleTree_Low_path *mt_deserialize_path(const uint8_t *buf, uint64_t len
   return MerkleTree_Low_Serialization_mt_deserialize_path(buf, len);
 }
 
+/*
+  Creation of a file-backed tree
+
+  @param[in]  path       The file to store the tree in; it is created or truncated
+  @param[in]  hash_size  Hash size (in bytes)
+  @param[in]  init       The initial hash
+  @param[in]  hash_fun   Hash function
+
+  return pointer to the new tree if successful, NULL otherwise
+
+  Note: The node hashes of the tree live in memory mappings of the file, so its
+  resident size is bounded by the page cache. The file is extended as hashes are
+  inserted and never shrinks. mt_free syncs the tree, then unmaps and closes the file.
+*/
+inline MerkleTree_Low_merkle_tree
+*mt_create_file(
+  const char *path,
+  uint32_t hash_size,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  return MerkleTree_Low_File_mt_create(path, hash_size, init, hash_fun);
+}
+
+/*
+  Opening a file-backed tree
+
+  @param[in]  path      A file written by a tree created with mt_create_file
+  @param[in]  hash_fun  Hash function
+
+  return pointer to the tree if successful, NULL otherwise
+
+  Note: The hashes are not read nor copied, only mapped; the tree is in the state
+  of the last mt_sync of the file. Retractions are synced immediately.
+*/
+inline MerkleTree_Low_merkle_tree
+*mt_open(const char *path, void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2))
+{
+  return MerkleTree_Low_File_mt_open(path, hash_fun);
+}
+
+/*
+  Syncing a file-backed tree
+
+  @param[in]  mt  The Merkle tree
+
+  return true if the state of the tree is on disk; always true for trees in memory
+*/
+inline bool mt_sync(MerkleTree_Low_merkle_tree *mt)
+{
+  return MerkleTree_Low_File_mt_sync(mt);
+}
+
 /*
   Default hash function
 */
@@ -857,8 +1027,336 @@ alloc_rid___uint8_t__uint32_t(regional__uint32_t__uint8_t_ rg, uint32_t len)
   return vec;
 }
 
+/*
+  Node hashes are not allocated one by one: each level stores them inline, at
+  hash_size stride, in a list of 64-byte aligned chunks. A level only grows at
+  its end (insertion) and shrinks at its start (flush) or at its end (retract),
+  so slots are always handed out and released in order and a chunk is returned
+  to the allocator as soon as its last live slot is released. The level vectors
+  of hs keep pointing into these chunks, so reading a node (in mt_get_path, say)
+  still goes through one pointer; what the arena saves is the per-hash
+  allocation and its overhead, and consecutive nodes of a level are adjacent.
+
+  The chunks of a file-backed arena are mapped from its file instead, where each
+  one starts with a 64-byte header recording its level, its capacity and the
+  index within the level of its first slot. Chunks are only ever appended to the
+  file, so a file header written by mt_sync describes a consistent tree for as
+  long as the chunks up to its file_end are not overwritten.
+*/
+typedef struct arena_chunk_s
+{
+  struct arena_chunk_s *prev;
+  struct arena_chunk_s *next;
+  uint32_t cap;
+  uint32_t lo;
+  uint32_t hi;
+  uint32_t base;
+  uint8_t *data;
+  uint8_t *map;
+  size_t map_len;
+}
+arena_chunk;
+
+typedef struct arena_level_s
+{
+  arena_chunk *head;
+  arena_chunk *tail;
+  uint32_t end;
+}
+arena_level;
+
+struct MerkleTree_Low_arena_s
+{
+  uint32_t hash_size;
+  arena_level lvs[32U];
+  int fd;
+  uint64_t file_end;
+  uint64_t seq;
+};
+
+static const uint8_t mt_file_magic[8U] = { 0x48U, 0x41U, 0x43U, 0x4cU, 0x4dU, 0x54U, 0x00U, 0x02U };
+
+static const uint32_t mt_chunk_magic = (uint32_t)0x4d54434bU;
+
+static MerkleTree_Low_arena *arena_create(uint32_t hsz)
+{
+  MerkleTree_Low_arena *a = KRML_HOST_CALLOC((uint32_t)1U, sizeof (MerkleTree_Low_arena));
+  if (a == NULL)
+  {
+    KRML_HOST_EPRINTF("Merkle tree: cannot allocate node hashes\n");
+    KRML_HOST_EXIT(255U);
+  }
+  a->hash_size = hsz;
+  a->fd = -1;
+  return a;
+}
+
+/* Bytes of one header copy that are covered by its checksum */
+static uint32_t mt_file_slot_used(uint32_t hsz)
+{
+  return (uint32_t)64U + (uint32_t)33U * hsz;
+}
+
+static uint64_t mt_file_slot_len(uint32_t hsz)
+{
+  return ((uint64_t)mt_file_slot_used(hsz) + (uint64_t)32U + (uint64_t)4095U) & ~(uint64_t)4095U;
+}
+
+/* The fixed page and two copies of the header, see MerkleTree_Low_File_mt_sync */
+static uint64_t mt_file_header_len(uint32_t hsz)
+{
+  return (uint64_t)4096U + (uint64_t)2U * mt_file_slot_len(hsz);
+}
+
+static uint64_t mt_file_chunk_len(uint32_t hsz, uint32_t cap)
+{
+  return ((uint64_t)64U + (uint64_t)cap * (uint64_t)hsz + (uint64_t)4095U) & ~(uint64_t)4095U;
+}
+
+#if !(defined(_WIN32) || defined(_WIN64))
+static arena_chunk *arena_chunk_map(int fd, uint64_t off, uint64_t len, uint32_t cap, uint32_t base)
+{
+  uint8_t *map = mmap(NULL, (size_t)len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, (off_t)off);
+  if (map == MAP_FAILED)
+  {
+    return NULL;
+  }
+  arena_chunk *c = KRML_HOST_MALLOC(sizeof (arena_chunk));
+  if (c == NULL)
+  {
+    munmap(map, (size_t)len);
+    return NULL;
+  }
+  c->prev = NULL;
+  c->next = NULL;
+  c->cap = cap;
+  c->lo = (uint32_t)0U;
+  c->hi = (uint32_t)0U;
+  c->base = base;
+  c->data = map + (uint32_t)64U;
+  c->map = map;
+  c->map_len = (size_t)len;
+  return c;
+}
+#endif
+
+static arena_chunk *arena_chunk_alloc(MerkleTree_Low_arena *a, uint32_t lv, uint32_t cap)
+{
+  uint32_t hsz = a->hash_size;
+  #if !(defined(_WIN32) || defined(_WIN64))
+  if (a->fd >= 0)
+  {
+    uint64_t off = a->file_end;
+    uint64_t len = mt_file_chunk_len(hsz, cap);
+    arena_chunk *c = NULL;
+    if (ftruncate(a->fd, (off_t)(off + len)) == 0)
+    {
+      c = arena_chunk_map(a->fd, off, len, cap, a->lvs[lv].end);
+    }
+    if (c == NULL)
+    {
+      KRML_HOST_EPRINTF("Merkle tree: cannot extend the backing file\n");
+      KRML_HOST_EXIT(255U);
+    }
+    store32_le(c->map, mt_chunk_magic);
+    store32_le(c->map + (uint32_t)4U, lv);
+    store32_le(c->map + (uint32_t)8U, cap);
+    store32_le(c->map + (uint32_t)12U, c->base);
+    a->file_end = off + len;
+    return c;
+  }
+  #endif
+  uint8_t *raw = KRML_HOST_MALLOC(sizeof (arena_chunk) + (size_t)cap * hsz + (size_t)63U);
+  if (raw == NULL)
+  {
+    KRML_HOST_EPRINTF("Merkle tree: cannot allocate node hashes\n");
+    KRML_HOST_EXIT(255U);
+  }
+  arena_chunk *c = (arena_chunk *)raw;
+  uintptr_t data = ((uintptr_t)(raw + sizeof (arena_chunk)) + (uintptr_t)63U) & ~(uintptr_t)63U;
+  c->prev = NULL;
+  c->next = NULL;
+  c->cap = cap;
+  c->lo = (uint32_t)0U;
+  c->hi = (uint32_t)0U;
+  c->base = a->lvs[lv].end;
+  c->data = (uint8_t *)data;
+  c->map = NULL;
+  c->map_len = (size_t)0U;
+  return c;
+}
+
+static void arena_chunk_free(arena_chunk *c)
+{
+  #if !(defined(_WIN32) || defined(_WIN64))
+  if (c->map != NULL)
+  {
+    munmap(c->map, c->map_len);
+  }
+  #endif
+  KRML_HOST_FREE(c);
+}
+
+static void arena_push_chunk(arena_level *l, arena_chunk *c)
+{
+  c->prev = l->tail;
+  if (l->tail == NULL)
+  {
+    l->head = c;
+  }
+  else
+  {
+    l->tail->next = c;
+  }
+  l->tail = c;
+}
+
+static void arena_drop_tail(arena_level *l)
+{
+  arena_chunk *c = l->tail;
+  l->tail = c->prev;
+  if (l->tail == NULL)
+  {
+    l->head = NULL;
+  }
+  else
+  {
+    l->tail->next = NULL;
+  }
+  arena_chunk_free(c);
+}
+
+/* Returns an uninitialized slot at the end of level lv. */
+static uint8_t *arena_alloc(MerkleTree_Low_arena *a, uint32_t lv)
+{
+  arena_level *l = a->lvs + lv;
+  arena_chunk *c = l->tail;
+  if (c == NULL || c->hi == c->cap)
+  {
+    /* Chunks double in size, so that small trees stay small, up to 16384 hashes,
+       or 2^20 hashes in a file, where each chunk costs a mapping. */
+    uint32_t cap = (uint32_t)16U;
+    uint32_t max_cap = (uint32_t)16384U;
+    if (a->fd >= 0)
+    {
+      cap = ((uint32_t)4096U - (uint32_t)64U) / a->hash_size;
+      if (cap < (uint32_t)16U)
+      {
+        cap = (uint32_t)16U;
+      }
+      max_cap = (uint32_t)0x100000U;
+    }
+    /* The file start is not a power of two, so doubling alone could overshoot
+       max_cap, past what mt_open accepts. */
+    if (c != NULL)
+    {
+      cap = c->cap < max_cap / (uint32_t)2U ? (uint32_t)2U * c->cap : max_cap;
+    }
+    c = arena_chunk_alloc(a, lv, cap);
+    arena_push_chunk(l, c);
+  }
+  uint8_t *h = c->data + c->hi * a->hash_size;
+  c->hi = c->hi + (uint32_t)1U;
+  l->end = l->end + (uint32_t)1U;
+  return h;
+}
+
+/* Releases the n oldest slots of level lv. */
+static void arena_pop_front(MerkleTree_Low_arena *a, uint32_t lv, uint32_t n)
+{
+  arena_level *l = a->lvs + lv;
+  while (n > (uint32_t)0U && l->head != NULL)
+  {
+    arena_chunk *c = l->head;
+    uint32_t k = c->hi - c->lo;
+    if (n < k)
+    {
+      k = n;
+    }
+    c->lo = c->lo + k;
+    n = n - k;
+    if (c->lo == c->hi)
+    {
+      l->head = c->next;
+      if (l->head == NULL)
+      {
+        l->tail = NULL;
+      }
+      else
+      {
+        l->head->prev = NULL;
+      }
+      arena_chunk_free(c);
+    }
+  }
+}
+
+/* Releases the n newest slots of level lv. */
+static void arena_pop_back(MerkleTree_Low_arena *a, uint32_t lv, uint32_t n)
+{
+  arena_level *l = a->lvs + lv;
+  while (n > (uint32_t)0U && l->tail != NULL)
+  {
+    arena_chunk *c = l->tail;
+    uint32_t k = c->hi - c->lo;
+    if (n < k)
+    {
+      k = n;
+    }
+    c->hi = c->hi - k;
+    l->end = l->end - k;
+    n = n - k;
+    if (c->lo == c->hi)
+    {
+      arena_drop_tail(l);
+    }
+  }
+}
+
+static void arena_free(MerkleTree_Low_arena *a)
+{
+  for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+  {
+    while (a->lvs[lv].tail != NULL)
+    {
+      arena_drop_tail(a->lvs + lv);
+    }
+  }
+  #if !(defined(_WIN32) || defined(_WIN64))
+  if (a->fd >= 0)
+  {
+    close(a->fd);
+  }
+  #endif
+  KRML_HOST_FREE(a);
+}
+
+/* Moves individually allocated level hashes, e.g. from deserialization, into the arena. */
+static void
+arena_adopt(
+  MerkleTree_Low_arena *a,
+  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs
+)
+{
+  for (uint32_t lv = (uint32_t)0U; lv < hs.sz; lv++)
+  {
+    LowStar_Vector_vector_str___uint8_t_ lvhs = hs.vs[lv];
+    for (uint32_t i = (uint32_t)0U; i < lvhs.sz; i++)
+    {
+      uint8_t *h = arena_alloc(a, lv);
+      hash_copy(a->hash_size, lvhs.vs[i], h);
+      hash_r_free(a->hash_size, lvhs.vs[i]);
+      lvhs.vs[i] = h;
+    }
+  }
+}
+
 static MerkleTree_Low_merkle_tree
-*create_empty_mt(uint32_t hsz, void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2))
+*create_empty_mt(
+  uint32_t hsz,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2),
+  MerkleTree_Low_arena *arena
+)
 {
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_
   hs =
@@ -901,7 +1399,8 @@ static MerkleTree_Low_merkle_tree
         .rhs_ok = false,
         .rhs = rhs,
         .mroot = mroot,
-        .hash_fun = hash_fun
+        .hash_fun = hash_fun,
+        .arena = arena
       }
     );
   return mt;
@@ -916,23 +1415,6 @@ index__LowStar_Vector_vector_str__uint8_t_(
   return vec.vs[i];
 }
 
-static void
-free_elems__LowStar_Vector_vector_str__uint8_t__uint32_t(
-  regional__uint32_t_LowStar_Vector_vector_str___uint8_t_ rg,
-  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ rv,
-  uint32_t idx
-)
-{
-  LowStar_Vector_vector_str___uint8_t_
-  uu____0 = index__LowStar_Vector_vector_str__uint8_t_(rv, idx);
-  rg.r_free(rg.state, uu____0);
-  if (idx != (uint32_t)0U)
-  {
-    free_elems__LowStar_Vector_vector_str__uint8_t__uint32_t(rg, rv, idx - (uint32_t)1U);
-    return;
-  }
-}
-
 static void
 free__LowStar_Vector_vector_str__uint8_t_(
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ vec
@@ -941,31 +1423,17 @@ free__LowStar_Vector_vector_str__uint8_t_(
   KRML_HOST_FREE(vec.vs);
 }
 
-static void
-free__LowStar_Vector_vector_str__uint8_t__uint32_t(
-  regional__uint32_t_LowStar_Vector_vector_str___uint8_t_ rg,
-  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ rv
-)
-{
-  if (!(rv.sz == (uint32_t)0U))
-  {
-    free_elems__LowStar_Vector_vector_str__uint8_t__uint32_t(rg, rv, rv.sz - (uint32_t)1U);
-  }
-  free__LowStar_Vector_vector_str__uint8_t_(rv);
-}
-
 void MerkleTree_Low_mt_free(MerkleTree_Low_merkle_tree *mt)
 {
+  MerkleTree_Low_File_mt_sync(mt);
   MerkleTree_Low_merkle_tree mtv = *mt;
-  free__LowStar_Vector_vector_str__uint8_t__uint32_t((
-      (regional__uint32_t_LowStar_Vector_vector_str___uint8_t_){
-        .state = mtv.hash_size,
-        .dummy = { .sz = (uint32_t)0U, .cap = (uint32_t)0U, .vs = NULL },
-        .r_alloc = hash_vec_r_alloc,
-        .r_free = hash_vec_r_free
-      }
-    ),
-    mtv.hs);
+  /* The level hashes belong to the arena: only the level vectors are freed here. */
+  for (uint32_t lv = (uint32_t)0U; lv < mtv.hs.sz; lv++)
+  {
+    free___uint8_t_(index__LowStar_Vector_vector_str__uint8_t_(mtv.hs, lv));
+  }
+  free__LowStar_Vector_vector_str__uint8_t_(mtv.hs);
+  arena_free(mtv.arena);
   free___uint8_t__uint32_t((
       (regional__uint32_t__uint8_t_){
         .state = mtv.hash_size,
@@ -990,21 +1458,6 @@ insert___uint8_t__uint32_t(LowStar_Vector_vector_str___uint8_t_ rv, uint8_t *v)
   return irv;
 }
 
-typedef void (*copyable__uint32_t__uint8_t_)(uint32_t x0, uint8_t *x1, uint8_t *x2);
-
-static LowStar_Vector_vector_str___uint8_t_
-insert_copy___uint8_t__uint32_t(
-  regional__uint32_t__uint8_t_ rg,
-  void (*cp)(uint32_t x0, uint8_t *x1, uint8_t *x2),
-  LowStar_Vector_vector_str___uint8_t_ rv,
-  uint8_t *v
-)
-{
-  uint8_t *nv = rg.r_alloc(rg.state);
-  cp(rg.state, v, nv);
-  return insert___uint8_t__uint32_t(rv, nv);
-}
-
 static void
 assign__LowStar_Vector_vector_str__uint8_t__uint32_t(
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ rv,
@@ -1022,30 +1475,21 @@ insert_(
   uint32_t j,
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs,
   uint8_t *acc,
-  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2),
+  MerkleTree_Low_arena *arena
 )
 {
   LowStar_Vector_vector_str___uint8_t_
   uu____0 = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
-  LowStar_Vector_vector_str___uint8_t_
-  ihv =
-    insert_copy___uint8_t__uint32_t((
-        (regional__uint32_t__uint8_t_){
-          .state = hsz,
-          .dummy = NULL,
-          .r_alloc = hash_r_alloc,
-          .r_free = hash_r_free
-        }
-      ),
-      hash_copy,
-      uu____0,
-      acc);
+  uint8_t *nv = arena_alloc(arena, lv);
+  hash_copy(hsz, acc, nv);
+  LowStar_Vector_vector_str___uint8_t_ ihv = insert___uint8_t__uint32_t(uu____0, nv);
   assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv, ihv);
   if (j % (uint32_t)2U == (uint32_t)1U)
   {
     LowStar_Vector_vector_str___uint8_t_ lvhs = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
     hash_fun(index___uint8_t_(lvhs, lvhs.sz - (uint32_t)2U), acc, acc);
-    insert_(hsz, lv + (uint32_t)1U, j / (uint32_t)2U, hs, acc, hash_fun);
+    insert_(hsz, lv + (uint32_t)1U, j / (uint32_t)2U, hs, acc, hash_fun, arena);
     return;
   }
 }
@@ -1064,7 +1508,7 @@ void MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v)
   MerkleTree_Low_merkle_tree mtv = *mt;
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
   uint32_t hsz1 = mtv.hash_size;
-  insert_(hsz1, (uint32_t)0U, mtv.j, hs, v, mtv.hash_fun);
+  insert_(hsz1, (uint32_t)0U, mtv.j, hs, v, mtv.hash_fun, mtv.arena);
   *mt
   =
     (
@@ -1077,7 +1521,225 @@ void MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v)
         .rhs_ok = false,
         .rhs = mtv.rhs,
         .mroot = mtv.mroot,
-        .hash_fun = mtv.hash_fun
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
+      }
+    );
+}
+
+/* Vector kernels mt_sha256_compress_many may use, as a mask of the following. */
+#define COMPRESS_MANY_8 ((uint32_t)1U)
+#define COMPRESS_MANY_4 ((uint32_t)2U)
+#define COMPRESS_MANY_16 ((uint32_t)4U)
+
+static _Atomic uint32_t compress_many_kernels = (uint32_t)0U;
+
+/* The EverCrypt_AutoConfig2_generation at which compress_many_kernels was chosen. */
+static _Atomic uint32_t compress_many_generation = (uint32_t)0U;
+
+static uint32_t compress_many_choose()
+{
+  bool has_shaext = EverCrypt_AutoConfig2_has_shaext();
+  bool has_sse = EverCrypt_AutoConfig2_has_sse();
+  bool vec512 = EverCrypt_AutoConfig2_has_vec512();
+  bool vec256 = EverCrypt_AutoConfig2_has_vec256();
+  bool vec128 = EverCrypt_AutoConfig2_has_vec128();
+  uint32_t kernels = (uint32_t)0U;
+  /* With SHA-NI, one block at a time already beats the vector lanes. */
+  if (has_shaext && has_sse)
+  {
+    return kernels;
+  }
+  #if HACL_CAN_COMPILE_VEC512
+  if (vec512)
+  {
+    kernels = kernels | COMPRESS_MANY_16;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC256
+  if (vec256)
+  {
+    kernels = kernels | COMPRESS_MANY_8;
+  }
+  #endif
+  #if HACL_CAN_COMPILE_VEC128
+  if (vec128)
+  {
+    kernels = kernels | COMPRESS_MANY_4;
+  }
+  #endif
+  return kernels;
+}
+
+static uint32_t compress_many_resolve()
+{
+  uint32_t g = EverCrypt_AutoConfig2_generation();
+  if (atomic_load_explicit(&compress_many_generation, memory_order_acquire) != g)
+  {
+    atomic_store_explicit(&compress_many_kernels, compress_many_choose(), memory_order_relaxed);
+    atomic_store_explicit(&compress_many_generation, g, memory_order_release);
+  }
+  return atomic_load_explicit(&compress_many_kernels, memory_order_relaxed);
+}
+
+/*
+  Compresses the n pairs (src1[i], src2[i]) into dst[i] with mt_sha256_compress,
+  several pairs at a time when SHA2-256 vector lanes are available.
+*/
+static void
+mt_sha256_compress_many(uint32_t n, uint8_t **src1, uint8_t **src2, uint8_t **dst)
+{
+  uint32_t kernels = compress_many_resolve();
+  uint32_t i = (uint32_t)0U;
+  if (kernels != (uint32_t)0U)
+  {
+    uint8_t cb[(uint32_t)16U * (uint32_t)64U] = { 0U };
+    uint8_t *b[16U] = { 0U };
+    for (uint32_t k = (uint32_t)0U; k < (uint32_t)16U; k++)
+    {
+      b[k] = cb + k * (uint32_t)64U;
+    }
+    #if HACL_CAN_COMPILE_VEC512
+    if (kernels & COMPRESS_MANY_16)
+    {
+      for (; i + (uint32_t)16U <= n; i = i + (uint32_t)16U)
+      {
+        for (uint32_t k = (uint32_t)0U; k < (uint32_t)16U; k++)
+        {
+          memcpy(b[k], src1[i + k], (uint32_t)32U * sizeof (uint8_t));
+          memcpy(b[k] + (uint32_t)32U, src2[i + k], (uint32_t)32U * sizeof (uint8_t));
+        }
+        Hacl_SHA2_Vec512_sha256_compress_16(dst + i, b);
+      }
+    }
+    #endif
+    #if HACL_CAN_COMPILE_VEC256
+    if (kernels & COMPRESS_MANY_8)
+    {
+      for (; i + (uint32_t)8U <= n; i = i + (uint32_t)8U)
+      {
+        for (uint32_t k = (uint32_t)0U; k < (uint32_t)8U; k++)
+        {
+          memcpy(b[k], src1[i + k], (uint32_t)32U * sizeof (uint8_t));
+          memcpy(b[k] + (uint32_t)32U, src2[i + k], (uint32_t)32U * sizeof (uint8_t));
+        }
+        Hacl_SHA2_Vec256_sha256_compress_8(dst + i, b);
+      }
+    }
+    #endif
+    #if HACL_CAN_COMPILE_VEC128
+    if (kernels & COMPRESS_MANY_4)
+    {
+      for (; i + (uint32_t)4U <= n; i = i + (uint32_t)4U)
+      {
+        for (uint32_t k = (uint32_t)0U; k < (uint32_t)4U; k++)
+        {
+          memcpy(b[k], src1[i + k], (uint32_t)32U * sizeof (uint8_t));
+          memcpy(b[k] + (uint32_t)32U, src2[i + k], (uint32_t)32U * sizeof (uint8_t));
+        }
+        Hacl_SHA2_Vec128_sha256_compress_4(dst + i, b);
+      }
+    }
+    #endif
+  }
+  for (; i < n; i++)
+  {
+    mt_sha256_compress(src1[i], src2[i], dst[i]);
+  }
+}
+
+bool MerkleTree_Low_mt_insert_batch_pre(const MerkleTree_Low_merkle_tree *mt, uint32_t n)
+{
+  MerkleTree_Low_merkle_tree mt1 = *(MerkleTree_Low_merkle_tree *)mt;
+  return
+    n
+    <= MerkleTree_Low_uint32_32_max - mt1.j
+    && MerkleTree_Low_uint64_max - mt1.offset >= (uint64_t)mt1.j + (uint64_t)n;
+}
+
+void MerkleTree_Low_mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint32_t n, uint8_t **vs)
+{
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
+  uint32_t hsz1 = mtv.hash_size;
+  uint32_t j0 = mtv.j;
+  uint32_t j1 = mtv.j + n;
+  /* Level lv + 1 gains the parents p0 .. p1 - 1, at most n / 2 + 1 of them;
+     they are all computed before being appended, so that the whole level can
+     be handed to the hash function at once. The buffers are allocated first,
+     so that a failure stops before the tree or its backing file is modified,
+     as in arena_chunk_alloc. */
+  uint32_t np = n / (uint32_t)2U + (uint32_t)1U;
+  KRML_CHECK_SIZE(sizeof (uint8_t *), (uint32_t)3U * np);
+  uint8_t **lefts = KRML_HOST_MALLOC(sizeof (uint8_t *) * ((uint32_t)3U * np));
+  if (lefts == NULL)
+  {
+    KRML_HOST_EPRINTF("Merkle tree: cannot allocate the batch insertion buffers\n");
+    KRML_HOST_EXIT(255U);
+  }
+  uint8_t **rights = lefts + np;
+  uint8_t **dsts = rights + np;
+  LowStar_Vector_vector_str___uint8_t_ lv0 = index__LowStar_Vector_vector_str__uint8_t_(hs, (uint32_t)0U);
+  for (uint32_t i = (uint32_t)0U; i < n; i++)
+  {
+    uint8_t *nv = arena_alloc(mtv.arena, (uint32_t)0U);
+    hash_copy(hsz1, vs[i], nv);
+    lv0 = insert___uint8_t__uint32_t(lv0, nv);
+  }
+  assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, (uint32_t)0U, lv0);
+  for (uint32_t lv = (uint32_t)0U; lv < MerkleTree_Low_merkle_tree_size_lg - (uint32_t)1U; lv++)
+  {
+    uint32_t p0 = j0 >> (lv + (uint32_t)1U);
+    uint32_t p1 = j1 >> (lv + (uint32_t)1U);
+    if (p0 == p1)
+    {
+      break;
+    }
+    uint32_t cnt = p1 - p0;
+    LowStar_Vector_vector_str___uint8_t_ lvhs = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
+    /* The last element of level lv has index (j1 >> lv) - 1. */
+    uint32_t base = lvhs.sz - (j1 >> lv);
+    for (uint32_t k = (uint32_t)0U; k < cnt; k++)
+    {
+      uint32_t ofs = base + (uint32_t)2U * (p0 + k);
+      lefts[k] = index___uint8_t_(lvhs, ofs);
+      rights[k] = index___uint8_t_(lvhs, ofs + (uint32_t)1U);
+      dsts[k] = arena_alloc(mtv.arena, lv + (uint32_t)1U);
+    }
+    if (mtv.hash_fun == mt_sha256_compress)
+    {
+      mt_sha256_compress_many(cnt, lefts, rights, dsts);
+    }
+    else
+    {
+      for (uint32_t k = (uint32_t)0U; k < cnt; k++)
+      {
+        mtv.hash_fun(lefts[k], rights[k], dsts[k]);
+      }
+    }
+    LowStar_Vector_vector_str___uint8_t_
+    nxt = index__LowStar_Vector_vector_str__uint8_t_(hs, lv + (uint32_t)1U);
+    for (uint32_t k = (uint32_t)0U; k < cnt; k++)
+    {
+      nxt = insert___uint8_t__uint32_t(nxt, dsts[k]);
+    }
+    assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv + (uint32_t)1U, nxt);
+  }
+  KRML_HOST_FREE(lefts);
+  *mt
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = mtv.hash_size,
+        .offset = mtv.offset,
+        .i = mtv.i,
+        .j = j1,
+        .hs = mtv.hs,
+        .rhs_ok = false,
+        .rhs = mtv.rhs,
+        .mroot = mtv.mroot,
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
       }
     );
 }
@@ -1089,7 +1751,7 @@ MerkleTree_Low_merkle_tree
   void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
 )
 {
-  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun);
+  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun, arena_create(hsz));
   MerkleTree_Low_mt_insert(mt, init);
   return mt;
 }
@@ -1273,7 +1935,8 @@ void MerkleTree_Low_mt_get_root(const MerkleTree_Low_merkle_tree *mt, uint8_t *r
         .rhs_ok = true,
         .rhs = rhs,
         .mroot = mroot,
-        .hash_fun = hash_fun
+        .hash_fun = hash_fun,
+        .arena = mtv.arena
       }
     );
 }
@@ -1467,13 +2130,70 @@ MerkleTree_Low_mt_get_path(
   return j;
 }
 
+bool
+MerkleTree_Low_mt_get_paths_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *idxs,
+  MerkleTree_Low_path **ps,
+  uint8_t *root
+)
+{
+  bool ok = true;
+  for (uint32_t q = (uint32_t)0U; q < n; q++)
+  {
+    ok = ok && MerkleTree_Low_mt_get_path_pre(mt, idxs[q], ps[q], root);
+  }
+  return ok;
+}
+
+uint32_t
+MerkleTree_Low_mt_get_paths(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *idxs,
+  MerkleTree_Low_path **ps,
+  uint8_t *root
+)
+{
+  MerkleTree_Low_merkle_tree *ncmt = (MerkleTree_Low_merkle_tree *)mt;
+  /* Builds rhs and the root once; every path below only collects pointers. */
+  MerkleTree_Low_mt_get_root(mt, root);
+  MerkleTree_Low_merkle_tree mtv = *ncmt;
+  uint32_t hsz1 = mtv.hash_size;
+  uint32_t i = mtv.i;
+  uint32_t ofs = MerkleTree_Low_offset_of(mtv.i);
+  uint32_t j = mtv.j;
+  LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
+  LowStar_Vector_vector_str___uint8_t_ rhs = mtv.rhs;
+  LowStar_Vector_vector_str___uint8_t_ lv0 = index__LowStar_Vector_vector_str__uint8_t_(hs, (uint32_t)0U);
+  for (uint32_t q = (uint32_t)0U; q < n; q++)
+  {
+    uint32_t idx1 = (uint32_t)(idxs[q] - mtv.offset);
+    MerkleTree_Low_path pth = *ps[q];
+    LowStar_Vector_vector_str___uint8_t_ pv = pth.hashes;
+    uint32_t len = (uint32_t)1U + mt_path_length((uint32_t)0U, idx1, j, false);
+    if (pv.cap < len)
+    {
+      /* Paths are empty here: reserve the exact length up front. */
+      KRML_HOST_FREE(pv.vs);
+      pv = alloc_reserve___uint8_t_(len, NULL);
+    }
+    LowStar_Vector_vector_str___uint8_t_ ipv = insert___uint8_t_(pv, index___uint8_t_(lv0, idx1 - ofs));
+    *ps[q] = ((MerkleTree_Low_path){ .hash_size = hsz1, .hashes = ipv });
+    mt_get_path_(hsz1, (uint32_t)0U, hs, rhs, i, j, idx1, ps[q], false);
+  }
+  return j;
+}
+
 static void
 mt_flush_to_(
   uint32_t hsz,
   uint32_t lv,
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs,
   uint32_t pi,
-  uint32_t i
+  uint32_t i,
+  MerkleTree_Low_arena *arena
 )
 {
   uint32_t oi = MerkleTree_Low_offset_of(i);
@@ -1482,19 +2202,7 @@ mt_flush_to_(
   {
     uint32_t ofs = oi - opi;
     LowStar_Vector_vector_str___uint8_t_ hvec = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
-    if (!(ofs == (uint32_t)0U))
-    {
-      free_elems___uint8_t__uint32_t((
-          (regional__uint32_t__uint8_t_){
-            .state = hsz,
-            .dummy = NULL,
-            .r_alloc = hash_r_alloc,
-            .r_free = hash_r_free
-          }
-        ),
-        hvec,
-        ofs - (uint32_t)1U);
-    }
+    arena_pop_front(arena, lv, ofs);
     LowStar_Vector_vector_str___uint8_t_ frv;
     if (ofs >= hvec.sz)
     {
@@ -1524,7 +2232,7 @@ mt_flush_to_(
     }
     LowStar_Vector_vector_str___uint8_t_ flushed = frv;
     assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv, flushed);
-    mt_flush_to_(hsz, lv + (uint32_t)1U, hs, pi / (uint32_t)2U, i / (uint32_t)2U);
+    mt_flush_to_(hsz, lv + (uint32_t)1U, hs, pi / (uint32_t)2U, i / (uint32_t)2U, arena);
     return;
   }
 }
@@ -1547,7 +2255,7 @@ void MerkleTree_Low_mt_flush_to(MerkleTree_Low_merkle_tree *mt, uint64_t idx)
   uint32_t hsz = mtv.hash_size;
   uint32_t idx1 = (uint32_t)(idx - offset);
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
-  mt_flush_to_(hsz, (uint32_t)0U, hs, mtv.i, idx1);
+  mt_flush_to_(hsz, (uint32_t)0U, hs, mtv.i, idx1, mtv.arena);
   *mt
   =
     (
@@ -1560,7 +2268,8 @@ void MerkleTree_Low_mt_flush_to(MerkleTree_Low_merkle_tree *mt, uint64_t idx)
         .rhs_ok = mtv.rhs_ok,
         .rhs = mtv.rhs,
         .mroot = mtv.mroot,
-        .hash_fun = mtv.hash_fun
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
       }
     );
 }
@@ -1581,22 +2290,6 @@ void MerkleTree_Low_mt_flush(MerkleTree_Low_merkle_tree *mt)
   MerkleTree_Low_mt_flush_to(mt, jo);
 }
 
-static void
-free_elems_from___uint8_t__uint32_t(
-  regional__uint32_t__uint8_t_ rg,
-  LowStar_Vector_vector_str___uint8_t_ rv,
-  uint32_t idx
-)
-{
-  uint8_t *uu____0 = index___uint8_t_(rv, idx);
-  rg.r_free(rg.state, uu____0);
-  if (idx + (uint32_t)1U < rv.sz)
-  {
-    free_elems_from___uint8_t__uint32_t(rg, rv, idx + (uint32_t)1U);
-    return;
-  }
-}
-
 static LowStar_Vector_vector_str___uint8_t_
 shrink___uint8_t_(LowStar_Vector_vector_str___uint8_t_ vec, uint32_t new_size)
 {
@@ -1604,23 +2297,6 @@ shrink___uint8_t_(LowStar_Vector_vector_str___uint8_t_ vec, uint32_t new_size)
     ((LowStar_Vector_vector_str___uint8_t_){ .sz = new_size, .cap = vec.cap, .vs = vec.vs });
 }
 
-static LowStar_Vector_vector_str___uint8_t_
-shrink___uint8_t__uint32_t(
-  regional__uint32_t__uint8_t_ rg,
-  LowStar_Vector_vector_str___uint8_t_ rv,
-  uint32_t new_size
-)
-{
-  uint32_t size = rv.sz;
-  if (new_size >= size)
-  {
-    return rv;
-  }
-  free_elems_from___uint8_t__uint32_t(rg, rv, new_size);
-  LowStar_Vector_vector_str___uint8_t_ frv = shrink___uint8_t_(rv, new_size);
-  return frv;
-}
-
 static void
 mt_retract_to_(
   uint32_t hsz,
@@ -1628,7 +2304,8 @@ mt_retract_to_(
   uint32_t lv,
   uint32_t i,
   uint32_t s,
-  uint32_t j
+  uint32_t j,
+  MerkleTree_Low_arena *arena
 )
 {
   if (!(lv >= hs.sz))
@@ -1636,18 +2313,12 @@ mt_retract_to_(
     LowStar_Vector_vector_str___uint8_t_ hvec = index__LowStar_Vector_vector_str__uint8_t_(hs, lv);
     uint32_t old_len = j - MerkleTree_Low_offset_of(i);
     uint32_t new_len = s - MerkleTree_Low_offset_of(i);
-    LowStar_Vector_vector_str___uint8_t_
-    retracted =
-      shrink___uint8_t__uint32_t((
-          (regional__uint32_t__uint8_t_){
-            .state = hsz,
-            .dummy = NULL,
-            .r_alloc = hash_r_alloc,
-            .r_free = hash_r_free
-          }
-        ),
-        hvec,
-        new_len);
+    LowStar_Vector_vector_str___uint8_t_ retracted = hvec;
+    if (new_len < hvec.sz)
+    {
+      arena_pop_back(arena, lv, hvec.sz - new_len);
+      retracted = shrink___uint8_t_(hvec, new_len);
+    }
     assign__LowStar_Vector_vector_str__uint8_t__uint32_t(hs, lv, retracted);
     if (lv + (uint32_t)1U < hs.sz)
     {
@@ -1656,7 +2327,8 @@ mt_retract_to_(
         lv + (uint32_t)1U,
         i / (uint32_t)2U,
         s / (uint32_t)2U,
-        j / (uint32_t)2U);
+        j / (uint32_t)2U,
+        arena);
       return;
     }
     return;
@@ -1680,7 +2352,7 @@ void MerkleTree_Low_mt_retract_to(MerkleTree_Low_merkle_tree *mt, uint64_t r)
   uint64_t offset = mtv.offset;
   uint32_t r1 = (uint32_t)(r - offset);
   LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_ hs = mtv.hs;
-  mt_retract_to_(mtv.hash_size, hs, (uint32_t)0U, mtv.i, r1 + (uint32_t)1U, mtv.j);
+  mt_retract_to_(mtv.hash_size, hs, (uint32_t)0U, mtv.i, r1 + (uint32_t)1U, mtv.j, mtv.arena);
   *mt
   =
     (
@@ -1693,9 +2365,13 @@ void MerkleTree_Low_mt_retract_to(MerkleTree_Low_merkle_tree *mt, uint64_t r)
         .rhs_ok = false,
         .rhs = mtv.rhs,
         .mroot = mtv.mroot,
-        .hash_fun = mtv.hash_fun
+        .hash_fun = mtv.hash_fun,
+        .arena = mtv.arena
       }
     );
+  /* Slots released by the retraction are about to be reused: a file-backed tree
+     must stop covering them first. */
+  MerkleTree_Low_File_mt_sync(mt);
 }
 
 static void
@@ -1813,6 +2489,243 @@ MerkleTree_Low_mt_verify(
   return r;
 }
 
+typedef struct mt_verify_target_s
+{
+  uint64_t k;
+  uint32_t q;
+}
+mt_verify_target;
+
+static int mt_verify_target_cmp(const void *x, const void *y)
+{
+  uint64_t a = ((const mt_verify_target *)x)->k;
+  uint64_t b = ((const mt_verify_target *)y)->k;
+  if (a < b)
+  {
+    return -1;
+  }
+  if (a > b)
+  {
+    return 1;
+  }
+  return 0;
+}
+
+static bool
+mt_verify_same_rest(
+  uint32_t hsz,
+  const MerkleTree_Low_path *p1,
+  uint32_t pos1,
+  const MerkleTree_Low_path *p2,
+  uint32_t pos2
+)
+{
+  LowStar_Vector_vector_str___uint8_t_ h1 = p1->hashes;
+  LowStar_Vector_vector_str___uint8_t_ h2 = p2->hashes;
+  if (h1.sz - pos1 != h2.sz - pos2)
+  {
+    return false;
+  }
+  for (uint32_t i = (uint32_t)0U; i < h1.sz - pos1; i++)
+  {
+    uint8_t *a = index___uint8_t_(h1, pos1 + i);
+    uint8_t *b = index___uint8_t_(h2, pos2 + i);
+    if (a != b && memcmp(a, b, hsz * sizeof (uint8_t)) != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+MerkleTree_Low_mt_verify_batch(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *ks,
+  uint64_t j,
+  MerkleTree_Low_path **ps,
+  uint8_t *rt,
+  bool *res
+)
+{
+  MerkleTree_Low_merkle_tree mtv = *(MerkleTree_Low_merkle_tree *)mt;
+  uint32_t hsz = mtv.hash_size;
+  bool jok = j >= mtv.offset && j - mtv.offset <= MerkleTree_Low_offset_range_limit;
+  uint32_t j1 = (uint32_t)(j - mtv.offset);
+  if (n == (uint32_t)0U)
+  {
+    return true;
+  }
+  KRML_CHECK_SIZE(sizeof (uint8_t), (uint64_t)n * (uint64_t)hsz);
+  mt_verify_target *ord = KRML_HOST_MALLOC(sizeof (mt_verify_target) * n);
+  uint32_t *act = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  uint32_t *k = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  uint32_t *ppos = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  uint32_t *lead = KRML_HOST_MALLOC(sizeof (uint32_t) * n);
+  uint8_t **src1 = KRML_HOST_MALLOC(sizeof (uint8_t *) * n);
+  uint8_t **src2 = KRML_HOST_MALLOC(sizeof (uint8_t *) * n);
+  uint8_t **dst = KRML_HOST_MALLOC(sizeof (uint8_t *) * n);
+  uint8_t *accs = KRML_HOST_MALLOC(sizeof (uint8_t) * ((size_t)n * hsz));
+  if
+  (
+    ord == NULL
+    || act == NULL
+    || k == NULL
+    || ppos == NULL
+    || lead == NULL
+    || src1 == NULL
+    || src2 == NULL
+    || dst == NULL
+    || accs == NULL
+  )
+  {
+    for (uint32_t q = (uint32_t)0U; q < n; q++)
+    {
+      res[q] = false;
+    }
+    KRML_HOST_FREE(ord);
+    KRML_HOST_FREE(act);
+    KRML_HOST_FREE(k);
+    KRML_HOST_FREE(ppos);
+    KRML_HOST_FREE(lead);
+    KRML_HOST_FREE(src1);
+    KRML_HOST_FREE(src2);
+    KRML_HOST_FREE(dst);
+    KRML_HOST_FREE(accs);
+    return false;
+  }
+  for (uint32_t q = (uint32_t)0U; q < n; q++)
+  {
+    ord[q] = ((mt_verify_target){ .k = ks[q], .q = q });
+  }
+  /* In target order, paths meeting at a node are adjacent at every level. */
+  qsort(ord, n, sizeof (mt_verify_target), mt_verify_target_cmp);
+  uint32_t m = (uint32_t)0U;
+  for (uint32_t r = (uint32_t)0U; r < n; r++)
+  {
+    uint32_t q = ord[r].q;
+    lead[q] = q;
+    res[q] = false;
+    if
+    (
+      jok
+      && ks[q] < j
+      && ks[q] >= mtv.offset
+      && ps[q]->hash_size == hsz
+      && ps[q]->hashes.sz
+      == (uint32_t)1U + mt_path_length((uint32_t)0U, (uint32_t)(ks[q] - mtv.offset), j1, false)
+    )
+    {
+      k[q] = (uint32_t)(ks[q] - mtv.offset);
+      ppos[q] = (uint32_t)1U;
+      hash_copy(hsz, index___uint8_t_(ps[q]->hashes, (uint32_t)0U), accs + q * hsz);
+      act[m] = q;
+      m++;
+    }
+  }
+  uint32_t jj = j1;
+  bool actd = false;
+  while (jj != (uint32_t)0U)
+  {
+    /* A path agreeing with its predecessor from this node up takes its result. */
+    uint32_t m1 = (uint32_t)0U;
+    for (uint32_t r = (uint32_t)0U; r < m; r++)
+    {
+      uint32_t q = act[r];
+      if (m1 > (uint32_t)0U)
+      {
+        uint32_t p = act[m1 - (uint32_t)1U];
+        if
+        (
+          k[p] == k[q]
+          && memcmp(accs + p * hsz, accs + q * hsz, hsz * sizeof (uint8_t)) == 0
+          && mt_verify_same_rest(hsz, ps[p], ppos[p], ps[q], ppos[q])
+        )
+        {
+          lead[q] = p;
+          continue;
+        }
+      }
+      act[m1] = q;
+      m1++;
+    }
+    m = m1;
+    uint32_t cnt = (uint32_t)0U;
+    for (uint32_t r = (uint32_t)0U; r < m; r++)
+    {
+      uint32_t q = act[r];
+      uint8_t *acc = accs + q * hsz;
+      if (k[q] % (uint32_t)2U == (uint32_t)0U)
+      {
+        if (!(jj == k[q] || (jj == k[q] + (uint32_t)1U && !actd)))
+        {
+          src1[cnt] = acc;
+          src2[cnt] = index___uint8_t_(ps[q]->hashes, ppos[q]);
+          dst[cnt] = acc;
+          ppos[q] = ppos[q] + (uint32_t)1U;
+          cnt++;
+        }
+      }
+      else
+      {
+        src1[cnt] = index___uint8_t_(ps[q]->hashes, ppos[q]);
+        src2[cnt] = acc;
+        dst[cnt] = acc;
+        ppos[q] = ppos[q] + (uint32_t)1U;
+        cnt++;
+      }
+      k[q] = k[q] / (uint32_t)2U;
+    }
+    if (mtv.hash_fun == mt_sha256_compress)
+    {
+      mt_sha256_compress_many(cnt, src1, src2, dst);
+    }
+    else
+    {
+      for (uint32_t r = (uint32_t)0U; r < cnt; r++)
+      {
+        mtv.hash_fun(src1[r], src2[r], dst[r]);
+      }
+    }
+    actd = actd || jj % (uint32_t)2U == (uint32_t)1U;
+    jj = jj / (uint32_t)2U;
+  }
+  for (uint32_t r = (uint32_t)0U; r < m; r++)
+  {
+    uint32_t q = act[r];
+    uint8_t *acc = accs + q * hsz;
+    uint8_t z = (uint8_t)255U;
+    for (uint32_t i = (uint32_t)0U; i < hsz; i++)
+    {
+      uint8_t uu____0 = FStar_UInt8_eq_mask(acc[i], rt[i]);
+      z = uu____0 & z;
+    }
+    res[q] = z == (uint8_t)255U;
+  }
+  /* Leaders precede their followers in target order. */
+  bool all = true;
+  for (uint32_t r = (uint32_t)0U; r < n; r++)
+  {
+    uint32_t q = ord[r].q;
+    if (lead[q] != q)
+    {
+      res[q] = res[lead[q]];
+    }
+    all = all && res[q];
+  }
+  KRML_HOST_FREE(ord);
+  KRML_HOST_FREE(act);
+  KRML_HOST_FREE(k);
+  KRML_HOST_FREE(ppos);
+  KRML_HOST_FREE(lead);
+  KRML_HOST_FREE(src1);
+  KRML_HOST_FREE(src2);
+  KRML_HOST_FREE(dst);
+  KRML_HOST_FREE(accs);
+  return all;
+}
+
 typedef struct __bool_uint32_t_s
 {
   bool fst;
@@ -2594,6 +3507,8 @@ MerkleTree_Low_merkle_tree
   {
     return NULL;
   }
+  MerkleTree_Low_arena *arena = arena_create(hsz);
+  arena_adopt(arena, hs);
   KRML_CHECK_SIZE(sizeof (MerkleTree_Low_merkle_tree), (uint32_t)1U);
   MerkleTree_Low_merkle_tree *buf = KRML_HOST_MALLOC(sizeof (MerkleTree_Low_merkle_tree));
   buf[0U]
@@ -2608,7 +3523,8 @@ MerkleTree_Low_merkle_tree
         .rhs_ok = rhs_ok,
         .rhs = rhs,
         .mroot = mroot,
-        .hash_fun = hash_fun
+        .hash_fun = hash_fun,
+        .arena = arena
       }
     );
   return buf;
@@ -2665,6 +3581,333 @@ MerkleTree_Low_path
   return buf;
 }
 
+/*
+  File layout: a 4096-byte page holding the magic number and hash_size, written
+  once by mt_create_file; two header slots of mt_file_slot_len(hash_size) bytes;
+  then the arena chunks, up to file_end. A slot holds the magic number,
+  hash_size, i, j, rhs_ok, offset, file_end and a sequence number in its first 64
+  bytes, followed by mroot, the 32 hashes of rhs and the SHA2-256 of everything
+  before it.
+
+  Each sync writes the next sequence number into the slot the previous sync did
+  not use, so a write torn by a crash only damages that slot: its checksum then
+  fails and mt_open falls back to the other one, the state of the previous sync.
+*/
+
+static void mt_file_checksum(uint32_t hsz, uint8_t *slot, uint8_t *dst)
+{
+  EverCrypt_Hash_hash(Spec_Hash_Definitions_SHA2_256, dst, slot, mt_file_slot_used(hsz));
+}
+bool MerkleTree_Low_File_mt_sync(MerkleTree_Low_merkle_tree *mt)
+{
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  MerkleTree_Low_arena *a = mtv.arena;
+  if (a->fd < 0)
+  {
+    return true;
+  }
+  #if !(defined(_WIN32) || defined(_WIN64))
+  uint32_t hsz = mtv.hash_size;
+  bool ok = true;
+  for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+  {
+    for (arena_chunk *c = a->lvs[lv].head; c != NULL; c = c->next)
+    {
+      ok = ok && msync(c->map, c->map_len, MS_SYNC) == 0;
+    }
+  }
+  uint32_t len = mt_file_slot_used(hsz) + (uint32_t)32U;
+  uint64_t seq = a->seq + (uint64_t)1U;
+  KRML_CHECK_SIZE(sizeof (uint8_t), len);
+  uint8_t *hdr = KRML_HOST_CALLOC(len, sizeof (uint8_t));
+  if (hdr == NULL)
+  {
+    return false;
+  }
+  memcpy(hdr, mt_file_magic, (uint32_t)8U * sizeof (uint8_t));
+  store32_le(hdr + (uint32_t)8U, hsz);
+  store32_le(hdr + (uint32_t)12U, mtv.i);
+  store32_le(hdr + (uint32_t)16U, mtv.j);
+  hdr[20U] = (uint8_t)mtv.rhs_ok;
+  store64_le(hdr + (uint32_t)24U, mtv.offset);
+  store64_le(hdr + (uint32_t)32U, a->file_end);
+  store64_le(hdr + (uint32_t)40U, seq);
+  hash_copy(hsz, mtv.mroot, hdr + (uint32_t)64U);
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)32U; k++)
+  {
+    hash_copy(hsz, index___uint8_t_(mtv.rhs, k), hdr + (uint32_t)64U + (k + (uint32_t)1U) * hsz);
+  }
+  mt_file_checksum(hsz, hdr, hdr + mt_file_slot_used(hsz));
+  /* The chunks must be on disk before the header that refers to them. */
+  uint64_t pos = (uint64_t)4096U + (seq & (uint64_t)1U) * mt_file_slot_len(hsz);
+  ok = ok && pwrite(a->fd, hdr, (size_t)len, (off_t)pos) == (ssize_t)len;
+  ok = ok && fsync(a->fd) == 0;
+  KRML_HOST_FREE(hdr);
+  if (ok)
+  {
+    a->seq = seq;
+  }
+  return ok;
+  #else
+  return false;
+  #endif
+}
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_File_mt_create(
+  const char *path,
+  uint32_t hsz,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  #if !(defined(_WIN32) || defined(_WIN64))
+  if (hsz == (uint32_t)0U || hsz > (uint32_t)4032U)
+  {
+    return NULL;
+  }
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    return NULL;
+  }
+  MerkleTree_Low_arena *arena = arena_create(hsz);
+  arena->fd = fd;
+  arena->file_end = mt_file_header_len(hsz);
+  uint8_t fixed[64U] = { 0U };
+  memcpy(fixed, mt_file_magic, (uint32_t)8U * sizeof (uint8_t));
+  store32_le(fixed + (uint32_t)8U, hsz);
+  if
+  (
+    ftruncate(fd, (off_t)arena->file_end) != 0
+    || pwrite(fd, fixed, (size_t)64U, (off_t)0) != (ssize_t)64
+  )
+  {
+    arena_free(arena);
+    return NULL;
+  }
+  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun, arena);
+  MerkleTree_Low_mt_insert(mt, init);
+  if (!MerkleTree_Low_File_mt_sync(mt))
+  {
+    MerkleTree_Low_mt_free(mt);
+    return NULL;
+  }
+  return mt;
+  #else
+  return NULL;
+  #endif
+}
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_File_mt_open(
+  const char *path,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+)
+{
+  #if !(defined(_WIN32) || defined(_WIN64))
+  int fd = open(path, O_RDWR);
+  if (fd < 0)
+  {
+    return NULL;
+  }
+  uint8_t fixed[64U] = { 0U };
+  struct stat st;
+  if
+  (
+    pread(fd, fixed, (size_t)64U, (off_t)0) != (ssize_t)64
+    || memcmp(fixed, mt_file_magic, (uint32_t)8U * sizeof (uint8_t)) != 0
+    || fstat(fd, &st) != 0
+  )
+  {
+    close(fd);
+    return NULL;
+  }
+  uint32_t hsz0 = load32_le(fixed + (uint32_t)8U);
+  if (hsz0 == (uint32_t)0U || hsz0 > (uint32_t)4032U)
+  {
+    close(fd);
+    return NULL;
+  }
+  uint32_t used = mt_file_slot_used(hsz0);
+  uint8_t *slots = KRML_HOST_CALLOC((uint32_t)2U * (used + (uint32_t)32U), sizeof (uint8_t));
+  if (slots == NULL)
+  {
+    close(fd);
+    return NULL;
+  }
+  /* The valid slot with the higher sequence number wins */
+  uint8_t *hdr = NULL;
+  uint64_t seq = (uint64_t)0U;
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)2U; k++)
+  {
+    uint8_t *slot = slots + k * (used + (uint32_t)32U);
+    uint8_t sum[32U] = { 0U };
+    uint64_t pos = (uint64_t)4096U + (uint64_t)k * mt_file_slot_len(hsz0);
+    bool valid =
+      pread(fd, slot, (size_t)(used + (uint32_t)32U), (off_t)pos)
+      == (ssize_t)(used + (uint32_t)32U)
+      && memcmp(slot, mt_file_magic, (uint32_t)8U * sizeof (uint8_t)) == 0
+      && load32_le(slot + (uint32_t)8U) == hsz0;
+    if (valid)
+    {
+      mt_file_checksum(hsz0, slot, sum);
+      valid = memcmp(sum, slot + used, (uint32_t)32U * sizeof (uint8_t)) == 0;
+    }
+    if (valid && (hdr == NULL || load64_le(slot + (uint32_t)40U) > seq))
+    {
+      hdr = slot;
+      seq = load64_le(slot + (uint32_t)40U);
+    }
+  }
+  if (hdr == NULL)
+  {
+    KRML_HOST_FREE(slots);
+    close(fd);
+    return NULL;
+  }
+  memcpy(fixed, hdr, (uint32_t)64U * sizeof (uint8_t));
+  uint32_t hsz = load32_le(fixed + (uint32_t)8U);
+  uint32_t i = load32_le(fixed + (uint32_t)12U);
+  uint32_t j = load32_le(fixed + (uint32_t)16U);
+  bool rhs_ok = fixed[20U] != (uint8_t)0U;
+  uint64_t offset = load64_le(fixed + (uint32_t)24U);
+  uint64_t file_end = load64_le(fixed + (uint32_t)32U);
+  if
+  (
+    hsz == (uint32_t)0U
+    || hsz > (uint32_t)4032U
+    || j < i
+    || MerkleTree_Low_uint64_max - offset < (uint64_t)j
+    || file_end < mt_file_header_len(hsz)
+    || file_end > (uint64_t)st.st_size
+  )
+  {
+    KRML_HOST_FREE(slots);
+    close(fd);
+    return NULL;
+  }
+  MerkleTree_Low_arena *a = arena_create(hsz);
+  a->fd = fd;
+  a->file_end = file_end;
+  a->seq = seq;
+  /* Walk the chunks in file order. A chunk supersedes the slots of older chunks of
+     its level from its base on, which were released by a retraction; only the slots
+     in the range the header gives to each level are kept. */
+  bool ok = true;
+  uint64_t off = mt_file_header_len(hsz);
+  while (ok && off < file_end)
+  {
+    uint8_t ch[16U] = { 0U };
+    ok = pread(fd, ch, (size_t)16U, (off_t)off) == (ssize_t)16;
+    uint32_t lv = load32_le(ch + (uint32_t)4U);
+    uint32_t cap = load32_le(ch + (uint32_t)8U);
+    uint32_t base = load32_le(ch + (uint32_t)12U);
+    uint64_t len = mt_file_chunk_len(hsz, cap);
+    ok =
+      ok
+      && load32_le(ch) == mt_chunk_magic
+      && lv < (uint32_t)32U
+      && cap > (uint32_t)0U
+      && cap <= (uint32_t)0x100000U
+      && len <= file_end - off;
+    if (!ok)
+    {
+      break;
+    }
+    arena_level *l = a->lvs + lv;
+    while (l->tail != NULL && l->tail->base + l->tail->lo >= base)
+    {
+      arena_drop_tail(l);
+    }
+    if (l->tail != NULL && l->tail->base + l->tail->hi > base)
+    {
+      l->tail->hi = base - l->tail->base;
+    }
+    uint64_t lo = (uint64_t)MerkleTree_Low_offset_of(i >> lv);
+    uint64_t hi = (uint64_t)(j >> lv);
+    if ((uint64_t)base > lo)
+    {
+      lo = (uint64_t)base;
+    }
+    if ((uint64_t)base + (uint64_t)cap < hi)
+    {
+      hi = (uint64_t)base + (uint64_t)cap;
+    }
+    if (lo < hi)
+    {
+      arena_chunk *c = arena_chunk_map(fd, off, len, cap, base);
+      ok = c != NULL;
+      if (ok)
+      {
+        c->lo = (uint32_t)(lo - (uint64_t)base);
+        c->hi = (uint32_t)(hi - (uint64_t)base);
+        arena_push_chunk(l, c);
+      }
+    }
+    off = off + len;
+  }
+  /* Every level must hold exactly the nodes offset_of(i >> lv) .. (j >> lv) - 1. */
+  for (uint32_t lv = (uint32_t)0U; ok && lv < (uint32_t)32U; lv++)
+  {
+    uint32_t next = MerkleTree_Low_offset_of(i >> lv);
+    for (arena_chunk *c = a->lvs[lv].head; ok && c != NULL; c = c->next)
+    {
+      ok = c->base + c->lo == next;
+      next = c->base + c->hi;
+    }
+    ok = ok && next == j >> lv;
+    a->lvs[lv].end = j >> lv;
+  }
+  uint8_t *hashes = hdr + (uint32_t)64U;
+  if (!ok)
+  {
+    KRML_HOST_FREE(slots);
+    arena_free(a);
+    return NULL;
+  }
+  MerkleTree_Low_merkle_tree *mt = create_empty_mt(hsz, hash_fun, a);
+  MerkleTree_Low_merkle_tree mtv = *mt;
+  for (uint32_t lv = (uint32_t)0U; lv < (uint32_t)32U; lv++)
+  {
+    LowStar_Vector_vector_str___uint8_t_ lvhs = index__LowStar_Vector_vector_str__uint8_t_(mtv.hs, lv);
+    for (arena_chunk *c = a->lvs[lv].head; c != NULL; c = c->next)
+    {
+      for (uint32_t k = c->lo; k < c->hi; k++)
+      {
+        lvhs = insert___uint8_t__uint32_t(lvhs, c->data + k * hsz);
+      }
+    }
+    assign__LowStar_Vector_vector_str__uint8_t__uint32_t(mtv.hs, lv, lvhs);
+  }
+  hash_copy(hsz, hashes, mtv.mroot);
+  for (uint32_t k = (uint32_t)0U; k < (uint32_t)32U; k++)
+  {
+    hash_copy(hsz, hashes + (k + (uint32_t)1U) * hsz, index___uint8_t_(mtv.rhs, k));
+  }
+  KRML_HOST_FREE(slots);
+  *mt
+  =
+    (
+      (MerkleTree_Low_merkle_tree){
+        .hash_size = hsz,
+        .offset = offset,
+        .i = i,
+        .j = j,
+        .hs = mtv.hs,
+        .rhs_ok = rhs_ok,
+        .rhs = mtv.rhs,
+        .mroot = mtv.mroot,
+        .hash_fun = hash_fun,
+        .arena = a
+      }
+    );
+  return mt;
+  #else
+  return NULL;
+  #endif
+}
+
 uint8_t *MerkleTree_Low_Hashfunctions_init_hash(uint32_t hsz)
 {
   regional__uint32_t__uint8_t_
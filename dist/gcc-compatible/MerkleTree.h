@@ -76,6 +76,11 @@ typedef struct LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t__s
 }
 LowStar_Vector_vector_str__LowStar_Vector_vector_str___uint8_t_;
 
+/*
+  Per-level storage of the node hashes of a tree; see MerkleTree.c.
+*/
+typedef struct MerkleTree_Low_arena_s MerkleTree_Low_arena;
+
 typedef struct MerkleTree_Low_merkle_tree_s
 {
   uint32_t hash_size;
@@ -87,6 +92,7 @@ typedef struct MerkleTree_Low_merkle_tree_s
   LowStar_Vector_vector_str___uint8_t_ rhs;
   uint8_t *mroot;
   void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2);
+  MerkleTree_Low_arena *arena;
 }
 MerkleTree_Low_merkle_tree;
 
@@ -185,6 +191,26 @@ void mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 */
 bool mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 
+/*
+  Batch insertion
+
+  @param[in]  mt      The Merkle tree
+  @param[in]  n       The number of hashes to insert
+  @param[in]  leaves  An array of n hashes; the tree copies their content and does
+                      not take ownership of them.
+
+ The resulting tree is the same as after n calls to mt_insert, but each level is
+ only visited once and all its new nodes are hashed together, which lets the
+ default hash function compress several nodes per call. Unlike mt_insert, the
+ content of the hashes is left untouched.
+*/
+void mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint32_t n, uint8_t **leaves);
+
+/*
+  Precondition predicate for mt_insert_batch
+*/
+bool mt_insert_batch_pre(const MerkleTree_Low_merkle_tree *mt, uint32_t n);
+
 /*
   Getting the Merkle root
 
@@ -233,6 +259,45 @@ mt_get_path_pre(
   uint8_t *root
 );
 
+/*
+  Getting several Merkle paths at once
+
+  @param[in]  mt    The Merkle tree
+  @param[in]  n     The number of paths to get
+  @param[in]  idxs  The n indices of the target hashes
+  @param[out] paths n empty paths, each receiving the Merkle path of the
+                    corresponding index (leaf hash included)
+  @param[out] root  The Merkle root
+
+  return The number of elements in the tree
+
+  Notes:
+  - Equivalent to n calls to mt_get_path, except that the root and right
+    hashes are computed once for all paths, and each path is allocated at its
+    final length.
+  - Each index must satisfy the requirements of mt_get_path.
+*/
+uint32_t
+mt_get_paths(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *idxs,
+  MerkleTree_Low_path **paths,
+  uint8_t *root
+);
+
+/*
+  Precondition predicate for mt_get_paths
+*/
+bool
+mt_get_paths_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *idxs,
+  MerkleTree_Low_path **paths,
+  uint8_t *root
+);
+
 /*
   Flush the Merkle tree
 
@@ -307,6 +372,40 @@ mt_verify_pre(
   uint8_t *root
 );
 
+/*
+  Client-side verification of several paths against one root
+
+  @param[in]  mt      The Merkle tree
+  @param[in]  n       The number of paths to verify
+  @param[in]  tgts    The n indices of the target hashes
+  @param[in]  max     The maximum index + 1 of the tree when the paths were
+                      generated
+  @param[in]  paths   The n Merkle paths to verify
+  @param[in]  root
+  @param[out] results results[i] is set to the outcome of verifying paths[i]
+
+  return true if all the verifications succeeded, false otherwise
+
+  Notes:
+  - results[i] is the value mt_verify would return for (tgts[i], paths[i]),
+    except that malformed paths are rejected instead of being read out of
+    bounds.
+  - If the working buffers cannot be allocated, every results[i] is false.
+  - Paths that reach the same interior node with the same hash and the same
+    remaining siblings share the hashing from that node up, so each distinct
+    node is hashed once per batch.
+*/
+bool
+mt_verify_batch(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *tgts,
+  uint64_t max,
+  MerkleTree_Low_path **paths,
+  uint8_t *root,
+  bool *results
+);
+
 /*
   Serialization size
 
@@ -372,6 +471,54 @@ uint64_t mt_serialize_path(const MerkleTree_Low_path *path1, uint8_t *buf, uint6
 */
 MerkleTree_Low_path *mt_deserialize_path(const uint8_t *buf, uint64_t len);
 
+/*
+  Creation of a file-backed tree
+
+  @param[in]  path       The file to store the tree in; it is created or truncated
+  @param[in]  hash_size  Hash size (in bytes)
+  @param[in]  init       The initial hash
+  @param[in]  hash_fun   Hash function
+
+  return pointer to the new tree if successful, NULL otherwise
+
+  Note: The node hashes of the tree live in memory mappings of the file, so its
+  resident size is bounded by the page cache. The file is extended as hashes are
+  inserted and never shrinks. mt_free syncs the tree, then unmaps and closes the file.
+*/
+MerkleTree_Low_merkle_tree
+*mt_create_file(
+  const char *path,
+  uint32_t hash_size,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+/*
+  Opening a file-backed tree
+
+  @param[in]  path      A file written by a tree created with mt_create_file
+  @param[in]  hash_fun  Hash function
+
+  return pointer to the tree if successful, NULL otherwise
+
+  Note: The hashes are not read nor copied, only mapped; the tree is in the state
+  of the last mt_sync of the file. Retractions are synced immediately. If a crash
+  interrupted the last sync, the tree is in the state of the sync before it.
+  Opening still takes time linear in the number of nodes, as the per-level
+  vectors of node pointers are rebuilt over the mappings.
+*/
+MerkleTree_Low_merkle_tree
+*mt_open(const char *path, void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2));
+
+/*
+  Syncing a file-backed tree
+
+  @param[in]  mt  The Merkle tree
+
+  return true if the state of the tree is on disk; always true for trees in memory
+*/
+bool mt_sync(MerkleTree_Low_merkle_tree *mt);
+
 typedef MerkleTree_Low_merkle_tree *mt_p0;
 
 /*
@@ -450,6 +597,10 @@ bool MerkleTree_Low_mt_insert_pre(const MerkleTree_Low_merkle_tree *mt, uint8_t
 
 void MerkleTree_Low_mt_insert(MerkleTree_Low_merkle_tree *mt, uint8_t *v);
 
+bool MerkleTree_Low_mt_insert_batch_pre(const MerkleTree_Low_merkle_tree *mt, uint32_t n);
+
+void MerkleTree_Low_mt_insert_batch(MerkleTree_Low_merkle_tree *mt, uint32_t n, uint8_t **vs);
+
 MerkleTree_Low_merkle_tree
 *MerkleTree_Low_mt_create_custom(
   uint32_t hsz,
@@ -502,6 +653,24 @@ MerkleTree_Low_mt_get_path(
   uint8_t *root
 );
 
+bool
+MerkleTree_Low_mt_get_paths_pre(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *idxs,
+  MerkleTree_Low_path **ps,
+  uint8_t *root
+);
+
+uint32_t
+MerkleTree_Low_mt_get_paths(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *idxs,
+  MerkleTree_Low_path **ps,
+  uint8_t *root
+);
+
 bool MerkleTree_Low_mt_flush_to_pre(const MerkleTree_Low_merkle_tree *mt, uint64_t idx);
 
 void MerkleTree_Low_mt_flush_to(MerkleTree_Low_merkle_tree *mt, uint64_t idx);
@@ -532,6 +701,17 @@ MerkleTree_Low_mt_verify(
   uint8_t *rt
 );
 
+bool
+MerkleTree_Low_mt_verify_batch(
+  const MerkleTree_Low_merkle_tree *mt,
+  uint32_t n,
+  uint64_t *ks,
+  uint64_t j,
+  MerkleTree_Low_path **ps,
+  uint8_t *rt,
+  bool *res
+);
+
 typedef uint8_t MerkleTree_Low_Serialization_uint8_t;
 
 typedef uint16_t MerkleTree_Low_Serialization_uint16_t;
@@ -570,6 +750,22 @@ MerkleTree_Low_Serialization_mt_serialize_path(
 MerkleTree_Low_path
 *MerkleTree_Low_Serialization_mt_deserialize_path(const uint8_t *input, uint64_t sz);
 
+bool MerkleTree_Low_File_mt_sync(MerkleTree_Low_merkle_tree *mt);
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_File_mt_create(
+  const char *path,
+  uint32_t hsz,
+  uint8_t *init,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
+MerkleTree_Low_merkle_tree
+*MerkleTree_Low_File_mt_open(
+  const char *path,
+  void (*hash_fun)(uint8_t *x0, uint8_t *x1, uint8_t *x2)
+);
+
 uint8_t *MerkleTree_Low_Hashfunctions_init_hash(uint32_t hsz);
 
 void MerkleTree_Low_Hashfunctions_free_hash(uint8_t *h);
@@ -65,6 +65,10 @@ extern uint64_t check_rdrand();
 
 extern uint64_t check_avx512();
 
+extern uint64_t check_vaes();
+
+extern uint64_t check_ifma();
+
 extern uint64_t check_osxsave();
 
 extern uint64_t check_avx_xcr0();
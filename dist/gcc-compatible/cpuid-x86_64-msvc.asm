@@ -126,6 +126,31 @@ check_avx512 proc
   ret
 check_avx512 endp
 ALIGN 16
+check_vaes proc
+  mov r9, rbx
+  mov rax, 7
+  mov rcx, 0
+  cpuid
+  mov rax, rcx
+  and rax, 512
+  and rcx, 1024
+  shr rcx, 1
+  and rax, rcx
+  mov rbx, r9
+  ret
+check_vaes endp
+ALIGN 16
+check_ifma proc
+  mov r9, rbx
+  mov rax, 7
+  mov rcx, 0
+  cpuid
+  mov rax, rbx
+  and rax, 2097152
+  mov rbx, r9
+  ret
+check_ifma endp
+ALIGN 16
 check_osxsave proc
   mov r9, rbx
   mov rcx, 0
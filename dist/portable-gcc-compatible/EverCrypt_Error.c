@@ -136,5 +136,20 @@ bool EverCrypt_Error_uu___is_DecodeError(EverCrypt_Error_error_code projectee)
   }
 }
 
+bool EverCrypt_Error_uu___is_OutOfMemory(EverCrypt_Error_error_code projectee)
+{
+  switch (projectee)
+  {
+    case EverCrypt_Error_OutOfMemory:
+      {
+        return true;
+      }
+    default:
+      {
+        return false;
+      }
+  }
+}
+
 /* SNIPPET_END: EverCrypt_Error_uu___is_DecodeError */
 
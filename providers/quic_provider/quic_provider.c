@@ -11,17 +11,16 @@
 
 #include "kremlib.h"
 #include "EverCrypt.h"
+#include "Lib_Memzero0.h"
 #include "quic_provider.h"
 
 typedef struct quic_key {
   mitls_aead alg;
   unsigned char key[32];
   unsigned char static_iv[12];
-  union {
-    unsigned char case_chacha20[32];
-    EverCrypt_aes128_key case_aes128;
-    EverCrypt_aes256_key case_aes256;
-  } pne;
+  EverCrypt_AEAD_state_s *aead;
+  // Same algorithm under the header protection key, for its block function
+  EverCrypt_AEAD_state_s *hp;
 } quic_key;
 
 #if DEBUG
@@ -205,17 +204,34 @@ int MITLS_CALLCONV quic_derive_initial_secrets(quic_secret *client_in, quic_secr
   return 1;
 }
 
-int MITLS_CALLCONV quic_crypto_derive_key(quic_key **k, const quic_secret *secret)
+// Expands the AEAD and header protection keys once, rather than on every packet
+static int aead_create(quic_key *k, const unsigned char *pne_key)
 {
-  quic_key *key = KRML_HOST_MALLOC(sizeof(quic_key));
-  if(!key) return 0;
-  key->alg = secret->ae;
+  Spec_Agile_AEAD_alg a = Spec_Agile_AEAD_CHACHA20_POLY1305;
+  if(k->alg == TLS_aead_AES_128_GCM)
+    a = Spec_Agile_AEAD_AES128_GCM;
+  else if(k->alg == TLS_aead_AES_256_GCM)
+    a = Spec_Agile_AEAD_AES256_GCM;
+  k->aead = NULL;
+  k->hp = NULL;
+  if(EverCrypt_AEAD_create_in(a, &k->aead, k->key) != EverCrypt_Error_Success)
+    return 0;
+  if(EverCrypt_AEAD_create_in(a, &k->hp, (uint8_t*)pne_key) != EverCrypt_Error_Success)
+  {
+    EverCrypt_AEAD_free(k->aead);
+    k->aead = NULL;
+    return 0;
+  }
+  return 1;
+}
 
+// Fills in key from secret; pnkey receives the header protection key
+static int derive_key(quic_key *key, const quic_secret *secret, unsigned char *pnkey)
+{
   uint32_t klen = (secret->ae == TLS_aead_AES_128_GCM ? 16 : 32);
   uint32_t slen = (secret->hash == TLS_hash_SHA256 ? 32 : (secret->hash == TLS_hash_SHA384 ? 48 : 64));
 
   unsigned char info[259] = {0};
-  unsigned char pnkey[32];
   size_t info_len;
 
   if(!quic_crypto_hkdf_label(secret->hash, info, &info_len, "key", klen))
@@ -239,18 +255,25 @@ int MITLS_CALLCONV quic_crypto_derive_key(quic_key **k, const quic_secret *secre
    printf("PNE: "); dump(pnkey, klen);
 #endif
 
-   if(key->alg == TLS_aead_AES_128_GCM)
-   {
-     key->pne.case_aes128 = EverCrypt_aes128_create(pnkey);
-   }
-   else if(key->alg == TLS_aead_AES_256_GCM)
-   {
-     key->pne.case_aes256 = EverCrypt_aes256_create(pnkey);
-   }
-   else if(key->alg == TLS_aead_CHACHA20_POLY1305)
-   {
-     memcpy(key->pne.case_chacha20, pnkey, 32);
-   }
+  return aead_create(key, pnkey);
+}
+
+int MITLS_CALLCONV quic_crypto_derive_key(quic_key **k, const quic_secret *secret)
+{
+  quic_key *key = KRML_HOST_MALLOC(sizeof(quic_key));
+  if(!key) return 0;
+  key->alg = secret->ae;
+  key->aead = NULL;
+  key->hp = NULL;
+
+  unsigned char pnkey[32];
+  int ok = derive_key(key, secret, pnkey);
+  Lib_Memzero0_memzero(pnkey, sizeof(pnkey));
+  if(!ok)
+  {
+    quic_crypto_free_key(key);
+    return 0;
+  }
 
   *k = key;
   return 1;
@@ -272,12 +295,11 @@ int MITLS_CALLCONV quic_crypto_create(quic_key **key, mitls_aead alg, const unsi
   memcpy(k->key, raw_key, klen);
   memcpy(k->static_iv, iv, 12);
 
-  if(alg == TLS_aead_AES_128_GCM)
-    k->pne.case_aes128 = EverCrypt_aes128_create((uint8_t*)pne_key);
-  else if(alg == TLS_aead_AES_256_GCM)
-    k->pne.case_aes256 = EverCrypt_aes256_create((uint8_t*)pne_key);
-  else if(alg == TLS_aead_CHACHA20_POLY1305)
-    memcpy(k->pne.case_chacha20, pne_key, 32);
+  if(!aead_create(k, pne_key))
+  {
+    quic_crypto_free_key(k);
+    return 0;
+  }
 
   *key = k;
   return 1;
@@ -290,19 +312,8 @@ int MITLS_CALLCONV quic_crypto_encrypt(quic_key *key, unsigned char *cipher, uin
   memcpy(iv, key->static_iv, 12);
   sn_to_iv(iv, sn);
 
-  if(key->alg == TLS_aead_AES_128_GCM)
-  {
-    EverCrypt_aes128_gcm_encrypt(key->key, iv, (uint8_t*)ad, ad_len, (uint8_t*)plain, plain_len, cipher, (cipher+plain_len));
-  }
-  else if(key->alg == TLS_aead_AES_256_GCM)
-  {
-    EverCrypt_aes256_gcm_encrypt(key->key, iv, (uint8_t*)ad, ad_len, (uint8_t*)plain, plain_len, cipher, (cipher+plain_len));
-  }
-  else if(key->alg == TLS_aead_CHACHA20_POLY1305)
-  {
-    EverCrypt_Chacha20Poly1305_aead_encrypt(key->key, iv, ad_len, (uint8_t*)ad,
-        plain_len, (uint8_t*)plain, cipher, cipher + plain_len);
-  }
+  EverCrypt_AEAD_encrypt(key->aead, iv, 12, (uint8_t*)ad, ad_len, (uint8_t*)plain, plain_len,
+    cipher, cipher + plain_len);
 
 #if DEBUG
   printf("ENCRYPT %s\n", key->alg == TLS_aead_AES_128_GCM ? "AES128-GCM" : (key->alg == TLS_aead_AES_256_GCM ? "AES256-GCM" : "CHACHA20-POLY1305"));
@@ -329,19 +340,8 @@ int MITLS_CALLCONV quic_crypto_decrypt(quic_key *key, unsigned char *plain, uint
 
   uint32_t r = 0, plain_len = cipher_len - quic_crypto_tag_length(key);
 
-  if(key->alg == TLS_aead_AES_128_GCM)
-  {
-    r = EverCrypt_aes128_gcm_decrypt(key->key, iv, (uint8_t*)ad, ad_len, plain, plain_len, (uint8_t*)cipher, (uint8_t*)(cipher+plain_len));
-  }
-  else if(key->alg == TLS_aead_AES_256_GCM)
-  {
-    r = EverCrypt_aes256_gcm_decrypt(key->key, iv, (uint8_t*)ad, ad_len, plain, plain_len, (uint8_t*)cipher, (uint8_t*)(cipher+plain_len));
-  }
-  else if(key->alg == TLS_aead_CHACHA20_POLY1305)
-  {
-    r = 1 - EverCrypt_Chacha20Poly1305_aead_decrypt(key->key, iv, ad_len, (uint8_t*)ad,
-        plain_len, (uint8_t*)plain, cipher, (uint8_t*)(cipher+plain_len));
-  }
+  r = EverCrypt_AEAD_decrypt(key->aead, iv, 12, (uint8_t*)ad, ad_len, (uint8_t*)cipher, plain_len,
+    (uint8_t*)(cipher+plain_len), plain) == EverCrypt_Error_Success;
 
 #if DEBUG
   printf("DECRYPT %X->%X %s\n", cipher, plain, r?"OK":"BAD");
@@ -359,41 +359,238 @@ int MITLS_CALLCONV quic_crypto_decrypt(quic_key *key, unsigned char *plain, uint
 int MITLS_CALLCONV quic_crypto_hp_mask(quic_key *key, const unsigned char *sample, unsigned char *mask)
 {
   unsigned char block[16];
-  if(key->alg == TLS_aead_AES_128_GCM)
+  uint8_t *p = (uint8_t*)sample;
+  if(EverCrypt_AEAD_header_masks(key->hp, 1, &p, block) != EverCrypt_Error_Success)
+    return 0;
+  memcpy(mask, block, 5);
+  return 1;
+}
+
+// Long headers protect the low 4 bits of the first byte, short headers 5
+static inline void hp_apply(unsigned char *packet, uint32_t pn_offset, uint32_t pn_len, const unsigned char *mask)
+{
+  packet[0] ^= mask[0] & (packet[0] & 0x80 ? 0x0f : 0x1f);
+  for(uint32_t i = 0; i < pn_len; i++)
+    packet[pn_offset + i] ^= mask[1 + i];
+}
+
+// RFC 9000, appendix A.3
+static inline uint64_t decode_pn(uint64_t expected, uint64_t truncated, uint32_t pn_len)
+{
+  uint64_t win = (uint64_t)1 << (8 * pn_len);
+  uint64_t hwin = win / 2;
+  uint64_t candidate = (expected & ~(win - 1)) | truncated;
+  if(candidate + hwin <= expected && candidate < ((uint64_t)1 << 62) - win)
+    return candidate + win;
+  if(candidate > expected + hwin && candidate >= win)
+    return candidate - win;
+  return candidate;
+}
+
+int MITLS_CALLCONV quic_crypto_protect_packet(quic_key *key, unsigned char *packet, uint32_t header_len, uint64_t sn, uint32_t plain_len)
+{
+  unsigned char iv[12], mask[5];
+  uint32_t pn_len = (packet[0] & 3) + 1;
+  if(header_len < pn_len + 1 || pn_len + plain_len < 4)
+    return 0;
+
+  memcpy(iv, key->static_iv, 12);
+  sn_to_iv(iv, sn);
+  uint8_t *payload = packet + header_len;
+  if(EverCrypt_AEAD_encrypt(key->aead, iv, 12, packet, header_len, payload, plain_len,
+      payload, payload + plain_len) != EverCrypt_Error_Success)
+    return 0;
+
+  // The sample starts 4 bytes after the packet number, and is still in cache
+  uint32_t pn_offset = header_len - pn_len;
+  if(!quic_crypto_hp_mask(key, packet + pn_offset + 4, mask))
+    return 0;
+  hp_apply(packet, pn_offset, pn_len, mask);
+  return 1;
+}
+
+int MITLS_CALLCONV quic_crypto_unprotect_packet(quic_key *key, unsigned char *packet, uint32_t pn_offset, uint32_t packet_len,
+  uint64_t expected_sn, uint64_t *sn, uint32_t *header_len, uint32_t *plain_len)
+{
+  unsigned char iv[12], mask[5];
+  if(packet_len < pn_offset + 4 + 16 || pn_offset < 1)
+    return 0;
+  if(!quic_crypto_hp_mask(key, packet + pn_offset + 4, mask))
+    return 0;
+
+  // The packet number length is only known once the first byte is unmasked
+  packet[0] ^= mask[0] & (packet[0] & 0x80 ? 0x0f : 0x1f);
+  uint32_t pn_len = (packet[0] & 3) + 1;
+  uint64_t truncated = 0;
+  for(uint32_t i = 0; i < pn_len; i++)
   {
-    EverCrypt_aes128_compute(key->pne.case_aes128, (uint8_t*)sample, block);
-    memcpy(mask, block, 5);
-    return 1;
+    packet[pn_offset + i] ^= mask[1 + i];
+    truncated = (truncated << 8) | packet[pn_offset + i];
   }
 
-  if(key->alg == TLS_aead_AES_256_GCM)
+  uint32_t hlen = pn_offset + pn_len;
+  if(packet_len < hlen + quic_crypto_tag_length(key))
+    return 0;
+  uint32_t plen = packet_len - hlen - quic_crypto_tag_length(key);
+  uint64_t pn = decode_pn(expected_sn, truncated, pn_len);
+
+  memcpy(iv, key->static_iv, 12);
+  sn_to_iv(iv, pn);
+  uint8_t *payload = packet + hlen;
+  if(EverCrypt_AEAD_decrypt(key->aead, iv, 12, packet, hlen, payload, plen,
+      payload + plen, payload) != EverCrypt_Error_Success)
+    return 0;
+
+  *sn = pn;
+  *header_len = hlen;
+  *plain_len = plen;
+  return 1;
+}
+
+// Packets of a train are processed QUIC_BATCH at a time
+#define QUIC_BATCH 64
+
+int MITLS_CALLCONV quic_crypto_encrypt_batch(quic_key *key, uint32_t n, uint64_t first_sn,
+  unsigned char **packet, const uint32_t *header_len, const uint32_t *plain_len)
+{
+  EverCrypt_AEAD_state_s *st[QUIC_BATCH];
+  unsigned char iv[QUIC_BATCH][12], mask[QUIC_BATCH * 16];
+  uint8_t *ivp[QUIC_BATCH], *ad[QUIC_BATCH], *payload[QUIC_BATCH], *tag[QUIC_BATCH], *sample[QUIC_BATCH];
+  uint32_t iv_len[QUIC_BATCH], ad_len[QUIC_BATCH], len[QUIC_BATCH];
+  EverCrypt_Error_error_code res[QUIC_BATCH];
+
+  // Nothing is written unless every packet can be protected
+  for(uint32_t i = 0; i < n; i++)
   {
-    EverCrypt_aes256_compute(key->pne.case_aes256, (uint8_t*)sample, block);
-    memcpy(mask, block, 5);
-    return 1;
+    uint32_t pn_len = (packet[i][0] & 3) + 1;
+    if(header_len[i] < pn_len + 1 || pn_len + plain_len[i] < 4)
+      return 0;
   }
 
-  if(key->alg == TLS_aead_CHACHA20_POLY1305)
+  for(uint32_t i = 0; i < n; i += QUIC_BATCH)
   {
-    uint8_t zero[5] = {0};
-    uint32_t ctr = sample[0] + (sample[1] << 8) + (sample[2] << 16) + (sample[3] << 24);
-
-    EverCrypt_Cipher_chacha20(5, mask, zero, (uint8_t*)key->pne.case_chacha20,
-        (uint8_t*)sample+4, ctr);
-    return 1;
+    uint32_t m = n - i < QUIC_BATCH ? n - i : QUIC_BATCH;
+    for(uint32_t j = 0; j < m; j++)
+    {
+      unsigned char *p = packet[i + j];
+      memcpy(iv[j], key->static_iv, 12);
+      sn_to_iv(iv[j], first_sn + i + j);
+      st[j] = key->aead;
+      ivp[j] = iv[j];
+      iv_len[j] = 12;
+      ad[j] = p;
+      ad_len[j] = header_len[i + j];
+      payload[j] = p + header_len[i + j];
+      len[j] = plain_len[i + j];
+      tag[j] = payload[j] + len[j];
+    }
+    // Counter blocks (AES-GCM) or lanes (ChaCha20) interleave across packets
+    if(EverCrypt_AEAD_encrypt_batch(m, st, ivp, iv_len, ad, ad_len, payload, len, payload, tag, res)
+        != EverCrypt_Error_Success)
+      return 0;
+
+    for(uint32_t j = 0; j < m; j++)
+      sample[j] = packet[i + j] + header_len[i + j] - ((packet[i + j][0] & 3) + 1) + 4;
+    if(EverCrypt_AEAD_header_masks(key->hp, m, sample, mask) != EverCrypt_Error_Success)
+      return 0;
+    for(uint32_t j = 0; j < m; j++)
+    {
+      uint32_t pn_len = (packet[i + j][0] & 3) + 1;
+      hp_apply(packet[i + j], header_len[i + j] - pn_len, pn_len, mask + 16 * j);
+    }
   }
+  return 1;
+}
 
-  return 0;
+int MITLS_CALLCONV quic_crypto_decrypt_batch(quic_key *key, uint32_t n, uint64_t expected_sn,
+  unsigned char **packet, const uint32_t *pn_offset, const uint32_t *packet_len,
+  uint64_t *sn, uint32_t *header_len, uint32_t *plain_len, int *ok)
+{
+  EverCrypt_AEAD_state_s *st[QUIC_BATCH];
+  unsigned char iv[QUIC_BATCH][12], mask[QUIC_BATCH * 16];
+  uint8_t *ivp[QUIC_BATCH], *ad[QUIC_BATCH], *payload[QUIC_BATCH], *tag[QUIC_BATCH], *sample[QUIC_BATCH];
+  uint32_t iv_len[QUIC_BATCH], ad_len[QUIC_BATCH], len[QUIC_BATCH], idx[QUIC_BATCH];
+  EverCrypt_Error_error_code res[QUIC_BATCH];
+  int all = 1;
+
+  for(uint32_t i = 0; i < n; i += QUIC_BATCH)
+  {
+    uint32_t m = n - i < QUIC_BATCH ? n - i : QUIC_BATCH, k = 0;
+    for(uint32_t j = 0; j < m; j++)
+    {
+      ok[i + j] = 0;
+      if(packet_len[i + j] >= pn_offset[i + j] + 4 + 16 && pn_offset[i + j] >= 1)
+      {
+        idx[k] = i + j;
+        sample[k++] = packet[i + j] + pn_offset[i + j] + 4;
+      }
+      else
+        all = 0;
+    }
+    if(EverCrypt_AEAD_header_masks(key->hp, k, sample, mask) != EverCrypt_Error_Success)
+      return 0;
+
+    uint32_t b = 0;
+    for(uint32_t j = 0; j < k; j++)
+    {
+      uint32_t x = idx[j];
+      unsigned char *p = packet[x];
+      const unsigned char *mk = mask + 16 * j;
+      p[0] ^= mk[0] & (p[0] & 0x80 ? 0x0f : 0x1f);
+      uint32_t pn_len = (p[0] & 3) + 1;
+      uint64_t truncated = 0;
+      for(uint32_t l = 0; l < pn_len; l++)
+      {
+        p[pn_offset[x] + l] ^= mk[1 + l];
+        truncated = (truncated << 8) | p[pn_offset[x] + l];
+      }
+      uint32_t hlen = pn_offset[x] + pn_len;
+      if(packet_len[x] < hlen + quic_crypto_tag_length(key))
+      {
+        all = 0;
+        continue;
+      }
+      // Packets of one train are close enough for a single reference
+      sn[x] = decode_pn(expected_sn, truncated, pn_len);
+      header_len[x] = hlen;
+      plain_len[x] = packet_len[x] - hlen - quic_crypto_tag_length(key);
+      memcpy(iv[b], key->static_iv, 12);
+      sn_to_iv(iv[b], sn[x]);
+      st[b] = key->aead;
+      ivp[b] = iv[b];
+      iv_len[b] = 12;
+      ad[b] = p;
+      ad_len[b] = hlen;
+      payload[b] = p + hlen;
+      len[b] = plain_len[x];
+      tag[b] = payload[b] + len[b];
+      idx[b++] = x;
+    }
+    // A packet only counts as opened if decrypt_batch says so; the call
+    // returns the first failure among res, which says which packets failed
+    for(uint32_t j = 0; j < b; j++)
+      res[j] = EverCrypt_Error_AuthenticationFailure;
+    if(EverCrypt_AEAD_decrypt_batch(b, st, ivp, iv_len, ad, ad_len, payload, len, tag, payload, res)
+        != EverCrypt_Error_Success)
+      all = 0;
+    for(uint32_t j = 0; j < b; j++)
+    {
+      ok[idx[j]] = res[j] == EverCrypt_Error_Success;
+      all = all && ok[idx[j]];
+    }
+  }
+  return all;
 }
 
 int MITLS_CALLCONV quic_crypto_free_key(quic_key *key)
 {
   if(key != NULL)
   {
-    if(key->alg == TLS_aead_AES_128_GCM)
-      EverCrypt_aes128_free(key->pne.case_aes128);
-    if(key->alg == TLS_aead_AES_256_GCM)
-      EverCrypt_aes256_free(key->pne.case_aes256);
+    if(key->aead != NULL)
+      EverCrypt_AEAD_free(key->aead);
+    if(key->hp != NULL)
+      EverCrypt_AEAD_free(key->hp);
+    Lib_Memzero0_memzero(key, sizeof(quic_key));
     KRML_HOST_FREE(key);
   }
   return 1;
@@ -73,6 +73,42 @@ int MITLS_CALLCONV quic_crypto_decrypt(quic_key *key, /*out*/ unsigned char *pla
 // 5 bytes will be written to *mask
 int MITLS_CALLCONV quic_crypto_hp_mask(quic_key *key, const unsigned char *sample, unsigned char *mask);
 
+// Packet protection in one call, in place (see quic-tls section 5).
+//
+// protect_packet: packet holds the header_len bytes of the header, which end
+// with the truncated packet number whose length is encoded in the low 2 bits
+// of the first byte, followed by the plain_len bytes of the payload. The
+// payload is encrypted in place with the header as additional data, the tag
+// is appended (the buffer must hold header_len + plain_len + 16 bytes), and
+// header protection is applied to the first byte and the packet number.
+// Fails if the packet is too short to sample (pn_len + plain_len < 4).
+int MITLS_CALLCONV quic_crypto_protect_packet(quic_key *key, /*inout*/ unsigned char *packet, uint32_t header_len, uint64_t sn, uint32_t plain_len);
+
+// unprotect_packet: packet holds a whole protected packet of packet_len bytes,
+// with its packet number at pn_offset. Header protection is removed, the full
+// packet number is recovered from expected_sn (one more than the largest
+// packet number received so far in this space) and returned in sn, and the
+// payload is decrypted in place at packet + header_len, plain_len bytes long.
+// On failure the header may have been unmasked and the packet must be dropped.
+int MITLS_CALLCONV quic_crypto_unprotect_packet(quic_key *key, /*inout*/ unsigned char *packet, uint32_t pn_offset, uint32_t packet_len,
+  uint64_t expected_sn, /*out*/ uint64_t *sn, /*out*/ uint32_t *header_len, /*out*/ uint32_t *plain_len);
+
+// Batched protect_packet/unprotect_packet for the packets of a GSO/GRO
+// train under one key. Packet i of encrypt_batch is laid out as for
+// protect_packet and gets packet number first_sn + i; all masks are
+// computed together, and nothing is written unless every packet is long
+// enough. decrypt_batch opens each packet as unprotect_packet would, all
+// relative to expected_sn, sets ok[i] per packet and returns 1 only if all
+// of them authenticated; packets with ok[i] == 0 must be dropped. As with
+// unprotect_packet, the header of a packet that fails (ok[i] == 0) may
+// already have been unmasked in place, so it cannot be retried.
+int MITLS_CALLCONV quic_crypto_encrypt_batch(quic_key *key, uint32_t n, uint64_t first_sn,
+  /*inout*/ unsigned char **packet, const uint32_t *header_len, const uint32_t *plain_len);
+
+int MITLS_CALLCONV quic_crypto_decrypt_batch(quic_key *key, uint32_t n, uint64_t expected_sn,
+  /*inout*/ unsigned char **packet, const uint32_t *pn_offset, const uint32_t *packet_len,
+  /*out*/ uint64_t *sn, /*out*/ uint32_t *header_len, /*out*/ uint32_t *plain_len, /*out*/ int *ok);
+
 // Keys allocated by quic_crypto_derive_key and quic_crypto_create must be freed
 int MITLS_CALLCONV quic_crypto_free_key(quic_key *key);
 
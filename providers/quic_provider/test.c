@@ -579,6 +579,147 @@ void test_initial_secrets()
     printf("==== PASS: test_initial_secrets ==== \n");
 }
 
+// protect_packet must match the separate encrypt + hp_mask calls, and
+// unprotect_packet must undo it and recover the full packet number.
+void test_protect_packet(const quic_secret *secret)
+{
+    quic_key *key;
+    unsigned char packet[1200], ref[1200], mask[5];
+    uint64_t pn = 0xa82f9b32, out_sn;
+    uint32_t out_hlen, out_plen;
+
+    printf("==== test_protect_packet(%s) ====\n", aead_to_name[secret->ae]);
+
+    if (!quic_crypto_derive_key(&key, secret)) {
+        printf("FAIL: quic_crypto_derive_key failed\n");
+        exit(1);
+    }
+
+    for (uint32_t pn_len = 1; pn_len <= 4; pn_len++) {
+        for (uint32_t long_hdr = 0; long_hdr < 2; long_hdr++) {
+            // First byte, 8-byte connection ID, then the truncated packet number
+            uint32_t hlen = 1 + 8 + pn_len, plen = 3 + 251 * pn_len;
+            packet[0] = (long_hdr ? 0xc0 : 0x40) | (pn_len - 1);
+            memset(packet + 1, 0x5a, 8);
+            for (uint32_t i = 0; i < pn_len; i++)
+                packet[9 + i] = (pn >> (8 * (pn_len - 1 - i))) & 0xff;
+            for (uint32_t i = 0; i < plen; i++)
+                packet[hlen + i] = (unsigned char)(i * 13 + pn_len);
+
+            quic_crypto_encrypt(key, ref + hlen, pn, packet, hlen, packet + hlen, plen);
+            memcpy(ref, packet, hlen);
+            quic_crypto_hp_mask(key, ref + 9 + 4, mask);
+            ref[0] ^= mask[0] & (long_hdr ? 0x0f : 0x1f);
+            for (uint32_t i = 0; i < pn_len; i++)
+                ref[9 + i] ^= mask[1 + i];
+
+            unsigned char payload[1200];
+            memcpy(payload, packet + hlen, plen);
+            if (!quic_crypto_protect_packet(key, packet, hlen, pn, plen)) {
+                printf("FAIL: quic_crypto_protect_packet failed\n");
+                exit(1);
+            }
+            check_result("quic_crypto_protect_packet", packet, ref, hlen + plen + 16);
+
+            // The receiver has seen packets up to just below pn
+            if (!quic_crypto_unprotect_packet(key, packet, 9, hlen + plen + 16, pn - 7, &out_sn, &out_hlen, &out_plen)
+                || out_sn != pn || out_hlen != hlen || out_plen != plen) {
+                printf("FAIL: quic_crypto_unprotect_packet failed\n");
+                exit(1);
+            }
+            check_result("quic_crypto_unprotect_packet", packet + hlen, payload, plen);
+
+            memcpy(packet, ref, hlen + plen + 16);
+            packet[hlen + plen / 2] ^= 1;
+            if (quic_crypto_unprotect_packet(key, packet, 9, hlen + plen + 16, pn, &out_sn, &out_hlen, &out_plen)) {
+                printf("FAIL: quic_crypto_unprotect_packet accepted a forgery\n");
+                exit(1);
+            }
+        }
+    }
+
+    // Too short to sample
+    packet[0] = 0x40;
+    if (quic_crypto_protect_packet(key, packet, 10, pn, 2)) {
+        printf("FAIL: quic_crypto_protect_packet accepted a short packet\n");
+        exit(1);
+    }
+
+    quic_crypto_free_key(key);
+    printf("==== PASS: test_protect_packet ==== \n");
+}
+
+// A GSO train sealed with encrypt_batch must match packet-by-packet
+// protection, and decrypt_batch must flag exactly the damaged packets.
+#define TRAIN 70
+
+void test_packet_batch(const quic_secret *secret)
+{
+    quic_key *key;
+    static unsigned char train[TRAIN][1400], ref[TRAIN][1400], payload[TRAIN][1400];
+    unsigned char *pkt[TRAIN];
+    uint32_t hlen[TRAIN], plen[TRAIN], pn_off[TRAIN], plen_tot[TRAIN], out_hlen[TRAIN], out_plen[TRAIN];
+    uint64_t out_sn[TRAIN], first = 0x1234567;
+    int ok[TRAIN];
+
+    printf("==== test_packet_batch(%s) ====\n", aead_to_name[secret->ae]);
+
+    if (!quic_crypto_derive_key(&key, secret)) {
+        printf("FAIL: quic_crypto_derive_key failed\n");
+        exit(1);
+    }
+
+    for (uint32_t i = 0; i < TRAIN; i++) {
+        uint32_t pn_len = 1 + i % 4;
+        uint64_t pn = first + i;
+        hlen[i] = 1 + 8 + pn_len;
+        pn_off[i] = 9;
+        // Equal-sized segments but a shorter last one, as GSO sends them
+        plen[i] = i == TRAIN - 1 ? 7 : 1200 - hlen[i];
+        plen_tot[i] = hlen[i] + plen[i] + 16;
+        train[i][0] = 0x40 | (pn_len - 1);
+        memset(train[i] + 1, 0xa5, 8);
+        for (uint32_t j = 0; j < pn_len; j++)
+            train[i][9 + j] = (pn >> (8 * (pn_len - 1 - j))) & 0xff;
+        for (uint32_t j = 0; j < plen[i]; j++)
+            train[i][hlen[i] + j] = (unsigned char)(i + 3 * j);
+        memcpy(payload[i], train[i] + hlen[i], plen[i]);
+        memcpy(ref[i], train[i], hlen[i] + plen[i]);
+        quic_crypto_protect_packet(key, ref[i], hlen[i], pn, plen[i]);
+        pkt[i] = train[i];
+    }
+
+    if (!quic_crypto_encrypt_batch(key, TRAIN, first, pkt, hlen, plen)) {
+        printf("FAIL: quic_crypto_encrypt_batch failed\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < TRAIN; i++)
+        check_result("quic_crypto_encrypt_batch", train[i], ref[i], plen_tot[i]);
+
+    train[3][hlen[3] + 5] ^= 1;
+    train[66][plen_tot[66] - 1] ^= 1;
+    if (quic_crypto_decrypt_batch(key, TRAIN, first, pkt, pn_off, plen_tot, out_sn, out_hlen, out_plen, ok)) {
+        printf("FAIL: quic_crypto_decrypt_batch accepted a forgery\n");
+        exit(1);
+    }
+    for (uint32_t i = 0; i < TRAIN; i++) {
+        if (ok[i] != (i != 3 && i != 66)) {
+            printf("FAIL: quic_crypto_decrypt_batch packet %u\n", i);
+            exit(1);
+        }
+        if (ok[i]) {
+            if (out_sn[i] != first + i || out_hlen[i] != hlen[i] || out_plen[i] != plen[i]) {
+                printf("FAIL: quic_crypto_decrypt_batch packet %u header\n", i);
+                exit(1);
+            }
+            check_result("quic_crypto_decrypt_batch", train[i] + hlen[i], payload[i], plen[i]);
+        }
+    }
+
+    quic_crypto_free_key(key);
+    printf("==== PASS: test_packet_batch ==== \n");
+}
+
 void exhaustive(void)
 {
     quic_secret secret;
@@ -594,6 +735,13 @@ void exhaustive(void)
         test_crypto(&secret, testcombinations[i].expected_cipher);
     }
 
+    for (size_t i=0; i<3; ++i) {
+        secret.hash = TLS_hash_SHA256;
+        secret.ae = testcombinations[3*i].ae;
+        test_protect_packet(&secret);
+        test_packet_batch(&secret);
+    }
+
     test_pn_encrypt();
     test_initial_secrets();
 }
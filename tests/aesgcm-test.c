@@ -0,0 +1,560 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "test_helpers.h"
+
+#include "EverCrypt_AEAD.h"
+#include "EverCrypt_AutoConfig2.h"
+
+#include "aesgcm_vectors.h"
+
+#define THREADS 4
+#define ROUNDS  2000
+#define SIZE    1024
+
+bool print_test(aesgcm_test_vector *v) {
+  EverCrypt_AEAD_state_s *s = NULL;
+  if (EverCrypt_AEAD_create_in(v->alg, &s, v->key) != EverCrypt_Error_Success) {
+    printf("AES-GCM not supported on this platform, skipping\n");
+    return true;
+  }
+  uint8_t cipher[v->input_len];
+  uint8_t plain[v->input_len];
+  uint8_t tag[16] = {0};
+  EverCrypt_AEAD_encrypt(s, v->iv, 12, v->aad, v->aad_len, v->input, v->input_len, cipher, tag);
+  printf("AES-GCM Result (cipher):\n");
+  bool ok = compare_and_print(v->input_len, cipher, v->cipher);
+  printf("(tag):\n");
+  ok = compare_and_print(16, tag, v->tag) && ok;
+  EverCrypt_Error_error_code r =
+    EverCrypt_AEAD_decrypt(s, v->iv, 12, v->aad, v->aad_len, v->cipher, v->input_len, v->tag, plain);
+  ok = ok && r == EverCrypt_Error_Success;
+  ok = ok && compare_and_print(v->input_len, plain, v->input);
+  EverCrypt_AEAD_free(s);
+  return ok;
+}
+
+// One key object, shared read-only by all threads.
+static EverCrypt_AEAD_state_s *shared;
+static uint8_t plain[SIZE];
+static uint8_t aad[SIZE];
+static uint8_t expected[SIZE][SIZE + 16];
+
+static void *worker(void *arg) {
+  uintptr_t t = (uintptr_t)arg;
+  uint8_t cipher[SIZE];
+  uint8_t dec[SIZE];
+  uint8_t tag[16];
+  uint8_t iv[12] = {0};
+  bool ok = true;
+  for (uint32_t r = 0; r < ROUNDS; r++) {
+    uint32_t len = (r * 37 + t * 101) % SIZE;
+    iv[0] = (uint8_t)len;
+    iv[1] = (uint8_t)(len >> 8);
+    EverCrypt_AEAD_encrypt(shared, iv, 12, aad, len % 61, plain, len, cipher, tag);
+    ok = ok && memcmp(cipher, expected[len], len) == 0;
+    ok = ok && memcmp(tag, expected[len] + len, 16) == 0;
+    ok = ok && EverCrypt_AEAD_decrypt(shared, iv, 12, aad, len % 61, cipher, len, tag, dec)
+      == EverCrypt_Error_Success;
+    ok = ok && memcmp(dec, plain, len) == 0;
+  }
+  return ok ? arg : NULL;
+}
+
+bool test_shared_key() {
+  uint8_t key[16];
+  uint8_t iv[12] = {0};
+  memset(key, 0x5a, 16);
+  if (EverCrypt_AEAD_create_in(Spec_Agile_AEAD_AES128_GCM, &shared, key) != EverCrypt_Error_Success)
+    return true;
+  for (uint32_t i = 0; i < SIZE; i++) {
+    plain[i] = (uint8_t)i;
+    aad[i] = (uint8_t)(3 * i);
+  }
+  for (uint32_t len = 0; len < SIZE; len++) {
+    iv[0] = (uint8_t)len;
+    iv[1] = (uint8_t)(len >> 8);
+    EverCrypt_AEAD_encrypt(shared, iv, 12, aad, len % 61, plain, len, expected[len], expected[len] + len);
+  }
+  pthread_t th[THREADS];
+  for (uintptr_t t = 0; t < THREADS; t++)
+    pthread_create(&th[t], NULL, worker, (void *)(t + 1));
+  bool ok = true;
+  for (uintptr_t t = 0; t < THREADS; t++) {
+    void *res;
+    pthread_join(th[t], &res);
+    ok = ok && res != NULL;
+  }
+  EverCrypt_AEAD_free(shared);
+  return ok;
+}
+
+// The implementation picked before and after calling disable must agree on
+// every length, with short and long IVs.
+bool test_cross(Spec_Agile_AEAD_alg alg, void (*disable)(void)) {
+  uint8_t key[32];
+  uint8_t iv[20];
+  uint8_t c1[SIZE], c2[SIZE], d[SIZE];
+  uint8_t t1[16], t2[16];
+  memset(key, 0xa7, 32);
+  for (uint32_t i = 0; i < 20; i++)
+    iv[i] = (uint8_t)(7 * i);
+  EverCrypt_AEAD_state_s *vale = NULL, *ct = NULL;
+  if (EverCrypt_AEAD_create_in(alg, &vale, key) != EverCrypt_Error_Success)
+    return true;
+  disable();
+  EverCrypt_AEAD_create_in(alg, &ct, key);
+  bool ok = true;
+  for (uint32_t len = 0; len < SIZE; len++) {
+    uint32_t iv_len = len % 3 == 0 ? 20 : 12;
+    EverCrypt_AEAD_encrypt(vale, iv, iv_len, aad, len % 41, plain, len, c1, t1);
+    EverCrypt_AEAD_encrypt(ct, iv, iv_len, aad, len % 41, plain, len, c2, t2);
+    ok = ok && memcmp(c1, c2, len) == 0 && memcmp(t1, t2, 16) == 0;
+    ok = ok && EverCrypt_AEAD_decrypt(ct, iv, iv_len, aad, len % 41, c1, len, t1, d)
+      == EverCrypt_Error_Success && memcmp(d, plain, len) == 0;
+    t1[len % 16] ^= 1;
+    ok = ok && EverCrypt_AEAD_decrypt(ct, iv, iv_len, aad, len % 41, c1, len, t1, d)
+      == EverCrypt_Error_AuthenticationFailure;
+  }
+  EverCrypt_AEAD_free(vale);
+  EverCrypt_AEAD_free(ct);
+  return ok;
+}
+
+#define BATCH  32
+#define MAXLEN 1300
+
+static uint8_t b_iv[BATCH][16];
+static uint8_t b_plain[BATCH][MAXLEN];
+static uint8_t b_cipher[BATCH][MAXLEN];
+static uint8_t b_dec[BATCH][MAXLEN];
+static uint8_t b_tag[BATCH][16];
+static EverCrypt_AEAD_state_s *b_s[BATCH];
+static uint8_t *ivp[BATCH], *adp[BATCH], *pp[BATCH], *cp[BATCH], *dp[BATCH], *tp[BATCH];
+static uint32_t iv_len[BATCH], ad_len[BATCH], mlen[BATCH];
+static EverCrypt_Error_error_code res[BATCH];
+
+// Records of a batch mix key sizes, algorithms and IV lengths, and each one
+// must match the single-record API, including records that fail to open.
+bool test_batch() {
+  Spec_Agile_AEAD_alg algs[3] =
+    { Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305 };
+  uint8_t key[32];
+  bool ok = true;
+  for (uint32_t i = 0; i < BATCH; i++) {
+    memset(key, (uint8_t)(i + 1), 32);
+    // Runs of the same algorithm, broken up now and then
+    EverCrypt_AEAD_create_in(algs[(i / 7 + (i % 5 == 4)) % 3], &b_s[i], key);
+    for (uint32_t j = 0; j < 16; j++)
+      b_iv[i][j] = (uint8_t)(i + 3 * j);
+    for (uint32_t j = 0; j < MAXLEN; j++)
+      b_plain[i][j] = (uint8_t)(i * j + 1);
+    iv_len[i] = i == 8 ? 16 : 12;
+    ad_len[i] = (i * 13) % 61;
+    mlen[i] = (i * i * 53) % MAXLEN;
+    ivp[i] = b_iv[i]; adp[i] = aad; pp[i] = b_plain[i];
+    cp[i] = b_cipher[i]; dp[i] = b_dec[i]; tp[i] = b_tag[i];
+  }
+  ok = ok && EverCrypt_AEAD_encrypt_batch(BATCH, b_s, ivp, iv_len, adp, ad_len, pp, mlen, cp, tp, res)
+    == EverCrypt_Error_Success;
+  for (uint32_t i = 0; i < BATCH; i++) {
+    uint8_t c[MAXLEN], t[16];
+    EverCrypt_Error_error_code r =
+      EverCrypt_AEAD_encrypt(b_s[i], ivp[i], iv_len[i], adp[i], ad_len[i], pp[i], mlen[i], c, t);
+    ok = ok && r == res[i] && memcmp(c, cp[i], mlen[i]) == 0 && memcmp(t, tp[i], 16) == 0;
+  }
+  ok = ok && EverCrypt_AEAD_decrypt_batch(BATCH, b_s, ivp, iv_len, adp, ad_len, cp, mlen, tp, dp, res)
+    == EverCrypt_Error_Success;
+  for (uint32_t i = 0; i < BATCH; i++)
+    ok = ok && res[i] == EverCrypt_Error_Success && memcmp(dp[i], pp[i], mlen[i]) == 0;
+
+  b_tag[2][5] ^= 1;
+  b_cipher[8][0] ^= 1;
+  b_cipher[16][mlen[16] - 1] ^= 1;
+  iv_len[20] = 0;
+  ok = ok && EverCrypt_AEAD_decrypt_batch(BATCH, b_s, ivp, iv_len, adp, ad_len, cp, mlen, tp, dp, res)
+    == EverCrypt_Error_AuthenticationFailure;
+  for (uint32_t i = 0; i < BATCH; i++) {
+    EverCrypt_Error_error_code r =
+      EverCrypt_AEAD_decrypt(b_s[i], ivp[i], iv_len[i], adp[i], ad_len[i], cp[i], mlen[i], tp[i], b_dec[0]);
+    ok = ok && r == res[i];
+    ok = ok && (r != EverCrypt_Error_Success) == (i == 2 || i == 8 || i == 16 || i == 20);
+  }
+  for (uint32_t i = 0; i < BATCH; i++)
+    EverCrypt_AEAD_free(b_s[i]);
+  return ok;
+}
+
+// Per-record cost of sealing BATCH AES128-GCM records of the same size, one
+// by one and batched.
+void print_batch_perf(const char *name, uint32_t len) {
+  uint8_t key[16] = {0};
+  EverCrypt_AEAD_state_s *st[BATCH];
+  for (uint32_t i = 0; i < BATCH; i++) {
+    key[0] = (uint8_t)i;
+    EverCrypt_AEAD_create_in(Spec_Agile_AEAD_AES128_GCM, &st[i], key);
+    mlen[i] = len;
+    ad_len[i] = 20;
+    iv_len[i] = 12;
+  }
+  cycles a, b;
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS / 10; j++)
+    for (uint32_t i = 0; i < BATCH; i++)
+      EverCrypt_AEAD_encrypt(st[i], ivp[i], 12, adp[i], 20, pp[i], len, cp[i], tp[i]);
+  b = cpucycles_end();
+  uint64_t single = (uint64_t)(b - a) / (ROUNDS / 10 * BATCH);
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS / 10; j++)
+    EverCrypt_AEAD_encrypt_batch(BATCH, st, ivp, iv_len, adp, ad_len, pp, mlen, cp, tp, res);
+  b = cpucycles_end();
+  uint64_t batch = (uint64_t)(b - a) / (ROUNDS / 10 * BATCH);
+  printf("AES128-GCM (%s) %4" PRIu32 "-byte records PERF: %" PRIu64 " cycles/record, batched: %" PRIu64 " cycles/record\n",
+    name, len, single, batch);
+  for (uint32_t i = 0; i < BATCH; i++)
+    EverCrypt_AEAD_free(st[i]);
+}
+
+// Header-protection masks: the RFC 9001 appendix A samples, then batches of
+// every length up to 37 against one-sample calls.
+bool test_header_masks() {
+  uint8_t aes_key[16] = { 0x9f,0x50,0x44,0x9e,0x04,0xa0,0xe8,0x10,0x28,0x3a,0x1e,0x99,0x33,0xad,0xed,0xd2 };
+  uint8_t aes_sample[16] = { 0xd1,0xb1,0xc9,0x8d,0xd7,0x68,0x9f,0xb8,0xec,0x11,0xd2,0x42,0xb1,0x23,0xdc,0x9b };
+  uint8_t aes_mask[5] = { 0x43,0x7b,0x9a,0xec,0x36 };
+  uint8_t chacha_key[32] = {
+    0x25,0xa2,0x82,0xb9,0xe8,0x2f,0x06,0xf2,0x1f,0x48,0x89,0x17,0xa4,0xfc,0x8f,0x1b,
+    0x73,0x57,0x36,0x85,0x60,0x85,0x97,0xd0,0xef,0xcb,0x07,0x6b,0x0a,0xb7,0xa7,0xa4 };
+  uint8_t chacha_sample[16] = { 0x5e,0x5c,0xd5,0x5c,0x41,0xf6,0x90,0x80,0x57,0x5d,0x79,0x99,0xc2,0x5a,0x5b,0xfb };
+  uint8_t chacha_mask[5] = { 0xae,0xfe,0xfe,0x7d,0x03 };
+  Spec_Agile_AEAD_alg algs[3] =
+    { Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305 };
+  uint8_t *sample[37];
+  static uint8_t samples[37][16], mask[37 * 16], one[16];
+  bool ok = true;
+
+  EverCrypt_AEAD_state_s *s = NULL;
+  uint8_t *p = aes_sample;
+  EverCrypt_AEAD_create_in(Spec_Agile_AEAD_AES128_GCM, &s, aes_key);
+  ok = ok && EverCrypt_AEAD_header_masks(s, 1, &p, mask) == EverCrypt_Error_Success;
+  ok = ok && memcmp(mask, aes_mask, 5) == 0;
+  EverCrypt_AEAD_free(s);
+  p = chacha_sample;
+  EverCrypt_AEAD_create_in(Spec_Agile_AEAD_CHACHA20_POLY1305, &s, chacha_key);
+  ok = ok && EverCrypt_AEAD_header_masks(s, 1, &p, mask) == EverCrypt_Error_Success;
+  ok = ok && memcmp(mask, chacha_mask, 5) == 0;
+  EverCrypt_AEAD_free(s);
+
+  for (uint32_t i = 0; i < 37; i++) {
+    for (uint32_t j = 0; j < 16; j++)
+      samples[i][j] = (uint8_t)(i * 31 + j * 7);
+    // Not in order, as samples from the packets of a train need not be
+    sample[i] = samples[(i * 5) % 37];
+  }
+  for (uint32_t a = 0; a < 3; a++) {
+    EverCrypt_AEAD_create_in(algs[a], &s, chacha_key);
+    for (uint32_t n = 0; n <= 37; n++) {
+      memset(mask, 0, sizeof(mask));
+      ok = ok && EverCrypt_AEAD_header_masks(s, n, sample, mask) == EverCrypt_Error_Success;
+      for (uint32_t i = 0; i < n; i++) {
+        EverCrypt_AEAD_header_masks(s, 1, sample + i, one);
+        ok = ok && memcmp(one, mask + 16 * i, 16) == 0;
+      }
+      for (uint32_t i = 16 * n; i < sizeof(mask); i++)
+        ok = ok && mask[i] == 0;
+    }
+    EverCrypt_AEAD_free(s);
+  }
+  return ok;
+}
+
+// Cuts len bytes of buf into segments of pseudo-random lengths, empty and
+// one-byte segments included; returns the number of segments.
+static uint32_t split(EverCrypt_AEAD_iovec *v, uint8_t *buf, uint32_t len, uint32_t seed) {
+  uint32_t n = 0, pos = 0;
+  while (pos < len) {
+    seed = seed * 1103515245 + 12345;
+    uint32_t l = (seed >> 16) % 5 == 0 ? (seed >> 8) % 2 : (seed >> 16) % 300;
+    if (l > len - pos) l = len - pos;
+    v[n].base = buf + pos; v[n].len = l;
+    n++; pos += l;
+  }
+  return n;
+}
+
+// Scattered records must seal and open exactly like contiguous ones, whatever
+// the cut points of the AAD, the input and the output.
+bool test_iovec() {
+  Spec_Agile_AEAD_alg algs[3] =
+    { Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305 };
+  static EverCrypt_AEAD_iovec va[MAXLEN], vp[MAXLEN], vc[MAXLEN], vd[MAXLEN];
+  uint8_t key[32];
+  bool ok = true;
+  for (uint32_t i = 0; i < BATCH; i++) {
+    EverCrypt_AEAD_state_s *s = NULL;
+    memset(key, (uint8_t)(i + 7), 32);
+    EverCrypt_AEAD_create_in(algs[i % 3], &s, key);
+    uint32_t ivl = i % 3 != 2 && i % 4 == 1 ? 16 : 12;
+    uint32_t al = (i * 37) % 200;
+    uint32_t ml = (i * i * 71) % MAXLEN;
+    for (uint32_t j = 0; j < 16; j++)
+      b_iv[i][j] = (uint8_t)(i * j + 5);
+    for (uint32_t j = 0; j < ml; j++)
+      b_plain[i][j] = (uint8_t)(i + 7 * j);
+    uint8_t c[MAXLEN], t[16], tv[16];
+    EverCrypt_AEAD_encrypt(s, b_iv[i], ivl, aad, al, b_plain[i], ml, c, t);
+
+    uint32_t na = split(va, aad, al, i);
+    uint32_t np = split(vp, b_plain[i], ml, 2 * i + 1);
+    uint32_t nc = split(vc, b_cipher[i], ml, 3 * i + 2);
+    ok = ok && EverCrypt_AEAD_encryptv(s, b_iv[i], ivl, va, na, vp, np, vc, nc, tv) == EverCrypt_Error_Success;
+    ok = ok && memcmp(c, b_cipher[i], ml) == 0 && memcmp(t, tv, 16) == 0;
+
+    // In place, over the same segments
+    memcpy(b_dec[i], b_plain[i], ml);
+    np = split(vd, b_dec[i], ml, 5 * i);
+    ok = ok && EverCrypt_AEAD_encryptv(s, b_iv[i], ivl, va, na, vd, np, vd, np, tv) == EverCrypt_Error_Success;
+    ok = ok && memcmp(c, b_dec[i], ml) == 0 && memcmp(t, tv, 16) == 0;
+    ok = ok && EverCrypt_AEAD_decryptv(s, b_iv[i], ivl, va, na, vd, np, t, vd, np) == EverCrypt_Error_Success;
+    ok = ok && memcmp(b_plain[i], b_dec[i], ml) == 0;
+
+    // A bad tag leaves the destination alone
+    memset(b_dec[i], 0xAA, ml);
+    np = split(vd, b_dec[i], ml, 7 * i);
+    t[i % 16] ^= 1;
+    ok = ok && EverCrypt_AEAD_decryptv(s, b_iv[i], ivl, va, na, vc, nc, t, vd, np) == EverCrypt_Error_AuthenticationFailure;
+    for (uint32_t j = 0; j < ml; j++)
+      ok = ok && b_dec[i][j] == 0xAA;
+    t[i % 16] ^= 1;
+    ok = ok && EverCrypt_AEAD_decryptv(s, b_iv[i], ivl, va, na, vc, nc, t, vd, np) == EverCrypt_Error_Success;
+    ok = ok && memcmp(b_plain[i], b_dec[i], ml) == 0;
+    if (ml > 0)
+      ok = ok && EverCrypt_AEAD_decryptv(s, b_iv[i], ivl, va, na, vc, nc, t, vd, np - 1) == EverCrypt_Error_DecodeError;
+    EverCrypt_AEAD_free(s);
+  }
+
+  // More than one IV can cover is rejected up front; the segments are never read
+  uint8_t t[16] = {0};
+  for (uint32_t i = 0; i < 65; i++) {
+    vd[i].base = b_dec[0]; vd[i].len = 0xffffffffU;
+  }
+  for (uint32_t i = 0; i < 3; i++) {
+    EverCrypt_AEAD_state_s *s = NULL;
+    EverCrypt_AEAD_create_in(algs[i], &s, key);
+    uint32_t n = i == 2 ? 65 : 17;
+    ok = ok && EverCrypt_AEAD_encryptv(s, b_iv[0], 12, NULL, 0, vd, n, vd, n, t) == EverCrypt_Error_DecodeError;
+    ok = ok && EverCrypt_AEAD_decryptv(s, b_iv[0], 12, NULL, 0, vd, n, t, vd, n) == EverCrypt_Error_DecodeError;
+    EverCrypt_AEAD_free(s);
+  }
+  return ok;
+}
+
+// A 16 KiB AES128-GCM record, contiguous and as 1500-byte segments
+void print_iovec_perf(const char *name) {
+  uint8_t key[16] = {0};
+  uint8_t iv[12] = {0};
+  uint8_t tag[16];
+  static uint8_t buf[16384];
+  static EverCrypt_AEAD_iovec v[16];
+  uint32_t n;
+  for (n = 0; n * 1500 < sizeof(buf); n++) {
+    v[n].base = buf + n * 1500;
+    v[n].len = sizeof(buf) - n * 1500 < 1500 ? sizeof(buf) - n * 1500 : 1500;
+  }
+  EverCrypt_AEAD_state_s *s = NULL;
+  EverCrypt_AEAD_create_in(Spec_Agile_AEAD_AES128_GCM, &s, key);
+  cycles a, b;
+  a = cpucycles_begin();
+  for (int j = 0; j < 100; j++)
+    EverCrypt_AEAD_encryptv(s, iv, 12, NULL, 0, v, n, v, n, tag);
+  b = cpucycles_end();
+  printf("AES128-GCM (%s) encryptv PERF: %.2f cycles/byte\n", name, (double)(b - a) / (100.0 * sizeof(buf)));
+  EverCrypt_AEAD_free(s);
+}
+
+// A record fed to a streaming context in pieces of pseudo-random sizes must
+// seal and open like the one-shot API.
+bool test_streaming() {
+  Spec_Agile_AEAD_alg algs[3] =
+    { Spec_Agile_AEAD_AES128_GCM, Spec_Agile_AEAD_AES256_GCM, Spec_Agile_AEAD_CHACHA20_POLY1305 };
+  static EverCrypt_AEAD_iovec va[MAXLEN], vp[MAXLEN];
+  uint8_t key[32];
+  bool ok = true;
+  EverCrypt_AEAD_streaming_state_s *st = NULL;
+  for (uint32_t i = 0; i < BATCH; i++) {
+    EverCrypt_AEAD_state_s *s = NULL;
+    memset(key, (uint8_t)(i + 9), 32);
+    EverCrypt_AEAD_create_in(algs[i % 3], &s, key);
+    uint32_t ivl = i % 3 != 2 && i % 4 == 3 ? 16 : 12;
+    uint32_t al = (i * 41) % 200;
+    uint32_t ml = (i * i * 67) % MAXLEN;
+    for (uint32_t j = 0; j < 16; j++)
+      b_iv[i][j] = (uint8_t)(i * j + 11);
+    for (uint32_t j = 0; j < ml; j++)
+      b_plain[i][j] = (uint8_t)(i + 5 * j);
+    uint8_t c[MAXLEN], t[16], ts[16];
+    EverCrypt_AEAD_encrypt(s, b_iv[i], ivl, aad, al, b_plain[i], ml, c, t);
+
+    uint32_t na = split(va, aad, al, i + 1);
+    uint32_t np = split(vp, b_plain[i], ml, 3 * i);
+    // The first message allocates, the others reuse the context
+    if (i == 0)
+      ok = ok && EverCrypt_AEAD_streaming_create_in(s, b_iv[i], ivl, &st) == EverCrypt_Error_Success;
+    else
+      ok = ok && EverCrypt_AEAD_streaming_init(st, s, b_iv[i], ivl) == EverCrypt_Error_Success;
+    for (uint32_t j = 0; j < na; j++)
+      ok = ok && EverCrypt_AEAD_streaming_update_aad(st, va[j].base, va[j].len) == EverCrypt_Error_Success;
+    for (uint32_t j = 0; j < np; j++)
+      ok = ok && EverCrypt_AEAD_streaming_encrypt_update(st, vp[j].base, vp[j].len,
+        b_cipher[i] + (vp[j].base - b_plain[i])) == EverCrypt_Error_Success;
+    if (ml > 0) {
+      uint8_t x = 0;
+      ok = ok && EverCrypt_AEAD_streaming_update_aad(st, aad, 1) == EverCrypt_Error_DecodeError;
+      ok = ok && EverCrypt_AEAD_streaming_decrypt_update(st, &x, 1, &x) == EverCrypt_Error_DecodeError;
+      ok = ok && EverCrypt_AEAD_streaming_decrypt_finish(st, t) == EverCrypt_Error_DecodeError;
+    }
+    ok = ok && EverCrypt_AEAD_streaming_encrypt_finish(st, ts) == EverCrypt_Error_Success;
+    ok = ok && memcmp(c, b_cipher[i], ml) == 0 && memcmp(t, ts, 16) == 0;
+    // Once finished, the context only accepts init
+    ok = ok && EverCrypt_AEAD_streaming_update_aad(st, aad, 1) == EverCrypt_Error_DecodeError;
+    ok = ok && EverCrypt_AEAD_streaming_encrypt_update(st, aad, 1, ts) == EverCrypt_Error_DecodeError;
+    ok = ok && EverCrypt_AEAD_streaming_encrypt_finish(st, ts) == EverCrypt_Error_DecodeError;
+    ok = ok && memcmp(t, ts, 16) == 0;
+
+    for (int bad = 0; bad < 2; bad++) {
+      t[i % 16] ^= (uint8_t)bad;
+      np = split(vp, b_cipher[i], ml, 5 * i + bad);
+      ok = ok && EverCrypt_AEAD_streaming_init(st, s, b_iv[i], ivl) == EverCrypt_Error_Success;
+      for (uint32_t j = 0; j < na; j++)
+        EverCrypt_AEAD_streaming_update_aad(st, va[j].base, va[j].len);
+      for (uint32_t j = 0; j < np; j++)
+        EverCrypt_AEAD_streaming_decrypt_update(st, vp[j].base, vp[j].len,
+          b_dec[i] + (vp[j].base - b_cipher[i]));
+      EverCrypt_Error_error_code r = EverCrypt_AEAD_streaming_decrypt_finish(st, t);
+      ok = ok && r == (bad ? EverCrypt_Error_AuthenticationFailure : EverCrypt_Error_Success);
+      ok = ok && memcmp(b_plain[i], b_dec[i], ml) == 0;
+      t[i % 16] ^= (uint8_t)bad;
+    }
+    EverCrypt_AEAD_free(s);
+  }
+  EverCrypt_AEAD_streaming_free(st);
+  return ok;
+}
+
+// A 16 KiB AES128-GCM record, fed 1500 bytes at a time
+void print_streaming_perf(const char *name) {
+  uint8_t key[16] = {0};
+  uint8_t iv[12] = {0};
+  uint8_t tag[16];
+  static uint8_t buf[16384];
+  EverCrypt_AEAD_state_s *s = NULL;
+  EverCrypt_AEAD_streaming_state_s *st = NULL;
+  EverCrypt_AEAD_create_in(Spec_Agile_AEAD_AES128_GCM, &s, key);
+  EverCrypt_AEAD_streaming_create_in(s, iv, 12, &st);
+  cycles a, b;
+  a = cpucycles_begin();
+  for (int j = 0; j < 100; j++) {
+    EverCrypt_AEAD_streaming_init(st, s, iv, 12);
+    for (uint32_t pos = 0; pos < sizeof(buf); pos += 1500) {
+      uint32_t n = sizeof(buf) - pos < 1500 ? sizeof(buf) - pos : 1500;
+      EverCrypt_AEAD_streaming_encrypt_update(st, buf + pos, n, buf + pos);
+    }
+    EverCrypt_AEAD_streaming_encrypt_finish(st, tag);
+  }
+  b = cpucycles_end();
+  printf("AES128-GCM (%s) streaming PERF: %.2f cycles/byte\n", name, (double)(b - a) / (100.0 * sizeof(buf)));
+  EverCrypt_AEAD_streaming_free(st);
+  EverCrypt_AEAD_free(s);
+}
+
+void print_perf(const char *name) {
+  uint8_t key[16] = {0};
+  uint8_t iv[12] = {0};
+  uint8_t tag[16];
+  static uint8_t buf[16384];
+  EverCrypt_AEAD_state_s *s = NULL;
+  EverCrypt_AEAD_create_in(Spec_Agile_AEAD_AES128_GCM, &s, key);
+  cycles a, b;
+  a = cpucycles_begin();
+  for (int j = 0; j < 100; j++)
+    EverCrypt_AEAD_encrypt(s, iv, 12, NULL, 0, buf, sizeof(buf), buf, tag);
+  b = cpucycles_end();
+  printf("AES128-GCM (%s) PERF: %.2f cycles/byte\n", name, (double)(b - a) / (100.0 * sizeof(buf)));
+  EverCrypt_AEAD_free(s);
+}
+
+bool test_all(const char *name) {
+  bool ok = true;
+  for (int i = 0; i < sizeof(vectors)/sizeof(aesgcm_test_vector); ++i) {
+    ok &= print_test(&vectors[i]);
+  }
+
+  bool b = test_shared_key();
+  printf("AES-GCM (%s) shared key (%d threads) Result: %s\n", name, THREADS, b ? "Success!" : "**FAILED**");
+  bool c = test_batch();
+  printf("AES-GCM (%s) batch Result: %s\n", name, c ? "Success!" : "**FAILED**");
+  bool h = test_header_masks();
+  printf("AEAD (%s) header masks Result: %s\n", name, h ? "Success!" : "**FAILED**");
+  bool d = test_iovec();
+  printf("AEAD (%s) encryptv/decryptv Result: %s\n", name, d ? "Success!" : "**FAILED**");
+  bool e = test_streaming();
+  printf("AEAD (%s) streaming Result: %s\n", name, e ? "Success!" : "**FAILED**");
+  print_perf(name);
+  print_iovec_perf(name);
+  print_streaming_perf(name);
+  print_batch_perf(name, 64);
+  print_batch_perf(name, 256);
+  print_batch_perf(name, 1200);
+  return ok && b && c && d && e && h;
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+
+  bool ok = true;
+  bool b = true;
+  if (EverCrypt_AutoConfig2_has_vaes()) {
+    ok = test_all("VAES");
+    b = test_cross(Spec_Agile_AEAD_AES128_GCM, EverCrypt_AutoConfig2_disable_vaes);
+    EverCrypt_AutoConfig2_init();
+    b = b && test_cross(Spec_Agile_AEAD_AES256_GCM, EverCrypt_AutoConfig2_disable_vaes);
+    printf("AES-GCM VAES vs Vale Result: %s\n", b ? "Success!" : "**FAILED**");
+    ok = ok && b;
+  }
+
+  ok = test_all("Vale") && ok;
+
+  // Without AES-NI, AES-GCM is unsupported unless unverified code is allowed
+  EverCrypt_AutoConfig2_disable_vaes();
+  EverCrypt_AutoConfig2_disable_aesni();
+  EverCrypt_AEAD_state_s *none = NULL;
+  uint8_t key[32] = { 0U }, iv[12] = { 0U }, c[16], t[16];
+  b = EverCrypt_AEAD_create_in(Spec_Agile_AEAD_AES128_GCM, &none, key)
+    == EverCrypt_Error_UnsupportedAlgorithm;
+  b = b && EverCrypt_AEAD_encrypt_expand_aes256_gcm(key, iv, 12, aad, 0, plain, 16, c, t)
+    == EverCrypt_Error_UnsupportedAlgorithm;
+  b = b && EverCrypt_AEAD_decrypt_expand_aes128_gcm(key, iv, 12, aad, 0, c, 16, t, c)
+    == EverCrypt_Error_UnsupportedAlgorithm;
+  printf("AES-GCM unverified fallback is opt-in Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  // Everything from here on runs on the portable bitsliced implementation
+  EverCrypt_AutoConfig2_init();
+  EverCrypt_AutoConfig2_disable_vaes();
+  EverCrypt_AutoConfig2_enable_unverified();
+  b = test_cross(Spec_Agile_AEAD_AES128_GCM, EverCrypt_AutoConfig2_disable_aesni);
+  EverCrypt_AutoConfig2_init();
+  EverCrypt_AutoConfig2_disable_vaes();
+  EverCrypt_AutoConfig2_enable_unverified();
+  b = b && test_cross(Spec_Agile_AEAD_AES256_GCM, EverCrypt_AutoConfig2_disable_aesni);
+  printf("AES-GCM bitsliced vs Vale Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+  ok = test_all("bitsliced") && ok;
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
@@ -21,6 +21,10 @@
 #include "Hacl_Chacha20_Vec256.h"
 #endif
 
+#if defined(HACL_CAN_COMPILE_VEC512)
+#include "Hacl_Chacha20_Vec512.h"
+#endif
+
 #include "EverCrypt_AutoConfig2.h"
 
 #include "chacha20_vectors.h"
@@ -54,6 +58,14 @@ bool print_test(int in_len, uint8_t* in, uint8_t* key, uint8_t* nonce, uint8_t*
     ok = ok && print_result(in_len,comp,exp);
   }
 #endif
+
+#if defined(HACL_CAN_COMPILE_VEC512)
+  if (EverCrypt_AutoConfig2_has_vec512()) {
+    Hacl_Chacha20_Vec512_chacha20_encrypt_512(in_len,comp,in,key,nonce,1);
+    printf("Chacha20 (512-bit) Result:\n");
+    ok = ok && print_result(in_len,comp,exp);
+  }
+#endif
   return ok;
 }
 
@@ -132,6 +144,28 @@ int main() {
   uint64_t cyc3 = b - a;
 #endif
 
+#if defined(HACL_CAN_COMPILE_VEC512)
+  memset(plain,'P',SIZE);
+  memset(key,'K',16);
+  memset(nonce,'N',12);
+
+  if (EverCrypt_AutoConfig2_has_vec512()) {
+    for (int j = 0; j < ROUNDS; j++) {
+      Hacl_Chacha20_Vec512_chacha20_encrypt_512(SIZE,plain,plain,key,nonce,1);
+    }
+
+    t1 = clock();
+    a = cpucycles_begin();
+    for (int j = 0; j < ROUNDS; j++) {
+      Hacl_Chacha20_Vec512_chacha20_encrypt_512(SIZE,plain,plain,key,nonce,1);
+    }
+    b = cpucycles_end();
+    t2 = clock();
+  }
+  double diff4 = t2 - t1;
+  uint64_t cyc4 = b - a;
+#endif
+
   uint64_t count = ROUNDS * SIZE;
   printf("32-bit Chacha20\n"); print_time(count,diff1,cyc1);
 
@@ -145,6 +179,12 @@ int main() {
   }
 #endif
 
+#if defined(HACL_CAN_COMPILE_VEC512)
+  if (EverCrypt_AutoConfig2_has_vec512()) {
+    printf("512-bit Chacha20\n"); print_time(count,diff4,cyc4);
+  }
+#endif
+
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
 }
@@ -14,6 +14,7 @@
 #include "Hacl_Chacha20Poly1305_32.h"
 
 #include "EverCrypt_AutoConfig2.h"
+#include "EverCrypt_Chacha20Poly1305.h"
 
 #include "chacha20poly1305_vectors.h"
 
@@ -45,6 +46,64 @@ bool print_test(int in_len, uint8_t* in, uint8_t* key, uint8_t* nonce, int aad_l
   return ok;
 }
 
+// The EverCrypt entry points are bound once per configuration change; check that
+// every disable_* re-binds them to an implementation that still agrees with
+// the vectors, all the way down to the portable one.
+bool test_dispatch(){
+  EverCrypt_AutoConfig2_disabler disablers[4] = {
+    NULL,
+    EverCrypt_AutoConfig2_disable_avx512,
+    EverCrypt_AutoConfig2_disable_avx2,
+    EverCrypt_AutoConfig2_disable_avx
+  };
+  bool ok = true;
+  for (int d = 0; d < 4; d++) {
+    if (disablers[d] != NULL) disablers[d]();
+    for (int i = 0; i < sizeof(vectors)/sizeof(chacha20poly1305_test_vector); ++i) {
+      uint32_t len = vectors[i].input_len;
+      uint8_t ciphertext[len];
+      uint8_t plaintext[len];
+      uint8_t mac[16] = {0};
+      EverCrypt_Chacha20Poly1305_aead_encrypt(vectors[i].key, vectors[i].nonce,
+        vectors[i].aad_len, vectors[i].aad, len, vectors[i].input, ciphertext, mac);
+      ok = ok && memcmp(ciphertext, vectors[i].cipher, len) == 0;
+      ok = ok && memcmp(mac, vectors[i].tag, 16) == 0;
+      uint32_t res = EverCrypt_Chacha20Poly1305_aead_decrypt(vectors[i].key, vectors[i].nonce,
+        vectors[i].aad_len, vectors[i].aad, len, plaintext, ciphertext, mac);
+      ok = ok && res == 0 && memcmp(plaintext, vectors[i].input, len) == 0;
+    }
+  }
+  EverCrypt_AutoConfig2_init();
+  printf("EverCrypt Chacha20Poly1305 dispatch: %s\n", ok ? "ok" : "FAILED");
+  return ok;
+}
+
+// Short records are where the per-call flag checks used to show up.
+void print_dispatch_perf(){
+  uint8_t plain[64];
+  uint8_t cipher[64];
+  uint8_t key[32];
+  uint8_t nonce[12] = {0};
+  uint8_t tag[16];
+  memset(plain,'P',64);
+  memset(key,'K',32);
+  cycles a,b;
+  clock_t t1,t2;
+  int res = 0;
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++) {
+    EverCrypt_Chacha20Poly1305_aead_encrypt(key, nonce, 0, nonce, 64, plain, cipher, tag);
+    res ^= tag[0];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  printf("EverCrypt Chacha20Poly1305 Encrypt (64-byte records) PERF:\n");
+  print_time((uint64_t)ROUNDS * 64, t2 - t1, b - a);
+  printf(" res: %i\n", res);
+}
+
 int main(){
   EverCrypt_AutoConfig2_init();
 
@@ -109,6 +168,9 @@ int main(){
   printf("Chacha20Poly1305 Encrypt (32-bit) PERF:\n");  print_time(count,tdiff1,cdiff1);
   printf("Chacha20Poly1305 Decrypt (32-bit) PERF:\n");  print_time(count,tdiff4,cdiff4);
 
+  ok = test_dispatch() && ok;
+  print_dispatch_perf();
+
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
 }
@@ -0,0 +1,149 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "test_helpers.h"
+
+#include "Hacl_Chacha20Poly1305_256.h"
+#include "Hacl_Chacha20Poly1305_512.h"
+
+#include "EverCrypt_AutoConfig2.h"
+
+#include "chacha20poly1305_vectors.h"
+
+#define ROUNDS 100000
+#define SIZE   16384
+
+bool print_result(int in_len, uint8_t* comp, uint8_t* exp) {
+  return compare_and_print(in_len, comp, exp);
+}
+
+bool print_test(int in_len, uint8_t* in, uint8_t* key, uint8_t* nonce, int aad_len, uint8_t* aad, uint8_t* exp_mac, uint8_t* exp_cipher){
+  uint8_t plaintext[in_len];
+  memset(plaintext, 0, in_len * sizeof plaintext[0]);
+  uint8_t ciphertext[in_len];
+  memset(ciphertext, 0, in_len * sizeof ciphertext[0]);
+  uint8_t mac[16] = {0};
+  bool ok = true;
+  int res = 0;
+
+  Hacl_Chacha20Poly1305_512_aead_encrypt(key, nonce, aad_len, aad, in_len, in, ciphertext, mac);
+  printf("Chacha20Poly1305 (512-bit) Result (chacha20):\n");
+  ok = print_result(in_len,ciphertext,exp_cipher);
+  printf("(poly1305):\n");
+  ok = ok && print_result(16,mac,exp_mac);
+
+  res = Hacl_Chacha20Poly1305_512_aead_decrypt(key, nonce, aad_len, aad, in_len, plaintext, exp_cipher, exp_mac);
+  if (res != 0) printf("AEAD Decrypt (Chacha20/Poly1305) failed \n.");
+  ok = ok && (res == 0);
+  ok = ok && print_result(in_len,plaintext,in);
+
+  return ok;
+}
+
+// Every length up to a few bulk iterations must agree with the 256-bit code.
+bool test_cross() {
+  static uint8_t plain[3100], aad[100], c1[3100], c2[3100], d[3100];
+  uint8_t key[32], nonce[12], t1[16], t2[16];
+  for (int i = 0; i < sizeof(plain); i++)
+    plain[i] = (uint8_t)(i * 5 + 1);
+  for (int i = 0; i < sizeof(aad); i++)
+    aad[i] = (uint8_t)(i * 3);
+  memset(key, 0x4b, 32);
+  memset(nonce, 0x4e, 12);
+  bool ok = true;
+  for (uint32_t len = 0; len < sizeof(plain); len++) {
+    uint32_t aad_len = len % sizeof(aad);
+    Hacl_Chacha20Poly1305_256_aead_encrypt(key, nonce, aad_len, aad, len, plain, c1, t1);
+    Hacl_Chacha20Poly1305_512_aead_encrypt(key, nonce, aad_len, aad, len, plain, c2, t2);
+    ok = ok && memcmp(c1, c2, len) == 0 && memcmp(t1, t2, 16) == 0;
+    ok = ok && Hacl_Chacha20Poly1305_512_aead_decrypt(key, nonce, aad_len, aad, len, d, c1, t1) == 0;
+    ok = ok && memcmp(d, plain, len) == 0;
+    t1[len % 16] ^= 0x10;
+    ok = ok && Hacl_Chacha20Poly1305_512_aead_decrypt(key, nonce, aad_len, aad, len, d, c1, t1) == 1;
+  }
+  printf("Chacha20Poly1305 (512-bit) vs (256-bit) Result: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+int main(){
+  EverCrypt_AutoConfig2_init();
+  if (!EverCrypt_AutoConfig2_has_vec512()) {
+      printf("The current hardware doesn't support vec512: aborting\n");
+      return EXIT_SUCCESS;
+  }
+  else {
+      printf("The current hardware supports vec512: performing the tests\n");
+  }
+
+  bool ok = true;
+  for (int i = 0; i < sizeof(vectors)/sizeof(chacha20poly1305_test_vector); ++i) {
+    ok &= print_test(vectors[i].input_len,vectors[i].input,vectors[i].key,vectors[i].nonce,vectors[i].aad_len,vectors[i].aad,vectors[i].tag,vectors[i].cipher);
+  }
+  ok = test_cross() && ok;
+
+  uint8_t plain[SIZE];
+  uint8_t cipher[SIZE];
+  uint8_t aead_key[32];
+  uint8_t aead_nonce[12];
+  int aad_len = 12;
+  uint8_t aead_aad[aad_len];
+
+  int res = 0;
+  uint8_t tag[16];
+  cycles a,b;
+  clock_t t1,t2;
+
+  memset(plain,'P',SIZE);
+  memset(aead_key,'K',32);
+  for (int j = 0; j < ROUNDS; j++) {
+    Hacl_Chacha20Poly1305_512_aead_encrypt(aead_key, aead_nonce, aad_len, aead_aad, SIZE, plain, cipher, tag);
+  }
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++) {
+    Hacl_Chacha20Poly1305_512_aead_encrypt(aead_key, aead_nonce, aad_len, aead_aad, SIZE, plain, cipher, tag);
+    res ^= tag[0] ^ tag[15];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  clock_t tdiff1 = t2 - t1;
+  cycles cdiff1 = b - a;
+
+  int res1 = 0;
+  for (int j = 0; j < ROUNDS; j++) {
+    res1 = Hacl_Chacha20Poly1305_512_aead_decrypt(aead_key, aead_nonce, aad_len, aead_aad, SIZE, plain, cipher, tag);
+    res1 ^= res1;
+  }
+
+  res1 = 0;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++) {
+    Hacl_Chacha20Poly1305_512_aead_decrypt(aead_key, aead_nonce, aad_len, aead_aad, SIZE, plain, cipher, tag);
+    res1 ^= res1;
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  clock_t tdiff2 = t2 - t1;
+  cycles cdiff2 = b - a;
+
+  // JP: I don't understand what this does since this variable is almost always
+  // zeroed-out.
+  printf ("\n res1: %i \n", res1);
+
+  uint64_t count = ROUNDS * SIZE;
+  printf("Chacha20Poly1305 Encrypt (512-bit) PERF:\n"); print_time(count,tdiff1,cdiff1);
+  printf("Chacha20Poly1305 Decrypt (512-bit) PERF:\n"); print_time(count,tdiff2,cdiff2);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
@@ -10,12 +10,15 @@
 #include <time.h>
 
 #include "Hacl_Curve25519_51.h"
+#include "EverCrypt_AutoConfig2.h"
+#include "EverCrypt_Curve25519.h"
 
 #include "test_helpers.h"
 #include "curve25519_vectors.h"
 
 #define ROUNDS 100000
 #define SIZE   1
+#define BATCH  64
 
 
 bool print_result(int in_len, uint8_t* comp, uint8_t* exp) {
@@ -31,8 +34,164 @@ bool print_test(uint8_t* scalar, uint8_t* pub, uint8_t* exp){
   return ok;
 }
 
+// Every batch size up to BATCH, so that each tail length is covered, checked
+// against the single-input ladder; the inputs are chained so that they differ.
+bool test_batch() {
+  uint8_t privs_buf[BATCH][32];
+  uint8_t pubs_buf[BATCH][32];
+  uint8_t outs_buf[BATCH][32];
+  uint8_t *privs[BATCH];
+  uint8_t *pubs[BATCH];
+  uint8_t *outs[BATCH];
+  uint8_t exp[32];
+  for (int i = 0; i < BATCH; i++) {
+    memset(privs_buf[i], 'S' + i, 32);
+    memset(pubs_buf[i], 'P' + i, 32);
+    privs_buf[i][0] ^= i;
+    pubs_buf[i][31] ^= i;
+    privs[i] = privs_buf[i];
+    pubs[i] = pubs_buf[i];
+    outs[i] = outs_buf[i];
+  }
+  // Non-canonical and low-order public values too.
+  memset(pubs_buf[1], 0xff, 32);
+  memset(pubs_buf[2], 0, 32);
+
+  bool ok = true;
+  for (int n = 0; n <= BATCH; n += (n < 20 ? 1 : 11)) {
+    memset(outs_buf, 0, sizeof(outs_buf));
+    EverCrypt_Curve25519_batch_scalarmult(n, outs, privs, pubs);
+    for (int i = 0; i < n; i++) {
+      Hacl_Curve25519_51_scalarmult(exp, privs[i], pubs[i]);
+      ok = ok && memcmp(exp, outs[i], 32) == 0;
+    }
+  }
+  for (int i = 0; i < sizeof(vectors)/sizeof(curve25519_test_vector); ++i) {
+    privs[i % BATCH] = vectors[i].scalar;
+    pubs[i % BATCH] = vectors[i].public;
+  }
+  int nv = sizeof(vectors)/sizeof(curve25519_test_vector);
+  if (nv > BATCH) nv = BATCH;
+  EverCrypt_Curve25519_batch_scalarmult(nv, outs, privs, pubs);
+  for (int i = 0; i < nv; i++) {
+    ok = ok && memcmp(outs[i], vectors[i].secret, 32) == 0;
+  }
+  printf("Curve25519 batch_scalarmult: %s\n", ok ? "ok" : "FAILED");
+  return ok;
+}
+
+// Fixed-base key generation against the ladder on u = 9, for the RFC 7748
+// section 6.1 keys and a run of chained scalars (including all-zero and
+// all-one bytes, which clamping must fix up).
+bool test_secret_to_public() {
+  uint8_t alice_priv[32] = {
+    0x77,0x07,0x6d,0x0a,0x73,0x18,0xa5,0x7d,0x3c,0x16,0xc1,0x72,0x51,0xb2,0x66,0x45,
+    0xdf,0x4c,0x2f,0x87,0xeb,0xc0,0x99,0x2a,0xb1,0x77,0xfb,0xa5,0x1d,0xb9,0x2c,0x2a };
+  uint8_t alice_pub[32] = {
+    0x85,0x20,0xf0,0x09,0x89,0x30,0xa7,0x54,0x74,0x8b,0x7d,0xdc,0xb4,0x3e,0xf7,0x5a,
+    0x0d,0xbf,0x3a,0x0d,0x26,0x38,0x1a,0xf4,0xeb,0xa4,0xa9,0x8e,0xaa,0x9b,0x4e,0x6a };
+  uint8_t basepoint[32] = { 9 };
+  uint8_t priv[32];
+  uint8_t pub[32];
+  uint8_t pub_ec[32];
+  uint8_t exp[32];
+
+  Hacl_Curve25519_51_secret_to_public(pub, alice_priv);
+  bool ok = memcmp(pub, alice_pub, 32) == 0;
+  memset(priv, 0, 32);
+  for (int i = 0; i < 256; i++) {
+    if (i == 1) memset(priv, 0xff, 32);
+    Hacl_Curve25519_51_scalarmult(exp, priv, basepoint);
+    Hacl_Curve25519_51_secret_to_public(pub, priv);
+    EverCrypt_Curve25519_secret_to_public(pub_ec, priv);
+    ok = ok && memcmp(pub, exp, 32) == 0 && memcmp(pub_ec, exp, 32) == 0;
+    memcpy(priv, exp, 32);
+    priv[i % 32] ^= i;
+  }
+  printf("Curve25519 secret_to_public: %s\n", ok ? "ok" : "FAILED");
+  return ok;
+}
+
+void print_keygen_perf() {
+  uint8_t basepoint[32] = { 9 };
+  uint8_t priv[32];
+  uint8_t pub[32];
+  uint64_t res = 0;
+  cycles a,b;
+  clock_t t1,t2;
+  int rounds = ROUNDS / 4;
+  memset(priv,'S',32);
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < rounds; j++) {
+    EverCrypt_Curve25519_scalarmult(pub, priv, basepoint);
+    res ^= pub[0];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  printf("EverCrypt Curve25519 scalarmult on the base point PERF:\n");
+  print_time(rounds, t2 - t1, b - a);
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < rounds; j++) {
+    EverCrypt_Curve25519_secret_to_public(pub, priv);
+    res ^= pub[0];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  printf("EverCrypt Curve25519 secret_to_public PERF:\n");
+  print_time(rounds, t2 - t1, b - a);
+  printf(" res: %" PRIu64 "\n", res);
+}
+
+void print_batch_perf() {
+  uint8_t privs_buf[BATCH][32];
+  uint8_t pubs_buf[BATCH][32];
+  uint8_t outs_buf[BATCH][32];
+  uint8_t *privs[BATCH];
+  uint8_t *pubs[BATCH];
+  uint8_t *outs[BATCH];
+  for (int i = 0; i < BATCH; i++) {
+    memset(privs_buf[i], 'S' + i, 32);
+    memset(pubs_buf[i], 'P' + i, 32);
+    privs[i] = privs_buf[i];
+    pubs[i] = pubs_buf[i];
+    outs[i] = outs_buf[i];
+  }
+  int rounds = ROUNDS / BATCH / 4;
+  uint64_t res = 0;
+  cycles a,b;
+  clock_t t1,t2;
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < rounds; j++) {
+    for (int i = 0; i < BATCH; i++)
+      EverCrypt_Curve25519_scalarmult(outs[i], privs[i], pubs[i]);
+    res ^= outs_buf[0][0];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  printf("EverCrypt Curve25519 scalarmult, one at a time PERF:\n");
+  print_time((uint64_t)rounds * BATCH, t2 - t1, b - a);
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < rounds; j++) {
+    EverCrypt_Curve25519_batch_scalarmult(BATCH, outs, privs, pubs);
+    res ^= outs_buf[0][0];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  printf("EverCrypt Curve25519 batch_scalarmult (%d per call) PERF:\n", BATCH);
+  print_time((uint64_t)rounds * BATCH, t2 - t1, b - a);
+  printf(" res: %" PRIu64 "\n", res);
+}
 
 int main() {
+  EverCrypt_AutoConfig2_init();
 
   bool ok = true;
   for (int i = 0; i < sizeof(vectors)/sizeof(curve25519_test_vector); ++i) {
@@ -70,6 +229,14 @@ int main() {
   printf("Curve25519 (51-bit) PERF:\n"); print_time(count,tdiff1,cdiff1);
   printf("smult %8.2f mul/s\n",nsigs);
 
+  ok = test_secret_to_public() && ok;
+  print_keygen_perf();
+  ok = test_batch() && ok;
+  print_batch_perf();
+  EverCrypt_AutoConfig2_disable_ifma();
+  ok = test_batch() && ok;
+  EverCrypt_AutoConfig2_init();
+
   if (ok) return EXIT_SUCCESS;
   else return EXIT_FAILURE;
 }
@@ -18,6 +18,7 @@
 #include <inttypes.h>
 
 #include "Hacl_P256.h"
+#include "Hacl_Hash.h"
 
 
 uint64_t incorrect = UINT64_MAX;
@@ -110,6 +111,27 @@ bool test_compression()
 
 	ok = ok && compare_and_print(64, point_compressed, compressed7);
 
+
+	printf("Compression function test (batch)\n");
+
+	uint8_t* compressed8 = (uint8_t *) malloc (sizeof (uint8_t) * 33);
+	uint8_t* compressed9 = (uint8_t *) malloc (sizeof (uint8_t) * 64);
+	uint8_t* compressed10 = (uint8_t *) malloc (sizeof (uint8_t) * 64);
+	memcpy(compressed8, compressed4, 33);
+	compressed8[0] = 0x04;
+
+	uint8_t* batch_in[3] = { compressed4, compressed8, compressed6 };
+	uint8_t* batch_out[3] = { compressed9, compressed10, compressed9 };
+	bool batch_results[3];
+	bool all = Hacl_P256_decompression_compressed_form_batch(3, batch_in, batch_out, batch_results);
+
+	ok = ok && !all && batch_results[0] && !batch_results[1] && batch_results[2];
+	ok = ok && compare_and_print(64, point_compressed, compressed9);
+
+	free(compressed8);
+	free(compressed9);
+	free(compressed10);
+
 	free(compressed0);
 	free(compressed1);
 	free(compressed2);
@@ -206,6 +228,55 @@ bool test_wycheproof()
 		}
 	}
 
+	printf("%s\n", "Wycheproof tests ECDSA (batch): ");
+
+	uint32_t n = sizeof(w_ecdsa_vectors)/sizeof(ecdsap256_w_i);
+	uint8_t** pks = (uint8_t**) malloc (sizeof (uint8_t*) * n);
+	uint8_t** hashes = (uint8_t**) malloc (sizeof (uint8_t*) * n);
+	uint8_t** rs = (uint8_t**) malloc (sizeof (uint8_t*) * n);
+	uint8_t** ss = (uint8_t**) malloc (sizeof (uint8_t*) * n);
+	bool* results = (bool*) malloc (sizeof (bool) * n);
+
+	bool expected_all = true;
+	for (uint32_t i = 0; i < n; i++)
+	{
+		pks[i] = (uint8_t*) malloc (sizeof (uint8_t) * 64);
+		hashes[i] = (uint8_t*) malloc (sizeof (uint8_t) * 32);
+		memcpy(pks[i], w_ecdsa_vectors[i].publicX, 32);
+		memcpy(pks[i] + 32, w_ecdsa_vectors[i].publicY, 32);
+		Hacl_Hash_SHA2_hash_256(w_ecdsa_vectors[i].message, w_ecdsa_vectors[i].mLen, hashes[i]);
+		rs[i] = w_ecdsa_vectors[i].r;
+		ss[i] = w_ecdsa_vectors[i].s;
+		expected_all = expected_all && w_ecdsa_vectors[i].flag != incorrect;
+	}
+
+	bool all = Hacl_P256_ecdsa_verif_batch(n, pks, hashes, rs, ss, results);
+	ok = ok && all == expected_all;
+
+	for (uint32_t i = 0; i < n; i++)
+	{
+		if (w_ecdsa_vectors[i].flag == incorrect && results[i])
+			ok = false;
+		if (w_ecdsa_vectors[i].flag == correct && !results[i])
+			ok = false;
+		if (!ok)
+		{
+			printf("\n Batch test %d failed \n", i);
+			break;
+		}
+	}
+
+	for (uint32_t i = 0; i < n; i++)
+	{
+		free(pks[i]);
+		free(hashes[i]);
+	}
+	free(pks);
+	free(hashes);
+	free(rs);
+	free(ss);
+	free(results);
+
 	free(decompressedPoint);
 	free(result);
 	free(pk);
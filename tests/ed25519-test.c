@@ -0,0 +1,227 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <openssl/bn.h>
+
+#include "Hacl_Ed25519.h"
+#include "Hacl_Hash.h"
+
+#include "test_helpers.h"
+#include "ed25519_vectors.h"
+
+#define ROUNDS 200
+#define BATCH  200
+
+bool print_test(ed25519_test_vector *v) {
+  uint8_t pub[32] = {0};
+  uint8_t sig[64] = {0};
+
+  Hacl_Ed25519_secret_to_public(pub, v->secret);
+  printf("Ed25519 secret_to_public Result:\n");
+  bool ok = compare_and_print(32, pub, v->public);
+
+  Hacl_Ed25519_sign(sig, v->secret, v->msg_len, v->msg);
+  printf("Ed25519 sign Result:\n");
+  ok = compare_and_print(64, sig, v->sig) && ok;
+
+  bool valid = Hacl_Ed25519_verify(v->public, v->msg_len, v->msg, v->sig);
+  printf("Ed25519 verify Result: %s\n", valid ? "Success!" : "**FAILED**");
+  return ok && valid;
+}
+
+static uint8_t secrets[BATCH][32];
+static uint8_t pubs[BATCH][32];
+static uint8_t msgs[BATCH][48];
+static uint8_t sigs[BATCH][64];
+
+static uint8_t *pub_ptrs[BATCH];
+static uint8_t *msg_ptrs[BATCH];
+static uint8_t *sig_ptrs[BATCH];
+static uint32_t lens[BATCH];
+static bool results[BATCH];
+
+bool check_batch(uint32_t n, bool expected_all, uint32_t nbad, uint32_t *bad) {
+  memset(results, 0, sizeof(results));
+  bool all = Hacl_Ed25519_verify_batch(n, pub_ptrs, lens, msg_ptrs, sig_ptrs, results);
+  bool ok = all == expected_all;
+  for (uint32_t i = 0; i < n; i++) {
+    bool expected = true;
+    for (uint32_t j = 0; j < nbad; j++)
+      expected = expected && bad[j] != i;
+    ok = ok && results[i] == expected;
+    ok = ok && results[i] == Hacl_Ed25519_verify(pub_ptrs[i], lens[i], msg_ptrs[i], sig_ptrs[i]);
+  }
+  return ok;
+}
+
+// SHA-512(R || A || msg) mod q, for messages of up to 48 bytes
+static BIGNUM *hash_modq(BN_CTX *ctx, BIGNUM *q, uint8_t *r, uint8_t *pub, uint32_t len, uint8_t *msg) {
+  uint8_t h[64], in[64 + 48];
+  memcpy(in, r, 32);
+  memcpy(in + 32, pub, 32);
+  memcpy(in + 64, msg, len);
+  Hacl_Hash_SHA2_hash_512(in, 64 + len, h);
+  BIGNUM *x = BN_lebin2bn(h, 64, NULL);
+  BN_mod(x, x, q, ctx);
+  return x;
+}
+
+// Signs msg under A + T, where T = (0, -1) has order 2, so that
+// [s]B == R + [h]A + [h]T. When h is odd, the cofactorless equation fails and
+// the cofactored one holds; returns false (try another message) otherwise.
+bool mixed_order_signature(uint8_t *pub, uint8_t *sig, uint8_t *secret, uint32_t len, uint8_t *msg) {
+  uint8_t ks[96], sig0[64], buf[32];
+  BN_CTX *ctx = BN_CTX_new();
+  BIGNUM *q = NULL, *p = BN_new();
+  BN_dec2bn(&q, "7237005577332262213973186563042994240857116359379907606001950938285454250989");
+  BN_set_bit(p, 255);
+  BN_sub_word(p, 19);
+  Hacl_Ed25519_expand_keys(ks, secret);
+  Hacl_Ed25519_sign(sig0, secret, len, msg);
+  // r = s - h a, the nonce of sig0
+  BIGNUM *a = BN_lebin2bn(ks + 32, 32, NULL);
+  BIGNUM *s = BN_lebin2bn(sig0 + 32, 32, NULL);
+  BIGNUM *h = hash_modq(ctx, q, sig0, ks, len, msg);
+  BIGNUM *r = BN_new();
+  BN_mod_mul(r, h, a, q, ctx);
+  BN_mod_sub(r, s, r, q, ctx);
+  // A + (0, -1) = (-x, -y)
+  memcpy(buf, ks, 32);
+  buf[31] &= 0x7f;
+  BIGNUM *y = BN_lebin2bn(buf, 32, NULL);
+  BN_sub(y, p, y);
+  BN_bn2lebinpad(y, pub, 32);
+  pub[31] |= (uint8_t)((ks[31] & 0x80) ^ 0x80);
+  BIGNUM *h1 = hash_modq(ctx, q, sig0, pub, len, msg);
+  bool odd = BN_is_odd(h1);
+  BN_mod_mul(s, h1, a, q, ctx);
+  BN_mod_add(s, s, r, q, ctx);
+  memcpy(sig, sig0, 32);
+  BN_bn2lebinpad(s, sig + 32, 32);
+  BN_free(q); BN_free(p); BN_free(a); BN_free(s); BN_free(h); BN_free(r); BN_free(y); BN_free(h1);
+  BN_CTX_free(ctx);
+  return odd;
+}
+
+int main() {
+
+  bool ok = true;
+  for (int i = 0; i < sizeof(vectors)/sizeof(ed25519_test_vector); ++i) {
+    ok &= print_test(&vectors[i]);
+  }
+
+  for (uint32_t i = 0; i < BATCH; i++) {
+    memset(secrets[i], (uint8_t)i, 32);
+    secrets[i][0] = 'S';
+    memset(msgs[i], (uint8_t)(3 * i), 48);
+    lens[i] = i % 48;
+    Hacl_Ed25519_secret_to_public(pubs[i], secrets[i]);
+    Hacl_Ed25519_sign(sigs[i], secrets[i], lens[i], msgs[i]);
+    pub_ptrs[i] = pubs[i];
+    msg_ptrs[i] = msgs[i];
+    sig_ptrs[i] = sigs[i];
+  }
+
+  bool b = check_batch(0, true, 0, NULL);
+  b = b && check_batch(1, true, 0, NULL);
+  b = b && check_batch(BATCH, true, 0, NULL);
+
+  // Tamper with S, with R, with a message and with a public key, across
+  // several chunks of the batch.
+  uint32_t bad[4] = { 5, 70, 130, 199 };
+  sigs[5][40] ^= 0x01;
+  sigs[70][3] ^= 0x20;
+  msgs[130][0] ^= 0x80;
+  pubs[199][7] ^= 0x04;
+  b = b && check_batch(BATCH, false, 4, bad);
+  // s >= q must be rejected without disturbing the other signatures
+  memset(sigs[5] + 32, 0xff, 32);
+  b = b && check_batch(BATCH, false, 4, bad);
+  printf("Ed25519 verify_batch Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  msgs[130][0] ^= 0x80;
+  pubs[199][7] ^= 0x04;
+  Hacl_Ed25519_sign(sigs[5], secrets[5], lens[5], msgs[5]);
+  Hacl_Ed25519_sign(sigs[70], secrets[70], lens[70], msgs[70]);
+  b = check_batch(BATCH, true, 0, NULL);
+  printf("Ed25519 verify_batch (restored) Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  // A signature with a small-order component in A is rejected by verify and
+  // accepted by verify_batch, whatever else is in the batch
+  uint8_t mpub[32], msig[64], mmsg[48] = { 0U };
+  while (!mixed_order_signature(mpub, msig, secrets[1], 48, mmsg))
+    mmsg[0]++;
+  b = !Hacl_Ed25519_verify(mpub, 48, mmsg, msig);
+  pub_ptrs[9] = mpub;
+  msg_ptrs[9] = mmsg;
+  sig_ptrs[9] = msig;
+  lens[9] = 48;
+  for (int round = 0; round < 16; round++) {
+    memset(results, 0, sizeof(results));
+    b = b && Hacl_Ed25519_verify_batch(BATCH, pub_ptrs, lens, msg_ptrs, sig_ptrs, results);
+    b = b && results[9];
+  }
+  sigs[70][3] ^= 0x20;
+  for (int round = 0; round < 16; round++) {
+    memset(results, 0, sizeof(results));
+    b = b && !Hacl_Ed25519_verify_batch(BATCH, pub_ptrs, lens, msg_ptrs, sig_ptrs, results);
+    b = b && results[9] && !results[70] && results[71];
+  }
+  sigs[70][3] ^= 0x20;
+  pub_ptrs[9] = pubs[9];
+  msg_ptrs[9] = msgs[9];
+  sig_ptrs[9] = sigs[9];
+  lens[9] = 9;
+  printf("Ed25519 verify_batch (cofactored) Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  uint32_t n = 64;
+  bool r = true;
+  cycles a, c;
+  clock_t t1, t2;
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++) {
+    for (uint32_t i = 0; i < n; i++)
+      r &= Hacl_Ed25519_verify(pub_ptrs[i], lens[i], msg_ptrs[i], sig_ptrs[i]);
+  }
+  c = cpucycles_end();
+  t2 = clock();
+  double time1 = (((double)(t2 - t1)) / CLOCKS_PER_SEC);
+  printf("Ed25519 verify PERF: %" PRIu64 " cycles/sig, %8.2f sigs/s\n",
+    (uint64_t)(c - a) / (ROUNDS * n), ((double)ROUNDS * n) / time1);
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++) {
+    r &= Hacl_Ed25519_verify_batch(n, pub_ptrs, lens, msg_ptrs, sig_ptrs, results);
+  }
+  c = cpucycles_end();
+  t2 = clock();
+  double time2 = (((double)(t2 - t1)) / CLOCKS_PER_SEC);
+  printf("Ed25519 verify_batch (%" PRIu32 ") PERF: %" PRIu64 " cycles/sig, %8.2f sigs/s\n",
+    n, (uint64_t)(c - a) / (ROUNDS * n), ((double)ROUNDS * n) / time2);
+
+  uint8_t sig[64];
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++) {
+    for (uint32_t i = 0; i < n; i++)
+      Hacl_Ed25519_sign(sig, secrets[i], lens[i], msgs[i]);
+  }
+  c = cpucycles_end();
+  t2 = clock();
+  double time3 = (((double)(t2 - t1)) / CLOCKS_PER_SEC);
+  printf("Ed25519 sign PERF: %" PRIu64 " cycles/sig, %8.2f sigs/s\n",
+    (uint64_t)(c - a) / (ROUNDS * n), ((double)ROUNDS * n) / time3);
+
+  if (ok && r) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
@@ -32,6 +32,318 @@ void print_tree(const mt_p mt, size_t num_elts) {
   }
 }
 
+// Batches of varying sizes, starting at odd and even positions, must build
+// the same tree as one-by-one insertion.
+bool test_insert_batch() {
+  uint32_t n = 300;
+  uint8_t **leaves = malloc(n * sizeof(uint8_t *));
+  for (uint32_t i = 0; i < n; i++) {
+    leaves[i] = mt_init_hash(hash_size);
+    leaves[i][0] = (uint8_t)i;
+    leaves[i][hash_size-1] = (uint8_t)(i >> 8);
+  }
+  uint8_t *init = mt_init_hash(hash_size);
+  mt_p mts = mt_create(init);
+  mt_p mtb = mt_create(init);
+  uint8_t *rs = mt_init_hash(hash_size);
+  uint8_t *rb = mt_init_hash(hash_size);
+  uint8_t *tmp = mt_init_hash(hash_size);
+  uint32_t sizes[6] = { 1, 2, 3, 17, 64, 213 };
+  uint32_t done = 0;
+  bool ok = true;
+  for (uint32_t b = 0; b < 6; b++) {
+    for (uint32_t i = done; i < done + sizes[b]; i++) {
+      memcpy(tmp, leaves[i], hash_size);
+      mt_insert(mts, tmp);
+    }
+    if (!mt_insert_batch_pre(mtb, sizes[b])) {
+      printf("ERROR: Precondition for mt_insert_batch does not hold; exiting.\n");
+      exit(1);
+    }
+    mt_insert_batch(mtb, sizes[b], leaves + done);
+    done += sizes[b];
+    mt_get_root(mts, rs);
+    mt_get_root(mtb, rb);
+    ok = ok && memcmp(rs, rb, hash_size) == 0;
+  }
+  for (uint64_t k = 0; k <= done; k += 7) {
+    MerkleTree_Low_path *cur_path = mt_init_path(hash_size);
+    uint32_t j = mt_get_path(mtb, k, cur_path, rb);
+    ok = ok && mt_verify(mtb, k, j, cur_path, rb);
+    mt_free_path(cur_path);
+  }
+  for (uint32_t i = 0; i < n; i++)
+    mt_free_hash(leaves[i]);
+  free(leaves);
+  mt_free_hash(init);
+  mt_free_hash(rs);
+  mt_free_hash(rb);
+  mt_free_hash(tmp);
+  mt_free(mts);
+  mt_free(mtb);
+  return ok;
+}
+
+// A file-backed tree must come back from mt_open as it was last synced.
+bool test_file_backed() {
+  const char *path = "merkle_tree_test.mt";
+  uint32_t n = 1000;
+  uint8_t **leaves = malloc(n * sizeof(uint8_t *));
+  for (uint32_t i = 0; i < n; i++) {
+    leaves[i] = mt_init_hash(hash_size);
+    leaves[i][0] = (uint8_t)i;
+    leaves[i][1] = (uint8_t)(i >> 8);
+  }
+  uint8_t *init = mt_init_hash(hash_size);
+  uint8_t *rm = mt_init_hash(hash_size);
+  uint8_t *rf = mt_init_hash(hash_size);
+  mt_p mtm = mt_create(init);
+  mt_p mtf = mt_create_file(path, hash_size, init, mt_sha256_compress);
+  bool ok = mtf != NULL;
+  if (ok) {
+    mt_insert_batch(mtm, 600, leaves);
+    mt_insert_batch(mtf, 600, leaves);
+    mt_flush_to(mtm, 100);
+    mt_flush_to(mtf, 100);
+    mt_retract_to(mtm, 500);
+    mt_retract_to(mtf, 500);
+    ok = mt_sync(mtf);
+    // Close the writer before reopening: mt_free syncs the file again.
+    mt_free(mtf);
+    mtf = mt_open(path, mt_sha256_compress);
+    ok = ok && mtf != NULL;
+  }
+  if (ok) {
+    mt_get_root(mtm, rm);
+    mt_get_root(mtf, rf);
+    ok = memcmp(rm, rf, hash_size) == 0;
+    mt_insert_batch(mtm, 400, leaves + 600);
+    mt_insert_batch(mtf, 400, leaves + 600);
+    mt_free(mtf);
+    mtf = mt_open(path, mt_sha256_compress);
+    ok = ok && mtf != NULL;
+  }
+  if (ok) {
+    mt_get_root(mtm, rm);
+    mt_get_root(mtf, rf);
+    ok = memcmp(rm, rf, hash_size) == 0;
+    for (uint64_t k = 100; k < 901; k += 13) {
+      MerkleTree_Low_path *cur_path = mt_init_path(hash_size);
+      uint32_t j = mt_get_path(mtf, k, cur_path, rf);
+      ok = ok && mt_verify(mtf, k, j, cur_path, rf);
+      mt_free_path(cur_path);
+    }
+    mt_free(mtf);
+  }
+  // Not a tree file
+  FILE *fp = fopen(path, "wb");
+  fwrite(init, 1, hash_size, fp);
+  fclose(fp);
+  ok = ok && mt_open(path, mt_sha256_compress) == NULL;
+  remove(path);
+  for (uint32_t i = 0; i < n; i++)
+    mt_free_hash(leaves[i]);
+  free(leaves);
+  mt_free_hash(init);
+  mt_free_hash(rm);
+  mt_free_hash(rf);
+  mt_free(mtm);
+  return ok;
+}
+
+// A header write torn by a crash must not be trusted: mt_open falls back to the
+// state of the previous sync.
+bool test_file_backed_torn() {
+  const char *path = "merkle_tree_test_torn.mt";
+  uint32_t n = 300;
+  uint8_t **leaves = malloc(n * sizeof(uint8_t *));
+  for (uint32_t i = 0; i < n; i++) {
+    leaves[i] = mt_init_hash(hash_size);
+    leaves[i][0] = (uint8_t)i;
+    leaves[i][3] = (uint8_t)(i >> 8);
+  }
+  uint8_t *init = mt_init_hash(hash_size);
+  uint8_t *r0 = mt_init_hash(hash_size);
+  mt_p mtf = mt_create_file(path, hash_size, init, mt_sha256_compress);
+  bool ok = mtf != NULL;
+  if (ok) {
+    mt_insert_batch(mtf, 200, leaves);
+    mt_get_root(mtf, r0);
+    ok = mt_sync(mtf);
+    // mt_free syncs again, into the other slot
+    mt_insert_batch(mtf, 100, leaves + 200);
+    mt_free(mtf);
+  }
+  // The page of magic and hash size, then two 4096-byte header slots; damage the
+  // mroot of the slot with the higher sequence number.
+  FILE *fp = fopen(path, "r+b");
+  ok = ok && fp != NULL;
+  if (ok) {
+    uint8_t s0[8], s1[8], b;
+    fseek(fp, 4096 + 40, SEEK_SET);
+    ok = fread(s0, 1, 8, fp) == 8;
+    fseek(fp, 8192 + 40, SEEK_SET);
+    ok = ok && fread(s1, 1, 8, fp) == 8;
+    uint64_t q0 = 0, q1 = 0;
+    for (int k = 7; k >= 0; k--) {
+      q0 = q0 << 8 | s0[k];
+      q1 = q1 << 8 | s1[k];
+    }
+    long pos = (q0 > q1 ? 4096 : 8192) + 64;
+    fseek(fp, pos, SEEK_SET);
+    ok = ok && fread(&b, 1, 1, fp) == 1;
+    b ^= 1;
+    fseek(fp, pos, SEEK_SET);
+    ok = ok && fwrite(&b, 1, 1, fp) == 1;
+    fclose(fp);
+  }
+  if (ok) {
+    mtf = mt_open(path, mt_sha256_compress);
+    ok = mtf != NULL;
+  }
+  if (ok) {
+    uint8_t *r = mt_init_hash(hash_size);
+    mt_get_root(mtf, r);
+    ok = memcmp(r, r0, hash_size) == 0;
+    mt_free_hash(r);
+    mt_free(mtf);
+  }
+  remove(path);
+  for (uint32_t i = 0; i < n; i++)
+    mt_free_hash(leaves[i]);
+  free(leaves);
+  mt_free_hash(init);
+  mt_free_hash(r0);
+  return ok;
+}
+
+// A level larger than the biggest file-backed chunk spans several full-size
+// chunks, all of which mt_open must accept again.
+bool test_file_backed_large() {
+  const char *path = "merkle_tree_test_large.mt";
+  uint32_t n = 2100000, batch = 65536;
+  uint8_t *leaf = mt_init_hash(hash_size);
+  uint8_t **leaves = malloc(batch * sizeof(uint8_t *));
+  for (uint32_t i = 0; i < batch; i++)
+    leaves[i] = leaf;
+  uint8_t *init = mt_init_hash(hash_size);
+  uint8_t *r0 = mt_init_hash(hash_size);
+  uint8_t *r1 = mt_init_hash(hash_size);
+  mt_p mtf = mt_create_file(path, hash_size, init, mt_sha256_compress);
+  bool ok = mtf != NULL;
+  if (ok) {
+    for (uint32_t i = 0; i < n; i += batch) {
+      leaf[0] = (uint8_t)(i >> 16);
+      mt_insert_batch(mtf, n - i < batch ? n - i : batch, leaves);
+    }
+    mt_get_root(mtf, r0);
+    ok = mt_sync(mtf);
+    mt_free(mtf);
+    mtf = mt_open(path, mt_sha256_compress);
+    ok = ok && mtf != NULL;
+  }
+  if (ok) {
+    mt_get_root(mtf, r1);
+    ok = memcmp(r0, r1, hash_size) == 0;
+    mt_free(mtf);
+  }
+  remove(path);
+  free(leaves);
+  mt_free_hash(leaf);
+  mt_free_hash(init);
+  mt_free_hash(r0);
+  mt_free_hash(r1);
+  return ok;
+}
+
+// Batched path extraction and verification must agree with mt_get_path and
+// mt_verify path by path, including on duplicated and tampered paths.
+bool test_paths_batch() {
+  uint32_t n = 300, np = 40;
+  uint8_t **leaves = malloc(n * sizeof(uint8_t *));
+  for (uint32_t i = 0; i < n; i++) {
+    leaves[i] = mt_init_hash(hash_size);
+    leaves[i][0] = (uint8_t)i;
+    leaves[i][2] = (uint8_t)(i >> 8);
+  }
+  uint8_t *init = mt_init_hash(hash_size);
+  uint8_t *root = mt_init_hash(hash_size);
+  uint8_t *root1 = mt_init_hash(hash_size);
+  uint8_t *fake = mt_init_hash(hash_size);
+  mt_p mt = mt_create(init);
+  mt_insert_batch(mt, n - 1, leaves);
+  mt_flush_to(mt, 37);
+  uint64_t idxs[40];
+  bool results[40];
+  MerkleTree_Low_path *paths[40];
+  for (uint32_t q = 0; q < np; q++) {
+    // Unsorted, with duplicates, and including both ends of the tree
+    idxs[q] = 37 + (q * 97) % (n - 37);
+    if (q == 5) idxs[q] = idxs[2];
+    if (q == 6) idxs[q] = n - 1;
+    paths[q] = mt_init_path(hash_size);
+  }
+  bool ok = mt_get_paths_pre(mt, np, idxs, paths, root);
+  uint32_t j = mt_get_paths(mt, np, idxs, paths, root);
+  for (uint32_t q = 0; q < np; q++) {
+    MerkleTree_Low_path *p = mt_init_path(hash_size);
+    uint32_t j1 = mt_get_path(mt, idxs[q], p, root1);
+    ok = ok && j1 == j && memcmp(root, root1, hash_size) == 0;
+    ok = ok && mt_get_path_length(p) == mt_get_path_length(paths[q]);
+    for (uint32_t s = 0; ok && s < mt_get_path_length(p); s++)
+      ok = mt_get_path_step(p, s) == mt_get_path_step(paths[q], s);
+    mt_free_path(p);
+  }
+  ok = ok && mt_verify_batch(mt, np, idxs, j, paths, root, results);
+
+  // Tamper with a sibling shared by paths 2 and 5 in path 5 only, with the
+  // leaf of path 9, and make path 11 one step too short.
+  MerkleTree_Low_path *bad5 = mt_init_path(hash_size);
+  MerkleTree_Low_path *bad9 = mt_init_path(hash_size);
+  MerkleTree_Low_path *bad11 = mt_init_path(hash_size);
+  uint32_t len5 = mt_get_path_length(paths[5]);
+  for (uint32_t s = 0; s < len5; s++) {
+    if (s == len5 - 1) {
+      memcpy(fake, mt_get_path_step(paths[5], s), hash_size);
+      fake[0] ^= 1;
+      mt_path_insert(bad5, fake);
+    } else
+      mt_path_insert(bad5, mt_get_path_step(paths[5], s));
+  }
+  for (uint32_t s = 0; s < mt_get_path_length(paths[9]); s++)
+    mt_path_insert(bad9, s == 0 ? init : mt_get_path_step(paths[9], s));
+  for (uint32_t s = 0; s + 1 < mt_get_path_length(paths[11]); s++)
+    mt_path_insert(bad11, mt_get_path_step(paths[11], s));
+  MerkleTree_Low_path *good5 = paths[5], *good9 = paths[9], *good11 = paths[11];
+  paths[5] = bad5;
+  paths[9] = bad9;
+  paths[11] = bad11;
+  ok = ok && !mt_verify_batch(mt, np, idxs, j, paths, root, results);
+  for (uint32_t q = 0; q < np; q++) {
+    ok = ok && results[q] == (q != 5 && q != 9 && q != 11);
+    if (q != 11)
+      ok = ok && results[q] == mt_verify(mt, idxs[q], j, paths[q], root);
+  }
+  paths[5] = good5;
+  paths[9] = good9;
+  paths[11] = good11;
+  mt_free_path(bad5);
+  mt_free_path(bad9);
+  mt_free_path(bad11);
+
+  for (uint32_t q = 0; q < np; q++)
+    mt_free_path(paths[q]);
+  for (uint32_t i = 0; i < n; i++)
+    mt_free_hash(leaves[i]);
+  free(leaves);
+  mt_free_hash(init);
+  mt_free_hash(root);
+  mt_free_hash(root1);
+  mt_free_hash(fake);
+  mt_free(mt);
+  return ok;
+}
+
 int main(int argc, char *argv[]) {
 
   uint64_t num_elts = 1;
@@ -203,6 +515,35 @@ int main(int argc, char *argv[]) {
     mt_free_path(cur_path);
   }
 
+  printf("Testing batch insertion...\n");
+  bool bok = test_insert_batch();
+  // Without SHA-NI, the nodes are compressed on the vector lanes instead
+  EverCrypt_AutoConfig2_disable_shaext();
+  bok = bok && test_insert_batch();
+  printf("Batch insertion: %s\n", bok ? "Success!" : "**FAILED**");
+  if (!bok)
+    return 1;
+
+  bool fok = test_file_backed();
+  printf("File-backed tree: %s\n", fok ? "Success!" : "**FAILED**");
+  if (!fok)
+    return 1;
+
+  bool tok = test_file_backed_torn();
+  printf("Torn file-backed header: %s\n", tok ? "Success!" : "**FAILED**");
+  if (!tok)
+    return 1;
+
+  bool lok = test_file_backed_large();
+  printf("Large file-backed tree: %s\n", lok ? "Success!" : "**FAILED**");
+  if (!lok)
+    return 1;
+
+  bool pok = test_paths_batch();
+  printf("Batch paths: %s\n", pok ? "Success!" : "**FAILED**");
+  if (!pok)
+    return 1;
+
   // Free
   mt_free(mt);
   mt_free_hash(root);
@@ -0,0 +1,110 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "test_helpers.h"
+
+#include "Hacl_Poly1305_256.h"
+#include "Hacl_Poly1305_512.h"
+
+#include "EverCrypt_AutoConfig2.h"
+
+#include "poly1305_vectors.h"
+
+#define ROUNDS 100000
+#define SIZE   16384
+
+bool print_result(uint8_t* comp, uint8_t* exp) {
+  return compare_and_print(16, comp, exp);
+}
+
+bool print_test(int in_len, uint8_t* in, uint8_t* key, uint8_t* exp){
+  uint8_t comp[16] = {0};
+  bool ok = true;
+
+  Hacl_Poly1305_512_poly1305_mac(comp,in_len,in,key);
+  printf("Poly1305 (512-bit) Result:\n");
+  ok = ok && print_result(comp, exp);
+
+  return ok;
+}
+
+// Every length up to a few bulk iterations must agree with the 256-bit code,
+// including when the input is fed in two uneven updates.
+bool test_cross() {
+  uint8_t text[2200];
+  uint8_t key[32];
+  uint8_t t1[16], t2[16], t3[16];
+  for (int i = 0; i < sizeof(text); i++)
+    text[i] = (uint8_t)(i * 7 + 3);
+  for (int i = 0; i < 32; i++)
+    key[i] = (uint8_t)(0xf0 - i);
+  bool ok = true;
+  for (uint32_t len = 0; len < sizeof(text); len++) {
+    Hacl_Poly1305_256_poly1305_mac(t1, len, text, key);
+    Hacl_Poly1305_512_poly1305_mac(t2, len, text, key);
+    Lib_IntVector_Intrinsics_vec512 ctx[25] = { 0 };
+    uint32_t split = len / 32 * 16;
+    Hacl_Poly1305_512_poly1305_init(ctx, key);
+    Hacl_Poly1305_512_poly1305_update(ctx, split, text);
+    Hacl_Poly1305_512_poly1305_update(ctx, len - split, text + split);
+    Hacl_Poly1305_512_poly1305_finish(t3, key, ctx);
+    ok = ok && memcmp(t1, t2, 16) == 0 && memcmp(t1, t3, 16) == 0;
+  }
+  printf("Poly1305 (512-bit) vs (256-bit) Result: %s\n", ok ? "Success!" : "**FAILED**");
+  return ok;
+}
+
+int main() {
+  EverCrypt_AutoConfig2_init();
+  if (!EverCrypt_AutoConfig2_has_vec512()) {
+      printf("The current hardware doesn't support vec512: aborting\n");
+      return EXIT_SUCCESS;
+  }
+  else {
+      printf("The current hardware supports vec512: performing the tests\n");
+  }
+
+  bool ok = true;
+  for (int i = 0; i < sizeof(vectors)/sizeof(poly1305_test_vector); ++i) {
+    ok &= print_test(vectors[i].input_len,vectors[i].input,vectors[i].key,vectors[i].tag);
+  }
+  ok = test_cross() && ok;
+
+  uint8_t plain[SIZE];
+  uint8_t key[32];
+  uint64_t res = 0;
+  uint8_t tag[16];
+  cycles a,b;
+  clock_t t1,t2;
+
+  memset(plain,'P',SIZE);
+  memset(key,'K',16);
+  for (int j = 0; j < ROUNDS; j++) {
+    Hacl_Poly1305_512_poly1305_mac(plain,SIZE,plain,key);
+  }
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++) {
+    Hacl_Poly1305_512_poly1305_mac(tag,SIZE,plain,key);
+    res ^= tag[0] ^ tag[15];
+  }
+  b = cpucycles_end();
+  t2 = clock();
+  clock_t tdiff1 = t2 - t1;
+  cycles cdiff1 = b - a;
+
+  uint64_t count = ROUNDS * SIZE;
+  printf("Poly1305 (512-bit) PERF:\n"); print_time(count,tdiff1,cdiff1);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
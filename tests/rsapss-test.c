@@ -29,7 +29,13 @@ bool print_test(
   uint8_t *msg,
   uint32_t saltLen,
   uint8_t *salt,
-  uint8_t *sgnt_expected
+  uint8_t *sgnt_expected,
+  uint32_t pqBits,
+  uint8_t *pb,
+  uint8_t *qb,
+  uint8_t *dPb,
+  uint8_t *dQb,
+  uint8_t *qInvb
 ){
   uint32_t nbLen = (modBits - (uint32_t)1U) / (uint32_t)8U + (uint32_t)1U;
   uint8_t sgnt[nbLen];
@@ -47,6 +53,44 @@ bool print_test(
   bool ver = Hacl_RSAPSS_rsapss_verify(Spec_Hash_Definitions_SHA2_256, modBits, eBits, pkey, saltLen, nbLen, sgnt, msgLen, msg);
   if (ver) printf("Success!\n");
   ok = ok && ver;
+
+  uint64_t *skey_crt = Hacl_RSAPSS_new_rsapss_load_skey_crt(modBits, eBits, pqBits, nb, eb, pb, qb, dPb, dQb, qInvb);
+  memset(sgnt, 0U, nbLen * sizeof (sgnt[0U]));
+  bool sgn_crt = skey_crt != NULL &&
+    Hacl_RSAPSS_rsapss_sign_crt(Spec_Hash_Definitions_SHA2_256, modBits, eBits, pqBits, skey_crt, saltLen, salt, msgLen, msg, sgnt);
+  printf("RSAPSS sign (CRT) Result:\n");
+  ok = ok && sgn_crt && print_result(nbLen, sgnt, sgnt_expected);
+
+  Hacl_RSAPSS_pkey *pk = Hacl_RSAPSS_pkey_init(modBits, eBits, nb, eb);
+  Hacl_RSAPSS_skey *sk = Hacl_RSAPSS_skey_init(modBits, eBits, dBits, nb, eb, db);
+  memset(sgnt, 0U, nbLen * sizeof (sgnt[0U]));
+  bool sgn_key = pk != NULL && sk != NULL &&
+    Hacl_RSAPSS_rsapss_sign_key(Spec_Hash_Definitions_SHA2_256, sk, saltLen, salt, msgLen, msg, sgnt);
+  printf("RSAPSS sign (key object) Result:\n");
+  ok = ok && sgn_key && print_result(nbLen, sgnt, sgnt_expected);
+  bool ver_key = sgn_key &&
+    Hacl_RSAPSS_rsapss_verify_key(Spec_Hash_Definitions_SHA2_256, pk, saltLen, nbLen, sgnt, msgLen, msg);
+  sgnt[0U] ^= (uint8_t)1U;
+  ver_key = ver_key &&
+    !Hacl_RSAPSS_rsapss_verify_key(Spec_Hash_Definitions_SHA2_256, pk, saltLen, nbLen, sgnt, msgLen, msg);
+  printf("RSAPSS verify (key object) Result: %s\n", ver_key ? "Success!" : "**FAILED**");
+  ok = ok && ver_key;
+
+  Hacl_RSAPSS_skey *sk_crt = Hacl_RSAPSS_skey_init_crt(modBits, eBits, pqBits, nb, eb, pb, qb, dPb, dQb, qInvb);
+  memset(sgnt, 0U, nbLen * sizeof (sgnt[0U]));
+  bool sgn_key_crt = sk_crt != NULL &&
+    Hacl_RSAPSS_rsapss_sign_key(Spec_Hash_Definitions_SHA2_256, sk_crt, saltLen, salt, msgLen, msg, sgnt);
+  printf("RSAPSS sign (CRT key object) Result:\n");
+  ok = ok && sgn_key_crt && print_result(nbLen, sgnt, sgnt_expected);
+
+  Hacl_RSAPSS_pkey_free(pk);
+  Hacl_RSAPSS_skey_free(sk);
+  Hacl_RSAPSS_skey_free(sk_crt);
+  Hacl_RSAPSS_pkey_free(NULL);
+  Hacl_RSAPSS_skey_free(NULL);
+  free(pkey);
+  free(skey);
+  free(skey_crt);
   return ok;
 }
 
@@ -55,7 +99,8 @@ int main() {
   bool ok = true;
   for (int i = 0; i < sizeof(vectors)/sizeof(rsapss_test_vector); ++i) {
     ok &= print_test(vectors[i].modBits,vectors[i].n,vectors[i].eBits,vectors[i].e,vectors[i].dBits,vectors[i].d,
-		     vectors[i].msgLen,vectors[i].msg,vectors[i].saltLen,vectors[i].salt,vectors[i].sgnt_expected);
+		     vectors[i].msgLen,vectors[i].msg,vectors[i].saltLen,vectors[i].salt,vectors[i].sgnt_expected,
+		     vectors[i].pqBits,vectors[i].p,vectors[i].q,vectors[i].dP,vectors[i].dQ,vectors[i].qInv);
   }
 
   if (ok) return EXIT_SUCCESS;
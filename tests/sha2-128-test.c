@@ -0,0 +1,131 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdbool.h>
+
+#include "Hacl_Hash.h"
+#include "Hacl_SHA2_Vec128.h"
+
+#include "test_helpers.h"
+
+#include "EverCrypt_AutoConfig2.h"
+#include "sha2_vectors.h"
+
+#define ROUNDS 4096
+#define BATCH  64
+#define SIZE   1024
+
+static uint8_t msgs[BATCH][SIZE];
+static uint8_t digests[BATCH][32];
+static uint8_t expected[BATCH][32];
+static uint8_t *in_ptrs[BATCH];
+static uint8_t *dst_ptrs[BATCH];
+static uint32_t lens[BATCH];
+
+// Hashes the first n messages with the kernel and compares each digest to the
+// 32-bit implementation.
+bool check_lanes(uint32_t n) {
+  memset(digests, 0, sizeof(digests));
+  for (uint32_t i = 0; i < n; i++)
+    Hacl_Hash_SHA2_hash_256(in_ptrs[i], lens[i], expected[i]);
+  Hacl_SHA2_Vec128_sha256_4(dst_ptrs, lens, in_ptrs);
+  bool ok = true;
+  for (uint32_t i = 0; i < n; i++)
+    ok = ok && memcmp(digests[i], expected[i], 32) == 0;
+  return ok;
+}
+
+int main()
+{
+  EverCrypt_AutoConfig2_init();
+  if (!EverCrypt_AutoConfig2_has_vec128()) {
+      printf("The current hardware doesn't support vec128: aborting\n");
+      return EXIT_SUCCESS;
+  }
+  else {
+      printf("The current hardware supports vec128: performing the tests\n");
+  }
+
+  bool ok = true;
+  size_t nv = sizeof(vectors)/sizeof(sha2_test_vector);
+  for (uint32_t i = 0; i < BATCH; i++) {
+    in_ptrs[i] = msgs[i];
+    dst_ptrs[i] = digests[i];
+  }
+
+  // Known-answer vectors, each replicated in all lanes
+  for (size_t v = 0; v < nv; v++) {
+    for (uint32_t i = 0; i < 4; i++) {
+      in_ptrs[i] = vectors[v].input;
+      lens[i] = vectors[v].input_len;
+    }
+    Hacl_SHA2_Vec128_sha256_4(dst_ptrs, lens, in_ptrs);
+    printf("SHA2-256 (vec128, 4 lanes) Result:\n");
+    ok = compare_and_print(32, digests[3], vectors[v].tag_256) && ok;
+  }
+  for (uint32_t i = 0; i < BATCH; i++)
+    in_ptrs[i] = msgs[i];
+
+  // Lanes of different lengths, covering the one- and two-block paddings
+  for (uint32_t i = 0; i < BATCH; i++) {
+    for (uint32_t j = 0; j < SIZE; j++)
+      msgs[i][j] = (uint8_t)(i * 31 + j * 7);
+  }
+  bool b = true;
+  for (uint32_t r = 0; r < 300; r++) {
+    for (uint32_t i = 0; i < 4; i++)
+      lens[i] = (r * 13 + i * 57 + (r * i) % 5) % 300;
+    b = b && check_lanes(4);
+  }
+  printf("SHA2 vec128 mixed lengths Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  // Single-block compression from the initial state, without padding
+  b = true;
+  memset(digests, 0, sizeof(digests));
+  Hacl_SHA2_Vec128_sha256_compress_4(dst_ptrs, in_ptrs);
+  for (uint32_t i = 0; i < 4; i++) {
+    uint32_t st[8];
+    Hacl_Hash_Core_SHA2_init_256(st);
+    Hacl_Hash_Core_SHA2_update_256(st, in_ptrs[i]);
+    Hacl_Hash_Core_SHA2_finish_256(st, expected[i]);
+    b = b && memcmp(digests[i], expected[i], 32) == 0;
+  }
+  printf("SHA2-256 (vec128, 4 lanes) compress Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  // Throughput on 64-byte messages, as in a Merkle tree
+  for (uint32_t i = 0; i < BATCH; i++)
+    lens[i] = 64;
+  cycles a, c;
+  clock_t t1, t2;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (uint32_t i = 0; i < BATCH; i++)
+      Hacl_Hash_SHA2_hash_256(in_ptrs[i], lens[i], dst_ptrs[i]);
+  c = cpucycles_end();
+  t2 = clock();
+  double tdiff1 = (double)(t2 - t1);
+  uint64_t cdiff1 = (uint64_t)(c - a);
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (uint32_t i = 0; i < BATCH; i += 4)
+      Hacl_SHA2_Vec128_sha256_4(dst_ptrs + i, lens + i, in_ptrs + i);
+  c = cpucycles_end();
+  t2 = clock();
+  double tdiff2 = (double)(t2 - t1);
+  uint64_t cdiff2 = (uint64_t)(c - a);
+
+  printf("SHA2-256 (32-bit) PERF: %" PRIu64 " cycles/msg, %8.2f msgs/s\n",
+    cdiff1 / (ROUNDS * BATCH), (double)ROUNDS * BATCH * CLOCKS_PER_SEC / tdiff1);
+  printf("SHA2-256 (vec128, 4 lanes) PERF: %" PRIu64 " cycles/msg, %8.2f msgs/s\n",
+    cdiff2 / (ROUNDS * BATCH), (double)ROUNDS * BATCH * CLOCKS_PER_SEC / tdiff2);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}
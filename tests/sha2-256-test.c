@@ -0,0 +1,154 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdbool.h>
+
+#include "Hacl_Hash.h"
+#include "Hacl_SHA2_Vec256.h"
+#include "EverCrypt_Hash.h"
+
+#include "test_helpers.h"
+
+#include "EverCrypt_AutoConfig2.h"
+#include "sha2_vectors.h"
+
+#define ROUNDS 4096
+#define BATCH  64
+#define SIZE   1024
+
+static uint8_t msgs[BATCH][SIZE];
+static uint8_t digests[BATCH][64];
+static uint8_t expected[BATCH][64];
+static uint8_t *in_ptrs[BATCH];
+static uint8_t *dst_ptrs[BATCH];
+static uint32_t lens[BATCH];
+
+// Hashes the first n messages with the kernel and compares each digest to the
+// 32-bit implementation.
+bool check_lanes(uint32_t n, bool sha512) {
+  memset(digests, 0, sizeof(digests));
+  for (uint32_t i = 0; i < n; i++) {
+    if (sha512) Hacl_Hash_SHA2_hash_512(in_ptrs[i], lens[i], expected[i]);
+    else Hacl_Hash_SHA2_hash_256(in_ptrs[i], lens[i], expected[i]);
+  }
+  if (sha512) Hacl_SHA2_Vec256_sha512_4(dst_ptrs, lens, in_ptrs);
+  else Hacl_SHA2_Vec256_sha256_8(dst_ptrs, lens, in_ptrs);
+  bool ok = true;
+  for (uint32_t i = 0; i < n; i++)
+    ok = ok && memcmp(digests[i], expected[i], sha512 ? 64 : 32) == 0;
+  return ok;
+}
+
+int main()
+{
+  EverCrypt_AutoConfig2_init();
+  if (!EverCrypt_AutoConfig2_has_vec256()) {
+      printf("The current hardware doesn't support vec256: aborting\n");
+      return EXIT_SUCCESS;
+  }
+  else {
+      printf("The current hardware supports vec256: performing the tests\n");
+  }
+
+  bool ok = true;
+  size_t nv = sizeof(vectors)/sizeof(sha2_test_vector);
+  for (uint32_t i = 0; i < BATCH; i++) {
+    in_ptrs[i] = msgs[i];
+    dst_ptrs[i] = digests[i];
+  }
+
+  // Known-answer vectors, each replicated in all lanes
+  for (size_t v = 0; v < nv; v++) {
+    for (uint32_t i = 0; i < 8; i++) {
+      in_ptrs[i] = vectors[v].input;
+      lens[i] = vectors[v].input_len;
+    }
+    Hacl_SHA2_Vec256_sha256_8(dst_ptrs, lens, in_ptrs);
+    printf("SHA2-256 (vec256, 8 lanes) Result:\n");
+    ok = compare_and_print(32, digests[7], vectors[v].tag_256) && ok;
+    Hacl_SHA2_Vec256_sha512_4(dst_ptrs, lens, in_ptrs);
+    printf("SHA2-512 (vec256, 4 lanes) Result:\n");
+    ok = compare_and_print(64, digests[3], vectors[v].tag_512) && ok;
+  }
+  for (uint32_t i = 0; i < BATCH; i++)
+    in_ptrs[i] = msgs[i];
+
+  // Lanes of different lengths, covering the one- and two-block paddings
+  for (uint32_t i = 0; i < BATCH; i++) {
+    for (uint32_t j = 0; j < SIZE; j++)
+      msgs[i][j] = (uint8_t)(i * 31 + j * 7);
+  }
+  bool b = true;
+  for (uint32_t r = 0; r < 300; r++) {
+    for (uint32_t i = 0; i < 8; i++)
+      lens[i] = (r * 13 + i * 57 + (r * i) % 5) % 300;
+    b = b && check_lanes(8, false) && check_lanes(4, true);
+  }
+  printf("SHA2 vec256 mixed lengths Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  // Single-block compression from the initial state, without padding
+  b = true;
+  memset(digests, 0, sizeof(digests));
+  Hacl_SHA2_Vec256_sha256_compress_8(dst_ptrs, in_ptrs);
+  for (uint32_t i = 0; i < 8; i++) {
+    uint32_t st[8];
+    Hacl_Hash_Core_SHA2_init_256(st);
+    Hacl_Hash_Core_SHA2_update_256(st, in_ptrs[i]);
+    Hacl_Hash_Core_SHA2_finish_256(st, expected[i]);
+    b = b && memcmp(digests[i], expected[i], 32) == 0;
+  }
+  printf("SHA2-256 (vec256, 8 lanes) compress Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  // EverCrypt dispatch, with a batch size that is not a multiple of the lanes
+  b = true;
+  for (uint32_t i = 0; i < BATCH; i++)
+    lens[i] = (i * 97) % SIZE;
+  for (uint32_t k = 0; k < 2; k++) {
+    Spec_Hash_Definitions_hash_alg a = k == 0 ? Spec_Hash_Definitions_SHA2_256 : Spec_Hash_Definitions_SHA2_512;
+    memset(digests, 0, sizeof(digests));
+    EverCrypt_Hash_hash_many(a, BATCH - 3, dst_ptrs, in_ptrs, lens);
+    for (uint32_t i = 0; i < BATCH - 3; i++) {
+      EverCrypt_Hash_hash(a, expected[i], in_ptrs[i], lens[i]);
+      b = b && memcmp(digests[i], expected[i], k == 0 ? 32 : 64) == 0;
+    }
+  }
+  printf("EverCrypt_Hash_hash_many Result: %s\n", b ? "Success!" : "**FAILED**");
+  ok = ok && b;
+
+  // Throughput on 64-byte messages, as in a Merkle tree
+  for (uint32_t i = 0; i < BATCH; i++)
+    lens[i] = 64;
+  cycles a, c;
+  clock_t t1, t2;
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (uint32_t i = 0; i < BATCH; i++)
+      Hacl_Hash_SHA2_hash_256(in_ptrs[i], lens[i], dst_ptrs[i]);
+  c = cpucycles_end();
+  t2 = clock();
+  double tdiff1 = (double)(t2 - t1);
+  uint64_t cdiff1 = (uint64_t)(c - a);
+
+  t1 = clock();
+  a = cpucycles_begin();
+  for (int j = 0; j < ROUNDS; j++)
+    for (uint32_t i = 0; i < BATCH; i += 8)
+      Hacl_SHA2_Vec256_sha256_8(dst_ptrs + i, lens + i, in_ptrs + i);
+  c = cpucycles_end();
+  t2 = clock();
+  double tdiff2 = (double)(t2 - t1);
+  uint64_t cdiff2 = (uint64_t)(c - a);
+
+  printf("SHA2-256 (32-bit) PERF: %" PRIu64 " cycles/msg, %8.2f msgs/s\n",
+    cdiff1 / (ROUNDS * BATCH), (double)ROUNDS * BATCH * CLOCKS_PER_SEC / tdiff1);
+  printf("SHA2-256 (vec256, 8 lanes) PERF: %" PRIu64 " cycles/msg, %8.2f msgs/s\n",
+    cdiff2 / (ROUNDS * BATCH), (double)ROUNDS * BATCH * CLOCKS_PER_SEC / tdiff2);
+
+  if (ok) return EXIT_SUCCESS;
+  else return EXIT_FAILURE;
+}